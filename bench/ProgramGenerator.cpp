@@ -0,0 +1,198 @@
+#include "ProgramGenerator.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace umbra {
+namespace bench {
+
+    namespace {
+
+        /// xorshift32: mismo resultado en cualquier plataforma y biblioteca estándar.
+        class Random {
+            public:
+                explicit Random(uint32_t seed) : state(seed ? seed : 0x9E3779B9u) {}
+
+                uint32_t next() {
+                    state ^= state << 13;
+                    state ^= state >> 17;
+                    state ^= state << 5;
+                    return state;
+                }
+
+                int below(int n) { return n > 0 ? static_cast<int>(next() % static_cast<uint32_t>(n)) : 0; }
+
+            private:
+                uint32_t state;
+        };
+
+        class Generator {
+            public:
+                Generator(const ProgramShape& shape, std::ostringstream& out)
+                    : shape(shape), out(out), random(shape.seed) {}
+
+                void program() {
+                    for (int f = 0; f < shape.functions; ++f) {
+                        function(f);
+                    }
+
+                    out << "func start() -> void {\n";
+                    out << "    int total = 0\n";
+                    for (int f = 0; f < shape.functions; ++f) {
+                        out << "    total = total + f" << f << "(" << f << ", " << random.below(100) << ")\n";
+                    }
+                    out << "    print(\"total={}\", total)\n";
+                    out << "}\n";
+                }
+
+            private:
+                const ProgramShape& shape;
+                std::ostringstream& out;
+                Random random;
+                int currentFunction = 0;
+                int stringsLeft = 0;
+                int nextString = 0;
+
+                void indent(int level) {
+                    for (int i = 0; i < level; ++i) out << "    ";
+                }
+
+                /// Operando entero visible en cualquier punto del cuerpo de la función.
+                void operand() {
+                    switch (random.below(6)) {
+                        case 0: out << "a"; break;
+                        case 1: out << "b"; break;
+                        case 2: out << "acc"; break;
+                        case 3: out << "i"; break;
+                        case 4: out << "data[" << random.below(std::max(shape.arraySize, 1)) << "]"; break;
+                        default: out << random.below(1000); break;
+                    }
+                }
+
+                /// Cadena de operandos unidos por + - * (sin divisiones: nunca divide por cero).
+                void expression() {
+                    static const char* ops[] = {" + ", " - ", " * "};
+                    int length = std::max(shape.expressionLength, 1);
+                    for (int k = 0; k < length; ++k) {
+                        if (k > 0) out << ops[random.below(3)];
+                        // Paréntesis ocasionales para que el parser vea precedencias mezcladas
+                        if (k + 1 < length && random.below(5) == 0) {
+                            out << "(";
+                            operand();
+                            out << ops[random.below(3)];
+                            operand();
+                            out << ")";
+                            ++k;
+                        } else {
+                            operand();
+                        }
+                    }
+                }
+
+                void condition() {
+                    static const char* cmps[] = {" > ", " < ", " == "};
+                    out << "(";
+                    operand();
+                    out << cmps[random.below(3)];
+                    expression();
+                    out << ")";
+                }
+
+                void stringStatement(int level) {
+                    indent(level);
+                    int id = nextString++;
+                    --stringsLeft;
+                    if (id % 2 == 0) {
+                        out << "print(\"f" << currentFunction << " message " << id << ": {}\", acc)\n";
+                    } else {
+                        out << "string s" << id << " = \"literal " << id << " of f" << currentFunction << "\"\n";
+                    }
+                }
+
+                void statement(int level, int depth) {
+                    int choice = random.below(depth > 0 ? 6 : 4);
+                    if (stringsLeft > 0 && choice == 0) {
+                        stringStatement(level);
+                        return;
+                    }
+                    switch (choice) {
+                        case 4:
+                            indent(level);
+                            out << "if ";
+                            condition();
+                            out << " {\n";
+                            block(level + 1, depth - 1);
+                            indent(level);
+                            out << "} else {\n";
+                            block(level + 1, depth - 1);
+                            indent(level);
+                            out << "}\n";
+                            break;
+                        case 5:
+                            indent(level);
+                            out << "repeat " << 1 + random.below(4) << " times {\n";
+                            block(level + 1, depth - 1);
+                            indent(level);
+                            out << "}\n";
+                            break;
+                        case 3:
+                            if (currentFunction > 0) {
+                                indent(level);
+                                out << "acc = acc + f" << random.below(currentFunction) << "(b, acc)\n";
+                                break;
+                            }
+                            [[fallthrough]];
+                        default:
+                            indent(level);
+                            out << "acc = ";
+                            expression();
+                            out << "\n";
+                            break;
+                    }
+                }
+
+                void block(int level, int depth) {
+                    int count = 1 + random.below(3);
+                    for (int s = 0; s < count; ++s) {
+                        statement(level, depth);
+                    }
+                }
+
+                void function(int f) {
+                    currentFunction = f;
+                    stringsLeft = shape.stringLiterals;
+                    int size = std::max(shape.arraySize, 1);
+
+                    out << "func f" << f << "(int a, int b) -> int {\n";
+                    out << "    int acc = a\n";
+                    out << "    int [" << size << "]data\n";
+                    out << "    int i = 0\n";
+                    out << "    repeat " << size << " times {\n";
+                    out << "        data[i] = ";
+                    expression();
+                    out << "\n";
+                    out << "        i = i + 1\n";
+                    out << "    }\n";
+                    out << "    i = 0\n";
+                    for (int s = 0; s < shape.statementsPerFunction; ++s) {
+                        statement(1, shape.nestingDepth);
+                    }
+                    while (stringsLeft > 0) {
+                        stringStatement(1);
+                    }
+                    out << "    return acc\n";
+                    out << "}\n\n";
+                }
+        };
+
+    } // namespace
+
+    std::string generateProgram(const ProgramShape& shape) {
+        std::ostringstream out;
+        Generator generator(shape, out);
+        generator.program();
+        return out.str();
+    }
+
+} // namespace bench
+} // namespace umbra
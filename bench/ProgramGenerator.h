@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @file ProgramGenerator.h
+ * @brief Generador determinista de programas Umbra sintéticos para los benchmarks del frontend.
+ * @details
+ * El mismo ProgramShape produce siempre el mismo texto (el generador pseudoaleatorio es propio,
+ * no depende de la implementación de <random>), así que los resultados son comparables entre
+ * máquinas y entre commits. Los programas generados son válidos: pasan el análisis semántico y
+ * se pueden compilar y ejecutar.
+ */
+
+namespace umbra {
+namespace bench {
+
+    /// Forma del programa: cada campo escala una parte distinta del frontend.
+    struct ProgramShape {
+        int functions = 50;             // Funciones además de start()
+        int statementsPerFunction = 20; // Sentencias de nivel superior por función
+        int nestingDepth = 3;           // Profundidad máxima de if/repeat anidados
+        int expressionLength = 8;       // Operandos por expresión aritmética
+        int arraySize = 64;             // Elementos del array local de cada función
+        int stringLiterals = 4;         // Literales de cadena por función
+        uint32_t seed = 1;
+    };
+
+    /// Texto fuente del programa descrito por shape.
+    std::string generateProgram(const ProgramShape& shape);
+
+} // namespace bench
+} // namespace umbra
@@ -0,0 +1,241 @@
+#include "ProgramGenerator.h"
+
+#include "umbra/ast/Nodes.h"
+#include "umbra/codegen/analysis/ASTWalk.h"
+#include "umbra/codegen/context/CodegenContext.h"
+#include "umbra/codegen/visitors/CodegenVisitor.h"
+#include "umbra/error/ErrorManager.h"
+#include "umbra/lexer/Lexer.h"
+#include "umbra/parser/Parser.h"
+#include "umbra/semantic/ConstantFolder.h"
+#include "umbra/semantic/SemanticAnalyzer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file frontend_bench.cpp
+ * @brief Rendimiento de cada fase del compilador sobre programas generados.
+ * @details
+ * Cada benchmark mide una sola fase (lexer, parser, semántico + plegado de constantes, codegen)
+ * para cada forma de programa y reporta bytes/s del fuente y nodes/s del AST. Las fases previas
+ * se preparan fuera del tiempo medido. UMBRA_BENCH_SCALE multiplica el número de funciones.
+ */
+
+namespace {
+
+    using umbra::bench::ProgramShape;
+
+    struct NamedShape {
+        const char* name;
+        ProgramShape shape;
+    };
+
+    std::vector<NamedShape> makeShapes() {
+        int scale = 1;
+        if (const char* env = std::getenv("UMBRA_BENCH_SCALE")) {
+            scale = std::max(1, std::atoi(env));
+        }
+
+        // functions, statementsPerFunction, nestingDepth, expressionLength, arraySize, stringLiterals, seed
+        std::vector<NamedShape> shapes = {
+            {"balanced",   {50, 20, 3, 8, 64, 4, 1}},
+            {"many_funcs", {400, 6, 1, 4, 8, 1, 2}},
+            {"deep",       {20, 10, 12, 4, 16, 2, 3}},
+            {"long_exprs", {20, 10, 1, 200, 16, 1, 4}},
+            {"big_arrays", {40, 8, 2, 6, 100000, 1, 5}},
+            {"strings",    {40, 8, 1, 4, 16, 60, 6}},
+        };
+        for (auto& named : shapes) {
+            named.shape.functions *= scale;
+        }
+        return shapes;
+    }
+
+    const std::vector<NamedShape>& shapes() {
+        static const std::vector<NamedShape> all = makeShapes();
+        return all;
+    }
+
+    const std::string& source(size_t index) {
+        static std::vector<std::string> cache(shapes().size());
+        if (cache[index].empty()) {
+            cache[index] = umbra::bench::generateProgram(shapes()[index].shape);
+        }
+        return cache[index];
+    }
+
+    size_t countNodes(umbra::Expression* expr) {
+        if (!expr) return 0;
+        size_t count = 1;
+        umbra::code_gen::forEachChild(expr, [&](umbra::Expression* child) { count += countNodes(child); });
+        return count;
+    }
+
+    size_t countNodes(const std::vector<std::unique_ptr<umbra::Statement>>& block) {
+        size_t count = 0;
+        for (auto& stmt : block) {
+            ++count;
+            umbra::code_gen::forEachPart(
+                stmt.get(),
+                [&](umbra::Expression* expr) { count += countNodes(expr); },
+                [&](const std::vector<std::unique_ptr<umbra::Statement>>& body) { count += countNodes(body); });
+        }
+        return count;
+    }
+
+    size_t countNodes(umbra::ProgramNode& program) {
+        size_t count = 1;
+        for (auto& function : program.functions) {
+            count += 1 + countNodes(function->body);
+        }
+        return count;
+    }
+
+    /// Fases hasta el AST analizado; la fase medida parte de aquí.
+    struct Frontend {
+        umbra::ErrorManager errors;
+        std::vector<umbra::Lexer::Token> tokens;
+        std::unique_ptr<umbra::ProgramNode> program;
+
+        bool lex(const std::string& text) {
+            umbra::Lexer lexer(text, errors);
+            tokens = lexer.tokenize();
+            return errors.getErrorCount() == 0;
+        }
+
+        bool parse() {
+            umbra::Parser parser(tokens, errors);
+            program = parser.parseProgram();
+            return program && errors.getErrorCount() == 0;
+        }
+
+        bool analyze() {
+            umbra::SemanticAnalyzer analyzer(errors, program.get());
+            analyzer.execAnalysisPipeline();
+            umbra::ConstantFolder folder(errors);
+            folder.fold(program.get());
+            return errors.getErrorCount() == 0;
+        }
+    };
+
+    /// bytes/s del fuente y nodes/s del AST para la fase medida.
+    void reportRates(benchmark::State& state, size_t index, size_t nodes) {
+        const NamedShape& named = shapes()[index];
+        state.SetLabel(named.name);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source(index).size()));
+        state.counters["nodes/s"] = benchmark::Counter(
+            static_cast<double>(state.iterations()) * static_cast<double>(nodes), benchmark::Counter::kIsRate);
+        state.counters["source_MB"] = static_cast<double>(source(index).size()) / (1024.0 * 1024.0);
+    }
+
+    size_t nodesOf(size_t index) {
+        Frontend frontend;
+        if (!frontend.lex(source(index)) || !frontend.parse()) return 0;
+        return countNodes(*frontend.program);
+    }
+
+    void BM_Lexer(benchmark::State& state) {
+        size_t index = static_cast<size_t>(state.range(0));
+        const std::string& text = source(index);
+        for (auto _ : state) {
+            umbra::ErrorManager errors;
+            umbra::Lexer lexer(text, errors);
+            auto tokens = lexer.tokenize();
+            benchmark::DoNotOptimize(tokens.data());
+        }
+        reportRates(state, index, nodesOf(index));
+    }
+
+    void BM_Parser(benchmark::State& state) {
+        size_t index = static_cast<size_t>(state.range(0));
+        Frontend frontend;
+        if (!frontend.lex(source(index))) {
+            state.SkipWithError(frontend.errors.getErrorReport().c_str());
+            return;
+        }
+        size_t nodes = 0;
+        for (auto _ : state) {
+            umbra::ErrorManager errors;
+            umbra::Parser parser(frontend.tokens, errors);
+            auto program = parser.parseProgram();
+            state.PauseTiming();
+            if (!program || errors.getErrorCount() != 0) {
+                state.SkipWithError(errors.getErrorReport().c_str());
+                break;
+            }
+            nodes = countNodes(*program);
+            program.reset();
+            state.ResumeTiming();
+        }
+        reportRates(state, index, nodes);
+    }
+
+    void BM_Semantic(benchmark::State& state) {
+        size_t index = static_cast<size_t>(state.range(0));
+        size_t nodes = 0;
+        for (auto _ : state) {
+            state.PauseTiming();
+            Frontend frontend;
+            if (!frontend.lex(source(index)) || !frontend.parse()) {
+                state.SkipWithError(frontend.errors.getErrorReport().c_str());
+                break;
+            }
+            nodes = countNodes(*frontend.program);
+            state.ResumeTiming();
+
+            bool ok = frontend.analyze();
+
+            state.PauseTiming();
+            if (!ok) {
+                state.SkipWithError(frontend.errors.getErrorReport().c_str());
+                break;
+            }
+            frontend.program.reset();
+            state.ResumeTiming();
+        }
+        reportRates(state, index, nodes);
+    }
+
+    void BM_Codegen(benchmark::State& state) {
+        size_t index = static_cast<size_t>(state.range(0));
+        size_t nodes = 0;
+        for (auto _ : state) {
+            state.PauseTiming();
+            Frontend frontend;
+            if (!frontend.lex(source(index)) || !frontend.parse() || !frontend.analyze()) {
+                state.SkipWithError(frontend.errors.getErrorReport().c_str());
+                break;
+            }
+            nodes = countNodes(*frontend.program);
+            auto context = std::make_unique<umbra::CodegenContext>("umbra_bench");
+            state.ResumeTiming();
+
+            umbra::code_gen::CodegenVisitor visitor(*context);
+            visitor.visit(frontend.program.get());
+
+            state.PauseTiming();
+            context.reset();
+            frontend.program.reset();
+            state.ResumeTiming();
+        }
+        reportRates(state, index, nodes);
+    }
+
+    void allShapes(benchmark::internal::Benchmark* bench) {
+        bench->DenseRange(0, static_cast<int>(shapes().size()) - 1)->Unit(benchmark::kMillisecond);
+    }
+
+} // namespace
+
+BENCHMARK(BM_Lexer)->Apply(allShapes);
+BENCHMARK(BM_Parser)->Apply(allShapes);
+BENCHMARK(BM_Semantic)->Apply(allShapes);
+BENCHMARK(BM_Codegen)->Apply(allShapes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,31 @@
+#include <stdint.h>
+#include <stdio.h>
+
+int main(void) {
+    static int32_t a[256][256], b[256][256], c[256][256];
+    for (int32_t i = 0; i < 256; ++i) {
+        for (int32_t j = 0; j < 256; ++j) {
+            a[i][j] = i + j;
+            b[i][j] = i - j;
+            c[i][j] = 0;
+        }
+    }
+
+    for (int32_t i = 0; i < 256; ++i) {
+        for (int32_t k = 0; k < 256; ++k) {
+            int32_t aik = a[i][k];
+            for (int32_t j = 0; j < 256; ++j) {
+                c[i][j] = c[i][j] + aik * b[k][j];
+            }
+        }
+    }
+
+    int64_t checksum = 0;
+    for (int32_t i = 0; i < 256; ++i) {
+        for (int32_t j = 0; j < 256; ++j) {
+            checksum = checksum + c[i][j] * (j + 1);
+        }
+    }
+    printf("checksum=%lld\n", (long long)checksum);
+    return 0;
+}
@@ -0,0 +1,15 @@
+#include <stdint.h>
+#include <stdio.h>
+
+int main(void) {
+    int64_t total = 0;
+    for (int32_t i = 0; i < 400; ++i) {
+        for (int32_t j = 0; j < 400; ++j) {
+            for (int32_t k = 0; k < 200; ++k) {
+                total = total + i * j - k;
+            }
+        }
+    }
+    printf("total=%lld\n", (long long)total);
+    return 0;
+}
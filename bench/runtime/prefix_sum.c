@@ -0,0 +1,24 @@
+#include <stdint.h>
+#include <stdio.h>
+
+int main(void) {
+    static int32_t data[200000];
+    static int64_t prefix[200000];
+    int32_t n = 200000;
+    for (int32_t i = 0; i < n; ++i) {
+        data[i] = i - i / 7 * 7;
+    }
+
+    int64_t checksum = 0;
+    for (int32_t pass = 0; pass < 50; ++pass) {
+        int64_t running = pass;
+        for (int32_t i = 0; i < n; ++i) {
+            running = running + data[i];
+            prefix[i] = running;
+        }
+        checksum = checksum + prefix[n - 1] + prefix[n / 2];
+        data[pass] = data[pass] + 1;
+    }
+    printf("checksum=%lld\n", (long long)checksum);
+    return 0;
+}
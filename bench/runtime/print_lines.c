@@ -0,0 +1,9 @@
+#include <stdint.h>
+#include <stdio.h>
+
+int main(void) {
+    for (int32_t i = 0; i < 500000; ++i) {
+        printf("line %d: the quick brown fox jumps over the lazy dog %d\n", i, i * 3);
+    }
+    return 0;
+}
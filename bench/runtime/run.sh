@@ -0,0 +1,122 @@
+#!/usr/bin/env bash
+# Compara el código generado por Umbra con su equivalente en C.
+#
+# Uso: bench/runtime/run.sh [-O nivel] [-r repeticiones] [--umbra ruta] [--cc compilador] [--bounds-check] [kernel...]
+#
+# Cada kernel <k>.umbra se compila con umbra y <k>.c con $CC al mismo nivel -O (ambos para la CPU
+# del host). Se ejecutan -r veces, se toma el mejor tiempo y se comprueba que la salida coincide.
+# La columna ratio es umbra/C: por encima de 1 el binario de Umbra es más lento.
+# Con --bounds-check cada kernel se compila además con `umbra --bounds-check` (columna checked).
+
+set -u
+
+here="$(cd "$(dirname "$0")" && pwd)"
+repo="$(cd "$here/../.." && pwd)"
+
+opt=2
+runs=3
+umbra="${UMBRA:-$repo/build/bin/umbra}"
+cc="${CC:-cc}"
+bounds_check=0
+kernels=()
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -O) opt="$2"; shift 2 ;;
+        -O*) opt="${1#-O}"; shift ;;
+        -r) runs="$2"; shift 2 ;;
+        --umbra) umbra="$2"; shift 2 ;;
+        --cc) cc="$2"; shift 2 ;;
+        --bounds-check) bounds_check=1; shift ;;
+        -h|--help) sed -n '2,10p' "$0"; exit 0 ;;
+        *) kernels+=("$1"); shift ;;
+    esac
+done
+
+if [ ! -x "$umbra" ]; then
+    echo "umbra not found at '$umbra' (use --umbra or UMBRA=...)" >&2
+    exit 1
+fi
+
+if [ ${#kernels[@]} -eq 0 ]; then
+    for source in "$here"/*.umbra; do
+        kernels+=("$(basename "$source" .umbra)")
+    done
+fi
+
+work="$(mktemp -d)"
+trap 'rm -rf "$work"' EXIT
+
+# Mejor tiempo en milisegundos de $runs ejecuciones; la salida de la última queda en $2
+best_time() {
+    local binary="$1" output="$2" best="" start end elapsed
+    for ((run = 0; run < runs; ++run)); do
+        start=$(date +%s%N)
+        "$binary" > "$output" || return 1
+        end=$(date +%s%N)
+        elapsed=$(( (end - start) / 1000 ))
+        if [ -z "$best" ] || [ "$elapsed" -lt "$best" ]; then
+            best=$elapsed
+        fi
+    done
+    awk -v us="$best" 'BEGIN { printf "%.2f", us / 1000 }'
+}
+
+# Fila de la tabla; la columna checked solo aparece con --bounds-check
+row() {
+    if [ "$bounds_check" -eq 1 ]; then
+        printf "%-16s %12s %14s %12s %8s  %s\n" "$@"
+    else
+        printf "%-16s %12s %12s %8s  %s\n" "$1" "$2" "$4" "$5" "$6"
+    fi
+}
+
+row "kernel" "umbra (ms)" "checked (ms)" "C (ms)" "ratio" "output"
+status=0
+for kernel in "${kernels[@]}"; do
+    dir="$work/$kernel"
+    mkdir -p "$dir"
+
+    if ! (cd "$dir" && "$umbra" "$here/$kernel.umbra" -O "$opt" > compile.log 2>&1 && [ -x umbra_output ]); then
+        printf "%-16s %s\n" "$kernel" "umbra compilation failed (see below)"
+        cat "$dir/compile.log"
+        status=1
+        continue
+    fi
+    if ! "$cc" -O"$opt" -march=native "$here/$kernel.c" -o "$dir/c_output"; then
+        printf "%-16s %s\n" "$kernel" "C compilation failed"
+        status=1
+        continue
+    fi
+
+    checked_ms=""
+    if [ "$bounds_check" -eq 1 ]; then
+        mkdir -p "$dir/checked"
+        if ! (cd "$dir/checked" && "$umbra" "$here/$kernel.umbra" -O "$opt" --bounds-check > compile.log 2>&1 &&
+              [ -x umbra_output ]); then
+            printf "%-16s %s\n" "$kernel" "umbra --bounds-check compilation failed (see below)"
+            cat "$dir/checked/compile.log"
+            status=1
+            continue
+        fi
+    fi
+
+    umbra_ms=$(best_time "$dir/umbra_output" "$dir/umbra.out") || { echo "$kernel: umbra binary failed"; status=1; continue; }
+    if [ "$bounds_check" -eq 1 ]; then
+        checked_ms=$(best_time "$dir/checked/umbra_output" "$dir/checked.out") ||
+            { echo "$kernel: umbra --bounds-check binary failed"; status=1; continue; }
+    fi
+    c_ms=$(best_time "$dir/c_output" "$dir/c.out") || { echo "$kernel: C binary failed"; status=1; continue; }
+
+    if cmp -s "$dir/umbra.out" "$dir/c.out" &&
+       { [ "$bounds_check" -eq 0 ] || cmp -s "$dir/checked.out" "$dir/c.out"; }; then
+        match="ok"
+    else
+        match="DIFFERENT"
+        status=1
+    fi
+    ratio=$(awk -v u="$umbra_ms" -v c="$c_ms" 'BEGIN { printf "%.2f", (c > 0) ? u / c : 0 }')
+    row "$kernel" "$umbra_ms" "$checked_ms" "$c_ms" "$ratio" "$match"
+done
+
+exit $status
@@ -0,0 +1,25 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+int main(void) {
+    static bool composite[2000000];
+    int32_t n = 2000000;
+    for (int32_t i = 0; i < n; ++i) {
+        composite[i] = false;
+    }
+
+    int32_t count = 0;
+    for (int32_t p = 2; p < n; ++p) {
+        if (composite[p] == false) {
+            count = count + 1;
+            if (p < 1415) {
+                for (int32_t j = p * p; j < n; j += p) {
+                    composite[j] = true;
+                }
+            }
+        }
+    }
+    printf("primes=%d\n", count);
+    return 0;
+}
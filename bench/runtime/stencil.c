@@ -0,0 +1,37 @@
+#include <stdint.h>
+#include <stdio.h>
+
+static int64_t smooth(int32_t n, int32_t passes) {
+    static int32_t a[100000];
+    static int32_t b[100000];
+    int32_t histogram[16] = {0};
+    for (int32_t i = 0; i < n; ++i) {
+        a[i] = i - i / 13 * 13;
+    }
+
+    for (int32_t pass = 0; pass < passes; ++pass) {
+        b[0] = a[0];
+        b[n - 1] = a[n - 1];
+        for (int32_t i = 1; i < n - 1; ++i) {
+            b[i] = a[i - 1] + 2 * a[i] + a[i + 1];
+        }
+        for (int32_t i = 0; i < n; ++i) {
+            a[i] = b[i] / 4 + 1;
+            histogram[a[i] - a[i] / 16 * 16] = histogram[a[i] - a[i] / 16 * 16] + 1;
+        }
+    }
+
+    int64_t checksum = 0;
+    for (int32_t i = 0; i < n; ++i) {
+        checksum = checksum + a[i];
+    }
+    for (int32_t i = 0; i < 16; ++i) {
+        checksum = checksum + histogram[i] * (i + 1);
+    }
+    return checksum;
+}
+
+int main(void) {
+    printf("checksum=%lld\n", (long long)smooth(100000, 300));
+    return 0;
+}
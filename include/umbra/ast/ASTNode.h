@@ -2,6 +2,7 @@
 #define ASTNODE_H
 
 #include"umbra/semantic/SemanticType.h"
+#include"umbra/io/SourceLocation.h"
 
 namespace umbra {
 
@@ -51,7 +52,8 @@ class ASTNode {
     virtual ~ASTNode() = default;
     ASTNode(NodeKind kind) : kind(kind) {}
     NodeKind kind;
-    SemanticType semaT;
+    SemanticType semaT = SemanticType::None;
+    SourceLocation location; // Token que origina el nodo; se resuelve con SourceMap al reportar
 
     NodeKind getKind() const { return kind; }
 
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "umbra/ast/Nodes.h"
+
+namespace umbra {
+
+/**
+ * @file ASTSerializer.h
+ * @brief Formato binario del AST ya analizado (archivo .uast).
+ * @details
+ * Guarda un ProgramNode después del análisis semántico y del plegado de constantes, con lo que
+ * esas fases dejan en los nodos: semaT, la firma de cada función y los tipos de los argumentos
+ * de cada llamada. Las ubicaciones se guardan como offsets de SourceMap, válidas mientras el
+ * programa preprocesado sea el mismo; por eso cada archivo lleva el hash de sus fuentes y
+ * `--ast-cache` solo lo reutiliza si coincide.
+ *
+ * Estructura (enteros en varint, como en ModuleInterface):
+ * - cabecera: "UMBA", versión, hash de las fuentes (u64);
+ * - tabla de cadenas: nombres, operadores y literales de texto, cada uno una sola vez;
+ * - pool de nodos en postorden: tipo de nodo, ubicación, semaT y sus campos. Los hijos se
+ *   referencian por índice en el pool (0 = ausente) y siempre aparecen antes que su padre;
+ *   el último nodo es el ProgramNode.
+ */
+class ASTSerializer {
+public:
+    static constexpr uint32_t FormatVersion = 2;
+
+    /// main.umbra -> main.uast
+    static std::filesystem::path cachePathFor(const std::filesystem::path& sourcePath);
+
+    static std::string serialize(const ProgramNode& program, uint64_t sourceHash);
+
+    /**
+     * @brief Reconstruye el programa.
+     * @param expectedSourceHash Si se indica y no coincide con el del archivo, falla sin decodificar nodos.
+     * @return El programa, o nullptr (con el motivo en error) si los datos están truncados o corruptos.
+     */
+    static std::unique_ptr<ProgramNode> deserialize(std::string_view data, std::string& error,
+                                                    std::optional<uint64_t> expectedSourceHash = std::nullopt);
+
+    /// Serializa a un archivo; false (con el motivo en error) si no se pudo escribir.
+    static bool write(const std::filesystem::path& path, const ProgramNode& program, uint64_t sourceHash,
+                      std::string& error);
+
+    static std::unique_ptr<ProgramNode> read(const std::filesystem::path& path, std::string& error,
+                                             std::optional<uint64_t> expectedSourceHash = std::nullopt);
+};
+
+} // namespace umbra
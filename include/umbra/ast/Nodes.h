@@ -1,6 +1,7 @@
 #ifndef AST_NODES_HPP
 #define AST_NODES_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -52,6 +53,9 @@ namespace umbra {
     };
 
     // Function definition node
+    // Modificador de inlining: inline func / noinline func
+    enum class InlineHint { Default, Always, Never };
+
     class FunctionDefinition : public ASTNode {
     public:
         FunctionDefinition(std::unique_ptr<Identifier> name, std::unique_ptr<ParameterList> parameters,
@@ -61,6 +65,9 @@ namespace umbra {
               body(std::move(body)) {}
 
         FunctionSignature Signature;
+        bool isConstFunc = false; // constfunc: pura, ConstantFolder la evalúa con argumentos constantes
+        InlineHint inlineHint = InlineHint::Default;
+        bool isImported = false; // Prototipo de un módulo precompilado (.umi): sin cuerpo, definida en su .o
 
         std::unique_ptr<Identifier> name;
         std::unique_ptr<ParameterList> parameters;
@@ -126,6 +133,7 @@ namespace umbra {
         std::unique_ptr<Type> type;
         std::unique_ptr<Identifier> name;
         std::unique_ptr<Expression> initializer;
+        bool isConst = false; // const int N = ...: no se puede reasignar; ConstantFolder la propaga
     };
 
     // Assignment statement node
@@ -173,6 +181,12 @@ namespace umbra {
         std::unique_ptr<Identifier> target; // For deallocation
     };
 
+    // Reducción de un repeat paralelo: reduce(op: variable)
+    struct Reduction {
+        std::string op; // "+", "min" o "max"
+        std::unique_ptr<Identifier> target;
+    };
+
     // Repeat times statement node (For)
     class RepeatTimesStatement : public Statement {
     public:
@@ -183,6 +197,11 @@ namespace umbra {
 
         std::unique_ptr<Expression> times;
         std::vector<std::unique_ptr<Statement>> body;
+
+        // repeat N times in parallel [as i] [reduce(op: v, ...)]
+        bool parallel = false;
+        std::unique_ptr<Identifier> indexVar;  // Índice de iteración (opcional)
+        std::vector<Reduction> reductions;
     };
 
     // Repeat if statement node (While)
@@ -311,12 +330,18 @@ namespace umbra {
         std::unique_ptr<Expression> exp;
     };
 
-    // Numeric literal node
+    // Numeric literal node: los enteros se guardan exactos en intValue; floatValue solo para Float/Double
     class NumericLiteral : public Literal {
     public:
-        NumericLiteral(double value, BuiltinType numericType) : Literal(NodeKind::NUMERIC_LITERAL, numericType), value(value) {}
+        NumericLiteral(int64_t intValue, BuiltinType numericType) : Literal(NodeKind::NUMERIC_LITERAL, numericType), intValue(intValue) {}
+        NumericLiteral(double floatValue, BuiltinType numericType) : Literal(NodeKind::NUMERIC_LITERAL, numericType), floatValue(floatValue) {}
+
+        bool isFloating() const { return builtinType == BuiltinType::Float || builtinType == BuiltinType::Double; }
+        /// Valor como double (los Long mayores que 2^53 se redondean).
+        double asDouble() const { return isFloating() ? floatValue : static_cast<double>(intValue); }
 
-        double value;
+        int64_t intValue = 0;
+        double floatValue = 0.0;
     };
 
     // Boolean literal node
@@ -352,6 +377,7 @@ namespace umbra {
 
         std::unique_ptr<Expression> array;
         std::unique_ptr<Expression> index;
+        // location: posición del '[' (usada por --bounds-check al reportar fallos)
     };
 
     // Ternary conditional expression node
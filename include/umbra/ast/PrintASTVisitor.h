@@ -2,15 +2,20 @@
 
 #include "umbra/ast/Visitor.h"
 #include "umbra/ast/Nodes.h"
+#include <iostream>
 #include <memory>
 namespace umbra {
 
     class Printer : BaseV<std::unique_ptr, Printer, void> {
         public:
+            explicit Printer(std::ostream& out = std::cout) : out(out) {}
 
             void visitProgramNode(ProgramNode& node){
-                std::cout << static_cast<int>(node.getKind()) << std::endl;
+                out << static_cast<int>(node.getKind()) << std::endl;
             }
+
+        private:
+            std::ostream& out;
     };
 
 
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "umbra/ast/Nodes.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * @file ASTWalk.h
+ * @brief Recorrido genérico de subexpresiones y sub-bloques usado por los análisis de codegen.
+ */
+
+namespace umbra {
+namespace code_gen {
+
+    /// Desenvuelve PrimaryExpression hasta el nodo que realmente aporta el valor.
+    inline Expression* unwrap(Expression* expr) {
+        while (auto* primary = dynamic_cast<PrimaryExpression*>(expr)) {
+            switch (primary->exprType) {
+                case PrimaryExpression::IDENTIFIER:      expr = primary->identifier.get(); break;
+                case PrimaryExpression::LITERAL:         expr = primary->literal.get(); break;
+                case PrimaryExpression::PARENTHESIZED:   expr = primary->parenthesized.get(); break;
+                case PrimaryExpression::ARRAY_ACCESS:    expr = primary->arrayAccess.get(); break;
+                case PrimaryExpression::EXPRESSION_CALL: expr = primary->functionCall.get(); break;
+                default: return expr;
+            }
+        }
+        return expr;
+    }
+
+    /// Aplica fn a cada subexpresión directa de expr.
+    template <typename Fn>
+    void forEachChild(Expression* expr, Fn&& fn) {
+        if (!expr) return;
+        switch (expr->getKind()) {
+            case NodeKind::BINARY_EXPRESSION: {
+                auto* bin = static_cast<BinaryExpression*>(expr);
+                fn(bin->left.get());
+                fn(bin->right.get());
+                break;
+            }
+            case NodeKind::UNARY_EXPRESSION:
+                fn(static_cast<UnaryExpression*>(expr)->operand.get());
+                break;
+            case NodeKind::INCREMENT_EXPRESSION:
+                fn(static_cast<IncrementExpression*>(expr)->operand.get());
+                break;
+            case NodeKind::DECREMENT_EXPRESSION:
+                fn(static_cast<DecrementExpression*>(expr)->operand.get());
+                break;
+            case NodeKind::FUNCTION_CALL:
+                for (auto& arg : static_cast<FunctionCall*>(expr)->arguments) fn(arg.get());
+                break;
+            case NodeKind::ARRAY_ACCESS_EXPRESSION: {
+                auto* access = static_cast<ArrayAccessExpression*>(expr);
+                fn(access->array.get());
+                fn(access->index.get());
+                break;
+            }
+            case NodeKind::TERNARY_EXPRESSION: {
+                auto* ternary = static_cast<TernaryExpression*>(expr);
+                fn(ternary->condition.get());
+                fn(ternary->trueExpr.get());
+                fn(ternary->falseExpr.get());
+                break;
+            }
+            case NodeKind::CAST_EXPRESSION:
+                fn(static_cast<CastExpression*>(expr)->expression.get());
+                break;
+            case NodeKind::PRIMARY_EXPRESSION:
+            case NodeKind::PARENTHESIZED: {
+                auto* primary = static_cast<PrimaryExpression*>(expr);
+                fn(primary->identifier.get());
+                fn(primary->literal.get());
+                fn(primary->parenthesized.get());
+                fn(primary->functionCall.get());
+                fn(primary->arrayAccess.get());
+                fn(primary->castExpression.get());
+                fn(primary->ternaryExpression.get());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    /// Aplica fn a cada expresión evaluada directamente por stmt y a cada bloque anidado.
+    template <typename ExprFn, typename BlockFn>
+    void forEachPart(Statement* stmt, ExprFn&& exprFn, BlockFn&& blockFn) {
+        if (!stmt) return;
+        switch (stmt->getKind()) {
+            case NodeKind::VARIABLE_DECLARATION:
+                exprFn(static_cast<VariableDeclaration*>(stmt)->initializer.get());
+                break;
+            case NodeKind::ASSIGNMENT_STATEMENT: {
+                auto* assign = static_cast<AssignmentStatement*>(stmt);
+                exprFn(assign->target.get());
+                exprFn(assign->value.get());
+                break;
+            }
+            case NodeKind::EXPRESSION_STATEMENT:
+                exprFn(static_cast<ExpressionStatement*>(stmt)->exp.get());
+                break;
+            case NodeKind::RETURN_EXPRESSION:
+                exprFn(static_cast<ReturnExpression*>(stmt)->returnValue.get());
+                break;
+            case NodeKind::IF_STATEMENT: {
+                auto* ifStmt = static_cast<IfStatement*>(stmt);
+                for (auto& branch : ifStmt->branches) {
+                    exprFn(branch.condition.get());
+                    blockFn(branch.body);
+                }
+                blockFn(ifStmt->elseBranch);
+                break;
+            }
+            case NodeKind::REPEAT_TIMES_STATEMENT: {
+                auto* loop = static_cast<RepeatTimesStatement*>(stmt);
+                exprFn(loop->times.get());
+                blockFn(loop->body);
+                break;
+            }
+            case NodeKind::REPEAT_IF_STATEMENT: {
+                auto* loop = static_cast<RepeatIfStatement*>(stmt);
+                exprFn(loop->condition.get());
+                blockFn(loop->body);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+} // namespace code_gen
+} // namespace umbra
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "umbra/ast/Nodes.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file FunctionEffects.h
+ * @brief Inferencia interprocedural de efectos de las funciones del programa.
+ * @details
+ * Recorre el AST de cada función y resume qué memoria visible para el llamador puede tocar
+ * y si siempre retorna. Los resultados se propagan por el grafo de llamadas hasta un punto
+ * fijo y el CodegenVisitor los traduce a atributos LLVM (readnone/readonly/willreturn),
+ * con lo que el optimizador puede eliminar o mover llamadas a funciones auxiliares puras.
+ *
+ * Modelo (conservador):
+ * - Las variables y arrays locales no cuentan: viven en allocas de la propia función.
+ * - `access p`, los accesos a arrays recibidos como parámetro y los usos de un parámetro
+ *   `ref T` leen memoria; como destino de una asignación o de ++/-- la escriben.
+ * - print/read_*, new/delete, repeat paralelo y --bounds-check llaman al runtime: efectos
+ *   desconocidos y sin garantía de retorno.
+ * - `repeat if` y la recursión pueden no terminar, así que anulan willreturn.
+ */
+
+namespace umbra {
+namespace code_gen {
+
+    /// Memoria visible para el llamador a la que accede una función (ordenado de menor a mayor).
+    enum class MemoryEffect { None, ReadOnly, Unknown };
+
+    struct FunctionEffects {
+        MemoryEffect memory = MemoryEffect::None;
+        bool willReturn = true;
+    };
+
+    /**
+     * @class FunctionEffectAnalysis
+     * @brief Calcula FunctionEffects para todas las funciones de un ProgramNode.
+     */
+    class FunctionEffectAnalysis {
+    public:
+        /// Analiza el programa completo; descarta resultados anteriores.
+        void analyzeProgram(ProgramNode* program, bool boundsCheck);
+
+        /// Efectos inferidos para @p name (nullptr si no es una función del programa).
+        const FunctionEffects* effectsOf(const std::string& name) const;
+
+    private:
+        struct FunctionInfo {
+            FunctionEffects local;              ///< Efectos del propio cuerpo, sin callees.
+            std::unordered_set<std::string> callees;
+        };
+
+        void scanBlock(const std::vector<std::unique_ptr<Statement>>& body);
+        void scanStatement(Statement* stmt);
+        void scanExpression(Expression* expr, bool isWrite);
+        void addMemory(MemoryEffect effect);
+        void markRuntimeCall();
+        bool reaches(const std::string& from, const std::string& target) const;
+
+        std::unordered_map<std::string, FunctionInfo> infos;
+        std::unordered_map<std::string, FunctionEffects> results;
+
+        // Estado del recorrido de la función actual
+        FunctionInfo* current = nullptr;
+        /// Parámetros puntero/referencia/array: sus accesos tocan memoria del llamador.
+        std::unordered_set<std::string> callerMemory;
+        /// Parámetros `ref T`: basta nombrarlos para acceder a la variable del llamador.
+        std::unordered_set<std::string> referenceParams;
+        bool boundsCheck = false;
+    };
+
+} // namespace code_gen
+} // namespace umbra
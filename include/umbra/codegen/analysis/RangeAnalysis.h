@@ -0,0 +1,115 @@
+#pragma once
+
+#include "umbra/ast/Nodes.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file RangeAnalysis.h
+ * @brief Análisis de rangos de índices sobre bucles `repeat N times` (modo --bounds-check).
+ * @details
+ * Detecta variables de inducción (contadores que avanzan exactamente +1/-1 por iteración
+ * mediante un único statement de nivel superior del cuerpo) y propaga intervalos de valores
+ * enteros por la función. Con eso el CodegenVisitor puede:
+ * - Eliminar la comprobación de un acceso cuyo índice tiene un intervalo constante válido.
+ * - Adelantar la comprobación al preheader del bucle cuando el índice es afín respecto a la
+ *   variable de inducción e invariante en lo demás (una comprobación por entrada al bucle).
+ *   Si falla, el bucle se ejecuta en su versión con comprobaciones por acceso.
+ * Los accesos que no encajan en el modelo conservan su comprobación individual.
+ */
+
+namespace umbra {
+namespace code_gen {
+
+    /**
+     * @struct IndexInterval
+     * @brief Intervalo cerrado [lo, hi] de valores enteros.
+     */
+    struct IndexInterval {
+        int64_t lo = 0;
+        int64_t hi = 0;
+    };
+
+    /**
+     * @struct HoistedBoundsCheck
+     * @brief Comprobación de límites que puede resolverse en el preheader de un bucle.
+     * @details
+     * Si e0 es el valor del índice evaluado en el preheader, el índice en la iteración t vale
+     * e0 + coefficient * step * (t + afterStep).
+     */
+    struct HoistedBoundsCheck {
+        ArrayAccessExpression* access = nullptr; ///< Acceso cuyo índice se comprueba.
+        std::string arrayName;                   ///< Variable array base del acceso.
+        unsigned level = 0;                      ///< Dimensión indexada (0 = más externa).
+        int64_t coefficient = 0;                 ///< Coeficiente del índice respecto a la variable de inducción.
+        int64_t step = 0;                        ///< Paso de la variable de inducción (+1 / -1, 0 si no hay).
+        bool afterStep = false;                  ///< El acceso ocurre después del paso dentro de la iteración.
+    };
+
+    /**
+     * @class IndexRangeAnalysis
+     * @brief Recorre una función y calcula rangos estáticos y comprobaciones adelantables.
+     */
+    class IndexRangeAnalysis {
+    public:
+        /// Analiza el cuerpo de la función; descarta resultados de análisis anteriores.
+        void analyzeFunction(FunctionDefinition* fn);
+
+        /// Intervalo estático del índice de @p access, si pudo calcularse.
+        std::optional<IndexInterval> staticRange(const ArrayAccessExpression* access) const;
+
+        /// Comprobaciones adelantables al preheader de @p loop (nullptr si no hay).
+        const std::vector<HoistedBoundsCheck>* checksFor(const RepeatTimesStatement* loop) const;
+
+    private:
+        /// Intervalos conocidos de las variables enteras en un punto del programa.
+        using RangeEnv = std::unordered_map<std::string, IndexInterval>;
+        /// Cuenta de modificaciones por variable (asignaciones, ++/--, declaraciones).
+        using ModCount = std::unordered_map<std::string, int>;
+        /// Statement de paso de una variable de inducción -> (variable, intervalo tras el paso).
+        using StepMap = std::unordered_map<const Statement*, std::pair<std::string, IndexInterval>>;
+
+        /// Índice expresado como coefficient * v + rest, con rest invariante en el bucle.
+        struct Affine {
+            int64_t coefficient = 0;
+            std::optional<IndexInterval> rest;
+        };
+
+        /// Variable de inducción de un bucle.
+        struct Induction {
+            std::string name;
+            int64_t step = 0;
+            size_t stepIndex = 0;
+        };
+
+        void walkBlock(const std::vector<std::unique_ptr<Statement>>& stmts, RangeEnv& env,
+                       const StepMap* steps = nullptr);
+        void analyzeLoop(RepeatTimesStatement* loop, const RangeEnv& env);
+        void recordStaticRanges(Statement* stmt, const RangeEnv& env);
+
+        std::optional<Affine> affineIndex(Expression* expr, const std::string* iv,
+                                          const ModCount& modified, const RangeEnv& env) const;
+        std::optional<IndexInterval> evalRange(Expression* expr, const RangeEnv& env) const;
+
+        static bool isStepStatement(Statement* stmt, std::string& name, int64_t& step);
+        static void collectModified(Statement* stmt, ModCount& out);
+        static void collectModified(Expression* expr, ModCount& out);
+        static void collectAddressTaken(Statement* stmt, std::unordered_set<std::string>& out);
+        static void collectAddressTaken(Expression* expr, std::unordered_set<std::string>& out);
+        static bool containsReturn(const std::vector<std::unique_ptr<Statement>>& stmts);
+        static void collectAccesses(Statement* stmt, std::vector<ArrayAccessExpression*>& out);
+        static void collectAccesses(Expression* expr, std::vector<ArrayAccessExpression*>& out);
+
+        /// Variables cuya dirección se toma con 'ref' (posible aliasing: no se analizan).
+        std::unordered_set<std::string> addressTaken;
+        std::unordered_map<const ArrayAccessExpression*, IndexInterval> ranges;
+        std::unordered_map<const RepeatTimesStatement*, std::vector<HoistedBoundsCheck>> checks;
+    };
+
+} // namespace code_gen
+} // namespace umbra
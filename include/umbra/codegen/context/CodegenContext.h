@@ -5,6 +5,7 @@
 #include<llvm/IR/Module.h>
 #include<llvm/IR/IRBuilder.h>
 #include<unordered_map>
+#include "umbra/io/SourceMap.h"
 #include<string>
 
 namespace llvm { class Value; }
@@ -22,11 +23,32 @@ namespace umbra {
             std::unordered_map<llvm::Value*, llvm::Type*> valueTypes;
 
             llvm::Function* getPrintfFunction();
+            llvm::Function* getRuntimeFunction(const std::string& name, llvm::FunctionType* type);
+
+            // TBAA: un nodo escalar por tipo de valor bajo la raíz "Umbra TBAA". Umbra no permite
+            // reinterpretar memoria, así que accesos con tipos distintos nunca se solapan
+            llvm::MDNode* getTBAAAccessTag(llvm::Type* accessType);
+
+            // Emitir comprobaciones de rango en los accesos a arrays (--bounds-check)
+            bool boundsCheck = false;
+
+            // --emit-module: las funciones del usuario se exportan (linkage externo) para que
+            // otros programas las llamen desde el objeto del módulo
+            bool exportFunctions = false;
+
+            // Programa preprocesado: traduce la SourceLocation de un nodo a línea/columna de su
+            // archivo para los mensajes del runtime. Sin mapa se reporta 0:0
+            const SourceMap* sourceMap = nullptr;
+            PresumedLocation resolveLocation(SourceLocation location) const {
+                return sourceMap ? sourceMap->resolve(location) : PresumedLocation{};
+            }
 
             CodegenContext(const std::string& moduleName);
 
             private:
             llvm::Function* printfFunction = nullptr;
+            llvm::MDNode* tbaaRoot = nullptr;
+            std::unordered_map<llvm::Type*, llvm::MDNode*> tbaaAccessTags;
 
         };
 } // namespace umbra
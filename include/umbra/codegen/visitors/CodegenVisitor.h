@@ -3,9 +3,13 @@
 #include "umbra/codegen/context/CodegenContext.h"
 #include "umbra/ast/Nodes.h"
 #include "umbra/ast/Visitor.h"
+#include "umbra/codegen/analysis/RangeAnalysis.h"
+#include "umbra/codegen/analysis/FunctionEffects.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <vector>
 namespace umbra {
     template<template <typename> class Ptr, typename ImplClass, typename RetTy, class... ParamTys>
     class BaseV;
@@ -28,6 +32,18 @@ namespace code_gen {
                 return llvm::PointerType::get(llvm::Type::getInt8Ty(Ctxt), 0);
             case BuiltinType::Float:
                 return llvm::Type::getFloatTy(Ctxt);
+            case BuiltinType::Long:
+                return llvm::Type::getInt64Ty(Ctxt);
+            case BuiltinType::Double:
+                return llvm::Type::getDoubleTy(Ctxt);
+            case BuiltinType::Vec4Float:
+                return llvm::FixedVectorType::get(llvm::Type::getFloatTy(Ctxt), 4);
+            case BuiltinType::Vec8Float:
+                return llvm::FixedVectorType::get(llvm::Type::getFloatTy(Ctxt), 8);
+            case BuiltinType::Vec4Int:
+                return llvm::FixedVectorType::get(llvm::Type::getInt32Ty(Ctxt), 4);
+            case BuiltinType::Vec8Int:
+                return llvm::FixedVectorType::get(llvm::Type::getInt32Ty(Ctxt), 8);
             default:
                 return llvm::Type::getVoidTy(Ctxt);
         }
@@ -74,15 +90,100 @@ namespace code_gen {
         llvm::Value* visitVariableDeclaration(VariableDeclaration* node);
         llvm::Value* visitAssignmentStatement(AssignmentStatement* node);
         llvm::Value* visitArrayAccess(ArrayAccessExpression* node);
+        llvm::Value* visitArrayAccessExpression(ArrayAccessExpression* node);
         llvm::Value* visitIncrementExpression(IncrementExpression* node);
         llvm::Value* visitDecrementExpression(DecrementExpression* node);
         llvm::Value* visitUnaryExpression(UnaryExpression* node);
 
         private:
         llvm::Value* emitExpr(Expression* expr);
+
+        // print -> libumbra_rt
+        static Expression* unwrapPrintFormat(Expression* expr);
+        void emitPrintLiteral(const std::string& text);
+        llvm::Value* emitPrintValue(llvm::Value* v);
         llvm::Value* getArrayElementPtr(ArrayAccessExpression* node);
         llvm::Value* getAddressOf(Expression* expr);  // Helper to get address of an expression
+        // Memoria de una variable escalar (alloca o parámetro `ref T`) y el tipo almacenado;
+        // materialize vuelca a un alloca los parámetros por valor
+        llvm::Value* getVariableSlot(const std::string& name, llvm::Type*& type, bool materialize = false);
+        // Tipo apuntado por una expresión puntero (variable `ptr T` o `ref x`)
+        llvm::Type* pointeeTypeOf(Expression* expr);
+
+        // Load/store con metadatos de alias: etiqueta TBAA del tipo accedido y, si ptr es un
+        // elemento de array, el ámbito noalias de su array raíz (ver emitArrayAliasScopes)
+        llvm::LoadInst* emitLoad(llvm::Type* type, llvm::Value* ptr, const llvm::Twine& name = "");
+        llvm::StoreInst* emitStore(llvm::Value* value, llvm::Value* ptr);
+        void tagMemoryAccess(llvm::Instruction* inst, llvm::Type* type, llvm::Value* ptr);
+        void emitArrayAliasScopes(llvm::Function* F);
+
+        // Parámetros array como slices: (puntero al primer elemento, longitud por dimensión)
+        void lowerParameterTypes(FunctionDefinition* node, std::vector<llvm::Type*>& paramTys);
+        void bindParameters(FunctionDefinition* node, llvm::Function* F);
+        bool emitSliceArgument(Expression* arg, std::vector<llvm::Value*>& argsV);
+        llvm::Value* getSliceElementPtr(ArrayAccessExpression* node);
+
+        // Conversión implícita (bool->int, int->long, float->double, int->float)
+        llvm::Value* convertValue(llvm::Value* v, llvm::Type* destTy, Expression* source = nullptr);
+
+        // vec4/vec8: operadores lane a lane y builtins SIMD
+        llvm::Value* emitVectorBinary(const std::string& op, llvm::Value* L, llvm::Value* R);
+        llvm::Value* emitVectorBuiltin(FunctionCall* node);
+
+        // repeat N times in parallel -> función outlineada + umbra_rt_parallel_for
+        void emitParallelRepeat(RepeatTimesStatement* node, llvm::Value* timesVal);
+
+        // --bounds-check
+        void emitBoundsCheck(ArrayAccessExpression* node, llvm::Value* index64, uint64_t size);
+        llvm::Value* emitHoistedBoundsChecks(RepeatTimesStatement* node, llvm::Value* timesVal,
+                                             std::vector<const ArrayAccessExpression*>& hoisted);
+        void emitRepeatLoop(RepeatTimesStatement* node, llvm::Value* timesVal);
+        void emitBoundsFailure(llvm::Value* failCond, llvm::Value* index64, llvm::Value* size64,
+                               ArrayAccessExpression* node);
+
+        // Crea el prototipo LLVM de una función del usuario (visitProgramNode los declara todos antes)
+        llvm::Function* declareFunction(FunctionDefinition* node);
+        // Linkage y atributos (inline/noinline, readnone/readonly, willreturn) de una función del usuario
+        void applyFunctionAttributes(llvm::Function* F, FunctionDefinition* node);
+
+        // return f(...): recursión de cola propia -> salto a la cabecera; otras llamadas -> tail/musttail
+        void beginTailRecursion(FunctionDefinition* node, llvm::Function* F);
+        bool emitSelfTailCall(FunctionCall* call);
+        void markTailCall(llvm::Value* v, FunctionCall* call);
+
         CodegenContext& Ctxt;
+        IndexRangeAnalysis rangeAnalysis;
+        FunctionEffectAnalysis effectAnalysis;
+        // Accesos cuya comprobación ya se eliminó o se adelantó al preheader del bucle
+        std::unordered_set<const ArrayAccessExpression*> provenInBounds;
+        // > 0 dentro de la versión con comprobaciones por acceso de un bucle: no se versiona más
+        unsigned checkedLoopDepth = 0;
+        unsigned parallelBodyCount = 0;
+
+        // Parámetros de la función actual que no son valores SSA simples
+        struct ArraySlice {
+            llvm::Value* data = nullptr;
+            llvm::Type* elementType = nullptr;
+            std::vector<llvm::Value*> lengths;
+        };
+        std::unordered_map<std::string, ArraySlice> sliceParams;
+        std::unordered_map<std::string, llvm::Type*> referenceParams;  // nombre -> tipo apuntado
+        std::unordered_map<std::string, llvm::Type*> pointeeTypes;     // variables `ptr T` -> T
+        std::unordered_map<std::string, FunctionDefinition*> functionDefinitions;
+
+        // Scoped noalias: array raíz (local o slice) de cada puntero a elemento y accesos a
+        // elementos emitidos en la función actual, pendientes de recibir !alias.scope/!noalias
+        std::unordered_map<llvm::Value*, std::string> arrayElementRoots;
+        std::vector<std::pair<llvm::Instruction*, std::string>> arrayAccesses;
+
+        // Función actual convertida en bucle: los parámetros viven en allocas y
+        // `return f(...)` los reescribe y salta a la cabecera
+        struct TailRecursion {
+            std::string name;
+            llvm::Function* function = nullptr;
+            llvm::BasicBlock* header = nullptr;
+            std::vector<llvm::AllocaInst*> params;
+        } tailRecursion;
     };
 
 } // namespace code_gen
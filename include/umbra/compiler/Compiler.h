@@ -2,18 +2,28 @@
 
 #include <string>
 #include <memory>
+#include <ostream>
 #include "../error/ErrorManager.h"
+#include "../io/SourceManager.h"
+#include "../io/SourceMap.h"
+#include "../module/ModuleInterface.h"
 #include "../lexer/Lexer.h"
 #include "../parser/Parser.h"
 #include "../ast/ASTNode.h"
 #include "../ast/Nodes.h"
 #include <llvm/IR/Module.h>
+
+namespace llvm {
+    class TargetMachine;
+}
+
 namespace umbra {
 
     typedef struct UmbraCompilerOptions {
         std::string inputFilePath;
         std::string outputIRFile = "umbra_ir.ll";
         std::string outputExecName = "umbra_output";
+        std::string runtimeLibraryPath; // Vacío: libumbra_rt.a del árbol de build
         bool compileToExecutable = true;
         bool showASMCode = false;
         bool showIRCode = false;
@@ -22,28 +32,71 @@ namespace umbra {
         bool traceLex = false;
         bool printTokens = false;
         bool printGrammarTrace = false;
+        bool boundsCheck = false;
+        int optLevel = 0; // -O0..-O3: pipeline de LLVM sobre el IR antes de llc
+        std::string targetTriple; // Vacío: triple del host (--set-target-machine)
+        std::string targetCPU = "native"; // --march/--mcpu; "native" usa la CPU y extensiones del host
+        std::string profileGenerateFile; // --profile-generate: patrón de los .profraw; vacío = sin instrumentar
+        std::string profileUseFile; // --profile-use: perfil fusionado con llvm-profdata merge
+        std::string profileRuntimePath; // Vacío: libclang_rt.profile encontrada por CMake
+        bool emitModule = false; // --emit-module: lib.umbra -> lib.o + lib.umi en vez de un ejecutable
+        bool useModules = true; // --no-modules: incluir siempre el texto de los `use`, sin leer .umi
+        bool astCache = false; // --ast-cache: reutilizar main.uast si las fuentes no cambiaron
+        std::string emitASTFile; // --emit-ast: AST analizado en binario (ASTSerializer)
+        bool incremental = false; // --incremental: un objeto por función en main.ufc/, solo se regeneran las editadas
     } UmbraCompilerOptions;
 
     class Compiler {
         public:
             explicit Compiler(UmbraCompilerOptions opt); // Usará ErrorManager interno
             Compiler(UmbraCompilerOptions opt, ErrorManager& externalErrorManager); // Usará ErrorManager externo
+            /// Escribe en out/err en lugar de std::cout/std::cerr (una petición de --daemon)
+            Compiler(UmbraCompilerOptions opt, ErrorManager& externalErrorManager, std::ostream& out, std::ostream& err);
+            ~Compiler(); // Resuelve las ubicaciones pendientes antes de liberar los buffers
             bool compile();
 
+            /// Registra los targets de LLVM y detecta la CPU del host (una vez por proceso; --daemon lo hace al arrancar).
+            static void initializeTargets();
+
         private:
             UmbraCompilerOptions options;
             std::unique_ptr<ErrorManager> internalErrorManager_; // Solo se usa si no se proporciona uno externo
             ErrorManager& errorManagerRef_; // Siempre referencia a un ErrorManager válido
+            std::ostream& out; // Mensajes de la compilación (std::cout por defecto)
+            std::ostream& err; // Errores y avisos, también los de llc y gcc (std::cerr por defecto)
+            SourceManager sourceManager; // Buffers de los archivos fuente; viven toda la compilación
+            SourceMap sourceMap; // Tramos del programa preprocesado sobre esos buffers
+            std::vector<ModuleInterface> importedModules; // Interfaces .umi cargadas por los `use`
+            std::vector<const SourceBuffer*> splicedFiles; // Archivos incluidos como texto
+            std::string targetTriple; // Triple del módulo LLVM (se guarda en la interfaz)
+            std::unique_ptr<llvm::TargetMachine> targetMachine_; // La crea el primer configureTarget; los fragmentos la comparten
 
             void printTokens(const std::vector<Lexer::Token>& tokens);
-            bool preprocess(std::string& src);
+            bool preprocess();
             void printAST(ProgramNode& node);
-            std::vector<Lexer::Token> lex(std::string& src);
+            std::vector<Lexer::Token> lex(const SourceMap& src);
             std::unique_ptr<ProgramNode> parse(std::vector<Lexer::Token>& tokens);
+            void declareImportedFunctions(ProgramNode& programNode);
+            std::unique_ptr<ProgramNode> analyze(); // lex, parse, análisis semántico y plegado
+            uint64_t sourceHash() const; // Hash de todo lo que determina el AST analizado
+            std::unique_ptr<ProgramNode> loadCachedAST();
+            void storeCachedAST(const ProgramNode& programNode);
             bool semanticAnalyze(ProgramNode* programNode);
-            bool generateCode(ProgramNode& programNode, std::string& moduleName);
+            bool foldConstants(ProgramNode* programNode);
+            bool generateCode(ProgramNode& programNode, std::string& moduleName, const std::string& objectFile = "");
+            llvm::TargetMachine* configureTarget(llvm::Module& module);
+            void applyTargetAttributes(llvm::Module& module, llvm::TargetMachine& targetMachine);
+            void optimizeModule(llvm::Module& module, llvm::TargetMachine* targetMachine);
             void generateIRFile(llvm::Module& module, const std::string& filename);
+            bool generateObjectFile(const std::string& irFilename, const std::string& objectFile);
+            bool emitObjectFile(llvm::Module& module, llvm::TargetMachine& targetMachine, const std::string& objectFile);
             bool generateExecutable(const std::string& irFilename, const std::string& outputName);
+            bool linkExecutable(const std::vector<std::string>& objectFiles, const std::string& outputName);
+            bool compileIncremental();
+            uint64_t incrementalConfigHash() const;
+            bool generateFragment(ProgramNode& programNode, size_t function, const std::vector<size_t>& callees,
+                                  const std::string& objectFile);
+            bool writeModuleInterface(ProgramNode& programNode);
 
     };
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "umbra/ast/Nodes.h"
+#include "umbra/io/SourceMap.h"
+#include "umbra/lexer/Lexer.h"
+
+namespace umbra {
+
+/**
+ * @file FunctionCache.h
+ * @brief Objetos por función para la compilación incremental (`--incremental`).
+ * @details
+ * Cada función definida en el programa se compila a su propio objeto, main.ufc/<nombre>-<clave>.o.
+ * La clave resume todo lo que determina ese objeto:
+ * - los tokens de la función (cabecera y cuerpo);
+ * - la cabecera (firma) de cada función que nombra, y el cuerpo completo de las constfunc que
+ *   nombra, directa o indirectamente, porque ConstantFolder evalúa sus llamadas;
+ * - la configuración de la compilación (nivel -O, objetivo, módulos importados, ...).
+ * Con --bounds-check también la línea y columna de cada token: los mensajes de error llevan la
+ * posición. Si el objeto de esa clave ya existe, la función no se vuelve a analizar ni a generar.
+ */
+class FunctionCache {
+public:
+    /// Clave de una función y funciones del programa que nombra (sin contarse a sí misma).
+    struct FunctionKey {
+        uint64_t key = 0;
+        bool cacheable = false; ///< false si no se encontraron sus tokens o su nombre está repetido
+        std::vector<size_t> callees; ///< Índices en ProgramNode::functions
+    };
+
+    /// main.umbra -> main.ufc/
+    static std::filesystem::path directoryFor(const std::filesystem::path& sourcePath);
+
+    /**
+     * @brief Claves de las funciones de program, en el mismo orden.
+     * @param tokens Tokens de los que salió program (ordenados por ubicación).
+     * @param configHash Hash de las opciones que afectan al código generado.
+     * @param withPositions Incluir línea y columna de cada token en la clave.
+     */
+    static std::vector<FunctionKey> computeKeys(const ProgramNode& program, const std::vector<Lexer::Token>& tokens,
+                                                const SourceMap& sourceMap, uint64_t configHash, bool withPositions);
+
+    explicit FunctionCache(std::filesystem::path directory) : directory(std::move(directory)) {}
+
+    std::filesystem::path objectPathFor(const std::string& name, uint64_t key) const;
+
+    /// Ya existe el objeto de esa función con esa clave.
+    bool contains(const std::string& name, uint64_t key) const;
+
+    /// Crea el directorio; false (con el motivo en error) si no se pudo.
+    bool prepare(std::string& error) const;
+
+    /// Borra los objetos que no están en keep (versiones anteriores y funciones eliminadas).
+    void prune(const std::vector<std::filesystem::path>& keep) const;
+
+private:
+    std::filesystem::path directory;
+};
+
+} // namespace umbra
@@ -2,6 +2,7 @@
 #define UMBRA_COMPILER_ERROR_H
 
 #include "umbra/error/ErrorTypes.h"
+#include "umbra/io/SourceLocation.h"
 #include <string>
 
 namespace umbra {
@@ -11,12 +12,26 @@ class CompilerError {
     CompilerError(ErrorType type, const std::string &message, int line, int column)
         : type(type), message(message), line(line), column(column) {}
 
+    /// Error con ubicación en el programa; ErrorManager la resuelve a archivo:línea:columna al imprimir.
+    CompilerError(ErrorType type, const std::string &message, SourceLocation location)
+        : type(type), message(message), line(0), column(0), location(location) {}
+
     virtual ~CompilerError() = default;
 
     virtual std::string toString() const;
     ErrorType getType() const { return type; }
     int getLine() const { return line; }
     int getColumn() const { return column; }
+    SourceLocation getLocation() const { return location; }
+    void setLocation(SourceLocation loc) { location = loc; }
+    const std::string &getFile() const { return file; }
+
+    /// Fija el archivo, la línea y la columna resueltos desde la ubicación.
+    void resolve(const std::string &resolvedFile, int resolvedLine, int resolvedColumn) {
+        file = resolvedFile;
+        line = resolvedLine;
+        column = resolvedColumn;
+    }
 
   protected:
     std::string getErrorTypeString() const;
@@ -25,6 +40,8 @@ class CompilerError {
     std::string message;
     int line;
     int column;
+    SourceLocation location; ///< Inválida si el error solo tiene línea/columna
+    std::string file;        ///< Vacío hasta resolver la ubicación
 };
 
 class LexicalError : public CompilerError {
@@ -43,6 +60,7 @@ class SemanticError : public CompilerError {
     public:
         enum class Action {WARNING, ERROR};
         SemanticError(const std::string &message, int line, int column, Action action);
+        SemanticError(const std::string &message, SourceLocation location, Action action);
 
         std::string toString() const override;
 
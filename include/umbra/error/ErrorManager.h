@@ -8,6 +8,8 @@
 
 namespace umbra {
 
+class SourceMap;
+
 class ErrorManager {
   public:
     void addError(std::unique_ptr<CompilerError> error);
@@ -18,9 +20,18 @@ class ErrorManager {
     const std::vector<std::unique_ptr<CompilerError>> &getErrors() const;
     void sortErrors();
 
+    /// Mapa con el que se resuelven las SourceLocation de los errores; debe vivir hasta imprimirlos.
+    void setSourceMap(const SourceMap *map) { sourceMap = map; }
+
+    /// Resuelve las ubicaciones pendientes y suelta el mapa (antes de que este se destruya).
+    void detachSourceMap();
+
   private:
     static const size_t MAX_ERRORS = 100;
     std::vector<std::unique_ptr<CompilerError>> errors;
+    const SourceMap *sourceMap = nullptr;
+
+    void resolveLocations() const;
 };
 
 } // namespace umbra
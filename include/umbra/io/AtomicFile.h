@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace umbra {
+
+/**
+ * @file AtomicFile.h
+ * @brief Escritura de archivos generados (interfaces, cachés, objetos) sin estados intermedios.
+ * @details
+ * El contenido se escribe en un temporal junto al destino y se renombra: quien lee el archivo
+ * ve la versión anterior o la nueva, nunca una a medias. El nombre del temporal lleva el pid y
+ * un contador del proceso, así dos compilaciones del mismo daemon que escriben el mismo
+ * archivo no comparten temporal.
+ */
+
+/// path + ".tmp<pid>-<n>", distinto en cada llamada.
+std::filesystem::path temporaryPathFor(const std::filesystem::path& path);
+
+/// Escribe data en path (temporal + rename); false (con el motivo en error) si no se pudo.
+bool writeFileAtomically(const std::filesystem::path& path, std::string_view data, std::string& error);
+
+} // namespace umbra
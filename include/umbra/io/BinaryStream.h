@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace umbra {
+
+/**
+ * @file BinaryStream.h
+ * @brief Escritura y lectura de formatos binarios del compilador (interfaces de módulo, cachés).
+ * @details
+ * Enteros sin signo en varint LEB128 (7 bits por byte), enteros de 64 bits fijos en little
+ * endian y strings como longitud varint seguida de los bytes. El lector nunca lee fuera del
+ * buffer: ante datos truncados o corruptos queda en estado de fallo (ok() == false) y devuelve
+ * ceros, así el llamador comprueba una sola vez al final.
+ */
+class BinaryWriter {
+public:
+    void writeU8(uint8_t value) { data.push_back(static_cast<char>(value)); }
+    void writeVarint(uint64_t value);
+    void writeU64(uint64_t value);
+    void writeString(std::string_view value);
+    void writeBytes(std::string_view bytes) { data.append(bytes.data(), bytes.size()); }
+
+    const std::string& buffer() const { return data; }
+
+private:
+    std::string data;
+};
+
+class BinaryReader {
+public:
+    explicit BinaryReader(std::string_view data) : data(data) {}
+
+    uint8_t readU8();
+    uint64_t readVarint();
+    uint64_t readU64();
+    std::string readString();
+    /// Compara los siguientes bytes con expected (cabeceras "mágicas") y los consume.
+    bool expectBytes(std::string_view expected);
+
+    bool ok() const { return !failed; }
+    bool atEnd() const { return pos == data.size(); }
+    /// Marca el flujo como inválido (p. ej. un valor fuera de rango en el formato).
+    void fail() { failed = true; }
+
+private:
+    std::string_view data;
+    size_t pos = 0;
+    bool failed = false;
+};
+
+} // namespace umbra
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace umbra {
+
+/**
+ * @file ContentHash.h
+ * @brief Hash de contenido (FNV-1a de 64 bits) para detectar archivos modificados.
+ * @details No es criptográfico: solo decide si un artefacto en caché (p. ej. una interfaz de
+ * módulo) corresponde todavía al texto fuente del que salió.
+ */
+inline uint64_t hashContent(std::string_view bytes, uint64_t seed = 14695981039346656037ull) {
+    uint64_t hash = seed;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/// Encadena un valor (p. ej. el hash de otro archivo) a un hash acumulado.
+inline uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    char bytes[sizeof value];
+    for (size_t i = 0; i < sizeof value; ++i) bytes[i] = static_cast<char>(value >> (8 * i));
+    return hashContent(std::string_view(bytes, sizeof bytes), seed);
+}
+
+} // namespace umbra
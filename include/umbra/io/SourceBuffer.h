@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace umbra {
+
+/**
+ * @file SourceBuffer.h
+ * @brief Contenido inmutable de un archivo fuente, sin copias intermedias.
+ * @details
+ * - Los archivos regulares se proyectan en memoria con mmap (solo lectura); el preprocesador,
+ *   el lexer y los diagnósticos trabajan sobre la misma página, sin copiarla a un std::string.
+ *   Con open(..., map = false) se leen a un buffer propio (ver SourceCache::setMapFiles).
+ * - Pipes, FIFOs y otros archivos no proyectables se leen con read() a un buffer propio.
+ * - El BOM UTF-8 inicial queda fuera de text().
+ * - La tabla de inicios de línea se construye la primera vez que un diagnóstico la necesita;
+ *   una compilación sin errores nunca la calcula.
+ * - Un buffer puede compartirse entre compilaciones concurrentes (SourceCache): los datos
+ *   calculados bajo demanda se inicializan una sola vez con std::call_once.
+ */
+class SourceBuffer {
+public:
+    ~SourceBuffer();
+
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+
+    /**
+     * @brief Abre y proyecta (o lee) un archivo.
+     * @param file Ruta del archivo.
+     * @param error Recibe el motivo del fallo.
+     * @param map false para leerlo a memoria propia aunque se pueda proyectar.
+     * @return El buffer, o nullptr si no se pudo abrir o leer.
+     */
+    static std::unique_ptr<SourceBuffer> open(const std::filesystem::path& file, std::string& error, bool map = true);
+
+    /// Buffer en memoria con un nombre arbitrario (texto generado, pruebas).
+    static std::unique_ptr<SourceBuffer> fromString(std::string name, std::string content);
+
+    /// Texto del archivo sin el BOM. Válido mientras viva el buffer.
+    std::string_view text() const { return {data + bomSize, size - bomSize}; }
+
+    /// Ruta con la que se abrió (o nombre dado en fromString).
+    const std::string& getName() const { return name; }
+
+    /// true si el contenido está proyectado con mmap.
+    bool isMapped() const { return mapped; }
+
+    /**
+     * @brief Línea y columna (1-indexed) de un desplazamiento de text().
+     * @details Construye la tabla de líneas en la primera llamada.
+     */
+    std::pair<int, int> getLineColumn(size_t offset) const;
+
+    /// Contenido de una línea (1-indexed) sin el salto de línea; vacío si no existe.
+    std::string_view getLineText(int line) const;
+
+    /// Número de líneas del texto.
+    size_t getLineCount() const;
+
+    /// hashContent(text()), calculado en la primera llamada.
+    uint64_t getContentHash() const;
+
+private:
+    SourceBuffer() = default;
+
+    std::string name;
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t bomSize = 0;
+    bool mapped = false;
+    std::string owned; ///< Contenido cuando no está proyectado
+
+    mutable std::vector<uint32_t> lineStarts; ///< Desplazamientos de inicio de línea, calculados bajo demanda
+    mutable std::once_flag lineStartsOnce;
+    mutable uint64_t contentHash = 0;
+    mutable std::once_flag contentHashOnce;
+
+    void adopt(std::string content);
+    void detectBOM();
+    const std::vector<uint32_t>& getLineStarts() const;
+};
+
+} // namespace umbra
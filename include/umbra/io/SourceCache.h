@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "umbra/io/SourceBuffer.h"
+
+namespace umbra {
+
+/**
+ * @file SourceCache.h
+ * @brief Caché de archivos fuente compartida por todas las compilaciones del proceso.
+ * @details
+ * Cada archivo se identifica por (dispositivo, inodo) y se considera igual mientras no cambien
+ * su mtime ni su tamaño. Para un archivo ya visto:
+ * - canonicalPath() cuesta una llamada a stat en lugar de recorrer la ruta componente a
+ *   componente (weakly_canonical);
+ * - load() devuelve el mismo SourceBuffer sin volver a abrirlo ni proyectarlo.
+ * Un archivo modificado se vuelve a leer en la siguiente consulta; quien aún tenga el buffer
+ * anterior lo conserva (shared_ptr). Es segura para usarse desde varios hilos.
+ *
+ * En un proceso que compila muchas veces (--daemon) la caché no crece sin límite:
+ * - si una ruta pasa a ser otro inodo (un editor que guarda escribiendo un archivo nuevo y
+ *   renombrándolo), la entrada del inodo anterior se olvida;
+ * - el contenido guardado está acotado por setCapacity(); al superarlo se olvidan los
+ *   archivos usados hace más tiempo.
+ */
+class SourceCache {
+public:
+    static constexpr size_t DefaultCapacity = size_t(256) << 20;
+
+    /// Caché del proceso.
+    static SourceCache& global();
+
+    /**
+     * @brief Ruta canónica de un archivo existente.
+     * @return La ruta canónica, o una vacía si el archivo no existe.
+     */
+    std::filesystem::path canonicalPath(const std::filesystem::path& path);
+
+    /**
+     * @brief Buffer del archivo; se lee solo si no está en caché o cambió desde la última vez.
+     * @param path Ruta del archivo (el buffer se nombra con la ruta canónica si es un archivo regular).
+     * @param error Recibe el motivo del fallo.
+     * @return El buffer, o nullptr si no se pudo leer.
+     */
+    std::shared_ptr<const SourceBuffer> load(const std::filesystem::path& path, std::string& error);
+
+    /// Olvida todos los archivos (los buffers en uso siguen vivos).
+    void clear();
+
+    /// Bytes de contenido (y rutas) que se conservan como máximo.
+    void setCapacity(size_t bytes);
+
+    /**
+     * @brief false: los archivos se leen a memoria propia en lugar de proyectarse con mmap.
+     * @details Un archivo proyectado que otro proceso trunca produce SIGBUS al leerlo; en un
+     *          proceso de larga vida (--daemon) eso tiraría todas las compilaciones.
+     */
+    void setMapFiles(bool map) { mapFiles = map; }
+
+    /// Bytes que ocupan ahora las entradas (para pruebas).
+    size_t getSize();
+
+private:
+    using FileKey = std::pair<uint64_t, uint64_t>; ///< (st_dev, st_ino)
+
+    struct Entry {
+        int64_t mtimeNs = 0;
+        int64_t size = 0;
+        std::filesystem::path canonicalPath;
+        std::shared_ptr<const SourceBuffer> buffer; ///< nullptr hasta el primer load()
+        size_t cost = 0;                            ///< Bytes que cuenta para la capacidad
+        std::list<FileKey>::iterator recent;        ///< Posición en recency
+    };
+
+    std::mutex mutex;
+    std::map<FileKey, Entry> files;
+    std::map<std::filesystem::path, FileKey> byPath; ///< Ruta canónica -> inodo que tenía al leerla
+    std::list<FileKey> recency;                      ///< Más reciente primero
+    size_t bytes = 0;
+    size_t capacity = DefaultCapacity;
+    std::atomic<bool> mapFiles{true};
+
+    /// Entrada vigente del archivo (la crea o la renueva si cambió); false si stat falla.
+    bool lookup(const std::filesystem::path& path, FileKey& key, Entry& entry);
+
+    // Requieren el mutex
+    void erase(std::map<FileKey, Entry>::iterator found);
+    void trim();
+};
+
+} // namespace umbra
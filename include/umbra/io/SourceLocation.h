@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace umbra {
+
+/**
+ * @file SourceLocation.h
+ * @brief Posición compacta (32 bits) dentro del programa preprocesado.
+ * @details
+ * Es un desplazamiento en el espacio de SourceMap (los tramos de todos los archivos, uno tras
+ * otro). Tokens y nodos del AST solo guardan este entero; el archivo, la línea y la columna se
+ * calculan con SourceMap::resolve cuando un diagnóstico se imprime.
+ */
+struct SourceLocation {
+    static constexpr uint32_t InvalidOffset = UINT32_MAX;
+
+    uint32_t offset = InvalidOffset;
+
+    SourceLocation() = default;
+    explicit SourceLocation(uint32_t offset) : offset(offset) {}
+
+    bool isValid() const { return offset != InvalidOffset; }
+
+    /// Misma posición desplazada n bytes (p. ej. al carácter exacto de un error léxico).
+    SourceLocation advancedBy(uint32_t n) const { return isValid() ? SourceLocation(offset + n) : *this; }
+
+    bool operator==(const SourceLocation& other) const { return offset == other.offset; }
+    bool operator!=(const SourceLocation& other) const { return offset != other.offset; }
+};
+
+} // namespace umbra
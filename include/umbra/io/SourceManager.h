@@ -0,0 +1,50 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "umbra/io/SourceBuffer.h"
+
+namespace umbra {
+
+/**
+ * @file SourceManager.h
+ * @brief Dueño de los SourceBuffer de una compilación.
+ * @details
+ * Cada archivo se abre una sola vez (clave: ruta tal como se pide; el preprocesador ya la
+ * canonicaliza) y su buffer vive hasta que se destruye el SourceManager, de modo que el
+ * preprocesador, el lexer y los diagnósticos pueden guardar string_view al texto sin copiarlo.
+ * Los archivos se piden a SourceCache: compilaciones del mismo proceso comparten los buffers
+ * de los archivos que no cambiaron.
+ */
+class SourceManager {
+public:
+    using FileID = unsigned;
+
+    /**
+     * @brief Devuelve el buffer del archivo, abriéndolo la primera vez.
+     * @param file Ruta del archivo.
+     * @param errMsg Recibe el motivo del fallo (opcional).
+     * @return El buffer, o nullptr si no se pudo leer.
+     */
+    const SourceBuffer* load(const std::filesystem::path& file, std::string* errMsg = nullptr);
+
+    /// Registra un buffer en memoria (texto generado, pruebas).
+    const SourceBuffer* addBuffer(std::string name, std::string content);
+
+    /// Identificador estable de un buffer registrado; FileID(-1) si no pertenece a este manager.
+    FileID getFileID(const SourceBuffer* buffer) const;
+
+    /// Buffer por identificador; nullptr si está fuera de rango.
+    const SourceBuffer* getBuffer(FileID id) const;
+
+    size_t getBufferCount() const { return buffers.size(); }
+
+private:
+    std::vector<std::shared_ptr<const SourceBuffer>> buffers;
+    std::unordered_map<std::string, FileID> byPath;
+};
+
+} // namespace umbra
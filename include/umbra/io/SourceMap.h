@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "umbra/io/SourceBuffer.h"
+#include "umbra/io/SourceLocation.h"
+
+namespace umbra {
+
+/**
+ * @file SourceMap.h
+ * @brief Programa preprocesado como lista de rangos sobre los buffers de cada archivo.
+ * @details
+ * El preprocesador no concatena los archivos incluidos con 'use': registra, en orden, los
+ * tramos [begin, end) de cada SourceBuffer que forman el programa. El lexer recorre los tramos
+ * directamente y cada uno conserva su archivo, así que las líneas de los tokens son las del
+ * archivo real. Cada tramo ocupa además un intervalo contiguo [offset, offset + size) del
+ * programa completo: una SourceLocation es un punto de ese espacio y resolve() la traduce a
+ * archivo, línea y columna.
+ */
+/// Ubicación resuelta de una SourceLocation: archivo real, línea y columna (1-indexed).
+struct PresumedLocation {
+    const SourceBuffer* buffer = nullptr; ///< nullptr si la ubicación no es válida
+    int line = 0;
+    int column = 0;
+
+    bool isValid() const { return buffer != nullptr; }
+};
+
+class SourceMap {
+public:
+    struct Segment {
+        const SourceBuffer* buffer; ///< Archivo al que pertenece el tramo
+        uint32_t begin;             ///< Inicio dentro de buffer->text()
+        uint32_t end;               ///< Fin (exclusivo) dentro de buffer->text()
+        uint32_t offset;            ///< Posición del tramo en el programa completo
+
+        std::string_view text() const { return buffer->text().substr(begin, end - begin); }
+        uint32_t size() const { return end - begin; }
+    };
+
+    /// Agrega el tramo [begin, end) de buffer; los tramos vacíos se ignoran.
+    void append(const SourceBuffer& buffer, size_t begin, size_t end);
+
+    const std::vector<Segment>& getSegments() const { return segments; }
+
+    /// Bytes del programa completo (suma de los tramos).
+    uint32_t getSize() const { return size; }
+
+    /**
+     * @brief Archivo, línea y columna de una ubicación.
+     * @details Búsqueda binaria del tramo y tabla de líneas del buffer (que se construye
+     * en la primera consulta). Pensada para diagnósticos, no para el camino rápido.
+     */
+    PresumedLocation resolve(SourceLocation location) const;
+
+    /// Copia el programa completo a un string (depuración).
+    std::string flatten() const;
+
+private:
+    std::vector<Segment> segments;
+    uint32_t size = 0;
+};
+
+} // namespace umbra
@@ -1,12 +1,10 @@
 #pragma once
 
 #include <string>
-#include <fstream>
-#include <sstream>
 #include <filesystem>
 #include <optional>
-#include <system_error>
 #include "umbra/error/ErrorManager.h"
+#include "umbra/io/SourceBuffer.h"
 
 namespace umbra {
 
@@ -14,13 +12,12 @@ namespace umbra {
  * @file UmbraIO.h
  * @brief Utilidades de lectura de archivos fuente para Umbra.
  * @details
- * - Lee el contenido completo de un archivo a memoria.
- * - Valida existencia y tipo de archivo (regular).
- * - Intenta reservar memoria según el tamaño para minimizar realojos.
- * - Elimina BOM UTF-8 si está presente.
+ * - Copia el contenido completo de un archivo a un std::string.
+ * - La lectura la hace SourceBuffer (mmap, o read() para pipes); el BOM UTF-8 se descarta.
  * - Reporta errores vía ErrorManager (opcional).
  *
- * Nota: No soporta lectura desde stdin por decisión de diseño actual.
+ * Quien solo necesita leer el texto debe usar SourceManager/SourceBuffer directamente y
+ * evitar la copia.
  */
 class UmbraIO {
 public:
@@ -35,55 +32,13 @@ public:
         std::string msg;
         out.clear();
 
-        std::error_code ec;
-        if (!std::filesystem::exists(file, ec)) {
-            msg = "El archivo " + file.string() + " no existe";
+        std::unique_ptr<SourceBuffer> buffer = SourceBuffer::open(file, msg);
+        if (!buffer) {
             reportError(err, msg);
             return false;
         }
 
-        if (!std::filesystem::is_regular_file(file, ec)) {
-            msg = "El archivo " + file.string() + " no es regular";
-            reportError(err, msg);
-            return false;
-        }
-
-        std::ifstream ifs(file, std::ios::binary);
-        if (!ifs) {
-            msg = "No se pudo abrir el archivo " + file.string();
-            reportError(err, msg);
-            return false;
-        }
-
-        std::uintmax_t sz = std::filesystem::file_size(file, ec);
-        if (!ec && sz > 0) {
-            try {
-                out.resize(static_cast<size_t>(sz));
-            } catch (...) {
-                // Fallback a lectura por streambuf abajo
-            }
-        }
-
-        if (!out.empty()) {
-            ifs.read(out.data(), static_cast<std::streamsize>(out.size()));
-            if (!ifs) {
-                ifs.clear();
-                ifs.seekg(0, std::ios::beg);
-                std::ostringstream oss;
-                oss << ifs.rdbuf();
-                out = std::move(oss).str();
-            }
-        } else {
-            std::ostringstream oss;
-            oss << ifs.rdbuf();
-            out = std::move(oss).str();
-        }
-
-        if (!ifs.good() && !ifs.eof()) {
-            reportError(err, "Hubo un error al leer " + file.string());
-            return false;
-        }
-
+        out.assign(buffer->text());
         return true;
     }
 
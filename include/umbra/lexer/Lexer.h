@@ -14,7 +14,10 @@
 
 #include "../error/ErrorManager.h"
 #include "Tokens.h"
+#include "../io/SourceBuffer.h"
+#include "../io/SourceMap.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 
@@ -46,24 +49,22 @@ public:
      * @brief Representa un token léxico del código fuente
      */
     struct Token {
-        TokenType type;      ///< Tipo del token
-        std::string lexeme;  ///< Texto literal del token
-        int line;            ///< Línea donde se encontró (1-indexed)
-        int column;          ///< Columna donde se encontró (1-indexed)
+        TokenType type;          ///< Tipo del token
+        std::string lexeme;      ///< Texto literal del token
+        SourceLocation location; ///< Inicio del token en el programa (32 bits; se resuelve con SourceMap)
 
         /// @brief Constructor por defecto
-        Token() : type(TokenType::TOK_EOF), lexeme(""), line(0), column(0) {}
+        Token() : type(TokenType::TOK_EOF), lexeme("") {}
 
         /**
          * @brief Constructor de Token
          * @param type Tipo del token
          * @param start Puntero al inicio del lexema en el fuente
          * @param length Longitud del lexema
-         * @param line Línea donde se encontró
-         * @param column Columna donde se encontró
+         * @param location Posición del token en el programa preprocesado
          */
-        Token(TokenType type, const char* start, size_t length, int line, int column)
-            : type(type), lexeme(start, length), line(line), column(column) {}
+        Token(TokenType type, const char* start, size_t length, SourceLocation location)
+            : type(type), lexeme(start, length), location(location) {}
 
         /// @brief Obtiene el lexema del token
         inline const std::string& getLexeme() const { return lexeme; }
@@ -86,6 +87,21 @@ public:
      */
     Lexer(const std::string& source, ErrorManager& externalErrorManager);
 
+    /**
+     * @brief Constructor sobre un buffer ya cargado (sin copiar el texto)
+     * @param buffer Buffer fuente; debe vivir mientras se use el lexer
+     * @param externalErrorManager Referencia al gestor de errores externo
+     */
+    Lexer(const SourceBuffer& buffer, ErrorManager& externalErrorManager);
+
+    /**
+     * @brief Constructor sobre el programa preprocesado
+     * @details Recorre los tramos en orden; las líneas de cada token son las de su archivo.
+     * @param sourceMap Tramos del preprocesador; sus buffers deben vivir mientras se use el lexer
+     * @param externalErrorManager Referencia al gestor de errores externo
+     */
+    Lexer(const SourceMap& sourceMap, ErrorManager& externalErrorManager);
+
     //==========================================================================
     // Interfaz Pública
     //==========================================================================
@@ -121,16 +137,25 @@ public:
 
     /**
      * @brief Obtiene el código fuente
-     * @return Referencia al código fuente
+     * @return Vista del tramo en curso (todo el fuente si no hubo 'use')
+     */
+    std::string_view getSource() const;
+
+    /**
+     * @brief Mapa de tramos que tokeniza el lexer
+     * @details Resuelve la SourceLocation de sus tokens a archivo/línea/columna.
      */
-    const std::string& getSource() const;
+    const SourceMap& getSourceMap() const { return sourceMap; }
 
 private:
     //==========================================================================
     // Miembros de Datos
     //==========================================================================
     
-    std::string source;                                 ///< Código fuente
+    std::unique_ptr<SourceBuffer> internalBuffer;       ///< Copia propia si se construyó desde un string
+    SourceMap sourceMap;                                ///< Tramos a tokenizar, en orden
+    const SourceBuffer* buffer = nullptr;               ///< Archivo del tramo en curso
+    std::string_view source = "";                       ///< Texto del tramo en curso
     std::unique_ptr<ErrorManager> internalErrorManager; ///< Gestor interno
     ErrorManager* errorManager;                         ///< Gestor activo
     std::vector<Token> tokens;                          ///< Tokens generados
@@ -155,6 +180,7 @@ private:
         Rejection       ///< Estado de rechazo
     };
 
+    uint32_t segmentOffset = 0;///< Posición del tramo en curso en el programa
     int current = 0;           ///< Posición actual en el fuente
     int line = 1;              ///< Línea actual
     int start = 0;             ///< Inicio del token actual
@@ -172,6 +198,13 @@ private:
      */
     void setupDispatch();
 
+    /**
+     * @brief Posiciona el escáner al inicio de un tramo
+     * @details La línea inicial se toma del archivo del tramo, de modo que los
+     * tokens de un archivo incluido conservan sus propias líneas.
+     */
+    void enterSegment(const SourceMap::Segment& segment);
+
     //==========================================================================
     // Manejadores de Tokens (Tabla de Despacho)
     //==========================================================================
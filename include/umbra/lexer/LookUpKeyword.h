@@ -34,10 +34,18 @@ namespace umbra {
             case fnv1a_hash("bool", const_strlen("bool")):         return TokenType::TOK_BOOL;
             case fnv1a_hash("int", const_strlen("int")):           return TokenType::TOK_INT;
             case fnv1a_hash("float", const_strlen("float")):       return TokenType::TOK_FLOAT;
+            case fnv1a_hash("long", const_strlen("long")):         return TokenType::TOK_LONG;
+            case fnv1a_hash("double", const_strlen("double")):     return TokenType::TOK_DOUBLE;
             case fnv1a_hash("string", const_strlen("string")):              return TokenType::TOK_STRING;
             case fnv1a_hash("char", const_strlen("char")):         return TokenType::TOK_CHAR;
             case fnv1a_hash("array", const_strlen("array")):       return TokenType::TOK_ARRAY;
             case fnv1a_hash("void", const_strlen("void")):         return TokenType::TOK_VOID;
+            case fnv1a_hash("vec4", const_strlen("vec4")):         return TokenType::TOK_VEC4;
+            case fnv1a_hash("vec8", const_strlen("vec8")):         return TokenType::TOK_VEC8;
+            case fnv1a_hash("const", const_strlen("const")):       return TokenType::TOK_CONST;
+            case fnv1a_hash("constfunc", const_strlen("constfunc")): return TokenType::TOK_CONSTFUNC;
+            case fnv1a_hash("inline", const_strlen("inline")):     return TokenType::TOK_INLINE;
+            case fnv1a_hash("noinline", const_strlen("noinline")): return TokenType::TOK_NOINLINE;
             case fnv1a_hash("times", const_strlen("times")):       return TokenType::TOK_TIMES;
             case fnv1a_hash("new", const_strlen("new")):           return TokenType::TOK_NEW;
             case fnv1a_hash("delete", const_strlen("delete")):     return TokenType::TOK_DELETE;
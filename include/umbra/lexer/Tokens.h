@@ -18,12 +18,20 @@ enum class TokenType {
     // Keyword tokens for data types
     TOK_INT,
     TOK_FLOAT,
+    TOK_LONG,
+    TOK_DOUBLE,
     TOK_BOOL,
     TOK_CHAR,
     TOK_STRING,
     TOK_BINARY,
     TOK_ARRAY,
     TOK_VOID,
+    TOK_VEC4,  // 'vec4' (seguido del tipo de elemento: vec4 float)
+    TOK_VEC8,  // 'vec8'
+    TOK_CONST, // 'const' (variable local de solo lectura)
+    TOK_CONSTFUNC, // 'constfunc' (función evaluable en compilación)
+    TOK_INLINE, // 'inline' (forzar inlining de la función)
+    TOK_NOINLINE, // 'noinline' (prohibir inlining de la función)
     // TOK_ARRAY, wait for array definition
 
     // Keyword tokens for control structures
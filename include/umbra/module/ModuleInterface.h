@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include "umbra/semantic/SymbolTable.h"
+
+namespace umbra {
+
+/**
+ * @file ModuleInterface.h
+ * @brief Interfaz precompilada de un archivo incluido con `use` (archivo .umi).
+ * @details
+ * `umbra --emit-module lib.umbra` compila la biblioteca a lib.o y escribe junto a ella lib.umi con
+ * las firmas (FunctionSignature, lo mismo que construye SymbolCollector) de todas sus funciones.
+ * Un programa que hace `use "lib.umbra"` carga la interfaz en lugar de volver a leer, tokenizar y
+ * analizar el texto de la biblioteca, declara sus funciones como externas y enlaza lib.o.
+ *
+ * La interfaz guarda el hash de cada archivo fuente cuyo código contiene el objeto (la biblioteca
+ * y lo que ella incluyó como texto): si alguno cambió, o falta el objeto, la interfaz se ignora y
+ * el `use` vuelve a incluir el texto.
+ */
+struct ModuleInterface {
+    static constexpr uint32_t FormatVersion = 1;
+
+    /// Archivo fuente compilado dentro del objeto del módulo.
+    struct Source {
+        std::string path;   ///< Ruta canónica
+        uint64_t hash = 0;  ///< SourceBuffer::getContentHash (texto sin BOM)
+    };
+
+    /// Función exportada: nombre y firma tal como las registra SymbolCollector.
+    struct Function {
+        std::string name;
+        FunctionSignature signature;
+    };
+
+    std::string targetTriple;          ///< Triple con el que se generó el objeto
+    std::string objectFile;            ///< Ruta absoluta del .o
+    std::vector<Source> sources;       ///< sources[0] es el archivo del propio módulo
+    std::vector<std::string> imports;  ///< Módulos (rutas .umbra) que este módulo importó a su vez
+    std::vector<Function> functions;
+
+    /// lib.umbra -> lib.umi
+    static std::filesystem::path interfacePathFor(const std::filesystem::path& sourcePath);
+    /// lib.umbra -> lib.o
+    static std::filesystem::path objectPathFor(const std::filesystem::path& sourcePath);
+
+    /// Serializa la interfaz; false (con el motivo en error) si no se pudo escribir.
+    bool write(const std::filesystem::path& path, std::string& error) const;
+
+    /// Lee una interfaz; nullopt (con el motivo en error) si falta, está truncada o es de otra versión.
+    static std::optional<ModuleInterface> read(const std::filesystem::path& path, std::string& error);
+
+    /// Todos los fuentes conservan su hash y el objeto existe.
+    bool isUpToDate() const;
+};
+
+} // namespace umbra
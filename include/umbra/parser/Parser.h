@@ -88,6 +88,9 @@ private:
     /// @brief Salta tokens de nueva línea
     void skipNewLines() noexcept;
 
+    /// @brief Verifica palabra clave contextual (identificador con ese lexema)
+    [[nodiscard]] bool checkContextual(const char* word) const noexcept;
+
     //==========================================================================
     // Utilidades de Análisis
     //==========================================================================
@@ -102,14 +105,14 @@ private:
     void synchronize() noexcept;
     
     /// @brief Registra error sintáctico
-    void error(const char* msg, int ln, int col);
+    void error(const char* msg, SourceLocation location);
 
     //==========================================================================
     // Reglas de Producción - Declaraciones
     //==========================================================================
     
     std::unique_ptr<FunctionDefinition> parseFunctionDefinition();
-    std::unique_ptr<Type> parseType();
+    std::unique_ptr<Type> parseType(bool allowUnsized = false);
     std::vector<std::unique_ptr<Statement>> parseStatementList();
     std::unique_ptr<Statement> parseStatement();
     std::unique_ptr<VariableDeclaration> parseVariableDeclaration();
@@ -137,6 +140,7 @@ private:
     
     std::unique_ptr<IfStatement> parseIfStatement();
     std::unique_ptr<RepeatTimesStatement> parseRepeatTimesStatement();
+    void parseParallelClauses(RepeatTimesStatement& loop);
     std::unique_ptr<RepeatIfStatement> parseRepeatIfStatement();
 
     //==========================================================================
@@ -1,9 +1,16 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <set>
+#include <vector>
+#include <memory>
 #include <optional>
 #include <filesystem> // C++17
+#include <iostream>
+#include "umbra/io/SourceManager.h"
+#include "umbra/io/SourceMap.h"
+#include "umbra/module/ModuleInterface.h"
 
 namespace umbra {
 
@@ -12,19 +19,68 @@ const int MAX_INCLUDE_DEPTH = 32;
 class Preprocessor {
 public:
 
-    explicit Preprocessor(const std::string& mainFilePath);
+    explicit Preprocessor(const std::string& mainFilePath); // Usará SourceManager interno
+    /**
+     * @param useModules Si es true, un `use` cuyo archivo tiene una interfaz .umi vigente importa
+     *                   el módulo en lugar de incluir el texto.
+     * @param warnings Destino de los avisos (`use` mal formado, interfaz .umi ilegible).
+     */
+    Preprocessor(const std::string& mainFilePath, SourceManager& sources, bool useModules = true,
+                 std::ostream& warnings = std::cerr);
+
+    /// Programa preprocesado como tramos de los buffers originales (sin copias).
+    const SourceMap& getSourceMap() const { return sourceMap; }
     std::string getProcessedContent() const;
 
+    /// Módulos precompilados importados (con sus dependencias), en orden de importación.
+    const std::vector<ModuleInterface>& getModules() const { return modules; }
+
+    /// Archivos incluidos como texto (el principal primero), en el orden en que se leyeron.
+    const std::vector<const SourceBuffer*>& getSplicedFiles() const { return splicedFiles; }
+
 private:
-    std::string processedContent;
+    std::unique_ptr<SourceManager> internalSources;
+    SourceManager& sources;
+    SourceMap sourceMap;
     std::set<std::string> includedFilesCanonicalPaths; // Almacena rutas canónicas
+    bool useModules = true;
+    std::ostream& warnings;
+    std::vector<ModuleInterface> modules;
+    std::vector<const SourceBuffer*> splicedFiles;
+
+    /// Directiva `use` encontrada en un archivo.
+    struct UseDirective {
+        size_t lineStart;               ///< Offset del inicio de la línea de la directiva
+        size_t lineEnd;                 ///< Offset del '\n' que la termina (o fin del texto)
+        std::string path;               ///< Ruta tal como se escribió
+        std::filesystem::path target;   ///< Ruta resuelta (la completa prefetch)
+    };
+
+    void run(const std::string& mainFilePath);
 
-    std::string processFile(const std::filesystem::path& currentFileCanonicalPath, int level);
+    /// Incluye un archivo una sola vez: importa su módulo si es posible y si no, su texto.
+    void includeFile(const std::filesystem::path& canonicalPath, int level);
 
-    std::optional<std::string> parseUseDirective(const std::string& line);
+    /// Carga la interfaz .umi de canonicalPath; false si no existe, no es vigente o no aplica.
+    bool importModule(const std::filesystem::path& canonicalPath, int level);
+
+    /// Agrega al mapa los tramos de currentFile, con sus 'use' expandidos en su lugar.
+    void processFile(const SourceBuffer& currentFile, const std::filesystem::path& currentFileCanonicalPath,
+                     int level);
+
+    /// Directivas `use` de currentFile, en orden de aparición.
+    std::vector<UseDirective> scanUseDirectives(const SourceBuffer& currentFile);
+
+    /// Resuelve los destinos de las directivas y los lee hacia SourceCache; en paralelo si parallel.
+    void prefetch(std::vector<UseDirective>& directives, const std::filesystem::path& currentFileCanonicalPath,
+                  bool parallel);
+
+    std::optional<std::string> parseUseDirective(std::string_view line);
 
     std::filesystem::path resolveIncludePath(const std::filesystem::path& currentFileCanonicalPath,
                                              const std::string& includeDirectivePath);
+
+    const SourceBuffer& loadFile(const std::filesystem::path& canonicalPath);
 };
 
 } // namespace umbra
@@ -0,0 +1,81 @@
+#ifndef UMBRA_RT_H
+#define UMBRA_RT_H
+
+/**
+ * @file umbra_rt.h
+ * @brief Interfaz C del runtime de Umbra (libumbra_rt).
+ * @details
+ * El CodegenVisitor emite llamadas directas a estas funciones; los programas compilados
+ * se enlazan contra libumbra_rt.a. La salida se acumula en un buffer de usuario que se
+ * vacía al terminar el programa, al llenarse o, si stdout es una terminal, en cada salto
+ * de línea. La entrada se lee de stdin en bloques de 64 KiB.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Escribe una cadena terminada en '\0'.
+void umbra_print_str(const char* s);
+
+/// Escribe un entero de 32 bits en decimal.
+void umbra_print_i32(int32_t value);
+
+/// Escribe un entero de 64 bits en decimal.
+void umbra_print_i64(int64_t value);
+
+/// Escribe un float con el mismo formato que printf("%f").
+void umbra_print_f32(float value);
+
+/// Escribe un double con el mismo formato que printf("%f").
+void umbra_print_f64(double value);
+
+/// Escribe un único carácter.
+void umbra_print_char(char c);
+
+/// Escribe '\n'; en una terminal además vacía el buffer.
+void umbra_print_newline(void);
+
+/// Vacía el buffer de salida en stdout.
+void umbra_rt_flush(void);
+
+/// Lee un entero decimal de stdin saltando espacios; 0 al final de la entrada o si el token
+/// no es un número (el token se descarta).
+int32_t umbra_read_i32(void);
+
+/// Lee un entero decimal de 64 bits de stdin saltando espacios; mismos casos que umbra_read_i32.
+int64_t umbra_read_i64(void);
+
+/// Lee un número real (admite parte decimal y exponente) de stdin saltando espacios; 0 si el
+/// token no es un número (el token se descarta).
+float umbra_read_f32(void);
+
+/// Igual que umbra_read_f32 pero con precisión double.
+double umbra_read_f64(void);
+
+/// Lee el resto de la línea actual sin el '\n' final; "" al final de la entrada.
+const char* umbra_read_line(void);
+
+/// Cuerpo outlineado de un repeat paralelo: ejecuta las iteraciones [begin, end).
+typedef void (*umbra_rt_parallel_body)(void* ctx, int64_t begin, int64_t end);
+
+/**
+ * @brief Ejecuta body sobre [0, n) repartiendo el rango en el pool de hilos.
+ * @details Retorna cuando todas las iteraciones terminaron. Ver umbra_rt_parallel.c.
+ */
+void umbra_rt_parallel_for(int64_t n, umbra_rt_parallel_body body, void* ctx);
+
+/**
+ * @brief Informa de un acceso fuera de rango detectado por --bounds-check.
+ * @details Vacía la salida pendiente y escribe el mensaje en stderr. El código generado
+ *          ejecuta llvm.trap a continuación.
+ */
+void umbra_rt_report_bounds(int64_t index, uint64_t size, int32_t line, int32_t column);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UMBRA_RT_H
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "umbra/ast/Nodes.h"
+#include "umbra/ast/Visitor.h"
+
+/**
+ * @file ConstEvaluator.h
+ * @brief Intérprete del AST para evaluar funciones `constfunc` durante la compilación.
+ * @details
+ * ConstantFolder lo usa cuando encuentra una llamada a una `constfunc` con todos los
+ * argumentos constantes: la función se ejecuta sobre el AST y la llamada se reemplaza por
+ * el literal resultante. Solo maneja escalares (Int, Long, Float, Double, Bool) y arrays
+ * locales de tamaño fijo; ante cualquier construcción no soportada, o si se superan los
+ * límites de pasos, memoria o profundidad de llamadas, la evaluación se abandona y la
+ * llamada queda para tiempo de ejecución.
+ */
+
+namespace umbra {
+
+    /// Valor escalar conocido en compilación: Int, Long y Bool (0/1) usan integer; Float y Double, floating.
+    struct ConstValue {
+        BuiltinType type;
+        int64_t integer = 0;
+        double floating = 0.0;
+    };
+
+    /// Aplica un operador binario con la semántica del código generado; nullopt si no se puede plegar.
+    std::optional<ConstValue> evalConstBinary(const std::string& op, ConstValue lhs, ConstValue rhs);
+
+    /// Aplica `-` o `not`; nullopt si el operando no es del tipo adecuado.
+    std::optional<ConstValue> evalConstUnary(const std::string& op, ConstValue operand);
+
+    /// Conversión implícita al tipo destino (mismas reglas que isImplicitlyConvertible).
+    std::optional<ConstValue> convertConstValue(ConstValue value, BuiltinType to);
+
+    /// Valor de un NumericLiteral o BooleanLiteral.
+    std::optional<ConstValue> literalConstValue(Expression* expr);
+
+    /**
+     * @class ConstEvaluator
+     * @brief Visitante que interpreta el cuerpo de una `constfunc`.
+     * @details
+     * Cada visit devuelve false si la evaluación debe abandonarse; el valor de la última
+     * expresión evaluada queda en `result`. Las variables viven en un marco plano por llamada,
+     * igual que namedValues en codegen.
+     */
+    class ConstEvaluator : public BaseV<std::unique_ptr, ConstEvaluator, bool> {
+        public:
+            /// Pasos (statements + expresiones) permitidos por evaluación de nivel superior.
+            static constexpr std::size_t MAX_STEPS = 1000000;
+            /// Elementos de array vivos permitidos entre todos los marcos.
+            static constexpr std::size_t MAX_ARRAY_ELEMENTS = 1 << 20;
+            /// Profundidad máxima de llamadas anidadas entre constfunc.
+            static constexpr std::size_t MAX_CALL_DEPTH = 256;
+
+            /// @param functions Funciones `constfunc` del programa indexadas por nombre.
+            explicit ConstEvaluator(const std::unordered_map<std::string, FunctionDefinition*>& functions)
+                : functions(functions) {}
+
+            /**
+             * @brief Evalúa function(args...).
+             * @return El valor devuelto convertido al tipo de retorno, o nullopt si no se pudo evaluar.
+             */
+            std::optional<ConstValue> call(FunctionDefinition* function, const std::vector<ConstValue>& args);
+
+            /// Motivo del último abandono por límites (vacío si no se alcanzó ninguno).
+            const std::string& limitReason() const { return limitHit; }
+
+            bool visitVariableDeclaration(VariableDeclaration* node);
+            bool visitAssignmentStatement(AssignmentStatement* node);
+            bool visitIfStatement(IfStatement* node);
+            bool visitRepeatTimesStatement(RepeatTimesStatement* node);
+            bool visitRepeatIfStatement(RepeatIfStatement* node);
+            bool visitExpressionStatement(ExpressionStatement* node);
+            bool visitReturnExpression(ReturnExpression* node);
+
+            bool visitIdentifier(Identifier* node);
+            bool visitNumericLiteral(NumericLiteral* node);
+            bool visitBooleanLiteral(BooleanLiteral* node);
+            bool visitBinaryExpression(BinaryExpression* node);
+            bool visitUnaryExpression(UnaryExpression* node);
+            bool visitPrimaryExpression(PrimaryExpression* node);
+            bool visitArrayAccessExpression(ArrayAccessExpression* node);
+            bool visitIncrementExpression(IncrementExpression* node);
+            bool visitDecrementExpression(DecrementExpression* node);
+            bool visitFunctionCall(FunctionCall* node);
+
+        private:
+            struct Array {
+                BuiltinType elementType;
+                std::vector<std::size_t> dims;
+                std::vector<ConstValue> elements;
+            };
+
+            struct Frame {
+                std::unordered_map<std::string, ConstValue> scalars;
+                std::unordered_map<std::string, Array> arrays;
+            };
+
+            std::optional<ConstValue> invoke(FunctionDefinition* function, const std::vector<ConstValue>& args);
+            bool execBody(std::vector<std::unique_ptr<Statement>>& body);
+            bool step();
+            bool evalExpression(Expression* expr, ConstValue& out);
+            /// Resuelve un destino asignable a la ranura que almacena su valor.
+            ConstValue* resolveSlot(Expression* target);
+            bool applyStep(Expression* operand, bool isPrefix, const char* op);
+
+            const std::unordered_map<std::string, FunctionDefinition*>& functions;
+            std::vector<Frame> frames;
+            ConstValue result{BuiltinType::None, 0};
+            bool returning = false;
+            std::size_t steps = 0;
+            std::size_t liveElements = 0;
+            std::string limitHit;
+    };
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "umbra/ast/Nodes.h"
+#include "umbra/error/ErrorManager.h"
+#include "umbra/semantic/ConstEvaluator.h"
+
+/**
+ * @file ConstantFolder.h
+ * @brief Plegado de constantes sobre el AST, entre el análisis semántico y la generación de código.
+ * @details
+ * Reemplaza en el AST las subexpresiones cuyo valor se conoce en compilación por literales:
+ * - Aritmética, comparaciones y operadores lógicos entre literales del mismo tipo (o Int/Long,
+ *   Float/Double, que se promueven como en TypeCk).
+ * - Negación aritmética y lógica de literales.
+ * - Lecturas de variables `const` cuyo inicializador se pudo plegar.
+ * - Llamadas a funciones `constfunc` con argumentos constantes, evaluadas con ConstEvaluator.
+ *
+ * Int envuelve a 32 bits como lo hace el código generado; no se pliegan divisiones por cero ni
+ * `MIN / -1`, que quedan para tiempo de ejecución. Los tamaños de array deben plegarse a un
+ * entero positivo; si no, se reporta un error en ErrorManager.
+ */
+
+namespace umbra {
+
+    /**
+     * @class ConstantFolder
+     * @brief Pasada que pliega expresiones constantes y propaga variables `const`.
+     * @details
+     * El entorno de constantes es plano por función, igual que los scopes de SymbolCollector;
+     * las constantes declaradas dentro de un bloque (if, repeat) dejan de propagarse al salir
+     * de él porque el bloque podría no haberse ejecutado.
+     */
+    class ConstantFolder {
+        public:
+            /// @param warnings Destino de los avisos de constfunc que se dejan para tiempo de ejecución
+            explicit ConstantFolder(ErrorManager& errorManager, std::ostream& warnings = std::cerr)
+                : errorManager(errorManager), warnings(warnings) {}
+
+            /// Pliega todas las funciones del programa. No toma propiedad del AST.
+            void fold(ProgramNode* program);
+
+        private:
+            void foldStatements(std::vector<std::unique_ptr<Statement>>& body);
+            void foldBlock(std::vector<std::unique_ptr<Statement>>& body);
+            void foldStatement(Statement* stmt);
+            void foldVariableDeclaration(VariableDeclaration* node);
+
+            /// Pliega la expresión y, si el resultado es constante, sustituye el nodo por un literal.
+            void foldExpression(std::unique_ptr<Expression>& expr);
+            /// Igual que foldExpression pero sin sustituir el identificador base (destinos, ref, ++/--).
+            void foldLValue(std::unique_ptr<Expression>& expr);
+
+            /// Evalúa en compilación una llamada a `constfunc` con todos los argumentos constantes.
+            std::optional<ConstValue> foldConstFuncCall(FunctionCall* call);
+
+            static std::unique_ptr<Expression> makeLiteral(ConstValue c);
+
+            ErrorManager& errorManager;
+            std::ostream& warnings;
+            std::unordered_map<std::string, ConstValue> constants;
+            /// Funciones marcadas `constfunc`, por nombre.
+            std::unordered_map<std::string, FunctionDefinition*> constFunctions;
+    };
+
+}
@@ -70,6 +70,9 @@ namespace umbra {
              */
             void execAnalysisPipeline();
 
+            /// Con false no se exige start() (bibliotecas compiladas con --emit-module).
+            void setRequireEntryPoint(bool required) { collector.requireEntryPoint = required; }
+
         private:
             /// Tabla de símbolos con soporte de scopes (global/local) y firmas de funciones.
             SymbolTable symTable;        // Debe inicializarse primero
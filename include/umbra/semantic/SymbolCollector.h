@@ -71,6 +71,9 @@ namespace umbra {
          */
         void visitProgramNode(ProgramNode* node);
 
+        /// Validar que exista start(); una biblioteca compilada como módulo no lo necesita.
+        bool requireEntryPoint = true;
+
         /**
          * @brief Declara una función en el scope global y procesa su cuerpo (abre/cierra scope).
          */
@@ -120,6 +123,9 @@ namespace umbra {
          */
         bool validateFunctionCall(FunctionCall* node);
 
+        /// print: formato literal con un `{}` por cada argumento que le sigue.
+        bool validatePrintFormat(FunctionCall* node);
+
         /**
          * @brief Valida recursivamente todas las llamadas a función dentro de una expresión.
          * @param expr Expresión a analizar (puede contener llamadas anidadas).
@@ -144,10 +150,39 @@ namespace umbra {
          * @brief Registra símbolos builtin en el scope global (p.ej., print variádica).
          */
         void registerBuiltins();
+        /**
+         * @brief Valida índice, reducciones y cuerpo de un `repeat N times in parallel`.
+         */
+        void visitParallelRepeat(RepeatTimesStatement* node);
+        /**
+         * @brief Valida los builtins SIMD (splat4/splat8, lane, with_lane, hsum/hmin/hmax, select).
+         * @details Su tipo de retorno depende de los argumentos, por eso no tienen firma fija.
+         */
+        bool validateVectorBuiltin(FunctionCall* node);
         /**
          * @brief Valida el punto de entrada del programa (start() -> void/int sin params).
          */
         void validateEntryPoint();
+        /**
+         * @brief Comprueba que la firma de una `constfunc` sea evaluable en compilación.
+         * @details Parámetros y retorno deben ser escalares (Int, Long, Float, Double, Bool) por valor.
+         */
+        void validateConstFuncSignature(FunctionDefinition* node);
+        /**
+         * @brief Valida el paso de arrays (slices) y de argumentos a parámetros `ref T`.
+         * @details Exige arrays con las mismas dimensiones, lvalues no const para `ref` y que
+         *          ninguna variable llegue dos veces por referencia a la misma llamada.
+         */
+        bool validateArgumentPassing(FunctionCall* node, const FunctionSignature& signature,
+                                     const std::vector<SemanticType>& argTypes);
+        /**
+         * @brief Comprueba que el valor asignado a un puntero `ptr T` apunte a un T.
+         */
+        void validatePointerTarget(const std::string& what, SemanticType pointee, Expression* value);
+        /**
+         * @brief Inserta un símbolo en el scope actual; una redefinición se reporta en symbol.location.
+         */
+        void declare(const std::string& name, const Symbol& symbol);
 
         /// Nodo raíz del programa.
         ProgramNode* rootASTNode;
@@ -159,6 +194,8 @@ namespace umbra {
         TypeCk typeCk;
         /// Gestor de errores para reportar problemas semánticos.
         ErrorManager& errorManager;
+        /// Nombre de la `constfunc` cuyo cuerpo se está visitando (vacío fuera de ellas).
+        std::string currentConstFunc;
 
    };
 
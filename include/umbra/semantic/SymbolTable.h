@@ -5,6 +5,7 @@
 #include"umbra/semantic/SemanticType.h"
 #include<string>
 #include<unordered_map>
+#include"umbra/io/SourceLocation.h"
 
 /**
  * @file SymbolTable.h
@@ -38,11 +39,19 @@ namespace umbra{
      * @param isVarArg Indica si la función acepta número variable de argumentos.
      * @param returnType Tipo de retorno semántico.
      * @param argTypes Tipos de los parámetros formales en orden.
+     * @param isConstFunc Función declarada con `constfunc` (evaluable en compilación).
+     * @param argArrayDims Dimensiones de cada parámetro array (0 si es escalar); vacío en builtins.
+     * @param argByReference Parámetros `ref T`: el argumento debe ser una variable o elemento de array.
+     * @param argPointeeTypes Tipo apuntado por cada parámetro `ptr T` (None en el resto).
      */
     struct FunctionSignature {
         bool isVarArg = false;
         SemanticType returnType;
         std::vector<SemanticType> argTypes;
+        bool isConstFunc = false;
+        std::vector<int> argArrayDims = {};
+        std::vector<bool> argByReference = {};
+        std::vector<SemanticType> argPointeeTypes = {};
     };
 
     /**
@@ -51,15 +60,19 @@ namespace umbra{
      * @param type Tipo semántico principal (para variables) o redundante al retorno en funciones.
      * @param kind Clase del símbolo (variable/función).
      * @param signature Firma de función si aplica (vacía en variables).
-     * @param line Línea de declaración (si se dispone).
-     * @param col Columna de declaración (si se dispone).
+     * @param location Ubicación de la declaración (inválida en builtins).
+     * @param isConst Variable declarada con `const` (no admite asignaciones).
+     * @param arrayDimensions Dimensiones si la variable es un array (0 si es escalar).
+     * @param pointeeType Tipo apuntado por una variable `ptr T` (None si no es un puntero).
      */
     struct Symbol{
         SemanticType type;
         SymbolKind kind;
         FunctionSignature signature;
-        int line;
-        int col;
+        SourceLocation location;
+        bool isConst = false;
+        int arrayDimensions = 0;
+        SemanticType pointeeType = SemanticType::None;
     };
 
     /**
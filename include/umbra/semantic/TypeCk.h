@@ -32,6 +32,10 @@ namespace umbra {
 
         SemanticType visitStringLiteral(StringLiteral* node);
 
+        SemanticType visitBooleanLiteral(BooleanLiteral* node);
+
+        SemanticType visitCharLiteral(CharLiteral* node);
+
         SemanticType visitPrimaryExpression(PrimaryExpression* node);
 
         SemanticType visitFunctionCall(FunctionCall* node);
@@ -46,7 +50,16 @@ namespace umbra {
         
         SemanticType visitUnaryExpression(UnaryExpression* node);
 
+        /**
+         * @brief Tipo apuntado por una expresión puntero: `p` declarado `ptr T` o `ref x`.
+         * @return None si la expresión no tiene un tipo apuntado conocido.
+         */
+        SemanticType pointeeType(Expression* expr);
+
         private:
+        /// Reglas de operadores con vectores SIMD (element-wise, escalar se expande a todos los lanes).
+        SemanticType vectorBinaryType(BinaryExpression* node, SemanticType lType, SemanticType rType);
+
         SemanticContext ctxt;
         ErrorManager* errorManager;
 
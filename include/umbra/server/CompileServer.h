@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace umbra {
+
+/**
+ * @file CompileServer.h
+ * @brief Servidor de `umbra --daemon`: atiende a umbra-client por un socket Unix.
+ * @details
+ * Cada conexión es una compilación y la atiende un hilo del pool. El handler recibe dos
+ * std::ostream propios de la petición cuyo contenido se envía al cliente (frames Stdout/Stderr de
+ * DaemonProtocol); la compilación no debe escribir en std::cout ni std::cerr, que comparten
+ * todos los hilos (también su estado de formato). Las compilaciones comparten lo que
+ * el proceso ya tiene en memoria: SourceCache (fuentes incluidas e interfaces .umi) y los
+ * targets de LLVM con la CPU del host (Compiler::initializeTargets).
+ *
+ * Solo se aceptan conexiones del mismo usuario que ejecuta el daemon.
+ */
+class CompileServer {
+public:
+    /// Compila con los argumentos del cliente, relativos a su directorio, escribiendo en out/err; devuelve el código de salida.
+    using Handler = std::function<int(const std::vector<std::string>& arguments, const std::string& workingDirectory,
+                                      std::ostream& out, std::ostream& err)>;
+
+    CompileServer(std::string socketPath, unsigned threads, Handler handler);
+
+    /**
+     * @brief Escucha hasta recibir SIGINT o SIGTERM; las compilaciones en curso terminan antes de salir.
+     * @return false (con el motivo en error) si no se pudo abrir el socket.
+     */
+    bool run(std::string& error);
+
+private:
+    std::string socketPath;
+    unsigned threads;
+    Handler handler;
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<int> pending; ///< Conexiones aceptadas que esperan un hilo
+    bool stopping = false;
+
+    int listen(std::string& error);
+    void work();
+    void serve(int fd);
+};
+
+} // namespace umbra
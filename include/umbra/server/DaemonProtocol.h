@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace umbra {
+
+/**
+ * @file DaemonProtocol.h
+ * @brief Mensajes entre `umbra --daemon` y umbra-client por un socket Unix.
+ * @details
+ * Todo mensaje es un frame: tipo (1 byte), longitud de los datos (u32 little endian) y datos.
+ * - El cliente abre una conexión por compilación y envía un Request: versión del protocolo,
+ *   directorio de trabajo y argumentos de la línea de comandos (strings de BinaryWriter).
+ * - El daemon responde con frames Stdout y Stderr a medida que la compilación escribe y
+ *   termina con Exit, cuyo dato es el código de salida (un byte).
+ */
+struct DaemonProtocol {
+    static constexpr uint32_t Version = 1;
+    static constexpr uint32_t MaxRequestSize = 1 << 20;
+
+    enum class Frame : uint8_t { Request = 1, Stdout = 2, Stderr = 3, Exit = 4 };
+
+    struct Request {
+        std::string workingDirectory;
+        std::vector<std::string> arguments; ///< Sin argv[0]
+    };
+
+    /// $UMBRA_SOCKET, o umbra.sock en $XDG_RUNTIME_DIR, o /tmp/umbra-<uid>.sock.
+    static std::string defaultSocketPath();
+
+    /// Descriptor conectado al daemon, o -1 (con el motivo en error) si no hay uno escuchando.
+    static int connect(const std::string& socketPath, std::string& error);
+
+    /// Escribe un frame completo; false si la conexión se cerró.
+    static bool writeFrame(int fd, Frame type, std::string_view data);
+
+    /// Lee un frame completo; false si la conexión se cerró o supera maxSize.
+    static bool readFrame(int fd, Frame& type, std::string& data, uint32_t maxSize = UINT32_MAX);
+
+    static std::string encodeRequest(const Request& request);
+
+    /// false (con el motivo en error) si los datos están truncados o son de otra versión.
+    static bool decodeRequest(std::string_view data, Request& request, std::string& error);
+};
+
+} // namespace umbra
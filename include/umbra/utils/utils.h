@@ -25,6 +25,86 @@ namespace umbra {
         }
     }
 
+    /// Enteros escalares: int (32 bits) y long (64 bits).
+    inline constexpr bool isIntegerType(SemanticType sType){
+        return sType == SemanticType::Int || sType == SemanticType::Long;
+    }
+
+    /// Reales escalares: float (32 bits) y double (64 bits).
+    inline constexpr bool isFloatingType(SemanticType sType){
+        return sType == SemanticType::Float || sType == SemanticType::Double;
+    }
+
+    /**
+     * @brief Tipo común de dos operandos numéricos.
+     * @details Solo se ensancha dentro de la misma familia: Int -> Long y Float -> Double.
+     *          Enteros y reales no se mezclan implícitamente; en ese caso devuelve Error.
+     */
+    inline constexpr SemanticType promoteNumeric(SemanticType a, SemanticType b){
+        if(a == b) return a;
+        if(isIntegerType(a) && isIntegerType(b)) return SemanticType::Long;
+        if(isFloatingType(a) && isFloatingType(b)) return SemanticType::Double;
+        return SemanticType::Error;
+    }
+
+    /// Un valor de tipo from puede asignarse/pasarse donde se espera to (igual o ensanchamiento).
+    inline constexpr bool isImplicitlyConvertible(SemanticType from, SemanticType to){
+        return from == to || promoteNumeric(from, to) == to;
+    }
+
+    /**
+     * @brief Tipos vectoriales SIMD de ancho fijo (vec4/vec8 de int o float).
+     * @details Se representan como entradas planas de SemanticType; estas funciones
+     *          los descomponen en tipo de elemento y número de lanes.
+     */
+    inline constexpr bool isVectorType(SemanticType sType){
+        switch(sType){
+            case SemanticType::Vec4Float:
+            case SemanticType::Vec8Float:
+            case SemanticType::Vec4Int:
+            case SemanticType::Vec8Int:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /// Tipo de cada lane (Int o Float); Error si no es un tipo vectorial.
+    inline constexpr SemanticType vectorElementType(SemanticType sType){
+        switch(sType){
+            case SemanticType::Vec4Float:
+            case SemanticType::Vec8Float: return SemanticType::Float;
+            case SemanticType::Vec4Int:
+            case SemanticType::Vec8Int: return SemanticType::Int;
+            default: return SemanticType::Error;
+        }
+    }
+
+    /// Número de lanes; 0 si no es un tipo vectorial.
+    inline constexpr unsigned vectorLaneCount(SemanticType sType){
+        switch(sType){
+            case SemanticType::Vec4Float:
+            case SemanticType::Vec4Int: return 4;
+            case SemanticType::Vec8Float:
+            case SemanticType::Vec8Int: return 8;
+            default: return 0;
+        }
+    }
+
+    /// Vector de `lanes` elementos de tipo elem; Error si la combinación no existe.
+    inline constexpr SemanticType makeVectorType(SemanticType elem, unsigned lanes){
+        if(elem == SemanticType::Float && lanes == 4) return SemanticType::Vec4Float;
+        if(elem == SemanticType::Float && lanes == 8) return SemanticType::Vec8Float;
+        if(elem == SemanticType::Int && lanes == 4) return SemanticType::Vec4Int;
+        if(elem == SemanticType::Int && lanes == 8) return SemanticType::Vec8Int;
+        return SemanticType::Error;
+    }
+
+    /// Tipo resultado de comparar dos vectores: vector de Int (1/0 por lane) con los mismos lanes.
+    inline constexpr SemanticType vectorMaskType(SemanticType sType){
+        return makeVectorType(SemanticType::Int, vectorLaneCount(sType));
+    }
+
     inline std::string semanticTypeToString(SemanticType sType){
         switch(sType){
             case SemanticType::None: return "None";
@@ -42,6 +122,11 @@ namespace umbra {
             case SemanticType::Error: return "Error";
             case SemanticType::Ptr: return "Ptr";
             case SemanticType::Ref: return "Ref";
+            case SemanticType::Long: return "Long";
+            case SemanticType::Vec4Float: return "vec4 float";
+            case SemanticType::Vec8Float: return "vec8 float";
+            case SemanticType::Vec4Int: return "vec4 int";
+            case SemanticType::Vec8Int: return "vec8 int";
             default: return "Unknown";
         }
     }
@@ -0,0 +1,736 @@
+#include "umbra/ast/ASTSerializer.h"
+#include "umbra/io/AtomicFile.h"
+#include "umbra/io/BinaryStream.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+
+namespace umbra {
+
+namespace {
+
+constexpr std::string_view kMagic = "UMBA";
+
+constexpr unsigned kTypeCount = 0
+    #define X(T) + 1
+    #include "umbra/utils/builtin_types.def"
+    #undef X
+    ;
+
+constexpr unsigned kNodeKindCount = static_cast<unsigned>(NodeKind::STRING_LITERAL) + 1;
+
+// Límite de cordura para listas leídas del archivo: evita reservar memoria por un tamaño corrupto
+constexpr uint64_t kMaxEntries = 1u << 24;
+
+/**
+ * Escribe los nodos en postorden: cada write* emite primero los hijos (obteniendo sus
+ * referencias) y después el registro del propio nodo.
+ */
+class Encoder {
+public:
+    std::string finish(const ProgramNode& program, uint64_t sourceHash) {
+        write(&program); // El ProgramNode queda como último nodo del pool
+
+        BinaryWriter out;
+        out.writeBytes(kMagic);
+        out.writeVarint(ASTSerializer::FormatVersion);
+        out.writeU64(sourceHash);
+        out.writeVarint(strings.size());
+        for (const std::string* value : strings) {
+            out.writeString(*value);
+        }
+        out.writeVarint(nodeCount);
+        out.writeBytes(nodes.buffer());
+        return out.buffer();
+    }
+
+private:
+    BinaryWriter nodes;
+    uint64_t nodeCount = 0;
+    std::unordered_map<std::string, uint64_t> stringIndex;
+    std::vector<const std::string*> strings;
+
+    uint64_t string(const std::string& value) {
+        auto [it, inserted] = stringIndex.emplace(value, strings.size());
+        if (inserted) strings.push_back(&it->first);
+        return it->second;
+    }
+
+    void type(SemanticType value) { nodes.writeU8(static_cast<uint8_t>(value)); }
+    void type(BuiltinType value) { nodes.writeU8(static_cast<uint8_t>(value)); }
+
+    void signature(const FunctionSignature& signature) {
+        type(signature.returnType);
+        nodes.writeU8((signature.isVarArg ? 1 : 0) | (signature.isConstFunc ? 2 : 0));
+        nodes.writeVarint(signature.argTypes.size());
+        for (size_t i = 0; i < signature.argTypes.size(); ++i) {
+            type(signature.argTypes[i]);
+            nodes.writeVarint(i < signature.argArrayDims.size() ? signature.argArrayDims[i] : 0);
+            nodes.writeU8(i < signature.argByReference.size() && signature.argByReference[i] ? 1 : 0);
+            type(i < signature.argPointeeTypes.size() ? signature.argPointeeTypes[i] : SemanticType::None);
+        }
+    }
+
+    // Cabecera común del registro; devuelve la referencia (índice + 1) del nodo
+    uint64_t begin(const ASTNode* node) {
+        nodes.writeVarint(static_cast<uint64_t>(node->getKind()));
+        // InvalidOffset + 1 da 0: las ubicaciones inválidas ocupan un byte
+        nodes.writeVarint(static_cast<uint32_t>(node->location.offset + 1));
+        type(node->semaT);
+        return ++nodeCount;
+    }
+
+    template<typename Node>
+    std::vector<uint64_t> writeAll(const std::vector<std::unique_ptr<Node>>& list) {
+        std::vector<uint64_t> refs;
+        refs.reserve(list.size());
+        for (const auto& node : list) refs.push_back(write(node.get()));
+        return refs;
+    }
+
+    void refs(const std::vector<uint64_t>& list) {
+        nodes.writeVarint(list.size());
+        for (uint64_t ref : list) nodes.writeVarint(ref);
+    }
+
+    uint64_t write(const ASTNode* node) {
+        if (!node) return 0;
+
+        switch (node->getKind()) {
+            case NodeKind::PROGRAM: {
+                auto* program = static_cast<const ProgramNode*>(node);
+                std::vector<uint64_t> functions = writeAll(program->functions);
+                uint64_t ref = begin(node);
+                refs(functions);
+                return ref;
+            }
+            case NodeKind::FUNCTION_DEFINITION: {
+                auto* function = static_cast<const FunctionDefinition*>(node);
+                uint64_t name = write(function->name.get());
+                uint64_t parameters = write(function->parameters.get());
+                uint64_t returnType = write(function->returnType.get());
+                std::vector<uint64_t> body = writeAll(function->body);
+                uint64_t ref = begin(node);
+                nodes.writeVarint(name);
+                nodes.writeVarint(parameters);
+                nodes.writeVarint(returnType);
+                refs(body);
+                nodes.writeU8((function->isConstFunc ? 1 : 0) | (function->isImported ? 2 : 0));
+                nodes.writeU8(static_cast<uint8_t>(function->inlineHint));
+                signature(function->Signature);
+                return ref;
+            }
+            case NodeKind::PARAMETER_LIST: {
+                auto* list = static_cast<const ParameterList*>(node);
+                std::vector<std::pair<uint64_t, uint64_t>> parameters;
+                for (const auto& [paramType, paramName] : list->parameters) {
+                    uint64_t typeRef = write(paramType.get());
+                    parameters.emplace_back(typeRef, write(paramName.get()));
+                }
+                uint64_t ref = begin(node);
+                nodes.writeVarint(parameters.size());
+                for (const auto& [typeRef, nameRef] : parameters) {
+                    nodes.writeVarint(typeRef);
+                    nodes.writeVarint(nameRef);
+                }
+                return ref;
+            }
+            case NodeKind::TYPE: {
+                auto* typeNode = static_cast<const Type*>(node);
+                std::vector<uint64_t> sizes = writeAll(typeNode->arraySizes);
+                uint64_t base = write(typeNode->baseType.get());
+                uint64_t ref = begin(node);
+                type(typeNode->builtinType);
+                nodes.writeVarint(typeNode->arrayDimensions);
+                refs(sizes);
+                nodes.writeVarint(base);
+                nodes.writeU8((typeNode->isPointer ? 1 : 0) | (typeNode->isReference ? 2 : 0));
+                return ref;
+            }
+            case NodeKind::VARIABLE_DECLARATION: {
+                auto* declaration = static_cast<const VariableDeclaration*>(node);
+                uint64_t typeRef = write(declaration->type.get());
+                uint64_t name = write(declaration->name.get());
+                uint64_t initializer = write(declaration->initializer.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(typeRef);
+                nodes.writeVarint(name);
+                nodes.writeVarint(initializer);
+                nodes.writeU8(declaration->isConst ? 1 : 0);
+                return ref;
+            }
+            case NodeKind::ASSIGNMENT_STATEMENT: {
+                auto* assignment = static_cast<const AssignmentStatement*>(node);
+                uint64_t target = write(assignment->target.get());
+                uint64_t value = write(assignment->value.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(target);
+                nodes.writeVarint(value);
+                return ref;
+            }
+            case NodeKind::IF_STATEMENT: {
+                auto* ifStatement = static_cast<const IfStatement*>(node);
+                std::vector<std::pair<uint64_t, std::vector<uint64_t>>> branches;
+                for (const Branch& branch : ifStatement->branches) {
+                    uint64_t condition = write(branch.condition.get());
+                    branches.emplace_back(condition, writeAll(branch.body));
+                }
+                std::vector<uint64_t> elseBranch = writeAll(ifStatement->elseBranch);
+                uint64_t ref = begin(node);
+                nodes.writeVarint(branches.size());
+                for (const auto& [condition, body] : branches) {
+                    nodes.writeVarint(condition);
+                    refs(body);
+                }
+                refs(elseBranch);
+                return ref;
+            }
+            case NodeKind::REPEAT_TIMES_STATEMENT: {
+                auto* repeat = static_cast<const RepeatTimesStatement*>(node);
+                uint64_t times = write(repeat->times.get());
+                std::vector<uint64_t> body = writeAll(repeat->body);
+                uint64_t indexVar = write(repeat->indexVar.get());
+                std::vector<uint64_t> targets;
+                for (const Reduction& reduction : repeat->reductions) targets.push_back(write(reduction.target.get()));
+                uint64_t ref = begin(node);
+                nodes.writeVarint(times);
+                refs(body);
+                nodes.writeU8(repeat->parallel ? 1 : 0);
+                nodes.writeVarint(indexVar);
+                nodes.writeVarint(targets.size());
+                for (size_t i = 0; i < targets.size(); ++i) {
+                    nodes.writeVarint(string(repeat->reductions[i].op));
+                    nodes.writeVarint(targets[i]);
+                }
+                return ref;
+            }
+            case NodeKind::REPEAT_IF_STATEMENT: {
+                auto* repeat = static_cast<const RepeatIfStatement*>(node);
+                uint64_t condition = write(repeat->condition.get());
+                std::vector<uint64_t> body = writeAll(repeat->body);
+                uint64_t ref = begin(node);
+                nodes.writeVarint(condition);
+                refs(body);
+                return ref;
+            }
+            case NodeKind::EXPRESSION_STATEMENT: {
+                uint64_t exp = write(static_cast<const ExpressionStatement*>(node)->exp.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(exp);
+                return ref;
+            }
+            case NodeKind::MEMORY_MANAGEMENT: {
+                auto* memory = static_cast<const MemoryManagement*>(node);
+                uint64_t typeRef = write(memory->type.get());
+                uint64_t size = write(memory->size.get());
+                uint64_t target = write(memory->target.get());
+                uint64_t ref = begin(node);
+                nodes.writeU8(static_cast<uint8_t>(memory->action));
+                nodes.writeVarint(typeRef);
+                nodes.writeVarint(size);
+                nodes.writeVarint(target);
+                return ref;
+            }
+            case NodeKind::IDENTIFIER: {
+                uint64_t ref = begin(node);
+                nodes.writeVarint(string(static_cast<const Identifier*>(node)->name));
+                return ref;
+            }
+            case NodeKind::BINARY_EXPRESSION: {
+                auto* binary = static_cast<const BinaryExpression*>(node);
+                uint64_t left = write(binary->left.get());
+                uint64_t right = write(binary->right.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(string(binary->op));
+                nodes.writeVarint(left);
+                nodes.writeVarint(right);
+                return ref;
+            }
+            case NodeKind::UNARY_EXPRESSION: {
+                auto* unary = static_cast<const UnaryExpression*>(node);
+                uint64_t operand = write(unary->operand.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(string(unary->op));
+                nodes.writeVarint(operand);
+                return ref;
+            }
+            case NodeKind::INCREMENT_EXPRESSION:
+            case NodeKind::DECREMENT_EXPRESSION: {
+                bool isIncrement = node->getKind() == NodeKind::INCREMENT_EXPRESSION;
+                const Expression* operandNode = isIncrement ? static_cast<const IncrementExpression*>(node)->operand.get()
+                                                            : static_cast<const DecrementExpression*>(node)->operand.get();
+                bool isPrefix = isIncrement ? static_cast<const IncrementExpression*>(node)->isPrefix
+                                            : static_cast<const DecrementExpression*>(node)->isPrefix;
+                uint64_t operand = write(operandNode);
+                uint64_t ref = begin(node);
+                nodes.writeVarint(operand);
+                nodes.writeU8(isPrefix ? 1 : 0);
+                return ref;
+            }
+            case NodeKind::PRIMARY_EXPRESSION: {
+                auto* primary = static_cast<const PrimaryExpression*>(node);
+                const ASTNode* inner = nullptr;
+                switch (primary->exprType) {
+                    case PrimaryExpression::IDENTIFIER:         inner = primary->identifier.get(); break;
+                    case PrimaryExpression::LITERAL:            inner = primary->literal.get(); break;
+                    case PrimaryExpression::EXPRESSION_CALL:    inner = primary->functionCall.get(); break;
+                    case PrimaryExpression::PARENTHESIZED:      inner = primary->parenthesized.get(); break;
+                    case PrimaryExpression::ARRAY_ACCESS:       inner = primary->arrayAccess.get(); break;
+                    case PrimaryExpression::MEMBER_ACCESS:      inner = primary->memberAccess.get(); break;
+                    case PrimaryExpression::CAST_EXPRESSION:    inner = primary->castExpression.get(); break;
+                    case PrimaryExpression::TERNARY_EXPRESSION: inner = primary->ternaryExpression.get(); break;
+                }
+                uint64_t innerRef = write(inner);
+                uint64_t ref = begin(node);
+                nodes.writeU8(static_cast<uint8_t>(primary->exprType));
+                nodes.writeVarint(innerRef);
+                return ref;
+            }
+            case NodeKind::FUNCTION_CALL: {
+                auto* call = static_cast<const FunctionCall*>(node);
+                uint64_t name = write(call->functionName.get());
+                std::vector<uint64_t> arguments = writeAll(call->arguments);
+                uint64_t ref = begin(node);
+                nodes.writeVarint(name);
+                refs(arguments);
+                nodes.writeVarint(call->argTypes.size());
+                for (SemanticType argType : call->argTypes) type(argType);
+                return ref;
+            }
+            case NodeKind::RETURN_EXPRESSION: {
+                uint64_t value = write(static_cast<const ReturnExpression*>(node)->returnValue.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(value);
+                return ref;
+            }
+            case NodeKind::ARRAY_ACCESS_EXPRESSION: {
+                auto* access = static_cast<const ArrayAccessExpression*>(node);
+                uint64_t array = write(access->array.get());
+                uint64_t index = write(access->index.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(array);
+                nodes.writeVarint(index);
+                return ref;
+            }
+            case NodeKind::TERNARY_EXPRESSION: {
+                auto* ternary = static_cast<const TernaryExpression*>(node);
+                uint64_t condition = write(ternary->condition.get());
+                uint64_t trueExpr = write(ternary->trueExpr.get());
+                uint64_t falseExpr = write(ternary->falseExpr.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(condition);
+                nodes.writeVarint(trueExpr);
+                nodes.writeVarint(falseExpr);
+                return ref;
+            }
+            case NodeKind::CAST_EXPRESSION: {
+                auto* cast = static_cast<const CastExpression*>(node);
+                uint64_t targetType = write(cast->targetType.get());
+                uint64_t expression = write(cast->expression.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(targetType);
+                nodes.writeVarint(expression);
+                return ref;
+            }
+            case NodeKind::MEMBER_ACCESS_EXPRESSION: {
+                auto* access = static_cast<const MemberAccessExpression*>(node);
+                uint64_t object = write(access->object.get());
+                uint64_t member = write(access->member.get());
+                uint64_t ref = begin(node);
+                nodes.writeVarint(object);
+                nodes.writeVarint(member);
+                return ref;
+            }
+            case NodeKind::NUMERIC_LITERAL: {
+                auto* literal = static_cast<const NumericLiteral*>(node);
+                uint64_t ref = begin(node);
+                type(literal->builtinType);
+                // Los enteros se escriben tal cual; los flotantes, con los bits del double
+                uint64_t bits = static_cast<uint64_t>(literal->intValue);
+                if (literal->isFloating()) std::memcpy(&bits, &literal->floatValue, sizeof bits);
+                nodes.writeU64(bits);
+                return ref;
+            }
+            case NodeKind::BOOLEAN_LITERAL: {
+                uint64_t ref = begin(node);
+                nodes.writeU8(static_cast<const BooleanLiteral*>(node)->value ? 1 : 0);
+                return ref;
+            }
+            case NodeKind::CHAR_LITERAL: {
+                uint64_t ref = begin(node);
+                nodes.writeU8(static_cast<uint8_t>(static_cast<const CharLiteral*>(node)->value));
+                return ref;
+            }
+            case NodeKind::STRING_LITERAL: {
+                uint64_t ref = begin(node);
+                nodes.writeVarint(string(static_cast<const StringLiteral*>(node)->value));
+                return ref;
+            }
+            case NodeKind::LITERAL: {
+                uint64_t ref = begin(node);
+                type(static_cast<const Literal*>(node)->builtinType);
+                return ref;
+            }
+            default:
+                // PARENTHESIZED solo existe como PrimaryExpression::exprType
+                throw std::logic_error(std::string("ASTSerializer: unexpected node ") + node->getNodeTypeName());
+        }
+    }
+};
+
+/**
+ * Lee el pool en orden: cada registro toma (take) de pool los hijos que ya se leyeron. Un
+ * hijo solo puede tomarse una vez y con la clase esperada; cualquier otra cosa es un archivo
+ * corrupto.
+ */
+class Decoder {
+public:
+    explicit Decoder(BinaryReader& in) : in(in) {}
+
+    bool readStrings() {
+        uint64_t count = readCount();
+        for (uint64_t i = 0; i < count && in.ok(); ++i) strings.push_back(in.readString());
+        return in.ok();
+    }
+
+    std::unique_ptr<ProgramNode> readNodes() {
+        uint64_t count = readCount();
+        pool.reserve(count);
+        for (uint64_t i = 0; i < count && in.ok(); ++i) {
+            std::unique_ptr<ASTNode> node = readNode();
+            if (!node) in.fail();
+            pool.push_back(std::move(node));
+        }
+        if (!in.ok() || pool.empty() || taken != pool.size() - 1) return nullptr;
+        return take<ProgramNode>(pool.size());
+    }
+
+private:
+    BinaryReader& in;
+    std::vector<std::string> strings;
+    std::vector<std::unique_ptr<ASTNode>> pool;
+    size_t taken = 0;
+
+    uint64_t readCount() {
+        uint64_t count = in.readVarint();
+        if (count > kMaxEntries) {
+            in.fail();
+            return 0;
+        }
+        return count;
+    }
+
+    const std::string& string() {
+        static const std::string empty;
+        uint64_t index = in.readVarint();
+        if (index >= strings.size()) {
+            in.fail();
+            return empty;
+        }
+        return strings[index];
+    }
+
+    template<typename Enum>
+    Enum readEnum(unsigned count) {
+        uint8_t value = in.readU8();
+        if (value >= count) {
+            in.fail();
+            return Enum{};
+        }
+        return static_cast<Enum>(value);
+    }
+
+    SemanticType semanticType() { return readEnum<SemanticType>(kTypeCount); }
+    BuiltinType builtinType() { return readEnum<BuiltinType>(kTypeCount); }
+
+    template<typename Node>
+    std::unique_ptr<Node> take(uint64_t ref) {
+        if (ref == 0 || !in.ok()) return nullptr;
+        if (ref > pool.size() || !pool[ref - 1] || !dynamic_cast<Node*>(pool[ref - 1].get())) {
+            in.fail();
+            return nullptr;
+        }
+        ++taken;
+        return std::unique_ptr<Node>(static_cast<Node*>(pool[ref - 1].release()));
+    }
+
+    template<typename Node>
+    std::unique_ptr<Node> child() { return take<Node>(in.readVarint()); }
+
+    template<typename Node>
+    std::vector<std::unique_ptr<Node>> children() {
+        std::vector<std::unique_ptr<Node>> list;
+        uint64_t count = readCount();
+        for (uint64_t i = 0; i < count && in.ok(); ++i) list.push_back(child<Node>());
+        return list;
+    }
+
+    FunctionSignature signature() {
+        FunctionSignature signature;
+        signature.returnType = semanticType();
+        uint8_t flags = in.readU8();
+        signature.isVarArg = flags & 1;
+        signature.isConstFunc = flags & 2;
+        uint64_t argCount = readCount();
+        for (uint64_t i = 0; i < argCount && in.ok(); ++i) {
+            signature.argTypes.push_back(semanticType());
+            signature.argArrayDims.push_back(static_cast<int>(in.readVarint()));
+            signature.argByReference.push_back(in.readU8() != 0);
+            signature.argPointeeTypes.push_back(semanticType());
+        }
+        return signature;
+    }
+
+    std::unique_ptr<ASTNode> readNode() {
+        uint64_t kindValue = in.readVarint();
+        if (kindValue >= kNodeKindCount) {
+            in.fail();
+            return nullptr;
+        }
+        NodeKind kind = static_cast<NodeKind>(kindValue);
+        SourceLocation location(static_cast<uint32_t>(in.readVarint() - 1));
+        SemanticType semaT = semanticType();
+
+        std::unique_ptr<ASTNode> node = readPayload(kind);
+        if (!node || !in.ok()) return nullptr;
+        node->location = location;
+        node->semaT = semaT;
+        return node;
+    }
+
+    std::unique_ptr<ASTNode> readPayload(NodeKind kind) {
+        switch (kind) {
+            case NodeKind::PROGRAM:
+                return std::make_unique<ProgramNode>(children<FunctionDefinition>());
+            case NodeKind::FUNCTION_DEFINITION: {
+                auto name = child<Identifier>();
+                auto parameters = child<ParameterList>();
+                auto returnType = child<Type>();
+                auto body = children<Statement>();
+                auto function = std::make_unique<FunctionDefinition>(std::move(name), std::move(parameters),
+                                                                     std::move(returnType), std::move(body));
+                uint8_t flags = in.readU8();
+                function->isConstFunc = flags & 1;
+                function->isImported = flags & 2;
+                function->inlineHint = readEnum<InlineHint>(3);
+                function->Signature = signature();
+                return function;
+            }
+            case NodeKind::PARAMETER_LIST: {
+                std::vector<std::pair<std::unique_ptr<Type>, std::unique_ptr<Identifier>>> parameters;
+                uint64_t count = readCount();
+                for (uint64_t i = 0; i < count && in.ok(); ++i) {
+                    auto paramType = child<Type>();
+                    parameters.emplace_back(std::move(paramType), child<Identifier>());
+                }
+                return std::make_unique<ParameterList>(std::move(parameters));
+            }
+            case NodeKind::TYPE: {
+                BuiltinType builtin = builtinType();
+                int dimensions = static_cast<int>(in.readVarint());
+                auto sizes = children<Expression>();
+                auto base = child<Type>();
+                uint8_t flags = in.readU8();
+                auto typeNode = std::make_unique<Type>(builtin, dimensions, std::move(sizes));
+                typeNode->baseType = std::move(base);
+                typeNode->isPointer = flags & 1;
+                typeNode->isReference = flags & 2;
+                return typeNode;
+            }
+            case NodeKind::VARIABLE_DECLARATION: {
+                auto typeNode = child<Type>();
+                auto name = child<Identifier>();
+                auto initializer = child<Expression>();
+                auto declaration = std::make_unique<VariableDeclaration>(std::move(typeNode), std::move(name),
+                                                                         std::move(initializer));
+                declaration->isConst = in.readU8() != 0;
+                return declaration;
+            }
+            case NodeKind::ASSIGNMENT_STATEMENT: {
+                auto target = child<Expression>();
+                return std::make_unique<AssignmentStatement>(std::move(target), child<Expression>());
+            }
+            case NodeKind::IF_STATEMENT: {
+                std::vector<Branch> branches;
+                uint64_t count = readCount();
+                for (uint64_t i = 0; i < count && in.ok(); ++i) {
+                    Branch branch;
+                    branch.condition = child<Expression>();
+                    branch.body = children<Statement>();
+                    branches.push_back(std::move(branch));
+                }
+                return std::make_unique<IfStatement>(std::move(branches), children<Statement>());
+            }
+            case NodeKind::REPEAT_TIMES_STATEMENT: {
+                auto times = child<Expression>();
+                auto repeat = std::make_unique<RepeatTimesStatement>(std::move(times), children<Statement>());
+                repeat->parallel = in.readU8() != 0;
+                repeat->indexVar = child<Identifier>();
+                uint64_t count = readCount();
+                for (uint64_t i = 0; i < count && in.ok(); ++i) {
+                    Reduction reduction;
+                    reduction.op = string();
+                    reduction.target = child<Identifier>();
+                    repeat->reductions.push_back(std::move(reduction));
+                }
+                return repeat;
+            }
+            case NodeKind::REPEAT_IF_STATEMENT: {
+                auto condition = child<Expression>();
+                return std::make_unique<RepeatIfStatement>(std::move(condition), children<Statement>());
+            }
+            case NodeKind::EXPRESSION_STATEMENT:
+                return std::make_unique<ExpressionStatement>(child<Expression>());
+            case NodeKind::MEMORY_MANAGEMENT: {
+                auto action = readEnum<MemoryManagement::ActionType>(2);
+                auto typeNode = child<Type>();
+                auto size = child<Expression>();
+                return std::make_unique<MemoryManagement>(action, std::move(typeNode), std::move(size), child<Identifier>());
+            }
+            case NodeKind::IDENTIFIER:
+                return std::make_unique<Identifier>(string());
+            case NodeKind::BINARY_EXPRESSION: {
+                std::string op = string();
+                auto left = child<Expression>();
+                return std::make_unique<BinaryExpression>(std::move(op), std::move(left), child<Expression>());
+            }
+            case NodeKind::UNARY_EXPRESSION: {
+                std::string op = string();
+                return std::make_unique<UnaryExpression>(std::move(op), child<Expression>());
+            }
+            case NodeKind::INCREMENT_EXPRESSION: {
+                auto operand = child<Expression>();
+                return std::make_unique<IncrementExpression>(std::move(operand), in.readU8() != 0);
+            }
+            case NodeKind::DECREMENT_EXPRESSION: {
+                auto operand = child<Expression>();
+                return std::make_unique<DecrementExpression>(std::move(operand), in.readU8() != 0);
+            }
+            case NodeKind::PRIMARY_EXPRESSION: {
+                auto exprType = readEnum<PrimaryExpression::Type>(PrimaryExpression::TERNARY_EXPRESSION + 1);
+                switch (exprType) {
+                    case PrimaryExpression::IDENTIFIER:         return std::make_unique<PrimaryExpression>(child<Identifier>());
+                    case PrimaryExpression::LITERAL:            return std::make_unique<PrimaryExpression>(child<Literal>());
+                    case PrimaryExpression::EXPRESSION_CALL:    return std::make_unique<PrimaryExpression>(child<FunctionCall>());
+                    case PrimaryExpression::PARENTHESIZED:      return std::make_unique<PrimaryExpression>(child<Expression>());
+                    case PrimaryExpression::ARRAY_ACCESS:       return std::make_unique<PrimaryExpression>(child<ArrayAccessExpression>());
+                    case PrimaryExpression::MEMBER_ACCESS:      return std::make_unique<PrimaryExpression>(child<MemberAccessExpression>());
+                    case PrimaryExpression::CAST_EXPRESSION:    return std::make_unique<PrimaryExpression>(child<CastExpression>());
+                    case PrimaryExpression::TERNARY_EXPRESSION: return std::make_unique<PrimaryExpression>(child<TernaryExpression>());
+                }
+                return nullptr;
+            }
+            case NodeKind::FUNCTION_CALL: {
+                auto name = child<Identifier>();
+                auto call = std::make_unique<FunctionCall>(std::move(name), children<Expression>());
+                uint64_t count = readCount();
+                for (uint64_t i = 0; i < count && in.ok(); ++i) call->argTypes.push_back(semanticType());
+                return call;
+            }
+            case NodeKind::RETURN_EXPRESSION:
+                return std::make_unique<ReturnExpression>(child<Expression>());
+            case NodeKind::ARRAY_ACCESS_EXPRESSION: {
+                auto array = child<Expression>();
+                return std::make_unique<ArrayAccessExpression>(std::move(array), child<Expression>());
+            }
+            case NodeKind::TERNARY_EXPRESSION: {
+                auto condition = child<Expression>();
+                auto trueExpr = child<Expression>();
+                return std::make_unique<TernaryExpression>(std::move(condition), std::move(trueExpr), child<Expression>());
+            }
+            case NodeKind::CAST_EXPRESSION: {
+                auto targetType = child<Type>();
+                return std::make_unique<CastExpression>(std::move(targetType), child<Expression>());
+            }
+            case NodeKind::MEMBER_ACCESS_EXPRESSION: {
+                auto object = child<Expression>();
+                return std::make_unique<MemberAccessExpression>(std::move(object), child<Identifier>());
+            }
+            case NodeKind::NUMERIC_LITERAL: {
+                BuiltinType numericType = builtinType();
+                uint64_t bits = in.readU64();
+                if (numericType != BuiltinType::Float && numericType != BuiltinType::Double) {
+                    return std::make_unique<NumericLiteral>(static_cast<int64_t>(bits), numericType);
+                }
+                double value;
+                std::memcpy(&value, &bits, sizeof value);
+                return std::make_unique<NumericLiteral>(value, numericType);
+            }
+            case NodeKind::BOOLEAN_LITERAL:
+                return std::make_unique<BooleanLiteral>(in.readU8() != 0);
+            case NodeKind::CHAR_LITERAL:
+                return std::make_unique<CharLiteral>(static_cast<char>(in.readU8()));
+            case NodeKind::STRING_LITERAL:
+                return std::make_unique<StringLiteral>(string());
+            case NodeKind::LITERAL:
+                return std::make_unique<Literal>(NodeKind::LITERAL, builtinType());
+            default:
+                return nullptr;
+        }
+    }
+};
+
+} // namespace
+
+std::filesystem::path ASTSerializer::cachePathFor(const std::filesystem::path& sourcePath) {
+    return std::filesystem::path(sourcePath).replace_extension(".uast");
+}
+
+std::string ASTSerializer::serialize(const ProgramNode& program, uint64_t sourceHash) {
+    return Encoder().finish(program, sourceHash);
+}
+
+std::unique_ptr<ProgramNode> ASTSerializer::deserialize(std::string_view data, std::string& error,
+                                                        std::optional<uint64_t> expectedSourceHash) {
+    BinaryReader in(data);
+    if (!in.expectBytes(kMagic) || in.readVarint() != FormatVersion) {
+        error = "not an AST file of this compiler version";
+        return nullptr;
+    }
+    uint64_t sourceHash = in.readU64();
+    if (expectedSourceHash && sourceHash != *expectedSourceHash) {
+        error = "sources changed";
+        return nullptr;
+    }
+
+    Decoder decoder(in);
+    std::unique_ptr<ProgramNode> program;
+    if (decoder.readStrings()) {
+        program = decoder.readNodes();
+    }
+    if (!program || !in.ok() || !in.atEnd()) {
+        error = "truncated or corrupt AST";
+        return nullptr;
+    }
+    return program;
+}
+
+bool ASTSerializer::write(const std::filesystem::path& path, const ProgramNode& program, uint64_t sourceHash,
+                          std::string& error) {
+    std::string data = serialize(program, sourceHash);
+
+    // Igual que las interfaces .umi: se escribe aparte y se renombra
+    return writeFileAtomically(path, data, error);
+}
+
+std::unique_ptr<ProgramNode> ASTSerializer::read(const std::filesystem::path& path, std::string& error,
+                                                 std::optional<uint64_t> expectedSourceHash) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot open " + path.string();
+        return nullptr;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::unique_ptr<ProgramNode> program = deserialize(data, error, expectedSourceHash);
+    if (!program) {
+        error = path.string() + ": " + error;
+    }
+    return program;
+}
+
+} // namespace umbra
@@ -0,0 +1,69 @@
+// umbra-client: misma línea de comandos que umbra, compilada por `umbra --daemon`.
+// No enlaza LLVM ni el compilador; sin daemon escuchando ejecuta el umbra de su mismo directorio.
+#include "umbra/server/DaemonProtocol.h"
+
+#include <climits>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+    int runLocally(char* argv[], const std::string& reason) {
+        char self[PATH_MAX];
+        ssize_t length = ::readlink("/proc/self/exe", self, sizeof(self) - 1);
+        std::string compiler = "umbra";
+        if (length > 0) {
+            std::string path(self, static_cast<size_t>(length));
+            compiler = path.substr(0, path.rfind('/') + 1) + "umbra";
+        }
+        argv[0] = const_cast<char*>(compiler.c_str());
+        ::execv(compiler.c_str(), argv);
+        std::cerr << "Error: " << reason << ", and cannot run " << compiler << "." << std::endl;
+        return 1;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string error;
+    int fd = umbra::DaemonProtocol::connect(umbra::DaemonProtocol::defaultSocketPath(), error);
+    if (fd < 0) {
+        return runLocally(argv, error);
+    }
+
+    umbra::DaemonProtocol::Request request;
+    char cwd[PATH_MAX];
+    if (::getcwd(cwd, sizeof(cwd))) {
+        request.workingDirectory = cwd;
+    }
+    request.arguments.assign(argv + 1, argv + argc);
+    if (!umbra::DaemonProtocol::writeFrame(fd, umbra::DaemonProtocol::Frame::Request,
+                                           umbra::DaemonProtocol::encodeRequest(request))) {
+        std::cerr << "Error: cannot send the request to the umbra daemon." << std::endl;
+        return 1;
+    }
+
+    umbra::DaemonProtocol::Frame type;
+    std::string data;
+    while (umbra::DaemonProtocol::readFrame(fd, type, data)) {
+        switch (type) {
+            case umbra::DaemonProtocol::Frame::Stdout:
+                std::cout.write(data.data(), static_cast<std::streamsize>(data.size())).flush();
+                break;
+            case umbra::DaemonProtocol::Frame::Stderr:
+                std::cerr.write(data.data(), static_cast<std::streamsize>(data.size()));
+                break;
+            case umbra::DaemonProtocol::Frame::Exit:
+                ::close(fd);
+                return data.empty() ? 1 : static_cast<unsigned char>(data[0]);
+            default:
+                break;
+        }
+    }
+    ::close(fd);
+    std::cerr << "Error: the umbra daemon closed the connection." << std::endl;
+    return 1;
+}
@@ -0,0 +1,194 @@
+#include "umbra/codegen/analysis/FunctionEffects.h"
+#include "umbra/codegen/analysis/ASTWalk.h"
+
+#include <algorithm>
+
+namespace umbra {
+namespace code_gen {
+
+namespace {
+
+    /// Builtins SIMD: se emiten como instrucciones LLVM, sin efectos.
+    bool isPureBuiltin(const std::string& name) {
+        return name == "splat4" || name == "splat8" || name == "lane" || name == "with_lane" ||
+               name == "hsum" || name == "hmin" || name == "hmax" || name == "select";
+    }
+
+} // namespace
+
+void FunctionEffectAnalysis::analyzeProgram(ProgramNode* program, bool checkBounds) {
+    infos.clear();
+    results.clear();
+    boundsCheck = checkBounds;
+    if (!program) return;
+
+    for (auto& fn : program->functions) {
+        infos[fn->name->name];
+    }
+
+    for (auto& fn : program->functions) {
+        current = &infos[fn->name->name];
+        if (fn->isImported) {
+            // Definida en el objeto de un módulo: su cuerpo no está disponible
+            current->local = FunctionEffects{MemoryEffect::Unknown, false};
+            continue;
+        }
+        callerMemory.clear();
+        referenceParams.clear();
+        if (fn->parameters) {
+            for (auto& param : fn->parameters->parameters) {
+                Type* type = param.first.get();
+                if (type->isPointer || type->isReference || type->arrayDimensions > 0) {
+                    callerMemory.insert(param.second->name);
+                }
+                if (type->isReference) {
+                    referenceParams.insert(param.second->name);
+                }
+            }
+        }
+        scanBlock(fn->body);
+    }
+    current = nullptr;
+
+    // Punto fijo: los efectos de una función incluyen los de todo lo que llama
+    for (auto& [name, info] : infos) results[name] = info.local;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto& [name, info] : infos) {
+            FunctionEffects& fx = results[name];
+            for (const std::string& callee : info.callees) {
+                const FunctionEffects& calleeFx = results[callee];
+                MemoryEffect merged = std::max(fx.memory, calleeFx.memory);
+                bool willReturn = fx.willReturn && calleeFx.willReturn;
+                if (merged != fx.memory || willReturn != fx.willReturn) {
+                    fx.memory = merged;
+                    fx.willReturn = willReturn;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    for (auto& [name, fx] : results) {
+        if (fx.willReturn && reaches(name, name)) fx.willReturn = false;
+    }
+}
+
+const FunctionEffects* FunctionEffectAnalysis::effectsOf(const std::string& name) const {
+    auto it = results.find(name);
+    return it == results.end() ? nullptr : &it->second;
+}
+
+void FunctionEffectAnalysis::scanBlock(const std::vector<std::unique_ptr<Statement>>& body) {
+    for (auto& stmt : body) scanStatement(stmt.get());
+}
+
+void FunctionEffectAnalysis::scanStatement(Statement* stmt) {
+    if (!stmt) return;
+
+    switch (stmt->getKind()) {
+        case NodeKind::ASSIGNMENT_STATEMENT: {
+            auto* assign = static_cast<AssignmentStatement*>(stmt);
+            scanExpression(assign->target.get(), true);
+            scanExpression(assign->value.get(), false);
+            return;
+        }
+        case NodeKind::REPEAT_TIMES_STATEMENT:
+            if (static_cast<RepeatTimesStatement*>(stmt)->parallel) markRuntimeCall();
+            break;
+        case NodeKind::REPEAT_IF_STATEMENT:
+            current->local.willReturn = false;
+            break;
+        case NodeKind::MEMORY_MANAGEMENT:
+            markRuntimeCall();
+            scanExpression(static_cast<MemoryManagement*>(stmt)->size.get(), false);
+            return;
+        default:
+            break;
+    }
+
+    forEachPart(stmt,
+                [this](Expression* expr) { scanExpression(expr, false); },
+                [this](const std::vector<std::unique_ptr<Statement>>& body) { scanBlock(body); });
+}
+
+void FunctionEffectAnalysis::scanExpression(Expression* expr, bool isWrite) {
+    expr = unwrap(expr);
+    if (!expr) return;
+
+    switch (expr->getKind()) {
+        case NodeKind::IDENTIFIER:
+            // `ref T x`: cada uso de x lee (o escribe) la variable del llamador
+            if (referenceParams.count(static_cast<Identifier*>(expr)->name)) {
+                addMemory(isWrite ? MemoryEffect::Unknown : MemoryEffect::ReadOnly);
+            }
+            return;
+        case NodeKind::UNARY_EXPRESSION: {
+            auto* unary = static_cast<UnaryExpression*>(expr);
+            if (unary->op == "access") {
+                addMemory(isWrite ? MemoryEffect::Unknown : MemoryEffect::ReadOnly);
+            }
+            scanExpression(unary->operand.get(), false);
+            return;
+        }
+        case NodeKind::ARRAY_ACCESS_EXPRESSION: {
+            auto* access = static_cast<ArrayAccessExpression*>(expr);
+            if (boundsCheck) markRuntimeCall();
+            Expression* base = unwrap(access->array.get());
+            if (base && base->getKind() == NodeKind::IDENTIFIER &&
+                callerMemory.count(static_cast<Identifier*>(base)->name)) {
+                addMemory(isWrite ? MemoryEffect::Unknown : MemoryEffect::ReadOnly);
+            }
+            // a[i][j]: el acceso interno es parte del mismo destino
+            scanExpression(access->array.get(), isWrite);
+            scanExpression(access->index.get(), false);
+            return;
+        }
+        case NodeKind::INCREMENT_EXPRESSION:
+            scanExpression(static_cast<IncrementExpression*>(expr)->operand.get(), true);
+            return;
+        case NodeKind::DECREMENT_EXPRESSION:
+            scanExpression(static_cast<DecrementExpression*>(expr)->operand.get(), true);
+            return;
+        case NodeKind::FUNCTION_CALL: {
+            const std::string& name = static_cast<FunctionCall*>(expr)->functionName->name;
+            if (infos.count(name)) {
+                current->callees.insert(name);
+            } else if (!isPureBuiltin(name)) {
+                markRuntimeCall();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    forEachChild(expr, [this](Expression* child) { scanExpression(child, false); });
+}
+
+void FunctionEffectAnalysis::addMemory(MemoryEffect effect) {
+    current->local.memory = std::max(current->local.memory, effect);
+}
+
+void FunctionEffectAnalysis::markRuntimeCall() {
+    current->local.memory = MemoryEffect::Unknown;
+    current->local.willReturn = false;
+}
+
+bool FunctionEffectAnalysis::reaches(const std::string& from, const std::string& target) const {
+    std::unordered_set<std::string> visited;
+    std::vector<std::string> pending(infos.at(from).callees.begin(), infos.at(from).callees.end());
+    while (!pending.empty()) {
+        std::string name = std::move(pending.back());
+        pending.pop_back();
+        if (name == target) return true;
+        if (!visited.insert(name).second) continue;
+        auto& callees = infos.at(name).callees;
+        pending.insert(pending.end(), callees.begin(), callees.end());
+    }
+    return false;
+}
+
+} // namespace code_gen
+} // namespace umbra
@@ -0,0 +1,469 @@
+/**
+ * @file RangeAnalysis.cpp
+ * @brief Análisis de rangos de índices para eliminar/adelantar comprobaciones de límites.
+ * @details
+ * El análisis es deliberadamente conservador: cualquier variable cuya dirección se toma,
+ * que se modifica dentro de una expresión o de forma no reconocida pierde su intervalo,
+ * y el acceso afectado conserva su comprobación individual.
+ */
+
+#include "umbra/codegen/analysis/RangeAnalysis.h"
+#include "umbra/codegen/analysis/ASTWalk.h"
+
+#include <algorithm>
+
+namespace umbra {
+namespace code_gen {
+
+namespace {
+
+/// Obtiene la variable base y la dimensión indexada por un acceso (a[i][j] -> "a", nivel 1 para j).
+bool arrayBaseOf(ArrayAccessExpression* access, std::string& name, unsigned& level) {
+    level = 0;
+    Expression* current = unwrap(access->array.get());
+    while (auto* inner = dynamic_cast<ArrayAccessExpression*>(current)) {
+        ++level;
+        current = unwrap(inner->array.get());
+    }
+    if (auto* id = dynamic_cast<Identifier*>(current)) {
+        name = id->name;
+        return true;
+    }
+    return false;
+}
+
+bool isIntLiteral(Expression* expr, int64_t value) {
+    auto* lit = dynamic_cast<NumericLiteral*>(unwrap(expr));
+    return lit && lit->builtinType == BuiltinType::Int && lit->intValue == value;
+}
+
+bool isIdentifierNamed(Expression* expr, const std::string& name) {
+    auto* id = dynamic_cast<Identifier*>(unwrap(expr));
+    return id && id->name == name;
+}
+
+IndexInterval add(IndexInterval a, IndexInterval b) { return {a.lo + b.lo, a.hi + b.hi}; }
+IndexInterval sub(IndexInterval a, IndexInterval b) { return {a.lo - b.hi, a.hi - b.lo}; }
+/// Producto de intervalos; nullopt si algún extremo desborda int64_t (el resultado queda sin rastrear).
+std::optional<IndexInterval> mul(IndexInterval a, IndexInterval b) {
+    int64_t p[4];
+    if (__builtin_mul_overflow(a.lo, b.lo, &p[0]) || __builtin_mul_overflow(a.lo, b.hi, &p[1]) ||
+        __builtin_mul_overflow(a.hi, b.lo, &p[2]) || __builtin_mul_overflow(a.hi, b.hi, &p[3])) {
+        return std::nullopt;
+    }
+    return IndexInterval{*std::min_element(p, p + 4), *std::max_element(p, p + 4)};
+}
+
+/// Evita desbordes en la aritmética de intervalos: índices fuera de este rango no se analizan.
+constexpr int64_t kMaxTracked = int64_t(1) << 40;
+
+bool isTracked(IndexInterval r) {
+    return r.lo > -kMaxTracked && r.hi < kMaxTracked;
+}
+
+} // namespace
+
+//==============================================================================
+// Interfaz pública
+//==============================================================================
+
+void IndexRangeAnalysis::analyzeFunction(FunctionDefinition* fn) {
+    addressTaken.clear();
+    ranges.clear();
+    checks.clear();
+    if (!fn) return;
+
+    for (auto& stmt : fn->body) {
+        collectAddressTaken(stmt.get(), addressTaken);
+    }
+
+    RangeEnv env;
+    walkBlock(fn->body, env);
+}
+
+std::optional<IndexInterval> IndexRangeAnalysis::staticRange(const ArrayAccessExpression* access) const {
+    auto it = ranges.find(access);
+    if (it == ranges.end()) return std::nullopt;
+    return it->second;
+}
+
+const std::vector<HoistedBoundsCheck>* IndexRangeAnalysis::checksFor(const RepeatTimesStatement* loop) const {
+    auto it = checks.find(loop);
+    return it == checks.end() ? nullptr : &it->second;
+}
+
+//==============================================================================
+// Recorrido de statements
+//==============================================================================
+
+/**
+ * @brief Recorre un bloque en orden propagando intervalos de variables.
+ * @param steps Statements de paso de las variables de inducción del bucle que contiene el bloque.
+ */
+void IndexRangeAnalysis::walkBlock(const std::vector<std::unique_ptr<Statement>>& stmts, RangeEnv& env,
+                                   const StepMap* steps) {
+    for (auto& owned : stmts) {
+        Statement* stmt = owned.get();
+        ModCount modified;
+        collectModified(stmt, modified);
+
+        // Los accesos de un statement que modifica variables no se fían de ellas
+        if (modified.empty()) {
+            recordStaticRanges(stmt, env);
+        } else {
+            RangeEnv evalEnv = env;
+            for (auto& [name, count] : modified) evalEnv.erase(name);
+            recordStaticRanges(stmt, evalEnv);
+        }
+
+        if (steps) {
+            auto step = steps->find(stmt);
+            if (step != steps->end()) {
+                env[step->second.first] = step->second.second;
+                continue;
+            }
+        }
+
+        switch (stmt->getKind()) {
+            case NodeKind::VARIABLE_DECLARATION: {
+                auto* decl = static_cast<VariableDeclaration*>(stmt);
+                std::optional<IndexInterval> value;
+                if (decl->initializer && decl->type && decl->type->arrayDimensions == 0) {
+                    value = evalRange(decl->initializer.get(), env);
+                }
+                for (auto& [name, count] : modified) env.erase(name);
+                if (value && !addressTaken.count(decl->name->name)) env[decl->name->name] = *value;
+                break;
+            }
+            case NodeKind::ASSIGNMENT_STATEMENT: {
+                auto* assign = static_cast<AssignmentStatement*>(stmt);
+                auto* target = dynamic_cast<Identifier*>(unwrap(assign->target.get()));
+                std::optional<IndexInterval> value;
+                if (target) value = evalRange(assign->value.get(), env);
+                for (auto& [name, count] : modified) env.erase(name);
+                if (target && value && !addressTaken.count(target->name)) env[target->name] = *value;
+                break;
+            }
+            case NodeKind::REPEAT_TIMES_STATEMENT:
+                analyzeLoop(static_cast<RepeatTimesStatement*>(stmt), env);
+                for (auto& [name, count] : modified) env.erase(name);
+                break;
+            case NodeKind::IF_STATEMENT: {
+                auto* ifStmt = static_cast<IfStatement*>(stmt);
+                for (auto& branch : ifStmt->branches) {
+                    RangeEnv branchEnv = env;
+                    walkBlock(branch.body, branchEnv);
+                }
+                RangeEnv elseEnv = env;
+                walkBlock(ifStmt->elseBranch, elseEnv);
+                for (auto& [name, count] : modified) env.erase(name);
+                break;
+            }
+            case NodeKind::REPEAT_IF_STATEMENT: {
+                for (auto& [name, count] : modified) env.erase(name);
+                RangeEnv bodyEnv = env;
+                walkBlock(static_cast<RepeatIfStatement*>(stmt)->body, bodyEnv);
+                break;
+            }
+            default:
+                for (auto& [name, count] : modified) env.erase(name);
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Analiza un `repeat N times`: variables de inducción, comprobaciones adelantables y cuerpo.
+ * @param env Intervalos válidos a la entrada del bucle.
+ */
+void IndexRangeAnalysis::analyzeLoop(RepeatTimesStatement* loop, const RangeEnv& env) {
+    ModCount modified;
+    for (auto& stmt : loop->body) collectModified(stmt.get(), modified);
+
+    std::optional<IndexInterval> trips = evalRange(loop->times.get(), env);
+
+    if (loop->parallel) {
+        // Las iteraciones corren en cualquier orden y hilo: no hay variables de inducción ni
+        // comprobaciones adelantables; el índice 'as i' recorre [0, N-1]
+        RangeEnv bodyEnv = env;
+        for (auto& [name, count] : modified) bodyEnv.erase(name);
+        if (loop->indexVar) {
+            const std::string& index = loop->indexVar->name;
+            bodyEnv.erase(index);
+            if (trips && trips->hi > 0 && !modified.count(index) && !addressTaken.count(index)) {
+                bodyEnv[index] = IndexInterval{0, trips->hi - 1};
+            }
+        }
+        walkBlock(loop->body, bodyEnv);
+        return;
+    }
+
+    // Variables de inducción: un único paso +1/-1 de nivel superior y ninguna otra escritura
+    std::vector<Induction> inductions;
+    for (size_t k = 0; k < loop->body.size(); ++k) {
+        std::string name;
+        int64_t step = 0;
+        if (isStepStatement(loop->body[k].get(), name, step) && modified[name] == 1 &&
+            !addressTaken.count(name)) {
+            inductions.push_back({name, step, k});
+        }
+    }
+
+    // Comprobaciones adelantables: accesos de nivel superior, sin 'return' que corte iteraciones
+    if (!containsReturn(loop->body)) {
+        auto& loopChecks = checks[loop];
+        for (size_t k = 0; k < loop->body.size(); ++k) {
+            std::vector<ArrayAccessExpression*> accesses;
+            collectAccesses(loop->body[k].get(), accesses);
+            for (auto* access : accesses) {
+                HoistedBoundsCheck check;
+                check.access = access;
+                if (!arrayBaseOf(access, check.arrayName, check.level)) continue;
+
+                std::optional<Affine> affine = affineIndex(access->index.get(), nullptr, modified, env);
+                const Induction* used = nullptr;
+                for (size_t i = 0; !affine && i < inductions.size(); ++i) {
+                    affine = affineIndex(access->index.get(), &inductions[i].name, modified, env);
+                    used = &inductions[i];
+                }
+                if (!affine) continue;
+
+                check.coefficient = affine->coefficient;
+                if (used && affine->coefficient != 0) {
+                    check.step = used->step;
+                    check.afterStep = used->stepIndex < k;
+                }
+                loopChecks.push_back(std::move(check));
+            }
+        }
+    }
+
+    // Cuerpo: las variables modificadas pierden su intervalo salvo las de inducción conocidas
+    RangeEnv bodyEnv = env;
+    for (auto& [name, count] : modified) bodyEnv.erase(name);
+
+    StepMap steps;
+    if (trips && trips->hi > 0) {
+        for (auto& iv : inductions) {
+            auto entry = env.find(iv.name);
+            if (entry == env.end()) continue;
+            int64_t span = iv.step * (trips->hi - 1);
+            IndexInterval before{entry->second.lo + std::min<int64_t>(0, span),
+                                 entry->second.hi + std::max<int64_t>(0, span)};
+            IndexInterval after{before.lo + iv.step, before.hi + iv.step};
+            if (!isTracked(before) || !isTracked(after)) continue;
+            bodyEnv[iv.name] = before;
+            steps[loop->body[iv.stepIndex].get()] = {iv.name, after};
+        }
+    }
+    walkBlock(loop->body, bodyEnv, &steps);
+}
+
+/// Registra el intervalo estático de cada acceso evaluado por stmt (sin entrar en bloques anidados).
+void IndexRangeAnalysis::recordStaticRanges(Statement* stmt, const RangeEnv& env) {
+    std::vector<ArrayAccessExpression*> accesses;
+    collectAccesses(stmt, accesses);
+    for (auto* access : accesses) {
+        if (auto range = evalRange(access->index.get(), env)) {
+            ranges[access] = *range;
+        }
+    }
+}
+
+//==============================================================================
+// Evaluación de índices
+//==============================================================================
+
+/**
+ * @brief Expresa expr como coefficient * iv + rest.
+ * @param iv Variable de inducción (nullptr: solo se aceptan expresiones invariantes).
+ * @param modified Variables escritas dentro del bucle: no son invariantes.
+ * @return nullopt si la expresión no es afín o depende de algo no analizable.
+ */
+std::optional<IndexRangeAnalysis::Affine> IndexRangeAnalysis::affineIndex(
+    Expression* expr, const std::string* iv, const ModCount& modified, const RangeEnv& env) const {
+    expr = unwrap(expr);
+    if (!expr) return std::nullopt;
+
+    if (auto* lit = dynamic_cast<NumericLiteral*>(expr)) {
+        if (lit->builtinType != BuiltinType::Int) return std::nullopt;
+        int64_t value = lit->intValue;
+        return Affine{0, IndexInterval{value, value}};
+    }
+
+    if (auto* id = dynamic_cast<Identifier*>(expr)) {
+        if (iv && id->name == *iv) return Affine{1, IndexInterval{0, 0}};
+        if (modified.count(id->name) || addressTaken.count(id->name)) return std::nullopt;
+        auto it = env.find(id->name);
+        if (it == env.end()) return Affine{0, std::nullopt};
+        return Affine{0, it->second};
+    }
+
+    auto* bin = dynamic_cast<BinaryExpression*>(expr);
+    if (!bin) return std::nullopt;
+
+    auto lhs = affineIndex(bin->left.get(), iv, modified, env);
+    if (!lhs) return std::nullopt;
+    auto rhs = affineIndex(bin->right.get(), iv, modified, env);
+    if (!rhs) return std::nullopt;
+
+    Affine result;
+    if (bin->op == "+" || bin->op == "-") {
+        bool plus = bin->op == "+";
+        bool overflow = plus ? __builtin_add_overflow(lhs->coefficient, rhs->coefficient, &result.coefficient)
+                             : __builtin_sub_overflow(lhs->coefficient, rhs->coefficient, &result.coefficient);
+        if (overflow) return std::nullopt;
+        if (lhs->rest && rhs->rest) {
+            result.rest = plus ? add(*lhs->rest, *rhs->rest) : sub(*lhs->rest, *rhs->rest);
+        }
+    } else if (bin->op == "*") {
+        // Solo se admite escalar la variable de inducción por una constante
+        auto isConst = [](const Affine& a) { return a.coefficient == 0 && a.rest && a.rest->lo == a.rest->hi; };
+        if (lhs->coefficient != 0 && rhs->coefficient != 0) return std::nullopt;
+        if (lhs->coefficient != 0 || rhs->coefficient != 0) {
+            const Affine& var = lhs->coefficient != 0 ? *lhs : *rhs;
+            const Affine& factor = lhs->coefficient != 0 ? *rhs : *lhs;
+            if (!isConst(factor)) return std::nullopt;
+            if (__builtin_mul_overflow(var.coefficient, factor.rest->lo, &result.coefficient)) return std::nullopt;
+            if (var.rest) result.rest = mul(*var.rest, *factor.rest);
+        } else if (lhs->rest && rhs->rest) {
+            result.rest = mul(*lhs->rest, *rhs->rest);
+        }
+    } else {
+        return std::nullopt;
+    }
+
+    if (result.rest && !isTracked(*result.rest)) result.rest.reset();
+    return result;
+}
+
+/// Intervalo de valores de una expresión entera sin efectos, si es calculable.
+std::optional<IndexInterval> IndexRangeAnalysis::evalRange(Expression* expr, const RangeEnv& env) const {
+    static const ModCount none;
+    auto affine = affineIndex(expr, nullptr, none, env);
+    if (!affine || affine->coefficient != 0) return std::nullopt;
+    return affine->rest;
+}
+
+//==============================================================================
+// Utilidades estáticas
+//==============================================================================
+
+/// Reconoce v++, ++v, v--, --v, v = v + 1, v = 1 + v y v = v - 1 como statements de paso.
+bool IndexRangeAnalysis::isStepStatement(Statement* stmt, std::string& name, int64_t& step) {
+    if (auto* exprStmt = dynamic_cast<ExpressionStatement*>(stmt)) {
+        Expression* expr = unwrap(exprStmt->exp.get());
+        Expression* operand = nullptr;
+        if (auto* inc = dynamic_cast<IncrementExpression*>(expr)) {
+            operand = inc->operand.get();
+            step = 1;
+        } else if (auto* dec = dynamic_cast<DecrementExpression*>(expr)) {
+            operand = dec->operand.get();
+            step = -1;
+        }
+        auto* id = dynamic_cast<Identifier*>(unwrap(operand));
+        if (!id) return false;
+        name = id->name;
+        return true;
+    }
+
+    if (auto* assign = dynamic_cast<AssignmentStatement*>(stmt)) {
+        auto* target = dynamic_cast<Identifier*>(unwrap(assign->target.get()));
+        auto* bin = dynamic_cast<BinaryExpression*>(unwrap(assign->value.get()));
+        if (!target || !bin) return false;
+        name = target->name;
+        if (bin->op == "+" && ((isIdentifierNamed(bin->left.get(), name) && isIntLiteral(bin->right.get(), 1)) ||
+                               (isIntLiteral(bin->left.get(), 1) && isIdentifierNamed(bin->right.get(), name)))) {
+            step = 1;
+            return true;
+        }
+        if (bin->op == "-" && isIdentifierNamed(bin->left.get(), name) && isIntLiteral(bin->right.get(), 1)) {
+            step = -1;
+            return true;
+        }
+    }
+    return false;
+}
+
+void IndexRangeAnalysis::collectModified(Statement* stmt, ModCount& out) {
+    if (auto* loop = dynamic_cast<RepeatTimesStatement*>(stmt); loop && loop->indexVar) {
+        ++out[loop->indexVar->name];
+    }
+    if (auto* decl = dynamic_cast<VariableDeclaration*>(stmt)) {
+        ++out[decl->name->name];
+    } else if (auto* assign = dynamic_cast<AssignmentStatement*>(stmt)) {
+        if (auto* id = dynamic_cast<Identifier*>(unwrap(assign->target.get()))) {
+            ++out[id->name];
+        }
+    }
+    forEachPart(stmt,
+        [&](Expression* expr) { collectModified(expr, out); },
+        [&](const std::vector<std::unique_ptr<Statement>>& block) {
+            for (auto& inner : block) collectModified(inner.get(), out);
+        });
+}
+
+void IndexRangeAnalysis::collectModified(Expression* expr, ModCount& out) {
+    if (!expr) return;
+    Expression* operand = nullptr;
+    if (auto* inc = dynamic_cast<IncrementExpression*>(expr)) operand = inc->operand.get();
+    if (auto* dec = dynamic_cast<DecrementExpression*>(expr)) operand = dec->operand.get();
+    if (auto* id = dynamic_cast<Identifier*>(unwrap(operand))) ++out[id->name];
+    forEachChild(expr, [&](Expression* child) { collectModified(child, out); });
+}
+
+void IndexRangeAnalysis::collectAddressTaken(Statement* stmt, std::unordered_set<std::string>& out) {
+    forEachPart(stmt,
+        [&](Expression* expr) { collectAddressTaken(expr, out); },
+        [&](const std::vector<std::unique_ptr<Statement>>& block) {
+            for (auto& inner : block) collectAddressTaken(inner.get(), out);
+        });
+}
+
+void IndexRangeAnalysis::collectAddressTaken(Expression* expr, std::unordered_set<std::string>& out) {
+    if (!expr) return;
+    if (auto* unary = dynamic_cast<UnaryExpression*>(expr)) {
+        if (unary->op == "ref" || unary->op == "ptr") {
+            if (auto* id = dynamic_cast<Identifier*>(unwrap(unary->operand.get()))) out.insert(id->name);
+        }
+    }
+    forEachChild(expr, [&](Expression* child) { collectAddressTaken(child, out); });
+}
+
+bool IndexRangeAnalysis::containsReturn(const std::vector<std::unique_ptr<Statement>>& stmts) {
+    bool found = false;
+    for (auto& stmt : stmts) {
+        if (found) break;
+        if (stmt->getKind() == NodeKind::RETURN_EXPRESSION) return true;
+        forEachPart(stmt.get(),
+            [](Expression*) {},
+            [&](const std::vector<std::unique_ptr<Statement>>& block) { found = found || containsReturn(block); });
+    }
+    return found;
+}
+
+void IndexRangeAnalysis::collectAccesses(Statement* stmt, std::vector<ArrayAccessExpression*>& out) {
+    // Solo expresiones evaluadas siempre por el statement: la primera condición de un if,
+    // el número de vueltas de un repeat, etc. Los cuerpos anidados se tratan por separado.
+    if (auto* ifStmt = dynamic_cast<IfStatement*>(stmt)) {
+        if (!ifStmt->branches.empty()) collectAccesses(ifStmt->branches.front().condition.get(), out);
+        return;
+    }
+    forEachPart(stmt,
+        [&](Expression* expr) { collectAccesses(expr, out); },
+        [](const std::vector<std::unique_ptr<Statement>>&) {});
+}
+
+void IndexRangeAnalysis::collectAccesses(Expression* expr, std::vector<ArrayAccessExpression*>& out) {
+    if (!expr) return;
+    if (auto* access = dynamic_cast<ArrayAccessExpression*>(expr)) out.push_back(access);
+    if (auto* ternary = dynamic_cast<TernaryExpression*>(expr)) {
+        // Las ramas de un ternario son condicionales
+        collectAccesses(ternary->condition.get(), out);
+        return;
+    }
+    forEachChild(expr, [&](Expression* child) { collectAccesses(child, out); });
+}
+
+} // namespace code_gen
+} // namespace umbra
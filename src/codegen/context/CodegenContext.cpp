@@ -3,7 +3,10 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Function.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Type.h>
+#include <llvm/Support/raw_ostream.h>
+#include <string>
 #include <vector>
 
 namespace umbra {
@@ -41,4 +44,46 @@ namespace umbra {
 
         }
 
+        llvm::Function* CodegenContext::getRuntimeFunction(const std::string& name, llvm::FunctionType* type) {
+
+            // Funciones de libumbra_rt (ver umbra/runtime/umbra_rt.h): se declaran una sola vez
+            if(llvm::Function* existing = llvmModule.getFunction(name))
+                return existing;
+
+            llvm::Function* function = llvm::Function::Create(
+                type,
+                llvm::Function::ExternalLinkage,
+                name,
+                &llvmModule
+            );
+
+            function->setCallingConv(llvm::CallingConv::C);
+            function->setDoesNotThrow();
+            return function;
+
+        }
+
+        llvm::MDNode* CodegenContext::getTBAAAccessTag(llvm::Type* accessType) {
+
+            auto it = tbaaAccessTags.find(accessType);
+            if(it != tbaaAccessTags.end())
+                return it->second;
+
+            llvm::MDBuilder mdBuilder(llvmContext);
+            if(!tbaaRoot)
+                tbaaRoot = mdBuilder.createTBAARoot("Umbra TBAA");
+
+            // El nombre del nodo es el tipo LLVM: i32 (int), double, <4 x float> (vec4 float), ptr...
+            std::string name;
+            llvm::raw_string_ostream os(name);
+            accessType->print(os);
+            os.flush();
+
+            llvm::MDNode* scalar = mdBuilder.createTBAAScalarTypeNode(name, tbaaRoot);
+            llvm::MDNode* tag = mdBuilder.createTBAAStructTagNode(scalar, scalar, 0);
+            tbaaAccessTags[accessType] = tag;
+            return tag;
+
+        }
+
 } // namespace umbra
@@ -1,6 +1,7 @@
 #include "umbra/codegen/visitors/CodegenVisitor.h"
 #include "umbra/ast/Visitor.h"
 #include "umbra/codegen/context/CodegenContext.h"
+#include "umbra/codegen/analysis/ASTWalk.h"
 #include "umbra/semantic/SymbolTable.h"
 #include <llvm/ADT/APInt.h>
 #include <llvm/ADT/ArrayRef.h>
@@ -11,51 +12,133 @@
 #include <llvm/IR/GlobalVariable.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Value.h>
 #include <llvm/Support/Casting.h>
 
+#include <algorithm>
+#include <climits>
+#include <set>
+
 namespace umbra {
 namespace code_gen {
 
 llvm::Value *CodegenVisitor::visitProgramNode(ProgramNode *node) {
-    // Visitar todas las funciones
+    // Efectos de cada función (para readnone/readonly/willreturn) antes de emitir ninguna
+    effectAnalysis.analyzeProgram(node, Ctxt.boundsCheck);
+
+    // Declarar todos los prototipos primero: una función puede llamar a otra definida después
+    for (auto &F : node->functions) {
+        declareFunction(F.get());
+    }
+
+    // Visitar todas las funciones; las importadas de un módulo solo se declaran
     for (auto &F : node->functions) {
-        visit(F.get());
+        if (!F->isImported)
+            visit(F.get());
     }
     return nullptr;
 }
 
-llvm::Value *CodegenVisitor::visitFunctionDefinition(FunctionDefinition *node) {
+llvm::Function *CodegenVisitor::declareFunction(FunctionDefinition *node) {
     // Tipos de retorno y params a partir de la firma semántica
     llvm::Type *retTy = builtinTypeToLLVMType(node->returnType->builtinType, Ctxt.llvmContext);
 
     std::vector<llvm::Type *> paramTys;
-    if (node->parameters) {
-        for (auto &p : node->parameters->parameters) {
-            paramTys.push_back(builtinTypeToLLVMType(p.first->builtinType, Ctxt.llvmContext));
+    lowerParameterTypes(node, paramTys);
+    auto *FT = llvm::FunctionType::get(retTy, paramTys, false);
+    // Solo el punto de entrada es visible fuera del módulo (main lo llama desde Compiler), salvo
+    // en un módulo precompilado y en los prototipos que vienen de uno
+    bool external = node->name->name == "start" || node->isImported || Ctxt.exportFunctions;
+    auto linkage = external ? llvm::Function::ExternalLinkage : llvm::Function::InternalLinkage;
+    llvm::Function *F = llvm::Function::Create(FT, linkage, node->name->name, Ctxt.llvmModule);
+    functionDefinitions[node->name->name] = node;
+    applyFunctionAttributes(F, node);
+    return F;
+}
+
+/**
+ * @brief Tipos LLVM de los parámetros de una función del usuario.
+ * @details
+ * - `T [] ... []v` (array de D dimensiones) -> T* al primer elemento seguido de D longitudes i64.
+ *   El array no se copia; los strides se derivan de las longitudes (disposición row-major).
+ * - `ref T x` y `ptr T x` -> T*.
+ * - Escalares -> su tipo por valor.
+ */
+void CodegenVisitor::lowerParameterTypes(FunctionDefinition *node, std::vector<llvm::Type *> &paramTys) {
+    if (!node->parameters)
+        return;
+    llvm::Type *i64 = llvm::Type::getInt64Ty(Ctxt.llvmContext);
+    for (auto &p : node->parameters->parameters) {
+        Type *type = p.first.get();
+        if (type->arrayDimensions > 0) {
+            llvm::Type *elementTy = builtinTypeToLLVMType(type->builtinType, Ctxt.llvmContext);
+            paramTys.push_back(llvm::PointerType::get(elementTy, 0));
+            paramTys.insert(paramTys.end(), type->arrayDimensions, i64);
+        } else {
+            paramTys.push_back(typeNodeToLLVMType(type, Ctxt.llvmContext));
         }
     }
-    auto *FT = llvm::FunctionType::get(retTy, paramTys, false);
-    llvm::Function *F = llvm::Function::Create(FT, llvm::Function::ExternalLinkage,
-                                               node->name->name, Ctxt.llvmModule);
+}
 
-    // Nombrar argumentos y meterlos al mapa namedValues como locales
-    if (node->parameters) {
-        unsigned idx = 0;
-        for (auto &arg : F->args()) {
-            auto &pname = node->parameters->parameters[idx++].second->name;
-            arg.setName(pname);
-            Ctxt.namedValues[pname] = &arg;
+/// Nombra los argumentos LLVM y registra cada parámetro (valor, `ref T` o slice) para el cuerpo.
+void CodegenVisitor::bindParameters(FunctionDefinition *node, llvm::Function *F) {
+    if (!node->parameters)
+        return;
+    auto argIt = F->arg_begin();
+    for (auto &p : node->parameters->parameters) {
+        Type *type = p.first.get();
+        const std::string &pname = p.second->name;
+        llvm::Argument *arg = &*argIt++;
+        arg->setName(pname);
+
+        if (type->arrayDimensions > 0) {
+            ArraySlice slice;
+            slice.data = arg;
+            slice.elementType = builtinTypeToLLVMType(type->builtinType, Ctxt.llvmContext);
+            for (int d = 0; d < type->arrayDimensions; ++d) {
+                llvm::Argument *length = &*argIt++;
+                length->setName(pname + ".len" + std::to_string(d));
+                slice.lengths.push_back(length);
+            }
+            sliceParams[pname] = std::move(slice);
+            continue;
+        }
+        if (type->isReference) {
+            referenceParams[pname] = typeNodeToLLVMType(type->baseType.get(), Ctxt.llvmContext);
+        } else if (type->isPointer && type->baseType) {
+            pointeeTypes[pname] = typeNodeToLLVMType(type->baseType.get(), Ctxt.llvmContext);
         }
+        Ctxt.namedValues[pname] = arg;
     }
+}
+
+llvm::Value *CodegenVisitor::visitFunctionDefinition(FunctionDefinition *node) {
+    llvm::Function *F = Ctxt.llvmModule.getFunction(node->name->name);
+    if (!F) {
+        F = declareFunction(node);
+    }
+    llvm::Type *retTy = F->getReturnType();
+
+    // Nombrar argumentos y meterlos al mapa namedValues como locales
+    bindParameters(node, F);
 
     // Crear bloque de entrada
     llvm::BasicBlock *entry = llvm::BasicBlock::Create(Ctxt.llvmContext, "entry", F);
     Ctxt.llvmBuilder.SetInsertPoint(entry);
 
+    beginTailRecursion(node, F);
+
+    // --bounds-check: rangos de índices para eliminar/adelantar comprobaciones
+    provenInBounds.clear();
+    if (Ctxt.boundsCheck) {
+        rangeAnalysis.analyzeFunction(node);
+    }
+
     // Emitir cuerpo
     for (auto &S : node->body) {
         visit(S.get());
@@ -67,26 +150,215 @@ llvm::Value *CodegenVisitor::visitFunctionDefinition(FunctionDefinition *node) {
     if (curBB && !curBB->getTerminator()) {
         if (retTy->isVoidTy()) {
             Ctxt.llvmBuilder.CreateRetVoid();
-        } else if (retTy->isIntegerTy(32)) {
-            // retorno por defecto 0 si no se emitió return
-            Ctxt.llvmBuilder.CreateRet(
-                llvm::ConstantInt::get(llvm::Type::getInt32Ty(Ctxt.llvmContext), 0, true));
         } else {
-            // fallback para otros tipos no soportados aún
-            Ctxt.llvmBuilder.CreateRetVoid();
+            // retorno por defecto 0 (o su equivalente en el tipo) si no se emitió return
+            Ctxt.llvmBuilder.CreateRet(llvm::Constant::getNullValue(retTy));
         }
     }
 
+    tailRecursion = {};
+    emitArrayAliasScopes(F);
+
     // Limpiar valores nombrados de parámetros para el próximo contexto de función
     if (node->parameters) {
         for (auto &p : node->parameters->parameters) {
             Ctxt.namedValues.erase(p.second->name);
         }
     }
+    sliceParams.clear();
+    referenceParams.clear();
+    pointeeTypes.clear();
 
     return F;
 }
 
+/// `ptr T`, un array de punteros o `ref ptr T`: por él pueden llegar direcciones de cualquier memoria.
+static bool carriesPointer(const Type *type) {
+    return type && (type->isPointer || type->builtinType == BuiltinType::Ptr || carriesPointer(type->baseType.get()));
+}
+
+void CodegenVisitor::applyFunctionAttributes(llvm::Function *F, FunctionDefinition *node) {
+    // Umbra no tiene excepciones y el runtime está escrito en C
+    F->setDoesNotThrow();
+
+    switch (node->inlineHint) {
+    case InlineHint::Always:
+        F->addFnAttr(llvm::Attribute::AlwaysInline);
+        break;
+    case InlineHint::Never:
+        F->addFnAttr(llvm::Attribute::NoInline);
+        break;
+    case InlineHint::Default:
+        break;
+    }
+
+    // Slices y `ref T`: el llamador pasa memoria viva que no llega por ningún otro parámetro
+    // (SymbolCollector rechaza pasar la misma variable dos veces por referencia). Un parámetro
+    // puntero puede apuntar dentro de cualquiera de ellos, y eso no se ve en la llamada:
+    // entonces no hay noalias, pero el resto de atributos sigue siendo cierto.
+    if (node->parameters) {
+        const llvm::DataLayout &DL = Ctxt.llvmModule.getDataLayout();
+        bool noAlias = std::none_of(node->parameters->parameters.begin(), node->parameters->parameters.end(),
+                                    [](auto &p) { return carriesPointer(p.first.get()); });
+        unsigned argNo = 0;
+        for (auto &p : node->parameters->parameters) {
+            Type *type = p.first.get();
+            llvm::Type *pointee = nullptr;
+            if (type->arrayDimensions > 0) {
+                pointee = builtinTypeToLLVMType(type->builtinType, Ctxt.llvmContext);
+            } else if (type->isReference && type->baseType) {
+                pointee = typeNodeToLLVMType(type->baseType.get(), Ctxt.llvmContext);
+            }
+            if (pointee && pointee->isSized()) {
+                if (noAlias)
+                    F->addParamAttr(argNo, llvm::Attribute::NoAlias);
+                F->addParamAttr(argNo, llvm::Attribute::NonNull);
+                F->addDereferenceableParamAttr(argNo, DL.getTypeAllocSize(pointee));
+                F->addParamAttr(argNo, llvm::Attribute::getWithAlignment(Ctxt.llvmContext, DL.getABITypeAlign(pointee)));
+            }
+            argNo += 1 + type->arrayDimensions;
+        }
+    }
+
+    const FunctionEffects *effects = effectAnalysis.effectsOf(node->name->name);
+    if (!effects) {
+        return;
+    }
+    if (effects->memory == MemoryEffect::None) {
+        F->setDoesNotAccessMemory();
+    } else if (effects->memory == MemoryEffect::ReadOnly) {
+        F->setOnlyReadsMemory();
+    }
+    if (effects->willReturn) {
+        F->setWillReturn();
+    }
+}
+
+/// Alguna subexpresión toma la dirección de una variable (`ref x`): apuntaría al marco actual.
+static bool takesAddress(Expression *expr) {
+    expr = unwrap(expr);
+    if (!expr)
+        return false;
+    if (auto *unary = dynamic_cast<UnaryExpression *>(expr); unary && unary->op == "ref")
+        return true;
+    bool found = false;
+    forEachChild(expr, [&](Expression *child) { found = found || takesAddress(child); });
+    return found;
+}
+
+/// `return name(...)` sin `ref` en los argumentos, o nullptr.
+static FunctionCall *asTailCallTo(ReturnExpression *ret, const std::string *name) {
+    auto *call = dynamic_cast<FunctionCall *>(unwrap(ret->returnValue.get()));
+    if (!call || (name && call->functionName->name != *name))
+        return nullptr;
+    for (auto &arg : call->arguments) {
+        if (takesAddress(arg.get()))
+            return nullptr;
+    }
+    return call;
+}
+
+/// Busca `return fn(...)` en el cuerpo, sin entrar en repeats paralelos (su cuerpo se outlinea).
+static bool hasSelfTailCall(const std::vector<std::unique_ptr<Statement>> &body, const std::string &fn) {
+    for (auto &stmt : body) {
+        if (auto *ret = dynamic_cast<ReturnExpression *>(stmt.get())) {
+            if (asTailCallTo(ret, &fn))
+                return true;
+            continue;
+        }
+        if (auto *loop = dynamic_cast<RepeatTimesStatement *>(stmt.get()); loop && loop->parallel)
+            continue;
+        bool found = false;
+        forEachPart(stmt.get(), [](Expression *) {},
+                    [&](const std::vector<std::unique_ptr<Statement>> &inner) {
+                        found = found || hasSelfTailCall(inner, fn);
+                    });
+        if (found)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Prepara la conversión de la recursión de cola propia en un bucle.
+ * @details Los parámetros se copian a allocas y el cuerpo se emite a partir de un bloque
+ *          cabecera; cada `return f(...)` guarda los nuevos argumentos y vuelve a él. Así la
+ *          recursión usa pila constante incluso sin optimizar. Solo para parámetros escalares.
+ */
+void CodegenVisitor::beginTailRecursion(FunctionDefinition *node, llvm::Function *F) {
+    tailRecursion = {};
+    if (!node->parameters || !hasSelfTailCall(node->body, node->name->name))
+        return;
+    for (auto &p : node->parameters->parameters) {
+        if (p.first->isPointer || p.first->isReference || p.first->arrayDimensions > 0)
+            return;
+    }
+
+    auto &B = Ctxt.llvmBuilder;
+    unsigned idx = 0;
+    for (auto &arg : F->args()) {
+        auto &pname = node->parameters->parameters[idx++].second->name;
+        llvm::AllocaInst *slot = B.CreateAlloca(arg.getType(), nullptr, pname + ".addr");
+        B.CreateStore(&arg, slot);
+        Ctxt.namedValues[pname] = slot;
+        Ctxt.valueTypes[slot] = arg.getType();
+        tailRecursion.params.push_back(slot);
+    }
+
+    tailRecursion.name = node->name->name;
+    tailRecursion.function = F;
+    tailRecursion.header = llvm::BasicBlock::Create(Ctxt.llvmContext, "tailrec.header", F);
+    B.CreateBr(tailRecursion.header);
+    B.SetInsertPoint(tailRecursion.header);
+}
+
+bool CodegenVisitor::emitSelfTailCall(FunctionCall *call) {
+    auto &B = Ctxt.llvmBuilder;
+    if (!tailRecursion.function || B.GetInsertBlock()->getParent() != tailRecursion.function ||
+        call->arguments.size() != tailRecursion.params.size())
+        return false;
+
+    // Todos los argumentos se evalúan con los valores anteriores antes de sobrescribir ninguno
+    std::vector<llvm::Value *> values;
+    for (size_t i = 0; i < call->arguments.size(); ++i) {
+        llvm::Value *v = emitExpr(call->arguments[i].get());
+        if (!v)
+            return false;
+        values.push_back(convertValue(v, tailRecursion.params[i]->getAllocatedType(), call->arguments[i].get()));
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        B.CreateStore(values[i], tailRecursion.params[i]);
+    }
+    B.CreateBr(tailRecursion.header);
+    return true;
+}
+
+/**
+ * @brief Marca como llamada de cola el `return g(...)` a otra función del usuario.
+ * @details musttail cuando los prototipos coinciden (LLVM garantiza el salto); tail en otro
+ *          caso. Nunca si algún argumento es un puntero: podría apuntar al marco actual.
+ */
+void CodegenVisitor::markTailCall(llvm::Value *v, FunctionCall *call) {
+    auto *inst = llvm::dyn_cast_or_null<llvm::CallInst>(v);
+    if (!inst || !call)
+        return;
+    llvm::Function *callee = inst->getCalledFunction();
+    llvm::Function *caller = Ctxt.llvmBuilder.GetInsertBlock()->getParent();
+    // Solo funciones del usuario (pueden estar aún sin cuerpo si se definen más abajo)
+    if (!callee || callee->isIntrinsic() || !effectAnalysis.effectsOf(callee->getName().str()))
+        return;
+    for (llvm::Value *arg : inst->args()) {
+        if (arg->getType()->isPointerTy())
+            return;
+    }
+    if (callee->getFunctionType() == caller->getFunctionType() &&
+        callee->getCallingConv() == caller->getCallingConv()) {
+        inst->setTailCallKind(llvm::CallInst::TCK_MustTail);
+    } else {
+        inst->setTailCall();
+    }
+}
+
 llvm::Value *CodegenVisitor::visitExpressionStatement(ExpressionStatement *node) {
     if (node->exp) {
         return visit(node->exp.get());
@@ -100,8 +372,9 @@ static llvm::Constant *getOrCreateGlobalString(CodegenContext &Ctxt, const std::
     if (it != Ctxt.globalStrings.end()) {
         return llvm::cast<llvm::Constant>(it->second);
     }
-    // Create a constant [N x i8] with the contents of str (including null)
-    llvm::Constant *gv = Ctxt.llvmBuilder.CreateGlobalString(str, nameHint);
+    // Constante [N x i8] con str (incluido el nulo), vista como i8*: el tipo de los string y
+    // de umbra_print_str. Con punteros tipados un [N x i8]* no encaja en esa firma
+    llvm::Constant *gv = Ctxt.llvmBuilder.CreateGlobalStringPtr(str, nameHint);
     Ctxt.globalStrings[str] = gv;
     return gv;
 }
@@ -117,11 +390,16 @@ llvm::Value *CodegenVisitor::visitBooleanLiteral(BooleanLiteral *node) {
 llvm::Value *CodegenVisitor::visitNumericLiteral(NumericLiteral *node) {
     switch (node->builtinType) {
     case BuiltinType::Int:
-        return llvm::ConstantInt::get(llvm::Type::getInt32Ty(Ctxt.llvmContext), (int)node->value,
+        return llvm::ConstantInt::get(llvm::Type::getInt32Ty(Ctxt.llvmContext), node->intValue,
+                                      true);
+    case BuiltinType::Long:
+        return llvm::ConstantInt::get(llvm::Type::getInt64Ty(Ctxt.llvmContext), node->intValue,
                                       true);
     case BuiltinType::Float: {
-        return llvm::ConstantFP::get(llvm::Type::getFloatTy(Ctxt.llvmContext), node->value);
+        return llvm::ConstantFP::get(llvm::Type::getFloatTy(Ctxt.llvmContext), node->floatValue);
     }
+    case BuiltinType::Double:
+        return llvm::ConstantFP::get(llvm::Type::getDoubleTy(Ctxt.llvmContext), node->floatValue);
     default:
         return nullptr;
     }
@@ -131,11 +409,120 @@ llvm::Value *CodegenVisitor::visitIdentifier(Identifier *node) {
     auto it = Ctxt.namedValues.find(node->name);
     if(it == Ctxt.namedValues.end()) return nullptr;
 
-    llvm::Value* val = it->second;
-    if(auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(val)){
-        return Ctxt.llvmBuilder.CreateLoad(alloca->getAllocatedType(), alloca, node->name + ".ld");
+    llvm::Type* slotType = nullptr;
+    if(llvm::Value* slot = getVariableSlot(node->name, slotType)){
+        return emitLoad(slotType, slot, node->name + ".ld");
     }
-    return val;
+    return it->second;
+}
+
+/**
+ * @brief Dirección donde vive la variable escalar name y tipo almacenado en ella.
+ * @details Locales (allocas) y parámetros `ref T`. Los parámetros por valor son valores SSA
+ *          sin memoria propia: devuelve nullptr salvo que materialize pida volcarlos a un
+ *          alloca (para asignarlos o tomar su dirección).
+ */
+llvm::Value *CodegenVisitor::getVariableSlot(const std::string &name, llvm::Type *&type, bool materialize) {
+    auto it = Ctxt.namedValues.find(name);
+    if (it == Ctxt.namedValues.end())
+        return nullptr;
+    if (auto *alloca = llvm::dyn_cast<llvm::AllocaInst>(it->second)) {
+        type = alloca->getAllocatedType();
+        return alloca;
+    }
+    auto *arg = llvm::dyn_cast<llvm::Argument>(it->second);
+    if (!arg)
+        return nullptr;
+    auto refIt = referenceParams.find(name);
+    if (refIt != referenceParams.end()) {
+        type = refIt->second;
+        return arg;
+    }
+    if (!materialize)
+        return nullptr;
+
+    llvm::Function *F = arg->getParent();
+    llvm::IRBuilder<> entryBuilder(&F->getEntryBlock(), F->getEntryBlock().begin());
+    llvm::AllocaInst *slot = entryBuilder.CreateAlloca(arg->getType(), nullptr, name + ".addr");
+    entryBuilder.CreateStore(arg, slot);
+    Ctxt.namedValues[name] = slot;
+    Ctxt.valueTypes[slot] = arg->getType();
+    type = arg->getType();
+    return slot;
+}
+
+//==============================================================================
+// Metadatos de alias
+//==============================================================================
+
+llvm::LoadInst *CodegenVisitor::emitLoad(llvm::Type *type, llvm::Value *ptr, const llvm::Twine &name) {
+    llvm::LoadInst *load = Ctxt.llvmBuilder.CreateLoad(type, ptr, name);
+    tagMemoryAccess(load, type, ptr);
+    return load;
+}
+
+llvm::StoreInst *CodegenVisitor::emitStore(llvm::Value *value, llvm::Value *ptr) {
+    llvm::StoreInst *store = Ctxt.llvmBuilder.CreateStore(value, ptr);
+    tagMemoryAccess(store, value->getType(), ptr);
+    return store;
+}
+
+/**
+ * @brief Etiqueta TBAA del tipo accedido y, para elementos de array, registro del array raíz.
+ * @details Un int y un float nunca comparten memoria en Umbra, así que la etiqueta escalar
+ *          basta para que LLVM separe accesos de tipos distintos. Los ámbitos noalias se
+ *          asignan al terminar la función, cuando ya se conocen todos sus arrays.
+ */
+void CodegenVisitor::tagMemoryAccess(llvm::Instruction *inst, llvm::Type *type, llvm::Value *ptr) {
+    if (type->isAggregateType())
+        return;
+    inst->setMetadata(llvm::LLVMContext::MD_tbaa, Ctxt.getTBAAAccessTag(type));
+    auto rootIt = arrayElementRoots.find(ptr);
+    if (rootIt != arrayElementRoots.end())
+        arrayAccesses.emplace_back(inst, rootIt->second);
+}
+
+/**
+ * @brief Scoped noalias entre los arrays de nivel superior de la función.
+ * @details Cada array local es un alloca propio y cada slice llega de un argumento distinto
+ *          (la llamada rechaza pasar el mismo array dos veces), así que dos arrays con nombre
+ *          distinto nunca se solapan. Cada acceso a un elemento lleva el ámbito de su array en
+ *          !alias.scope y los de todos los demás en !noalias. Los accesos por `ptr`/`ref` no
+ *          llevan ámbito y LLVM los sigue tratando de forma conservadora.
+ */
+void CodegenVisitor::emitArrayAliasScopes(llvm::Function *F) {
+    std::vector<std::string> roots;
+    for (auto &access : arrayAccesses) {
+        if (std::find(roots.begin(), roots.end(), access.second) == roots.end())
+            roots.push_back(access.second);
+    }
+
+    if (roots.size() > 1) {
+        llvm::MDBuilder mdBuilder(Ctxt.llvmContext);
+        llvm::MDNode *domain = mdBuilder.createAnonymousAliasScopeDomain(F->getName());
+        std::unordered_map<std::string, llvm::MDNode *> scopes;
+        for (auto &root : roots)
+            scopes[root] = mdBuilder.createAnonymousAliasScope(domain, root);
+
+        std::unordered_map<std::string, std::pair<llvm::MDNode *, llvm::MDNode *>> tags;
+        for (auto &root : roots) {
+            std::vector<llvm::Metadata *> others;
+            for (auto &other : roots) {
+                if (other != root)
+                    others.push_back(scopes[other]);
+            }
+            tags[root] = {llvm::MDNode::get(Ctxt.llvmContext, {scopes[root]}),
+                          llvm::MDNode::get(Ctxt.llvmContext, others)};
+        }
+        for (auto &access : arrayAccesses) {
+            auto &tag = tags[access.second];
+            access.first->setMetadata(llvm::LLVMContext::MD_alias_scope, tag.first);
+            access.first->setMetadata(llvm::LLVMContext::MD_noalias, tag.second);
+        }
+    }
+
+    arrayAccesses.clear();
+    arrayElementRoots.clear();
 }
 
 llvm::Value *CodegenVisitor::visitPrimaryExpression(PrimaryExpression *node) {
@@ -158,6 +545,37 @@ llvm::Value *CodegenVisitor::emitExpr(Expression *expr) {
     return visit(expr);
 }
 
+/**
+ * @brief Convierte v al tipo destTy según las reglas implícitas del lenguaje.
+ * @details Si source es un literal numérico, la constante se vuelve a crear directamente en
+ *          destTy a partir del valor original: `double d = 0.1` no pasa por float.
+ */
+llvm::Value *CodegenVisitor::convertValue(llvm::Value *v, llvm::Type *destTy, Expression *source) {
+    if (!v || !destTy || v->getType() == destTy)
+        return v;
+    llvm::IRBuilder<> &B = Ctxt.llvmBuilder;
+    llvm::Type *srcTy = v->getType();
+
+    if (auto *literal = dynamic_cast<NumericLiteral *>(unwrap(source))) {
+        if (destTy->isIntegerTy() && srcTy->isIntegerTy())
+            return llvm::ConstantInt::get(destTy, literal->intValue, true);
+        if (destTy->isFloatingPointTy())
+            return llvm::ConstantFP::get(destTy, literal->asDouble());
+    }
+
+    if (srcTy->isIntegerTy() && destTy->isIntegerTy()) {
+        // bool se extiende con ceros; los enteros conservan el signo
+        if (srcTy->isIntegerTy(1))
+            return B.CreateZExt(v, destTy, "zext");
+        return B.CreateSExtOrTrunc(v, destTy, "sext");
+    }
+    if (srcTy->isIntegerTy() && destTy->isFloatingPointTy())
+        return B.CreateSIToFP(v, destTy, "sitofp");
+    if (srcTy->isFloatingPointTy() && destTy->isFloatingPointTy())
+        return B.CreateFPCast(v, destTy, "fpcast");
+    return v;
+}
+
 static bool isIntTy(llvm::Value *V, unsigned bits) { return V && V->getType()->isIntegerTy(bits); }
 
 static bool isBoolLike(llvm::Value *V) { return V && V->getType()->isIntegerTy(1); }
@@ -181,6 +599,46 @@ llvm::Value *CodegenVisitor::visitBinaryExpression(BinaryExpression *node) {
         return nullptr;
     const std::string &Op = node->op;
 
+    if (L->getType()->isVectorTy() || R->getType()->isVectorTy())
+        return emitVectorBinary(Op, L, R);
+
+    // int con long, float con double: el operando estrecho se ensancha
+    llvm::Type *LTy = L->getType();
+    llvm::Type *RTy = R->getType();
+    if (LTy != RTy && LTy->isIntegerTy() && RTy->isIntegerTy() && !LTy->isIntegerTy(1) && !RTy->isIntegerTy(1)) {
+        if (LTy->getIntegerBitWidth() < RTy->getIntegerBitWidth())
+            L = convertValue(L, RTy, node->left.get());
+        else
+            R = convertValue(R, LTy, node->right.get());
+    } else if (LTy != RTy && LTy->isFloatingPointTy() && RTy->isFloatingPointTy()) {
+        if (LTy->getPrimitiveSizeInBits() < RTy->getPrimitiveSizeInBits())
+            L = convertValue(L, RTy, node->left.get());
+        else
+            R = convertValue(R, LTy, node->right.get());
+    } else if (LTy->isFloatingPointTy() != RTy->isFloatingPointTy()) {
+        // Expresiones que el análisis semántico aún no recorre (p. ej. 'return'): el entero pasa a real
+        if (LTy->isFloatingPointTy())
+            R = convertValue(R, LTy, node->right.get());
+        else
+            L = convertValue(L, RTy, node->left.get());
+    }
+
+    if (L->getType()->isFloatingPointTy()) {
+        llvm::IRBuilder<> &B = Ctxt.llvmBuilder;
+        if (Op == "+") return B.CreateFAdd(L, R, "addtmp");
+        if (Op == "-") return B.CreateFSub(L, R, "subtmp");
+        if (Op == "*") return B.CreateFMul(L, R, "multmp");
+        if (Op == "/") return B.CreateFDiv(L, R, "divtmp");
+        if (Op == "%") return B.CreateFRem(L, R, "modtmp");
+        if (Op == "<" || Op == "less_than") return B.CreateFCmpOLT(L, R, "cmptmp");
+        if (Op == ">" || Op == "greater_than") return B.CreateFCmpOGT(L, R, "cmptmp");
+        if (Op == "<=" || Op == "less_or_equal") return B.CreateFCmpOLE(L, R, "cmptmp");
+        if (Op == ">=" || Op == "greater_or_equal") return B.CreateFCmpOGE(L, R, "cmptmp");
+        if (Op == "==" || Op == "equal") return B.CreateFCmpOEQ(L, R, "cmptmp");
+        if (Op == "!=" || Op == "different") return B.CreateFCmpUNE(L, R, "cmptmp");
+        return nullptr;
+    }
+
     // Aritméticos básicos
     if (Op == "+")
         return Ctxt.llvmBuilder.CreateAdd(L, R, "addtmp");
@@ -205,14 +663,14 @@ llvm::Value *CodegenVisitor::visitBinaryExpression(BinaryExpression *node) {
         return Ctxt.llvmBuilder.CreateOr(L, R, "ortmp");
     }
 
-    // Comparadores palabra clave
-    if (Op == "less_than")
+    // Comparadores: el parser produce "<", ">", ...; se aceptan también las palabras clave
+    if (Op == "less_than" || Op == "<")
         return Ctxt.llvmBuilder.CreateICmpSLT(L, R, "cmptmp");
-    if (Op == "greater_than")
+    if (Op == "greater_than" || Op == ">")
         return Ctxt.llvmBuilder.CreateICmpSGT(L, R, "cmptmp");
-    if (Op == "less_or_equal")
+    if (Op == "less_or_equal" || Op == "<=")
         return Ctxt.llvmBuilder.CreateICmpSLE(L, R, "cmptmp");
-    if (Op == "greater_or_equal")
+    if (Op == "greater_or_equal" || Op == ">=")
         return Ctxt.llvmBuilder.CreateICmpSGE(L, R, "cmptmp");
     if (Op == "equal" || Op == "==")
         return Ctxt.llvmBuilder.CreateICmpEQ(L, R, "cmptmp");
@@ -226,54 +684,69 @@ llvm::Value *CodegenVisitor::visitFunctionCall(FunctionCall *node) {
     if (!node || !node->functionName)
         return nullptr;
     const std::string &fname = node->functionName->name;
-    // Por ahora solo soportamos print(string|int, ...) -> void mapeado a printf
+    // print("...{}...", args...) -> llamadas directas a libumbra_rt: el formato se
+    // resuelve aquí, en tiempo de compilación, sin pasar por el parser de printf
     if (fname == "print") {
-        if (!node->arguments.empty()) {
-            // Construir formato dinámico
-            std::string fmtStr;
-            std::vector<llvm::Value *> callArgs;
-
-            // Obtener el formato de string
-            auto *strLit = dynamic_cast<StringLiteral *>(node->arguments[0].get());
-            if (!strLit) return nullptr;
-
-            fmtStr = strLit->value;
-            size_t argIdx = 1;
-            size_t pos = 0;
-
-            while((pos = fmtStr.find("{}")) != std::string::npos && argIdx < node->argTypes.size()) {
-                auto &arg = node->argTypes[argIdx];
-                std::string fmtCode = "%d";
-                if (arg == SemanticType::String)
-                    fmtCode = "%s";
-                else if (arg == SemanticType::Int || arg == SemanticType::Bool)
-                    fmtCode = "%d";
-                else if (arg == SemanticType::Float)
-                    fmtCode = "%f";
-                else if (arg == SemanticType::Char)
-                    fmtCode = "%c";
-                fmtStr.replace(pos, 2, fmtCode);
-                ++argIdx;
-            }
-            fmtStr += "\n";
-            auto *fmt = getOrCreateGlobalString(Ctxt, fmtStr, "fmt");
-            callArgs.push_back(fmt);
-
-            // Agregar los argumentos
-            for (size_t i = 1; i < node->arguments.size(); ++i) {
-                llvm::Value *v = emitExpr(node->arguments[i].get());
-                if (v && v->getType()->isIntegerTy(1)) {
-                    // Extender bool a int32 para printf
-                    v = Ctxt.llvmBuilder.CreateZExt(v, llvm::Type::getInt32Ty(Ctxt.llvmContext));
-                }
-                callArgs.push_back(v);
-            }
-            // Llamar a printf
-            llvm::Function *printfFunc = Ctxt.getPrintfFunction();
-            return Ctxt.llvmBuilder.CreateCall(printfFunc, callArgs);
+        if (node->arguments.empty())
+            return nullptr;
+
+        auto *strLit = dynamic_cast<StringLiteral *>(unwrapPrintFormat(node->arguments[0].get()));
+        if (!strLit) return nullptr;
+
+        // Los argumentos se evalúan todos y en orden, aunque sobren marcadores
+        std::vector<llvm::Value *> values;
+        for (size_t i = 1; i < node->arguments.size(); ++i) {
+            values.push_back(emitExpr(node->arguments[i].get()));
         }
-        return nullptr;
+
+        const std::string &fmtStr = strLit->value;
+        size_t segStart = 0;
+        size_t pos = 0;
+        size_t argIdx = 0;
+        llvm::Value *last = nullptr;
+        while ((pos = fmtStr.find("{}", segStart)) != std::string::npos && argIdx < values.size()) {
+            emitPrintLiteral(fmtStr.substr(segStart, pos - segStart));
+            last = emitPrintValue(values[argIdx++]);
+            segStart = pos + 2;
+        }
+        emitPrintLiteral(fmtStr.substr(segStart));
+
+        auto *voidTy = llvm::Type::getVoidTy(Ctxt.llvmContext);
+        llvm::Function *newline = Ctxt.getRuntimeFunction(
+            "umbra_print_newline", llvm::FunctionType::get(voidTy, false));
+        last = Ctxt.llvmBuilder.CreateCall(newline);
+        return last;
+    }
+    // read_int/read_float/read_line -> lectura con buffer de libumbra_rt
+    llvm::Type *readTy = nullptr;
+    const char *readFn = nullptr;
+    if (fname == "read_int") {
+        readTy = llvm::Type::getInt32Ty(Ctxt.llvmContext);
+        readFn = "umbra_read_i32";
+    } else if (fname == "read_long") {
+        readTy = llvm::Type::getInt64Ty(Ctxt.llvmContext);
+        readFn = "umbra_read_i64";
+    } else if (fname == "read_float") {
+        readTy = llvm::Type::getFloatTy(Ctxt.llvmContext);
+        readFn = "umbra_read_f32";
+    } else if (fname == "read_double") {
+        readTy = llvm::Type::getDoubleTy(Ctxt.llvmContext);
+        readFn = "umbra_read_f64";
+    } else if (fname == "read_line") {
+        readTy = llvm::Type::getInt8Ty(Ctxt.llvmContext)->getPointerTo();
+        readFn = "umbra_read_line";
     }
+    if (readFn) {
+        llvm::Function *reader =
+            Ctxt.getRuntimeFunction(readFn, llvm::FunctionType::get(readTy, false));
+        return Ctxt.llvmBuilder.CreateCall(reader, {}, fname);
+    }
+
+    // splat4/splat8, lane, with_lane, hsum/hmin/hmax, select
+    if (llvm::Value *v = emitVectorBuiltin(node)) {
+        return v;
+    }
+
     // Funciones del usuario: buscar en el módulo y llamar
     llvm::Function *callee = Ctxt.llvmModule.getFunction(fname);
     if (!callee) {
@@ -281,23 +754,153 @@ llvm::Value *CodegenVisitor::visitFunctionCall(FunctionCall *node) {
     }
     std::vector<llvm::Value *> argsV;
     argsV.reserve(node->arguments.size());
-    for (auto &a : node->arguments) {
-        llvm::Value *v = emitExpr(a.get());
+    llvm::FunctionType *calleeTy = callee->getFunctionType();
+    auto defIt = functionDefinitions.find(fname);
+    ParameterList *params = defIt != functionDefinitions.end() ? defIt->second->parameters.get() : nullptr;
+    for (size_t i = 0; i < node->arguments.size(); ++i) {
+        Expression *arg = node->arguments[i].get();
+        Type *paramType = params && i < params->parameters.size() ? params->parameters[i].first.get() : nullptr;
+        // Arrays: (puntero, longitudes) sin copia; `ref T`: dirección de la variable
+        if (paramType && paramType->arrayDimensions > 0) {
+            if (!emitSliceArgument(arg, argsV))
+                return nullptr;
+            continue;
+        }
+        if (paramType && paramType->isReference) {
+            llvm::Value *address = getAddressOf(arg);
+            if (!address)
+                return nullptr;
+            argsV.push_back(address);
+            continue;
+        }
+        llvm::Value *v = emitExpr(arg);
+        if (argsV.size() < calleeTy->getNumParams())
+            v = convertValue(v, calleeTy->getParamType(argsV.size()), arg);
         argsV.push_back(v);
     }
     return Ctxt.llvmBuilder.CreateCall(callee, argsV);
 }
 
+/**
+ * @brief Argumento para un parámetro slice: puntero al primer elemento y longitudes.
+ * @details Un array local aporta su alloca y los tamaños de su tipo; un slice recibido se
+ *          reenvía tal cual.
+ */
+bool CodegenVisitor::emitSliceArgument(Expression *arg, std::vector<llvm::Value *> &argsV) {
+    if (auto *primary = dynamic_cast<PrimaryExpression *>(arg)) {
+        arg = primary->identifier.get();
+    }
+    auto *id = dynamic_cast<Identifier *>(arg);
+    if (!id)
+        return false;
+
+    auto sliceIt = sliceParams.find(id->name);
+    if (sliceIt != sliceParams.end()) {
+        argsV.push_back(sliceIt->second.data);
+        argsV.insert(argsV.end(), sliceIt->second.lengths.begin(), sliceIt->second.lengths.end());
+        return true;
+    }
+
+    auto it = Ctxt.namedValues.find(id->name);
+    if (it == Ctxt.namedValues.end())
+        return false;
+    auto typeIt = Ctxt.valueTypes.find(it->second);
+    if (typeIt == Ctxt.valueTypes.end() || !typeIt->second->isArrayTy())
+        return false;
+
+    llvm::Type *i64 = llvm::Type::getInt64Ty(Ctxt.llvmContext);
+    std::vector<llvm::Value *> zeros(1, llvm::ConstantInt::get(i64, 0));
+    std::vector<llvm::Value *> lengths;
+    for (llvm::Type *t = typeIt->second; t->isArrayTy(); t = t->getArrayElementType()) {
+        lengths.push_back(llvm::ConstantInt::get(i64, t->getArrayNumElements()));
+        zeros.push_back(zeros.front());
+    }
+    argsV.push_back(Ctxt.llvmBuilder.CreateInBoundsGEP(typeIt->second, it->second, zeros, id->name + ".data"));
+    argsV.insert(argsV.end(), lengths.begin(), lengths.end());
+    return true;
+}
+
+Expression *CodegenVisitor::unwrapPrintFormat(Expression *expr) {
+    auto *primary = dynamic_cast<PrimaryExpression *>(expr);
+    if (primary && primary->exprType == PrimaryExpression::LITERAL)
+        return primary->literal.get();
+    return expr;
+}
+
+void CodegenVisitor::emitPrintLiteral(const std::string &text) {
+    if (text.empty())
+        return;
+    auto *i8PtrTy = llvm::Type::getInt8Ty(Ctxt.llvmContext)->getPointerTo();
+    llvm::Function *printStr = Ctxt.getRuntimeFunction(
+        "umbra_print_str",
+        llvm::FunctionType::get(llvm::Type::getVoidTy(Ctxt.llvmContext), {i8PtrTy}, false));
+    Ctxt.llvmBuilder.CreateCall(printStr, {getOrCreateGlobalString(Ctxt, text, "str")});
+}
+
+llvm::Value *CodegenVisitor::emitPrintValue(llvm::Value *v) {
+    if (!v)
+        return nullptr;
+
+    // La primitiva se elige por el tipo LLVM del valor ya emitido
+    llvm::Type *ty = v->getType();
+
+    // Vectores: <a, b, c, d>
+    if (auto *vecTy = llvm::dyn_cast<llvm::FixedVectorType>(ty)) {
+        emitPrintLiteral("<");
+        llvm::Value *last = nullptr;
+        for (unsigned k = 0; k < vecTy->getNumElements(); ++k) {
+            if (k) emitPrintLiteral(", ");
+            last = emitPrintValue(Ctxt.llvmBuilder.CreateExtractElement(v, k));
+        }
+        emitPrintLiteral(">");
+        return last;
+    }
+
+    const char *name = nullptr;
+    if (ty->isIntegerTy(1)) {
+        v = Ctxt.llvmBuilder.CreateZExt(v, llvm::Type::getInt32Ty(Ctxt.llvmContext));
+        name = "umbra_print_i32";
+    } else if (ty->isIntegerTy(8)) {
+        name = "umbra_print_char";
+    } else if (ty->isIntegerTy(32)) {
+        name = "umbra_print_i32";
+    } else if (ty->isIntegerTy(64)) {
+        name = "umbra_print_i64";
+    } else if (ty->isFloatTy()) {
+        name = "umbra_print_f32";
+    } else if (ty->isDoubleTy()) {
+        name = "umbra_print_f64";
+    } else if (ty->isPointerTy()) {
+        name = "umbra_print_str";
+    } else {
+        return nullptr;
+    }
+
+    llvm::Function *fn = Ctxt.getRuntimeFunction(
+        name,
+        llvm::FunctionType::get(llvm::Type::getVoidTy(Ctxt.llvmContext), {v->getType()}, false));
+    return Ctxt.llvmBuilder.CreateCall(fn, {v});
+}
+
 llvm::Value *CodegenVisitor::visitReturnExpression(ReturnExpression *node) {
     if (!node->returnValue) {
         Ctxt.llvmBuilder.CreateRetVoid();
         return nullptr;
     }
+    FunctionCall *tailCall = asTailCallTo(node, nullptr);
+    if (tailCall && tailCall->functionName->name == tailRecursion.name && emitSelfTailCall(tailCall)) {
+        return nullptr;
+    }
+
     llvm::Value *v = emitExpr(node->returnValue.get());
-    // Ajustar bool -> i32 si la función retorna i32
+    // Ajustar al tipo de retorno (bool -> i32, int -> long, float -> double)
     llvm::Function *F = Ctxt.llvmBuilder.GetInsertBlock()->getParent();
-    if (F && F->getReturnType()->isIntegerTy(32) && v && v->getType()->isIntegerTy(1)) {
-        v = Ctxt.llvmBuilder.CreateZExt(v, llvm::Type::getInt32Ty(Ctxt.llvmContext));
+    if (F && v) {
+        // Solo es llamada de cola si no hace falta convertir el resultado
+        if (tailCall && v->getType() == F->getReturnType()) {
+            markTailCall(v, tailCall);
+        }
+        v = convertValue(v, F->getReturnType(), node->returnValue.get());
     }
     Ctxt.llvmBuilder.CreateRet(v);
     return v;
@@ -340,6 +943,11 @@ llvm::Value* CodegenVisitor::visitVariableDeclaration(VariableDeclaration* node)
 
     Ctxt.namedValues[vName] = alloca;
     Ctxt.valueTypes[alloca] = vType;
+    if(node->type->isPointer && node->type->baseType){
+        pointeeTypes[vName] = typeNodeToLLVMType(node->type->baseType.get(), Ctxt.llvmContext);
+    } else {
+        pointeeTypes.erase(vName);
+    }
 
     if(node->type->arrayDimensions > 0){
         return alloca;
@@ -352,17 +960,15 @@ llvm::Value* CodegenVisitor::visitVariableDeclaration(VariableDeclaration* node)
         if(initVal && initVal->getType()->isVoidTy()){
             initVal = llvm::Constant::getNullValue(baseType);
         }
-        else if(initVal && baseType->isIntegerTy(32) && initVal->getType()->isIntegerTy(1)){
-            initVal = Ctxt.llvmBuilder.CreateZExt(initVal, baseType, vName + ".zext");
-        }else if(initVal && baseType->isFloatTy() && initVal->getType()->isIntegerTy(32)){
-            initVal = Ctxt.llvmBuilder.CreateSIToFP(initVal, baseType, vName + ".sitofp");
+        else if(initVal && !baseType->isPointerTy()){
+            initVal = convertValue(initVal, baseType, node->initializer.get());
         }
     }else{
         initVal = llvm::Constant::getNullValue(baseType);
     }
 
     if(initVal){
-        Ctxt.llvmBuilder.CreateStore(initVal, alloca);
+        emitStore(initVal, alloca);
     }
     return alloca;
 
@@ -374,40 +980,62 @@ llvm::Value* CodegenVisitor::visitAssignmentStatement(AssignmentStatement* node)
     if(!rhs) return nullptr;
 
     if(auto id = dynamic_cast<Identifier*>(node->target.get())){
-        auto it = Ctxt.namedValues.find(id->name);
-        if(it == Ctxt.namedValues.end()){
-            return nullptr;
-        }
+        llvm::Type* destTy = nullptr;
+        llvm::Value* slot = getVariableSlot(id->name, destTy, true);
+        if(!slot) return nullptr;
 
-        llvm::Value* ptr = it->second;
-        auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(ptr);
-        if(!alloca) return nullptr;
-
-        llvm::Type* destTy = alloca->getAllocatedType();
-        if(destTy->isIntegerTy(32) && rhs->getType()->isIntegerTy(32)){
-            rhs = Ctxt.llvmBuilder.CreateZExt(rhs, destTy, "bool_to_i32");
-        }else if (destTy->isFloatTy() && rhs->getType()->isIntegerTy(32)){
-            rhs = Ctxt.llvmBuilder.CreateSIToFP(rhs, destTy, "i32_to_float");
+        if(!destTy->isPointerTy()){
+            rhs = convertValue(rhs, destTy, node->value.get());
         }
-        return Ctxt.llvmBuilder.CreateStore(rhs, alloca);
+        return emitStore(rhs, slot);
     }
     
+    // access p = v: store con el tipo apuntado declarado para p
+    if(auto deref = dynamic_cast<UnaryExpression*>(node->target.get()); deref && deref->op == "access"){
+        llvm::Type* pointee = pointeeTypeOf(deref->operand.get());
+        llvm::Value* ptrVal = emitExpr(deref->operand.get());
+        if(!pointee || !ptrVal || !ptrVal->getType()->isPointerTy()) return nullptr;
+        rhs = convertValue(rhs, pointee, node->value.get());
+        return emitStore(rhs, ptrVal);
+    }
+
     if(auto primaryExpr = dynamic_cast<PrimaryExpression*>(node->target.get())){
         if(primaryExpr->exprType == PrimaryExpression::ARRAY_ACCESS && primaryExpr->arrayAccess){
             llvm::Value* elementPtr = getArrayElementPtr(primaryExpr->arrayAccess.get());
             if(!elementPtr) return nullptr;
-            return Ctxt.llvmBuilder.CreateStore(rhs, elementPtr);
+            auto typeIt = Ctxt.valueTypes.find(elementPtr);
+            if(typeIt != Ctxt.valueTypes.end() && !typeIt->second->isAggregateType()){
+                rhs = convertValue(rhs, typeIt->second, node->value.get());
+            }
+            return emitStore(rhs, elementPtr);
+        }
+    }
+
+    // El parser genera el acceso a[i] = v sin envolver en PrimaryExpression
+    if(auto access = dynamic_cast<ArrayAccessExpression*>(node->target.get())){
+        llvm::Value* elementPtr = getArrayElementPtr(access);
+        if(!elementPtr) return nullptr;
+        auto typeIt = Ctxt.valueTypes.find(elementPtr);
+        if(typeIt != Ctxt.valueTypes.end() && !typeIt->second->isAggregateType()){
+            rhs = convertValue(rhs, typeIt->second, node->value.get());
         }
+        return emitStore(rhs, elementPtr);
     }
     
     return nullptr;
 }
 
 llvm::Value* CodegenVisitor::getArrayElementPtr(ArrayAccessExpression* node){
+    if(!sliceParams.empty()){
+        if(llvm::Value* elementPtr = getSliceElementPtr(node)) return elementPtr;
+    }
+
     llvm::Value* basePtr = nullptr;
     llvm::Type* baseType = nullptr;
+    std::string root;
     
     if(auto id = dynamic_cast<Identifier*>(node->array.get())){
+        root = id->name;
         auto it = Ctxt.namedValues.find(id->name);
         if(it == Ctxt.namedValues.end()){
             return nullptr;
@@ -420,10 +1048,23 @@ llvm::Value* CodegenVisitor::getArrayElementPtr(ArrayAccessExpression* node){
         } else if(auto alloca = llvm::dyn_cast<llvm::AllocaInst>(basePtr)){
             baseType = alloca->getAllocatedType();
         }
+    } else if(auto inner = dynamic_cast<ArrayAccessExpression*>(node->array.get())){
+        // a[i][j]: el parser anida los accesos directamente
+        basePtr = getArrayElementPtr(inner);
+        if(!basePtr) return nullptr;
+        auto rootIt = arrayElementRoots.find(basePtr);
+        if(rootIt != arrayElementRoots.end()) root = rootIt->second;
+
+        auto typeIt = Ctxt.valueTypes.find(basePtr);
+        if(typeIt != Ctxt.valueTypes.end()){
+            baseType = typeIt->second;
+        }
     } else if(auto primaryExpr = dynamic_cast<PrimaryExpression*>(node->array.get())){
         if(primaryExpr->exprType == PrimaryExpression::ARRAY_ACCESS && primaryExpr->arrayAccess){
             basePtr = getArrayElementPtr(primaryExpr->arrayAccess.get());
             if(!basePtr) return nullptr;
+            auto rootIt = arrayElementRoots.find(basePtr);
+            if(rootIt != arrayElementRoots.end()) root = rootIt->second;
             
             auto typeIt = Ctxt.valueTypes.find(basePtr);
             if(typeIt != Ctxt.valueTypes.end()){
@@ -444,9 +1085,9 @@ llvm::Value* CodegenVisitor::getArrayElementPtr(ArrayAccessExpression* node){
     
     llvm::Value* indexVal = emitExpr(node->index.get());
     if(!indexVal) return nullptr;
-    // GEP expects 64-bit indices for pointer arithmetic
+    // GEP expects 64-bit indices; sign-extend so a negative int index stays negative
     if(indexVal->getType()->isIntegerTy() && indexVal->getType()->getIntegerBitWidth() < 64){
-        indexVal = Ctxt.llvmBuilder.CreateZExt(indexVal, llvm::Type::getInt64Ty(Ctxt.llvmContext), "idx64");
+        indexVal = Ctxt.llvmBuilder.CreateSExt(indexVal, llvm::Type::getInt64Ty(Ctxt.llvmContext), "idx64");
     }
 
     std::vector<llvm::Value*> indices;
@@ -457,6 +1098,10 @@ llvm::Value* CodegenVisitor::getArrayElementPtr(ArrayAccessExpression* node){
     llvm::Type* elementType = nullptr;
     if(auto arrayType = llvm::dyn_cast<llvm::ArrayType>(baseType)){
         elementType = arrayType->getElementType();
+
+        if(Ctxt.boundsCheck){
+            emitBoundsCheck(node, indexVal, arrayType->getNumElements());
+        }
         
         llvm::Value* elementPtr = Ctxt.llvmBuilder.CreateInBoundsGEP(
             baseType,
@@ -466,12 +1111,69 @@ llvm::Value* CodegenVisitor::getArrayElementPtr(ArrayAccessExpression* node){
         );
         
         Ctxt.valueTypes[elementPtr] = elementType;
+        if(!root.empty()) arrayElementRoots[elementPtr] = root;
         return elementPtr;
     }
     
     return nullptr;
 }
 
+/**
+ * @brief Elemento de un parámetro slice indexado en todas sus dimensiones.
+ * @details m[i][j] sobre un slice de longitudes (n0, n1) -> data + (i * n1 + j). Con
+ *          --bounds-check cada índice se compara con la longitud recibida en tiempo de ejecución.
+ * @return nullptr si la base no es un slice o no se indexan todas las dimensiones.
+ */
+llvm::Value* CodegenVisitor::getSliceElementPtr(ArrayAccessExpression* node){
+    // a[i][j]: el parser anida los accesos; se recogen de fuera hacia dentro
+    std::vector<ArrayAccessExpression*> accesses;
+    Expression* current = node;
+    while(current){
+        if(auto* access = dynamic_cast<ArrayAccessExpression*>(current)){
+            accesses.push_back(access);
+            current = access->array.get();
+        } else if(auto* primary = dynamic_cast<PrimaryExpression*>(current)){
+            if(primary->exprType == PrimaryExpression::ARRAY_ACCESS && primary->arrayAccess){
+                current = primary->arrayAccess.get();
+            } else if(primary->exprType == PrimaryExpression::IDENTIFIER && primary->identifier){
+                current = primary->identifier.get();
+            } else {
+                return nullptr;
+            }
+        } else {
+            break;
+        }
+    }
+    auto* id = dynamic_cast<Identifier*>(current);
+    if(!id) return nullptr;
+    auto sliceIt = sliceParams.find(id->name);
+    if(sliceIt == sliceParams.end() || accesses.size() != sliceIt->second.lengths.size()) return nullptr;
+    const ArraySlice& slice = sliceIt->second;
+
+    llvm::IRBuilder<>& B = Ctxt.llvmBuilder;
+    llvm::Type* i64 = llvm::Type::getInt64Ty(Ctxt.llvmContext);
+    llvm::Value* linear = nullptr;
+    for(size_t d = 0; d < slice.lengths.size(); ++d){
+        ArrayAccessExpression* access = accesses[accesses.size() - 1 - d];
+        llvm::Value* index = emitExpr(access->index.get());
+        if(!index || !index->getType()->isIntegerTy()) return nullptr;
+        index = B.CreateSExtOrTrunc(index, i64, "idx64");
+
+        if(Ctxt.boundsCheck && !provenInBounds.count(access)){
+            llvm::Value* failCond = B.CreateICmpUGE(index, slice.lengths[d], "bounds.fail");
+            emitBoundsFailure(failCond, index, slice.lengths[d], access);
+        }
+        linear = linear ? B.CreateAdd(B.CreateMul(linear, slice.lengths[d], "slice.row", false, true),
+                                      index, "slice.idx", false, true)
+                        : index;
+    }
+
+    llvm::Value* elementPtr = B.CreateInBoundsGEP(slice.elementType, slice.data, linear, "sliceidx");
+    Ctxt.valueTypes[elementPtr] = slice.elementType;
+    arrayElementRoots[elementPtr] = id->name;
+    return elementPtr;
+}
+
 llvm::Value* CodegenVisitor::visitArrayAccess(ArrayAccessExpression* node){
     llvm::Value* elementPtr = getArrayElementPtr(node);
     if(!elementPtr) return nullptr;
@@ -487,11 +1189,137 @@ llvm::Value* CodegenVisitor::visitArrayAccess(ArrayAccessExpression* node){
         return elementPtr;
     }
     
-    return Ctxt.llvmBuilder.CreateLoad(
-        elementType,
-        elementPtr,
-        "arrayload"
-    );
+    return emitLoad(elementType, elementPtr, "arrayload");
+}
+
+llvm::Value* CodegenVisitor::visitArrayAccessExpression(ArrayAccessExpression* node){
+    return visitArrayAccess(node);
+}
+
+//==============================================================================
+// --bounds-check
+//==============================================================================
+
+/**
+ * @brief Protege el acceso a un array de tamaño size con una comprobación de rango.
+ * @details
+ * Se omite si el análisis de rangos demostró que el índice es válido, si la comprobación
+ * ya se adelantó al preheader del bucle o si el índice es una constante válida.
+ */
+void CodegenVisitor::emitBoundsCheck(ArrayAccessExpression* node, llvm::Value* index64, uint64_t size){
+    if(provenInBounds.count(node)) return;
+
+    if(auto constIdx = llvm::dyn_cast<llvm::ConstantInt>(index64)){
+        if(constIdx->getZExtValue() < size) return;
+    }
+    if(auto range = rangeAnalysis.staticRange(node)){
+        if(range->lo >= 0 && static_cast<uint64_t>(range->hi) < size) return;
+    }
+
+    // Comparación sin signo: cubre a la vez índices negativos y >= size
+    llvm::Value* failCond = Ctxt.llvmBuilder.CreateICmpUGE(
+        index64, llvm::ConstantInt::get(index64->getType(), size), "bounds.fail");
+    emitBoundsFailure(failCond, index64, llvm::ConstantInt::get(index64->getType(), size), node);
+}
+
+/**
+ * @brief Evalúa en el preheader de un bucle el rango de los accesos afines a su variable de
+ *        inducción: índice en la primera y en la última iteración.
+ * @details No aborta: devuelve la condición "todos en rango" (nullptr si no hay nada que
+ *          comprobar en tiempo de ejecución) y deja en hoisted los accesos que cubre. Los
+ *          que el rango estático ya demuestra válidos van directamente a provenInBounds.
+ */
+llvm::Value* CodegenVisitor::emitHoistedBoundsChecks(RepeatTimesStatement* node, llvm::Value* timesVal,
+                                                     std::vector<const ArrayAccessExpression*>& hoisted){
+    const std::vector<HoistedBoundsCheck>* checks = rangeAnalysis.checksFor(node);
+    if(!checks) return nullptr;
+
+    llvm::IRBuilder<>& B = Ctxt.llvmBuilder;
+    llvm::Type* i64 = llvm::Type::getInt64Ty(Ctxt.llvmContext);
+    llvm::Value* inRange = nullptr;
+
+    for(const HoistedBoundsCheck& check : *checks){
+        // Dimensión indexada: se desciende 'level' niveles por el tipo del array base
+        auto it = Ctxt.namedValues.find(check.arrayName);
+        if(it == Ctxt.namedValues.end()) continue;
+        auto typeIt = Ctxt.valueTypes.find(it->second);
+        if(typeIt == Ctxt.valueTypes.end()) continue;
+
+        llvm::Type* dimType = typeIt->second;
+        for(unsigned l = 0; l < check.level && dimType && dimType->isArrayTy(); ++l){
+            dimType = dimType->getArrayElementType();
+        }
+        auto* arrayType = llvm::dyn_cast_or_null<llvm::ArrayType>(dimType);
+        if(!arrayType) continue;
+        uint64_t size = arrayType->getNumElements();
+
+        // Índice constante o con rango estático válido: no hace falta comprobar nada
+        if(auto range = rangeAnalysis.staticRange(check.access)){
+            if(range->lo >= 0 && static_cast<uint64_t>(range->hi) < size){
+                provenInBounds.insert(check.access);
+                continue;
+            }
+        }
+
+        llvm::Value* first = emitExpr(check.access->index.get());
+        if(!first || !first->getType()->isIntegerTy()) continue;
+        first = B.CreateSExtOrTrunc(first, i64, "hoist.idx");
+
+        int64_t stride = check.coefficient * check.step;
+        llvm::Value* trips = B.CreateSExtOrTrunc(timesVal, i64, "hoist.trips");
+        llvm::Value* last = first;
+        if(stride != 0){
+            if(check.afterStep){
+                first = B.CreateAdd(first, llvm::ConstantInt::get(i64, stride, true), "hoist.first");
+            }
+            llvm::Value* span = B.CreateMul(
+                B.CreateSub(trips, llvm::ConstantInt::get(i64, 1)),
+                llvm::ConstantInt::get(i64, stride, true), "hoist.span");
+            last = B.CreateAdd(first, span, "hoist.last");
+        }
+
+        llvm::Value* sizeV = llvm::ConstantInt::get(i64, size);
+        llvm::Value* firstBad = B.CreateICmpUGE(first, sizeV, "hoist.first.bad");
+        llvm::Value* lastBad = B.CreateICmpUGE(last, sizeV, "hoist.last.bad");
+        llvm::Value* runs = B.CreateICmpSGT(trips, llvm::ConstantInt::get(i64, 0), "hoist.runs");
+        llvm::Value* ok = B.CreateNot(B.CreateAnd(runs, B.CreateOr(firstBad, lastBad)), "hoist.ok");
+        inRange = inRange ? B.CreateAnd(inRange, ok, "hoist.ok") : ok;
+        hoisted.push_back(check.access);
+    }
+    return inRange;
+}
+
+/**
+ * @brief Salta a un bloque que informa del acceso fuera de rango y aborta con llvm.trap.
+ *        La emisión continúa en el bloque "bounds.ok".
+ */
+void CodegenVisitor::emitBoundsFailure(llvm::Value* failCond, llvm::Value* index64, llvm::Value* size64,
+                                       ArrayAccessExpression* node){
+    llvm::IRBuilder<>& B = Ctxt.llvmBuilder;
+    llvm::Function* F = B.GetInsertBlock()->getParent();
+    llvm::BasicBlock* failBB = llvm::BasicBlock::Create(Ctxt.llvmContext, "bounds.trap", F);
+    llvm::BasicBlock* okBB = llvm::BasicBlock::Create(Ctxt.llvmContext, "bounds.ok", F);
+    B.CreateCondBr(failCond, failBB, okBB);
+
+    B.SetInsertPoint(failBB);
+    llvm::Type* i32 = llvm::Type::getInt32Ty(Ctxt.llvmContext);
+    llvm::Type* i64 = llvm::Type::getInt64Ty(Ctxt.llvmContext);
+    // El runtime vacía la salida pendiente y reporta por stderr
+    llvm::Function* report = Ctxt.getRuntimeFunction(
+        "umbra_rt_report_bounds",
+        llvm::FunctionType::get(llvm::Type::getVoidTy(Ctxt.llvmContext), {i64, i64, i32, i32}, false));
+    report->addFnAttr(llvm::Attribute::Cold);
+    PresumedLocation where = Ctxt.resolveLocation(node->location);
+    B.CreateCall(report, {
+        index64,
+        size64,
+        llvm::ConstantInt::get(i32, where.line),
+        llvm::ConstantInt::get(i32, where.column)
+    });
+    B.CreateIntrinsic(llvm::Intrinsic::trap, {}, {});
+    B.CreateUnreachable();
+
+    B.SetInsertPoint(okBB);
 }
 
 llvm::Value *CodegenVisitor::visitIfStatement(IfStatement *node) {
@@ -533,7 +1361,8 @@ llvm::Value *CodegenVisitor::visitIfStatement(IfStatement *node) {
         for (auto &S : node->branches[i].body) {
             visit(S.get());
         }
-        if (!thenBlocks[i]->getTerminator()) {
+        // Un if/repeat anidado deja el punto de inserción en su propio bloque de salida
+        if (!Ctxt.llvmBuilder.GetInsertBlock()->getTerminator()) {
             Ctxt.llvmBuilder.CreateBr(mergeBB);
         }
 
@@ -546,7 +1375,7 @@ llvm::Value *CodegenVisitor::visitIfStatement(IfStatement *node) {
         for (auto &S : node->elseBranch) {
             visit(S.get());
         }
-        if (!elseBlock->getTerminator()) {
+        if (!Ctxt.llvmBuilder.GetInsertBlock()->getTerminator()) {
             Ctxt.llvmBuilder.CreateBr(mergeBB);
         }
     }
@@ -564,11 +1393,63 @@ llvm::Value *CodegenVisitor::visitRepeatTimesStatement(RepeatTimesStatement *nod
     if (!timesVal)
         return nullptr;
 
-    // Crear variable temporal para el contador
-    llvm::AllocaInst *counterAlloca = Ctxt.llvmBuilder.CreateAlloca(
-        llvm::Type::getInt32Ty(Ctxt.llvmContext), nullptr, "for.counter");
-    Ctxt.llvmBuilder.CreateStore(
-        llvm::ConstantInt::get(llvm::Type::getInt32Ty(Ctxt.llvmContext), 0), counterAlloca);
+    if (node->parallel) {
+        emitParallelRepeat(node, timesVal);
+        return nullptr;
+    }
+
+    // --bounds-check: si el preheader demuestra que todos los accesos afines están en rango se
+    // ejecuta una versión del bucle sin sus comprobaciones; si no, la versión que comprueba cada
+    // acceso, para que el error llegue en la iteración que falla y no antes de las anteriores
+    std::vector<const ArrayAccessExpression*> hoisted;
+    llvm::Value *inRange = Ctxt.boundsCheck && checkedLoopDepth == 0
+        ? emitHoistedBoundsChecks(node, timesVal, hoisted)
+        : nullptr;
+    if (!inRange) {
+        emitRepeatLoop(node, timesVal);
+        return nullptr;
+    }
+
+    llvm::BasicBlock *fastBB = llvm::BasicBlock::Create(Ctxt.llvmContext, "for.unchecked", F);
+    llvm::BasicBlock *checkedBB = llvm::BasicBlock::Create(Ctxt.llvmContext, "for.checked", F);
+    llvm::BasicBlock *doneBB = llvm::BasicBlock::Create(Ctxt.llvmContext, "for.done", F);
+    Ctxt.llvmBuilder.CreateCondBr(inRange, fastBB, checkedBB);
+
+    Ctxt.llvmBuilder.SetInsertPoint(fastBB);
+    provenInBounds.insert(hoisted.begin(), hoisted.end());
+    emitRepeatLoop(node, timesVal);
+    for (const ArrayAccessExpression *access : hoisted) {
+        provenInBounds.erase(access);
+    }
+    Ctxt.llvmBuilder.CreateBr(doneBB);
+
+    // La versión lenta no vuelve a versionar sus bucles internos: basta con una copia comprobada
+    Ctxt.llvmBuilder.SetInsertPoint(checkedBB);
+    ++checkedLoopDepth;
+    emitRepeatLoop(node, timesVal);
+    --checkedLoopDepth;
+    Ctxt.llvmBuilder.CreateBr(doneBB);
+
+    Ctxt.llvmBuilder.SetInsertPoint(doneBB);
+    return nullptr;
+}
+
+/**
+ * @brief Emite el bucle secuencial de `repeat N times` desde el bloque actual.
+ * @details --bounds-check puede emitirlo dos veces (ver visitRepeatTimesStatement).
+ */
+void CodegenVisitor::emitRepeatLoop(RepeatTimesStatement *node, llvm::Value *timesVal) {
+    llvm::Function *F = Ctxt.llvmBuilder.GetInsertBlock()->getParent();
+
+    // Contador de 64 bits: un long como número de repeticiones puede superar 2^31. El alloca
+    // va al bloque de entrada para que un bucle anidado no reserve pila en cada iteración
+    llvm::Type *counterTy = llvm::Type::getInt64Ty(Ctxt.llvmContext);
+    llvm::IRBuilder<> entryBuilder(&F->getEntryBlock(), F->getEntryBlock().begin());
+    llvm::AllocaInst *counterAlloca = entryBuilder.CreateAlloca(counterTy, nullptr, "for.counter");
+    Ctxt.llvmBuilder.CreateStore(llvm::ConstantInt::get(counterTy, 0), counterAlloca);
+    llvm::Value *trips = timesVal->getType()->isIntegerTy()
+        ? Ctxt.llvmBuilder.CreateSExtOrTrunc(timesVal, counterTy, "for.trips")
+        : llvm::ConstantInt::get(counterTy, 0);
 
     // Crear bloques baciso para el bucle
     llvm::BasicBlock *loopCondBB = llvm::BasicBlock::Create(Ctxt.llvmContext, "for.cond", F);
@@ -578,9 +1459,8 @@ llvm::Value *CodegenVisitor::visitRepeatTimesStatement(RepeatTimesStatement *nod
     Ctxt.llvmBuilder.CreateBr(loopCondBB);
 
     Ctxt.llvmBuilder.SetInsertPoint(loopCondBB);
-    llvm::Value *counterVal = Ctxt.llvmBuilder.CreateLoad(llvm::Type::getInt32Ty(Ctxt.llvmContext),
-                                                          counterAlloca, "counter.load");
-    llvm::Value *cond = Ctxt.llvmBuilder.CreateICmpSLT(counterVal, timesVal, "for.cmp");
+    llvm::Value *counterVal = Ctxt.llvmBuilder.CreateLoad(counterTy, counterAlloca, "counter.load");
+    llvm::Value *cond = Ctxt.llvmBuilder.CreateICmpSLT(counterVal, trips, "for.cmp");
     Ctxt.llvmBuilder.CreateCondBr(cond, loopBodyBB, loopEndBB);
 
     // loop.body: emitir cuerpo y aumentar contador
@@ -589,18 +1469,348 @@ llvm::Value *CodegenVisitor::visitRepeatTimesStatement(RepeatTimesStatement *nod
         visit(stmt.get());
     }
 
-    llvm::Value *currentCounterVal = Ctxt.llvmBuilder.CreateLoad(
-        llvm::Type::getInt32Ty(Ctxt.llvmContext), counterAlloca, "current.counter.load");
+    llvm::Value *currentCounterVal =
+        Ctxt.llvmBuilder.CreateLoad(counterTy, counterAlloca, "current.counter.load");
     llvm::Value *inc = Ctxt.llvmBuilder.CreateAdd(
-        currentCounterVal, llvm::ConstantInt::get(llvm::Type::getInt32Ty(Ctxt.llvmContext), 1),
-        "for.inc");
+        currentCounterVal, llvm::ConstantInt::get(counterTy, 1), "for.inc");
     Ctxt.llvmBuilder.CreateStore(inc, counterAlloca);
 
     Ctxt.llvmBuilder.CreateBr(loopCondBB);
 
     // loop.end: continuar
     Ctxt.llvmBuilder.SetInsertPoint(loopEndBB);
-    return nullptr;
+}
+
+//==============================================================================
+// Vectores SIMD (vec4 / vec8)
+//==============================================================================
+
+/**
+ * @brief Operador binario lane a lane sobre vec4/vec8.
+ * @details TypeCk garantiza que el otro operando es del mismo tipo vectorial o del tipo de
+ *          elemento; en ese caso se expande con splat. Las comparaciones producen un vector
+ *          i32 con 1/0 por lane, el formato que espera select().
+ */
+llvm::Value* CodegenVisitor::emitVectorBinary(const std::string& op, llvm::Value* L, llvm::Value* R){
+    llvm::IRBuilder<>& B = Ctxt.llvmBuilder;
+    auto* vecTy = llvm::cast<llvm::FixedVectorType>(L->getType()->isVectorTy() ? L->getType() : R->getType());
+    unsigned lanes = vecTy->getNumElements();
+    if (!L->getType()->isVectorTy()) L = B.CreateVectorSplat(lanes, L, "splat");
+    if (!R->getType()->isVectorTy()) R = B.CreateVectorSplat(lanes, R, "splat");
+    const bool isFP = vecTy->getElementType()->isFloatingPointTy();
+
+    if (op == "+") return isFP ? B.CreateFAdd(L, R, "vaddtmp") : B.CreateAdd(L, R, "vaddtmp");
+    if (op == "-") return isFP ? B.CreateFSub(L, R, "vsubtmp") : B.CreateSub(L, R, "vsubtmp");
+    if (op == "*") return isFP ? B.CreateFMul(L, R, "vmultmp") : B.CreateMul(L, R, "vmultmp");
+    if (op == "/") return isFP ? B.CreateFDiv(L, R, "vdivtmp") : B.CreateSDiv(L, R, "vdivtmp");
+    if (op == "%") return B.CreateSRem(L, R, "vmodtmp");
+
+    llvm::CmpInst::Predicate pred;
+    if (op == "==")      pred = isFP ? llvm::CmpInst::FCMP_OEQ : llvm::CmpInst::ICMP_EQ;
+    else if (op == "!=") pred = isFP ? llvm::CmpInst::FCMP_UNE : llvm::CmpInst::ICMP_NE;
+    else if (op == "<")  pred = isFP ? llvm::CmpInst::FCMP_OLT : llvm::CmpInst::ICMP_SLT;
+    else if (op == ">")  pred = isFP ? llvm::CmpInst::FCMP_OGT : llvm::CmpInst::ICMP_SGT;
+    else if (op == "<=") pred = isFP ? llvm::CmpInst::FCMP_OLE : llvm::CmpInst::ICMP_SLE;
+    else if (op == ">=") pred = isFP ? llvm::CmpInst::FCMP_OGE : llvm::CmpInst::ICMP_SGE;
+    else return nullptr;
+
+    llvm::Value* cmp = B.CreateCmp(pred, L, R, "vcmptmp");
+    return B.CreateZExt(cmp, llvm::FixedVectorType::get(B.getInt32Ty(), lanes), "vmask");
+}
+
+/**
+ * @brief Builtins SIMD validados por SymbolCollector::validateVectorBuiltin.
+ * @return nullptr si node no es un builtin vectorial.
+ * @details Un índice de lane no constante se toma módulo el número de lanes, de modo que
+ *          lane()/with_lane() nunca producen poison.
+ */
+llvm::Value* CodegenVisitor::emitVectorBuiltin(FunctionCall* node){
+    const std::string& fname = node->functionName->name;
+    const bool isSplat = fname == "splat4" || fname == "splat8";
+    const bool isLane = fname == "lane" || fname == "with_lane";
+    const bool isReduce = fname == "hsum" || fname == "hmin" || fname == "hmax";
+    if (!isSplat && !isLane && !isReduce && fname != "select") {
+        return nullptr;
+    }
+
+    llvm::IRBuilder<>& B = Ctxt.llvmBuilder;
+    std::vector<llvm::Value*> args;
+    for (auto& arg : node->arguments) {
+        llvm::Value* v = emitExpr(arg.get());
+        if (!v) return nullptr;
+        args.push_back(v);
+    }
+    if (args.empty()) return nullptr;
+
+    if (isSplat) {
+        return B.CreateVectorSplat(fname == "splat4" ? 4 : 8, args[0], "splat");
+    }
+    if (fname == "select") {
+        llvm::Value* mask = B.CreateICmpNE(args[0], llvm::Constant::getNullValue(args[0]->getType()), "vsel.mask");
+        return B.CreateSelect(mask, args[1], args[2], "vsel");
+    }
+
+    auto* vecTy = llvm::dyn_cast<llvm::FixedVectorType>(args[0]->getType());
+    if (!vecTy) return nullptr;
+    const bool isFP = vecTy->getElementType()->isFloatingPointTy();
+
+    if (isLane) {
+        llvm::Value* index = args[1];
+        if (!llvm::isa<llvm::ConstantInt>(index)) {
+            index = B.CreateAnd(index, llvm::ConstantInt::get(index->getType(), vecTy->getNumElements() - 1), "lane.idx");
+        }
+        if (fname == "lane") {
+            return B.CreateExtractElement(args[0], index, "lane");
+        }
+        return B.CreateInsertElement(args[0], args[2], index, "with_lane");
+    }
+
+    if (fname == "hsum") {
+        if (!isFP) return B.CreateAddReduce(args[0]);
+        // Suma horizontal: se permite reasociar para reducir en árbol y no lane a lane
+        auto* sum = B.CreateFAddReduce(llvm::ConstantFP::get(vecTy->getElementType(), 0.0), args[0]);
+        sum->setHasAllowReassoc(true);
+        return sum;
+    }
+    if (fname == "hmin") {
+        return isFP ? B.CreateFPMinReduce(args[0]) : B.CreateIntMinReduce(args[0], true);
+    }
+    return isFP ? B.CreateFPMaxReduce(args[0]) : B.CreateIntMaxReduce(args[0], true);
+}
+
+//==============================================================================
+// repeat N times in parallel
+//==============================================================================
+
+static void collectReferencedNames(Expression* expr, std::set<std::string>& out) {
+    if (!expr) return;
+    if (auto* id = dynamic_cast<Identifier*>(expr)) out.insert(id->name);
+    forEachChild(expr, [&](Expression* child) { collectReferencedNames(child, out); });
+}
+
+static void collectReferencedNames(Statement* stmt, std::set<std::string>& out) {
+    forEachPart(stmt,
+        [&](Expression* expr) { collectReferencedNames(expr, out); },
+        [&](const std::vector<std::unique_ptr<Statement>>& block) {
+            for (auto& inner : block) collectReferencedNames(inner.get(), out);
+        });
+}
+
+/**
+ * @brief Emite un repeat paralelo.
+ * @details
+ * El cuerpo se outlinea en `void <f>.parallel.<k>(i8* ctx, i64 begin, i64 end)`, que recorre
+ * [begin, end). Las variables externas que usa el cuerpo viajan en ctx como punteros:
+ * - arrays: se comparten (cada iteración escribe sus propias posiciones);
+ * - escalares: cada bloque trabaja sobre una copia privada inicializada con el valor externo
+ *   (SymbolCollector rechaza escribirlos: lo escrito en la copia se perdería);
+ * - variables de reduce(op: v): copia privada con el neutro de op, combinada atómicamente
+ *   con v al final de cada bloque. Se combina lo que quede en la copia, así que el cuerpo
+ *   debe plegar cada iteración en v (`v = v + x`, `if (x > v) { v = x }`).
+ * El reparto entre hilos lo hace umbra_rt_parallel_for (libumbra_rt).
+ */
+void CodegenVisitor::emitParallelRepeat(RepeatTimesStatement* node, llvm::Value* timesVal){
+    llvm::IRBuilder<>& B = Ctxt.llvmBuilder;
+    llvm::LLVMContext& C = Ctxt.llvmContext;
+    llvm::Type* i8PtrTy = llvm::Type::getInt8Ty(C)->getPointerTo();
+    llvm::Type* i32 = llvm::Type::getInt32Ty(C);
+    llvm::Type* i64 = llvm::Type::getInt64Ty(C);
+    llvm::Function* parent = B.GetInsertBlock()->getParent();
+    llvm::IRBuilder<> entryBuilder(&parent->getEntryBlock(), parent->getEntryBlock().begin());
+
+    // Variables externas usadas por el cuerpo
+    std::set<std::string> names;
+    for (auto& stmt : node->body) collectReferencedNames(stmt.get(), names);
+    for (auto& reduction : node->reductions) names.insert(reduction.target->name);
+    if (node->indexVar) names.erase(node->indexVar->name);
+
+    struct Capture {
+        std::string name;
+        llvm::Value* storage;
+        llvm::Type* type;
+        bool slicePart = false;
+    };
+    std::vector<Capture> captures;
+    for (const std::string& name : names) {
+        // Slices: puntero y longitudes viajan volcados a memoria, como los parámetros por valor
+        auto sliceIt = sliceParams.find(name);
+        if (sliceIt != sliceParams.end()) {
+            std::vector<llvm::Value*> parts{sliceIt->second.data};
+            parts.insert(parts.end(), sliceIt->second.lengths.begin(), sliceIt->second.lengths.end());
+            for (llvm::Value* part : parts) {
+                auto* spill = entryBuilder.CreateAlloca(part->getType(), nullptr, part->getName() + ".spill");
+                B.CreateStore(part, spill);
+                captures.push_back({name, spill, part->getType(), true});
+            }
+            continue;
+        }
+
+        auto it = Ctxt.namedValues.find(name);
+        if (it == Ctxt.namedValues.end()) continue;
+        llvm::Value* value = it->second;
+        auto refIt = referenceParams.find(name);
+        if (auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(value)) {
+            auto typeIt = Ctxt.valueTypes.find(alloca);
+            llvm::Type* type = typeIt != Ctxt.valueTypes.end() ? typeIt->second : alloca->getAllocatedType();
+            captures.push_back({name, alloca, type});
+        } else if (refIt != referenceParams.end()) {
+            // `ref T`: el puntero ya es la variable del llamador; se trata como un escalar externo
+            captures.push_back({name, value, refIt->second});
+        } else if (llvm::isa<llvm::Argument>(value)) {
+            // Los parámetros son valores SSA: se vuelcan a memoria para pasarlos por ctx
+            auto* spill = entryBuilder.CreateAlloca(value->getType(), nullptr, name + ".spill");
+            B.CreateStore(value, spill);
+            captures.push_back({name, spill, value->getType()});
+        }
+    }
+
+    auto* ctxTy = llvm::ArrayType::get(i8PtrTy, captures.size());
+    auto* ctxAlloca = entryBuilder.CreateAlloca(ctxTy, nullptr, "par.ctx");
+    for (size_t k = 0; k < captures.size(); ++k) {
+        llvm::Value* slot = B.CreateConstInBoundsGEP2_32(ctxTy, ctxAlloca, 0, k);
+        B.CreateStore(B.CreatePointerCast(captures[k].storage, i8PtrTy), slot);
+    }
+
+    // Función outlineada
+    auto* bodyTy = llvm::FunctionType::get(llvm::Type::getVoidTy(C), {i8PtrTy, i64, i64}, false);
+    llvm::Function* bodyFn = llvm::Function::Create(
+        bodyTy, llvm::Function::InternalLinkage,
+        parent->getName() + ".parallel." + std::to_string(parallelBodyCount++), Ctxt.llvmModule);
+    auto argIt = bodyFn->arg_begin();
+    llvm::Argument* ctxArg = &*argIt++;
+    llvm::Argument* beginArg = &*argIt++;
+    llvm::Argument* endArg = &*argIt;
+    ctxArg->setName("ctx");
+    beginArg->setName("begin");
+    endArg->setName("end");
+
+    auto savedNamedValues = Ctxt.namedValues;
+    auto savedSliceParams = sliceParams;
+    auto savedReferenceParams = referenceParams;
+    llvm::BasicBlock* savedBlock = B.GetInsertBlock();
+
+    B.SetInsertPoint(llvm::BasicBlock::Create(C, "entry", bodyFn));
+    llvm::Value* ctxPtr = B.CreatePointerCast(ctxArg, ctxTy->getPointerTo());
+
+    struct PartialReduction {
+        const Reduction* reduction;
+        llvm::Value* shared;
+        llvm::Value* partial;
+        llvm::Type* type;
+    };
+    std::vector<PartialReduction> partials;
+    for (size_t k = 0; k < captures.size(); ++k) {
+        const Capture& capture = captures[k];
+        llvm::Value* raw = B.CreateLoad(i8PtrTy, B.CreateConstInBoundsGEP2_32(ctxTy, ctxPtr, 0, k));
+        llvm::Value* shared = B.CreatePointerCast(raw, capture.type->getPointerTo(), capture.name + ".shared");
+
+        if (capture.slicePart) {
+            // Solo lectura: se recarga el slice dentro de la función outlineada
+            ArraySlice& slice = sliceParams[capture.name];
+            llvm::Value* part = B.CreateLoad(capture.type, shared, capture.name + ".slice");
+            if (capture.type->isPointerTy()) {
+                slice.data = part;
+                slice.lengths.clear();
+            } else {
+                slice.lengths.push_back(part);
+            }
+            continue;
+        }
+
+        if (capture.type->isArrayTy()) {
+            Ctxt.namedValues[capture.name] = shared;
+            Ctxt.valueTypes[shared] = capture.type;
+            continue;
+        }
+
+        const Reduction* reduction = nullptr;
+        for (auto& r : node->reductions) {
+            if (r.target->name == capture.name) reduction = &r;
+        }
+
+        auto* priv = B.CreateAlloca(capture.type, nullptr, capture.name + (reduction ? ".partial" : ".priv"));
+        Ctxt.namedValues[capture.name] = priv;
+        Ctxt.valueTypes[priv] = capture.type;
+        if (!reduction) {
+            B.CreateStore(B.CreateLoad(capture.type, shared), priv);
+            continue;
+        }
+
+        llvm::Value* identity = nullptr;
+        if (reduction->op == "min") {
+            identity = llvm::ConstantInt::get(capture.type,
+                llvm::APInt::getSignedMaxValue(capture.type->getIntegerBitWidth()));
+        } else if (reduction->op == "max") {
+            identity = llvm::ConstantInt::get(capture.type,
+                llvm::APInt::getSignedMinValue(capture.type->getIntegerBitWidth()));
+        } else {
+            identity = llvm::Constant::getNullValue(capture.type);
+        }
+        B.CreateStore(identity, priv);
+        partials.push_back({reduction, shared, priv, capture.type});
+    }
+
+    // El índice es long si el número de iteraciones lo es (como en SymbolCollector)
+    llvm::AllocaInst* indexAlloca = nullptr;
+    if (node->indexVar) {
+        llvm::Type* indexTy = timesVal->getType()->isIntegerTy(64) ? i64 : i32;
+        indexAlloca = B.CreateAlloca(indexTy, nullptr, node->indexVar->name);
+        Ctxt.namedValues[node->indexVar->name] = indexAlloca;
+        Ctxt.valueTypes[indexAlloca] = indexTy;
+    }
+
+    // for (it = begin; it < end; ++it)
+    llvm::AllocaInst* counter = B.CreateAlloca(i64, nullptr, "par.it");
+    B.CreateStore(beginArg, counter);
+    llvm::BasicBlock* condBB = llvm::BasicBlock::Create(C, "par.cond", bodyFn);
+    llvm::BasicBlock* loopBB = llvm::BasicBlock::Create(C, "par.body", bodyFn);
+    llvm::BasicBlock* exitBB = llvm::BasicBlock::Create(C, "par.end", bodyFn);
+    B.CreateBr(condBB);
+
+    B.SetInsertPoint(condBB);
+    llvm::Value* it = B.CreateLoad(i64, counter, "par.it.ld");
+    B.CreateCondBr(B.CreateICmpSLT(it, endArg, "par.cmp"), loopBB, exitBB);
+
+    B.SetInsertPoint(loopBB);
+    if (indexAlloca) {
+        B.CreateStore(B.CreateSExtOrTrunc(it, indexAlloca->getAllocatedType()), indexAlloca);
+    }
+    for (auto& stmt : node->body) {
+        visit(stmt.get());
+    }
+    llvm::Value* current = B.CreateLoad(i64, counter, "par.it.cur");
+    B.CreateStore(B.CreateAdd(current, llvm::ConstantInt::get(i64, 1), "par.inc"), counter);
+    B.CreateBr(condBB);
+
+    // Un único acceso atómico por bloque y reducción
+    B.SetInsertPoint(exitBB);
+    for (const PartialReduction& p : partials) {
+        llvm::Value* value = B.CreateLoad(p.type, p.partial);
+        llvm::AtomicRMWInst::BinOp op = llvm::AtomicRMWInst::Add;
+        if (p.reduction->op == "min") {
+            op = llvm::AtomicRMWInst::Min;
+        } else if (p.reduction->op == "max") {
+            op = llvm::AtomicRMWInst::Max;
+        } else if (p.type->isFloatingPointTy()) {
+            op = llvm::AtomicRMWInst::FAdd;
+        }
+        B.CreateAtomicRMW(op, p.shared, value, llvm::MaybeAlign(), llvm::AtomicOrdering::SequentiallyConsistent);
+    }
+    B.CreateRetVoid();
+
+    Ctxt.namedValues = std::move(savedNamedValues);
+    sliceParams = std::move(savedSliceParams);
+    referenceParams = std::move(savedReferenceParams);
+    B.SetInsertPoint(savedBlock);
+
+    // umbra_rt_parallel_for(n, body, ctx)
+    llvm::Function* parallelFor = Ctxt.getRuntimeFunction(
+        "umbra_rt_parallel_for",
+        llvm::FunctionType::get(llvm::Type::getVoidTy(C), {i64, bodyTy->getPointerTo(), i8PtrTy}, false));
+    llvm::Value* trips = timesVal->getType()->isIntegerTy()
+        ? B.CreateSExtOrTrunc(timesVal, i64, "par.n")
+        : llvm::ConstantInt::get(i64, 0);
+    B.CreateCall(parallelFor, {trips, bodyFn, B.CreatePointerCast(ctxAlloca, i8PtrTy)});
 }
 
 llvm::Value* CodegenVisitor::visitIncrementExpression(IncrementExpression* node){
@@ -608,14 +1818,7 @@ llvm::Value* CodegenVisitor::visitIncrementExpression(IncrementExpression* node)
     llvm::Type* varType = nullptr;
     
     if(auto id = dynamic_cast<Identifier*>(node->operand.get())){
-        auto it = Ctxt.namedValues.find(id->name);
-        if(it == Ctxt.namedValues.end()){
-            return nullptr;
-        }
-        varPtr = it->second;
-        if(auto alloca = llvm::dyn_cast<llvm::AllocaInst>(varPtr)){
-            varType = alloca->getAllocatedType();
-        }
+        varPtr = getVariableSlot(id->name, varType, true);
     }
     else if(auto primaryExpr = dynamic_cast<PrimaryExpression*>(node->operand.get())){
         if(primaryExpr->exprType == PrimaryExpression::ARRAY_ACCESS && primaryExpr->arrayAccess){
@@ -628,12 +1831,21 @@ llvm::Value* CodegenVisitor::visitIncrementExpression(IncrementExpression* node)
             }
         }
     }
+    else if(auto access = dynamic_cast<ArrayAccessExpression*>(node->operand.get())){
+        varPtr = getArrayElementPtr(access);
+        if(!varPtr) return nullptr;
+
+        auto typeIt = Ctxt.valueTypes.find(varPtr);
+        if(typeIt != Ctxt.valueTypes.end()){
+            varType = typeIt->second;
+        }
+    }
     
     if(!varPtr || !varType){
         return nullptr;
     }
     
-    llvm::Value* oldValue = Ctxt.llvmBuilder.CreateLoad(varType, varPtr, "inc.old");
+    llvm::Value* oldValue = emitLoad(varType, varPtr, "inc.old");
     llvm::Value* newValue = nullptr;
     
     if(varType->isIntegerTy()){
@@ -642,7 +1854,7 @@ llvm::Value* CodegenVisitor::visitIncrementExpression(IncrementExpression* node)
             llvm::ConstantInt::get(varType, 1),
             "inc.result"
         );
-    } else if(varType->isFloatTy()){
+    } else if(varType->isFloatingPointTy()){
         newValue = Ctxt.llvmBuilder.CreateFAdd(
             oldValue,
             llvm::ConstantFP::get(varType, 1.0),
@@ -652,7 +1864,7 @@ llvm::Value* CodegenVisitor::visitIncrementExpression(IncrementExpression* node)
         return nullptr;
     }
     
-    Ctxt.llvmBuilder.CreateStore(newValue, varPtr);
+    emitStore(newValue, varPtr);
     
     return node->isPrefix ? newValue : oldValue;
 }
@@ -662,14 +1874,7 @@ llvm::Value* CodegenVisitor::visitDecrementExpression(DecrementExpression* node)
     llvm::Type* varType = nullptr;
     
     if(auto id = dynamic_cast<Identifier*>(node->operand.get())){
-        auto it = Ctxt.namedValues.find(id->name);
-        if(it == Ctxt.namedValues.end()){
-            return nullptr;
-        }
-        varPtr = it->second;
-        if(auto alloca = llvm::dyn_cast<llvm::AllocaInst>(varPtr)){
-            varType = alloca->getAllocatedType();
-        }
+        varPtr = getVariableSlot(id->name, varType, true);
     }
     else if(auto primaryExpr = dynamic_cast<PrimaryExpression*>(node->operand.get())){
         if(primaryExpr->exprType == PrimaryExpression::ARRAY_ACCESS && primaryExpr->arrayAccess){
@@ -682,12 +1887,21 @@ llvm::Value* CodegenVisitor::visitDecrementExpression(DecrementExpression* node)
             }
         }
     }
+    else if(auto access = dynamic_cast<ArrayAccessExpression*>(node->operand.get())){
+        varPtr = getArrayElementPtr(access);
+        if(!varPtr) return nullptr;
+
+        auto typeIt = Ctxt.valueTypes.find(varPtr);
+        if(typeIt != Ctxt.valueTypes.end()){
+            varType = typeIt->second;
+        }
+    }
     
     if(!varPtr || !varType){
         return nullptr;
     }
     
-    llvm::Value* oldValue = Ctxt.llvmBuilder.CreateLoad(varType, varPtr, "dec.old");
+    llvm::Value* oldValue = emitLoad(varType, varPtr, "dec.old");
     llvm::Value* newValue = nullptr;
     
     if(varType->isIntegerTy()){
@@ -696,7 +1910,7 @@ llvm::Value* CodegenVisitor::visitDecrementExpression(DecrementExpression* node)
             llvm::ConstantInt::get(varType, 1),
             "dec.result"
         );
-    } else if(varType->isFloatTy()){
+    } else if(varType->isFloatingPointTy()){
         newValue = Ctxt.llvmBuilder.CreateFSub(
             oldValue,
             llvm::ConstantFP::get(varType, 1.0),
@@ -706,7 +1920,7 @@ llvm::Value* CodegenVisitor::visitDecrementExpression(DecrementExpression* node)
         return nullptr;
     }
     
-    Ctxt.llvmBuilder.CreateStore(newValue, varPtr);
+    emitStore(newValue, varPtr);
     
     return node->isPrefix ? newValue : oldValue;
 }
@@ -719,11 +1933,12 @@ llvm::Value* CodegenVisitor::getAddressOf(Expression* expr){
     
     // Handle identifiers - get the alloca directly
     if(auto* id = dynamic_cast<Identifier*>(expr)){
-        auto it = Ctxt.namedValues.find(id->name);
-        if(it != Ctxt.namedValues.end()){
-            return it->second;  // Return the alloca/pointer directly
+        llvm::Type* slotType = nullptr;
+        if(llvm::Value* slot = getVariableSlot(id->name, slotType, true)){
+            return slot;
         }
-        return nullptr;
+        auto it = Ctxt.namedValues.find(id->name);
+        return it != Ctxt.namedValues.end() ? it->second : nullptr;
     }
     
     // Handle array access - get the GEP pointer
@@ -745,6 +1960,51 @@ llvm::Value* CodegenVisitor::getAddressOf(Expression* expr){
     return nullptr;
 }
 
+llvm::Type* CodegenVisitor::pointeeTypeOf(Expression* expr){
+    while(auto* primary = dynamic_cast<PrimaryExpression*>(expr)){
+        if(primary->exprType == PrimaryExpression::IDENTIFIER) expr = primary->identifier.get();
+        else if(primary->exprType == PrimaryExpression::PARENTHESIZED) expr = primary->parenthesized.get();
+        else break;
+    }
+    if(auto* id = dynamic_cast<Identifier*>(expr)){
+        auto it = pointeeTypes.find(id->name);
+        return it != pointeeTypes.end() ? it->second : nullptr;
+    }
+    // ref x: el tipo almacenado en x (variable, parámetro ref o elemento de array)
+    if(auto* unary = dynamic_cast<UnaryExpression*>(expr); unary && unary->op == "ref"){
+        Expression* target = unary->operand.get();
+        bool element = false;
+        while(target){
+            if(auto* primary = dynamic_cast<PrimaryExpression*>(target)){
+                if(primary->identifier) target = primary->identifier.get();
+                else if(primary->arrayAccess) target = primary->arrayAccess.get();
+                else return nullptr;
+            } else if(auto* access = dynamic_cast<ArrayAccessExpression*>(target)){
+                element = true;
+                target = access->array.get();
+            } else {
+                break;
+            }
+        }
+        auto* id = dynamic_cast<Identifier*>(target);
+        if(!id) return nullptr;
+        if(element){
+            auto sliceIt = sliceParams.find(id->name);
+            if(sliceIt != sliceParams.end()) return sliceIt->second.elementType;
+        }
+        llvm::Type* type = nullptr;
+        if(!getVariableSlot(id->name, type)){
+            auto it = Ctxt.namedValues.find(id->name);
+            if(it == Ctxt.namedValues.end()) return nullptr;
+            type = it->second->getType();
+        }
+        // Elemento de array: se baja por las dimensiones hasta el escalar
+        while(element && type->isArrayTy()) type = type->getArrayElementType();
+        return type;
+    }
+    return nullptr;
+}
+
 llvm::Value* CodegenVisitor::visitUnaryExpression(UnaryExpression* node){
     if(!node || !node->operand) return nullptr;
     
@@ -754,45 +2014,31 @@ llvm::Value* CodegenVisitor::visitUnaryExpression(UnaryExpression* node){
     if(op == "ref"){
         return getAddressOf(node->operand.get());
     }
+
+    if(op == "-"){
+        llvm::Value* v = emitExpr(node->operand.get());
+        if(!v) return nullptr;
+        if(v->getType()->isFPOrFPVectorTy()) return Ctxt.llvmBuilder.CreateFNeg(v, "negtmp");
+        return Ctxt.llvmBuilder.CreateNeg(v, "negtmp");
+    }
+
+    if(op == "not"){
+        llvm::Value* v = emitExpr(node->operand.get());
+        if(!v) return nullptr;
+        if(!isBoolLike(v)){
+            v = Ctxt.llvmBuilder.CreateICmpNE(v, llvm::Constant::getNullValue(v->getType()), "tobool");
+        }
+        return Ctxt.llvmBuilder.CreateNot(v, "nottmp");
+    }
     
-    // Handle 'access' operator - dereference pointer
+    // access p: load con el tipo apuntado declarado (ptr float -> float, ptr char -> i8)
     if(op == "access"){
+        llvm::Type* pointeeType = pointeeTypeOf(node->operand.get());
         llvm::Value* ptrVal = emitExpr(node->operand.get());
-        if(!ptrVal) return nullptr;
-        
-        // The operand should be a pointer type
-        if(!ptrVal->getType()->isPointerTy()){
+        if(!pointeeType || !ptrVal || !ptrVal->getType()->isPointerTy()){
             return nullptr;
         }
-        
-        // For opaque pointers in LLVM 15+, we need to know the pointed-to type
-        // We'll try to determine it from the context or assume i32 for now
-        llvm::Type* pointeeType = nullptr;
-        
-        // Try to get the pointee type from our stored type info
-        if(auto* loadInst = llvm::dyn_cast<llvm::LoadInst>(ptrVal)){
-            // If ptrVal came from a load, get the type from the alloca
-            if(auto* alloca = llvm::dyn_cast<llvm::AllocaInst>(loadInst->getPointerOperand())){
-                llvm::Type* allocaType = alloca->getAllocatedType();
-                if(allocaType->isPointerTy()){
-                    // It's a pointer to pointer, we need the element type
-                    // With opaque pointers, we store type info separately
-                    auto typeIt = Ctxt.valueTypes.find(alloca);
-                    if(typeIt != Ctxt.valueTypes.end() && typeIt->second->isPointerTy()){
-                        // Try to find the pointed-to type from variable declaration context
-                        // For now, default to i32
-                        pointeeType = llvm::Type::getInt32Ty(Ctxt.llvmContext);
-                    }
-                }
-            }
-        }
-        
-        // Default to i32 if we couldn't determine the type
-        if(!pointeeType){
-            pointeeType = llvm::Type::getInt32Ty(Ctxt.llvmContext);
-        }
-        
-        return Ctxt.llvmBuilder.CreateLoad(pointeeType, ptrVal, "deref");
+        return emitLoad(pointeeType, ptrVal, "deref");
     }
     
     // Handle 'ptr' in expressions (same as ref for now)
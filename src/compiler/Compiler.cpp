@@ -3,35 +3,194 @@
 #include "umbra/error/CompilerError.h"
 #include "umbra/error/ErrorManager.h"
 #include "umbra/semantic/SemanticAnalyzer.h"
+#include "umbra/semantic/ConstantFolder.h"
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/PGOOptions.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Target/TargetOptions.h>
+#if LLVM_VERSION_MAJOR >= 17
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/TargetParser/Host.h>
+#else
+#include <llvm/Support/Host.h>
+#endif
 #include "umbra/codegen/visitors/CodegenVisitor.h"
 #include "umbra/codegen/context/CodegenContext.h"
 #include "umbra/utils/utils.h"
 #include "umbra/ast/PrintASTVisitor.h"
+#include "umbra/ast/ASTSerializer.h"
+#include "umbra/io/AtomicFile.h"
+#include "umbra/io/ContentHash.h"
+#include "umbra/compiler/FunctionCache.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <memory>
 
+// Ruta de libumbra_rt.a; CMake la define con la ubicación en el árbol de build
+#ifndef UMBRA_RT_LIBRARY
+#define UMBRA_RT_LIBRARY "libumbra_rt.a"
+#endif
+
+// libclang_rt.profile para --profile-generate; vacío si CMake no la encontró
+#ifndef UMBRA_PROFILE_RUNTIME
+#define UMBRA_PROFILE_RUNTIME ""
+#endif
+
 namespace umbra {
 
+    namespace {
+
+        // PGOOptions cambió de firma en LLVM 17 (perfil de memoria y sistema de ficheros)
+        llvm::PGOOptions makePGOOptions(const std::string& profileFile, llvm::PGOOptions::PGOAction action) {
+#if LLVM_VERSION_MAJOR >= 17
+            return llvm::PGOOptions(profileFile, "", "", "", llvm::vfs::getRealFileSystem(), action);
+#else
+            return llvm::PGOOptions(profileFile, "", "", action);
+#endif
+        }
+
+        /// Triple, CPU y extensiones del host, para --march=native.
+        struct HostTarget {
+            std::string triple;
+            std::string cpu;
+            std::string features;
+        };
+
+        /**
+         * @brief Registra los targets de LLVM y detecta el host, una sola vez por proceso.
+         * @details La inicialización de una variable estática es segura entre hilos: las
+         *          compilaciones simultáneas de --daemon no registran los targets dos veces.
+         */
+        const HostTarget& hostTarget() {
+            static const HostTarget host = [] {
+                llvm::InitializeAllTargetInfos();
+                llvm::InitializeAllTargets();
+                llvm::InitializeAllTargetMCs();
+                // Para emitObjectFile; los objetos del programa completo los sigue emitiendo llc
+                llvm::InitializeAllAsmPrinters();
+
+                HostTarget target;
+                target.triple = llvm::Triple::normalize(llvm::sys::getDefaultTargetTriple());
+                target.cpu = llvm::sys::getHostCPUName().str();
+#if LLVM_VERSION_MAJOR >= 19
+                llvm::StringMap<bool> hostFeatures = llvm::sys::getHostCPUFeatures();
+#else
+                llvm::StringMap<bool> hostFeatures;
+                llvm::sys::getHostCPUFeatures(hostFeatures);
+#endif
+                for (const auto& feature : hostFeatures) {
+                    if (!target.features.empty()) target.features += ",";
+                    target.features += (feature.second ? "+" : "-") + feature.first().str();
+                }
+                return target;
+            }();
+            return host;
+        }
+
+        /**
+         * @brief Ejecuta llc o gcc como system(), pero su salida pasa por err.
+         * @details Bajo --daemon err llega al cliente que pidió la compilación; la salida de
+         *          un proceso hijo iría a la terminal del daemon.
+         */
+        int runTool(const std::string& command, std::ostream& err) {
+            FILE* pipe = ::popen((command + " 2>&1").c_str(), "re");
+            if (!pipe) {
+                return -1;
+            }
+            char chunk[4096];
+            size_t length;
+            while ((length = std::fread(chunk, 1, sizeof chunk, pipe)) > 0) {
+                err.write(chunk, static_cast<std::streamsize>(length));
+            }
+            err.flush();
+            return ::pclose(pipe);
+        }
+
+        std::unique_ptr<Type> typeFromSignature(SemanticType type, int arrayDimensions = 0) {
+            // Parámetros slice: dimensiones sin tamaño, como las deja el parser en `int [][]m`
+            std::vector<std::unique_ptr<Expression>> unsized(arrayDimensions);
+            return std::make_unique<Type>(semaTypeToBuiltinType(type), arrayDimensions, std::move(unsized));
+        }
+
+        /**
+         * @brief Prototipo (sin cuerpo) de una función exportada por un módulo precompilado.
+         * @details Reconstruye los nodos Type de los parámetros a partir de la FunctionSignature:
+         *          semántica y codegen los tratan como a una función definida en el programa.
+         */
+        std::unique_ptr<FunctionDefinition> makePrototype(const ModuleInterface::Function& function) {
+            const FunctionSignature& signature = function.signature;
+            std::vector<std::pair<std::unique_ptr<Type>, std::unique_ptr<Identifier>>> parameters;
+            for (size_t i = 0; i < signature.argTypes.size(); ++i) {
+                SemanticType argType = signature.argTypes[i];
+                SemanticType pointee = signature.argPointeeTypes[i];
+                std::unique_ptr<Type> type;
+                if (signature.argByReference[i]) {
+                    type = std::make_unique<Type>(BuiltinType::Ref, typeFromSignature(argType), false, true);
+                } else if (argType == SemanticType::Ptr) {
+                    type = std::make_unique<Type>(BuiltinType::Ptr,
+                        pointee != SemanticType::None ? typeFromSignature(pointee) : nullptr, true, false);
+                } else {
+                    type = typeFromSignature(argType, signature.argArrayDims[i]);
+                }
+                parameters.emplace_back(std::move(type), std::make_unique<Identifier>("arg" + std::to_string(i)));
+            }
+
+            auto prototype = std::make_unique<FunctionDefinition>(
+                std::make_unique<Identifier>(function.name),
+                std::make_unique<ParameterList>(std::move(parameters)),
+                typeFromSignature(signature.returnType),
+                std::vector<std::unique_ptr<Statement>>{});
+            // Sin cuerpo no se puede evaluar en compilación: las llamadas quedan en tiempo de ejecución
+            prototype->isImported = true;
+            return prototype;
+        }
+
+    } // namespace
+
     Compiler::Compiler(UmbraCompilerOptions opt)
         : options(std::move(opt)),
           internalErrorManager_(std::make_unique<ErrorManager>()),
-          errorManagerRef_(*internalErrorManager_) {
+          errorManagerRef_(*internalErrorManager_),
+          out(std::cout),
+          err(std::cerr) {
 
     }
 
     Compiler::Compiler(UmbraCompilerOptions opt, ErrorManager& externalErrorManager)
+        : Compiler(std::move(opt), externalErrorManager, std::cout, std::cerr) {
+    }
+
+    Compiler::Compiler(UmbraCompilerOptions opt, ErrorManager& externalErrorManager, std::ostream& out, std::ostream& err)
         : options(std::move(opt)),
-          errorManagerRef_(externalErrorManager) {
+          errorManagerRef_(externalErrorManager),
+          out(out),
+          err(err) {
     }
 
-    bool Compiler::preprocess(std::string& src) {
+    Compiler::~Compiler() {
+        errorManagerRef_.detachSourceMap();
+    }
+
+    bool Compiler::preprocess() {
 
         try{
-            Preprocessor preprocessor(options.inputFilePath);
-            src = preprocessor.getProcessedContent();
+            Preprocessor preprocessor(options.inputFilePath, sourceManager, options.useModules, err);
+            sourceMap = preprocessor.getSourceMap();
+            importedModules = preprocessor.getModules();
+            splicedFiles = preprocessor.getSplicedFiles();
+            errorManagerRef_.setSourceMap(&sourceMap);
             return true;
         } catch (const std::exception& e) {
             errorManagerRef_.addError(std::make_unique<CompilerError>(
@@ -46,14 +205,15 @@ namespace umbra {
 
     void Compiler::printTokens(const std::vector<Lexer::Token>& tokens) {
         for (const auto& token : tokens) {
-            std::cout << "Token << " << token.lexeme << " >> "
+            PresumedLocation where = sourceMap.resolve(token.location);
+            out << "Token << " << token.lexeme << " >> "
                       << "Type: " << static_cast<int>(token.type) << " "
-                      << "Line: " << token.line << " "
-                      << "Column: " << token.column << std::endl;
+                      << "Line: " << where.line << " "
+                      << "Column: " << where.column << std::endl;
         }
     }
 
-    std::vector<Lexer::Token> Compiler::lex(std::string& src){
+    std::vector<Lexer::Token> Compiler::lex(const SourceMap& src){
         std::unique_ptr<Lexer> lexer = std::make_unique<Lexer>(src, errorManagerRef_);
         auto tokens = lexer->tokenize();
 
@@ -76,121 +236,639 @@ namespace umbra {
         return programNode;
     }
 
+    /// Antepone al programa los prototipos de las funciones de cada módulo importado.
+    void Compiler::declareImportedFunctions(ProgramNode& programNode){
+        std::vector<std::unique_ptr<FunctionDefinition>> prototypes;
+        for (const ModuleInterface& module : importedModules) {
+            for (const ModuleInterface::Function& function : module.functions) {
+                prototypes.push_back(makePrototype(function));
+            }
+        }
+        programNode.functions.insert(programNode.functions.begin(),
+                                     std::make_move_iterator(prototypes.begin()),
+                                     std::make_move_iterator(prototypes.end()));
+    }
+
     bool Compiler::semanticAnalyze(ProgramNode* programNode){
         SemanticAnalyzer analizer(errorManagerRef_, programNode);
+        analizer.setRequireEntryPoint(!options.emitModule);
         analizer.execAnalysisPipeline();
         return !errorManagerRef_.hasErrors();
     }
 
+    bool Compiler::foldConstants(ProgramNode* programNode){
+        ConstantFolder folder(errorManagerRef_, err);
+        folder.fold(programNode);
+        return !errorManagerRef_.hasErrors();
+    }
+
     void Compiler::printAST(ProgramNode& node){
-        Printer prt;
+        Printer prt(out);
         prt.visitProgramNode(node);
     }
 
-    bool Compiler::generateCode(ProgramNode& programNode, std::string& moduleName){
+    /**
+     * @brief Genera el IR del programa, lo optimiza y lo escribe en options.outputIRFile.
+     * @param objectFile Si no está vacío, programNode es un fragmento de --incremental (una función
+     *                   y los prototipos de las que llama): sus funciones se exportan y el objeto se
+     *                   emite directamente ahí.
+     */
+    bool Compiler::generateCode(ProgramNode& programNode, std::string& moduleName, const std::string& objectFile){
         umbra::CodegenContext codegenContext(moduleName);
-        codegenContext.getPrintfFunction();
+        codegenContext.boundsCheck = options.boundsCheck;
+        codegenContext.exportFunctions = options.emitModule || !objectFile.empty();
+        codegenContext.sourceMap = &sourceMap;
+
+        // El datalayout debe estar fijado antes de emitir: los atributos align/dereferenceable dependen de él
+        llvm::TargetMachine* targetMachine = configureTarget(codegenContext.llvmModule);
+        if (!targetMachine) {
+            return false;
+        }
+        targetTriple = codegenContext.llvmModule.getTargetTriple();
+        for (const ModuleInterface& module : importedModules) {
+            if (module.targetTriple != targetTriple) {
+                err << "Error: module '" << module.sources.front().path << "' was compiled for '"
+                          << module.targetTriple << "', not '" << targetTriple
+                          << "'; rebuild it with --emit-module." << std::endl;
+                return false;
+            }
+        }
+
         umbra::code_gen::CodegenVisitor codegenVisitor(codegenContext);
         codegenVisitor.visit(&programNode);
         if (errorManagerRef_.hasErrors()) {
             return false;
         }
 
+        // Un módulo (--emit-module) no tiene punto de entrada: main solo existe en el ejecutable,
+        // y con --incremental en el fragmento de start
         llvm::Function* entryPointFunction = codegenContext.llvmModule.getFunction("start");
+        bool fragmentWithoutStart = !objectFile.empty() && (!entryPointFunction || entryPointFunction->isDeclaration());
+        if (!options.emitModule && !fragmentWithoutStart) {
+            if(entryPointFunction == nullptr){
+                err << "Error: Entry point function 'start' not found in module." << std::endl;
+                return false;
+            }
 
-        if(entryPointFunction == nullptr){
-            llvm::errs() << "Error: Entry point function 'start' not found in module.\n";
-            return false;
-        }
-
-        llvm::FunctionType* cMainFuncType = llvm::FunctionType::get(
-            llvm::Type::getInt32Ty(codegenContext.llvmContext),
-            false
-        );
+            llvm::FunctionType* cMainFuncType = llvm::FunctionType::get(
+                llvm::Type::getInt32Ty(codegenContext.llvmContext),
+                false
+            );
 
-        llvm::Function* cMainFunction = llvm::Function::Create(
-            cMainFuncType,
-            llvm::Function::ExternalLinkage,
-            "main",
-            codegenContext.llvmModule
-        );
+            llvm::Function* cMainFunction = llvm::Function::Create(
+                cMainFuncType,
+                llvm::Function::ExternalLinkage,
+                "main",
+                codegenContext.llvmModule
+            );
 
-        llvm::BasicBlock* cMainEntryBlock = llvm::BasicBlock::Create(codegenContext.llvmContext, "entry", cMainFunction);
+            llvm::BasicBlock* cMainEntryBlock = llvm::BasicBlock::Create(codegenContext.llvmContext, "entry", cMainFunction);
 
-        codegenContext.llvmBuilder.SetInsertPoint(cMainEntryBlock);
+            codegenContext.llvmBuilder.SetInsertPoint(cMainEntryBlock);
 
-        llvm::CallInst* callToStart = codegenContext.llvmBuilder.CreateCall(entryPointFunction);
+            llvm::CallInst* callToStart = codegenContext.llvmBuilder.CreateCall(entryPointFunction);
 
-        if (entryPointFunction->getReturnType()->isVoidTy()) {
-            codegenContext.llvmBuilder.CreateRet(llvm::ConstantInt::get(llvm::Type::getInt32Ty(codegenContext.llvmContext), 0, true));
-        } else if (entryPointFunction->getReturnType()->isIntegerTy(32)) {
+            if (entryPointFunction->getReturnType()->isVoidTy()) {
+                codegenContext.llvmBuilder.CreateRet(llvm::ConstantInt::get(llvm::Type::getInt32Ty(codegenContext.llvmContext), 0, true));
+            } else if (entryPointFunction->getReturnType()->isIntegerTy(32)) {
 
-            codegenContext.llvmBuilder.CreateRet(callToStart);
-        } else {
+                codegenContext.llvmBuilder.CreateRet(callToStart);
+            } else {
 
-            llvm::errs() << "Warning: Entry point function 'start' returns a non-integer/non-void type. 'main' will return 0.\n";
-            codegenContext.llvmBuilder.CreateRet(llvm::ConstantInt::get(llvm::Type::getInt32Ty(codegenContext.llvmContext), 0, true));
+                err << "Warning: Entry point function 'start' returns a non-integer/non-void type. 'main' will return 0." << std::endl;
+                codegenContext.llvmBuilder.CreateRet(llvm::ConstantInt::get(llvm::Type::getInt32Ty(codegenContext.llvmContext), 0, true));
+            }
+        }
+        // Sin llc nadie más verifica el IR de un fragmento antes de emitirlo
+        if (!objectFile.empty()) {
+            std::string problems;
+            llvm::raw_string_ostream problemStream(problems);
+            if (llvm::verifyModule(codegenContext.llvmModule, &problemStream)) {
+                err << problemStream.str() << "\nError generating object file." << std::endl;
+                return false;
+            }
+        }
+        applyTargetAttributes(codegenContext.llvmModule, *targetMachine);
+        optimizeModule(codegenContext.llvmModule, targetMachine);
+        if (!objectFile.empty()) {
+            return emitObjectFile(codegenContext.llvmModule, *targetMachine, objectFile);
         }
         generateIRFile(codegenContext.llvmModule, options.outputIRFile);
         return true;
     }
 
+    /**
+     * @brief Crea la TargetMachine del triple y la CPU elegidos y fija triple y datalayout del módulo.
+     * @details Sin --set-target-machine se usa el triple del host. Con --march=native (por defecto)
+     *          la CPU y sus extensiones (AVX2, AVX-512, ...) se detectan en la máquina que compila;
+     *          para un triple distinto del host native se reduce a "generic".
+     *          La TargetMachine se crea una vez por compilación: con --incremental cada fragmento
+     *          es un módulo propio y crearla de nuevo costaría más que generar la función.
+     * @return nullptr (tras informar en stderr) si el triple o la CPU no existen.
+     */
+    llvm::TargetMachine* Compiler::configureTarget(llvm::Module& module){
+        if (targetMachine_) {
+            module.setTargetTriple(targetMachine_->getTargetTriple().str());
+            module.setDataLayout(targetMachine_->createDataLayout());
+            return targetMachine_.get();
+        }
+
+        const HostTarget& host = hostTarget();
+        const std::string& hostTriple = host.triple;
+        std::string triple = options.targetTriple.empty() ? hostTriple : llvm::Triple::normalize(options.targetTriple);
+
+        std::string error;
+        const llvm::Target* target = llvm::TargetRegistry::lookupTarget(triple, error);
+        if (!target) {
+            err << "Error: unknown target '" << triple << "': " << error << std::endl;
+            return nullptr;
+        }
+
+        std::string cpu = options.targetCPU;
+        std::string features;
+        if (cpu == "native") {
+            if (triple == hostTriple) {
+                cpu = host.cpu;
+                features = host.features;
+            } else {
+                cpu = "generic";
+            }
+        }
+
+        llvm::TargetOptions targetOptions;
+        std::unique_ptr<llvm::TargetMachine> targetMachine(
+            target->createTargetMachine(triple, cpu, features, targetOptions, llvm::Reloc::PIC_));
+        if (!targetMachine) {
+            err << "Error: could not create a target machine for '" << triple << "'." << std::endl;
+            return nullptr;
+        }
+        if (!targetMachine->getMCSubtargetInfo()->isCPUStringValid(cpu)) {
+            err << "Error: unknown CPU '" << cpu << "' for target '" << triple << "'." << std::endl;
+            return nullptr;
+        }
+
+        module.setTargetTriple(triple);
+        module.setDataLayout(targetMachine->createDataLayout());
+        targetMachine_ = std::move(targetMachine);
+        return targetMachine_.get();
+    }
+
+    /// target-cpu/target-features en cada función definida (start, main, cuerpos paralelos...)
+    void Compiler::applyTargetAttributes(llvm::Module& module, llvm::TargetMachine& targetMachine){
+        llvm::StringRef cpu = targetMachine.getTargetCPU();
+        llvm::StringRef features = targetMachine.getTargetFeatureString();
+        for (llvm::Function& function : module) {
+            if (function.isDeclaration()) continue;
+            function.addFnAttr("target-cpu", cpu);
+            if (!features.empty()) {
+                function.addFnAttr("target-features", features);
+            }
+        }
+    }
+
+    /**
+     * @brief Ejecuta el pipeline estándar de LLVM para el nivel -O elegido.
+     * @details Con -O0 solo corre el pipeline mínimo, que aun así expande las funciones `inline`.
+     *          La TargetMachine aporta el coste real de cada instrucción y el ancho de vector
+     *          de la CPU al vectorizador.
+     *
+     *          PGO a nivel de IR: --profile-generate inserta los contadores de PGOInstrumentationGen
+     *          (el ejecutable escribe un .profraw al terminar) y --profile-use carga el perfil
+     *          fusionado, del que salen los pesos de las ramas y las decisiones de inlining.
+     */
+    void Compiler::optimizeModule(llvm::Module& module, llvm::TargetMachine* targetMachine){
+        llvm::LoopAnalysisManager loopAM;
+        llvm::FunctionAnalysisManager functionAM;
+        llvm::CGSCCAnalysisManager cgsccAM;
+        llvm::ModuleAnalysisManager moduleAM;
+
+#if LLVM_VERSION_MAJOR >= 16
+        std::optional<llvm::PGOOptions> pgoOptions;
+#else
+        llvm::Optional<llvm::PGOOptions> pgoOptions;
+#endif
+        if (!options.profileGenerateFile.empty()) {
+            pgoOptions = makePGOOptions(options.profileGenerateFile, llvm::PGOOptions::IRInstr);
+        } else if (!options.profileUseFile.empty()) {
+            pgoOptions = makePGOOptions(options.profileUseFile, llvm::PGOOptions::IRUse);
+        }
+
+        llvm::PassBuilder passBuilder(targetMachine, llvm::PipelineTuningOptions(), pgoOptions);
+        passBuilder.registerModuleAnalyses(moduleAM);
+        passBuilder.registerCGSCCAnalyses(cgsccAM);
+        passBuilder.registerFunctionAnalyses(functionAM);
+        passBuilder.registerLoopAnalyses(loopAM);
+        passBuilder.crossRegisterProxies(loopAM, functionAM, cgsccAM, moduleAM);
+
+        llvm::ModulePassManager modulePM;
+        switch (options.optLevel) {
+            case 0:
+                modulePM = passBuilder.buildO0DefaultPipeline(llvm::OptimizationLevel::O0);
+                break;
+            case 1:
+                modulePM = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O1);
+                break;
+            case 2:
+                modulePM = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+                break;
+            default:
+                modulePM = passBuilder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+                break;
+        }
+        modulePM.run(module, moduleAM);
+    }
+
 
     void Compiler::generateIRFile(llvm::Module& module, const std::string& filename){
         std::error_code errorCode;
         llvm::raw_fd_ostream outputStream(filename, errorCode);
         if (errorCode) {
-            std::cerr << "Error opening file for writing: " << errorCode.message() << std::endl;
+            err << "Error opening file for writing: " << errorCode.message() << std::endl;
             return;
         }
         module.print(outputStream, nullptr);
         outputStream.close();
     }
 
-    bool Compiler::generateExecutable(const std::string& irFilename, const std::string& outputName){
-        std::string command = "llc -filetype=obj " + irFilename + " -o " + outputName + ".o";
-        int result = system(command.c_str());
+    bool Compiler::generateObjectFile(const std::string& irFilename, const std::string& objectFile){
+        std::string command = "llc -filetype=obj " + irFilename + " -o " + objectFile;
+        if (options.optLevel > 0) {
+            command += " -O" + std::to_string(std::min(options.optLevel, 3));
+        }
+        int result = runTool(command, err);
         if (result != 0) {
-            std::cerr << "Error generating object file." << std::endl;
+            err << "Error generating object file." << std::endl;
             return false;
         }
+        return true;
+    }
 
-        command = "gcc " + outputName + ".o -no-pie -o " + outputName;
-        result = system(command.c_str());
+    /**
+     * @brief Emite el objeto de un fragmento de --incremental sin pasar por llc.
+     * @details Lanzar llc por cada función editada costaría más que compilarla; el nivel de
+     *          codegen es el mismo que usaría llc con el -O elegido. Se escribe aparte y se
+     *          renombra: el nombre lleva la clave, así que un objeto a medias no debe existir nunca.
+     */
+    bool Compiler::emitObjectFile(llvm::Module& module, llvm::TargetMachine& targetMachine, const std::string& objectFile){
+#if LLVM_VERSION_MAJOR >= 18
+        constexpr llvm::CodeGenOptLevel levels[] = {llvm::CodeGenOptLevel::Default, llvm::CodeGenOptLevel::Less,
+                                                    llvm::CodeGenOptLevel::Default, llvm::CodeGenOptLevel::Aggressive};
+        constexpr auto objectFileType = llvm::CodeGenFileType::ObjectFile;
+#else
+        constexpr llvm::CodeGenOpt::Level levels[] = {llvm::CodeGenOpt::Default, llvm::CodeGenOpt::Less,
+                                                      llvm::CodeGenOpt::Default, llvm::CodeGenOpt::Aggressive};
+        constexpr auto objectFileType = llvm::CGFT_ObjectFile;
+#endif
+        targetMachine.setOptLevel(levels[std::min(std::max(options.optLevel, 0), 3)]);
+
+        std::string temporary = temporaryPathFor(objectFile).string();
+        {
+            std::error_code errorCode;
+            llvm::raw_fd_ostream output(temporary, errorCode, llvm::sys::fs::OF_None);
+            if (errorCode) {
+                err << "Error opening file for writing: " << errorCode.message() << std::endl;
+                return false;
+            }
+            llvm::legacy::PassManager passManager;
+            if (targetMachine.addPassesToEmitFile(passManager, output, nullptr, objectFileType)) {
+                err << "Error: the target cannot emit object files." << std::endl;
+                output.close();
+                std::filesystem::remove(temporary, errorCode);
+                return false;
+            }
+            passManager.run(module);
+        }
+        std::error_code errorCode;
+        std::filesystem::rename(temporary, objectFile, errorCode);
+        if (errorCode) {
+            std::filesystem::remove(temporary, errorCode);
+            err << "Error generating object file." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool Compiler::generateExecutable(const std::string& irFilename, const std::string& outputName){
+        if (!generateObjectFile(irFilename, outputName + ".o")) {
+            return false;
+        }
+        // gcc solo enlaza para el host: con --set-target-machine de otro triple se entrega el objeto
+        if (targetTriple != hostTarget().triple) {
+            out << "Object file written to " << outputName << ".o; link it with a toolchain for '"
+                      << targetTriple << "'." << std::endl;
+            return true;
+        }
+        return linkExecutable({outputName + ".o"}, outputName);
+    }
+
+    bool Compiler::linkExecutable(const std::vector<std::string>& objectFiles, const std::string& outputName){
+        if (targetTriple != hostTarget().triple) {
+            err << "Error: cannot link an executable for '" << targetTriple
+                      << "' on this host; compile without --incremental to get its object file." << std::endl;
+            return false;
+        }
+        // Objetos de los módulos importados y runtime de Umbra (print, comprobaciones de rango, ...)
+        std::string runtimeLibrary = options.runtimeLibraryPath.empty() ? UMBRA_RT_LIBRARY : options.runtimeLibraryPath;
+        std::string command = "gcc";
+        for (const std::string& objectFile : objectFiles) {
+            command += " " + objectFile;
+        }
+        for (const ModuleInterface& module : importedModules) {
+            command += " " + module.objectFile;
+        }
+        command += " " + runtimeLibrary;
+        if (!options.profileGenerateFile.empty()) {
+            // Los contadores instrumentados se vuelcan al .profraw desde el runtime de perfilado de LLVM
+            std::string profileRuntime = options.profileRuntimePath.empty() ? UMBRA_PROFILE_RUNTIME : options.profileRuntimePath;
+            if (profileRuntime.empty()) {
+                err << "Error: --profile-generate needs the LLVM profile runtime (libclang_rt.profile); "
+                             "pass it with --profile-runtime." << std::endl;
+                return false;
+            }
+            command += " " + profileRuntime;
+        }
+        command += " -lm -lpthread -no-pie -o " + outputName;
+        int result = runTool(command, err);
         if (result != 0) {
-            std::cerr << "Error generating executable." << std::endl;
+            err << "Error generating executable." << std::endl;
             return false;
         }
         return true;
     }
 
-    bool Compiler::compile(){
-        std::string src;
-        if (!preprocess(src)){
+    /**
+     * @brief --emit-module: objeto junto al fuente (lib.o) y su interfaz (lib.umi).
+     * @details La interfaz lista las funciones definidas en el objeto con sus firmas, el hash de
+     *          cada archivo incluido como texto y los módulos importados, que el programa que
+     *          use este módulo importará y enlazará también.
+     */
+    bool Compiler::writeModuleInterface(ProgramNode& programNode){
+        std::filesystem::path sourcePath = splicedFiles.front()->getName();
+
+        ModuleInterface module;
+        module.targetTriple = targetTriple;
+        module.objectFile = ModuleInterface::objectPathFor(sourcePath).string();
+        for (const SourceBuffer* file : splicedFiles) {
+            module.sources.push_back({file->getName(), file->getContentHash()});
+        }
+        for (const ModuleInterface& imported : importedModules) {
+            module.imports.push_back(imported.sources.front().path);
+        }
+        for (const auto& function : programNode.functions) {
+            if (!function->isImported) {
+                module.functions.push_back({function->name->name, function->Signature});
+            }
+        }
 
+        if (!generateObjectFile(options.outputIRFile, module.objectFile)) {
             return false;
         }
-        auto tokens = lex(src);
-        if (errorManagerRef_.hasErrors()) {
+        std::string error;
+        if (!module.write(ModuleInterface::interfacePathFor(sourcePath), error)) {
+            err << "Error: " << error << std::endl;
             return false;
         }
+        return true;
+    }
+
+    std::unique_ptr<ProgramNode> Compiler::analyze(){
+        auto tokens = lex(sourceMap);
+        if (errorManagerRef_.hasErrors()) {
+            return nullptr;
+        }
 
         if (tokens.empty() || (tokens.back().type != TokenType::TOK_EOF && !tokens.empty()) ) {
-            return false;
+            return nullptr;
         }
 
         auto root = parse(tokens);
         if (errorManagerRef_.hasErrors() || !root) {
-            return false;
+            return nullptr;
         }
+        declareImportedFunctions(*root);
 
 
         if (!semanticAnalyze(root.get())) {
+            return nullptr;
+        }
+
+        if (!foldConstants(root.get())) {
+            return nullptr;
+        }
+        return root;
+    }
+
+    uint64_t Compiler::sourceHash() const {
+        // Las ubicaciones del AST son offsets de SourceMap: dependen de qué archivos se incluyeron,
+        // en qué orden y con qué contenido, y de las firmas de los módulos importados
+        uint64_t hash = hashCombine(hashContent("umbra-ast"), ASTSerializer::FormatVersion);
+        for (const SourceBuffer* file : splicedFiles) {
+            hash = hashContent(file->getName(), hash);
+            hash = hashCombine(hash, file->getContentHash());
+        }
+        for (const ModuleInterface& module : importedModules) {
+            for (const ModuleInterface::Source& source : module.sources) {
+                hash = hashContent(source.path, hash);
+                hash = hashCombine(hash, source.hash);
+            }
+        }
+        // Sin --emit-module el análisis además exige `start`
+        return hashCombine(hash, options.emitModule);
+    }
+
+    std::unique_ptr<ProgramNode> Compiler::loadCachedAST(){
+        std::filesystem::path mainFile = splicedFiles.front()->getName();
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(mainFile, ec)) {
+            return nullptr;
+        }
+
+        std::string error;
+        std::filesystem::path cachePath = ASTSerializer::cachePathFor(mainFile);
+        if (!std::filesystem::exists(cachePath, ec)) {
+            return nullptr;
+        }
+        // Desactualizado o dañado: se analiza de nuevo y storeCachedAST lo reemplaza
+        return ASTSerializer::read(cachePath, error, sourceHash());
+    }
+
+    void Compiler::storeCachedAST(const ProgramNode& programNode){
+        std::filesystem::path mainFile = splicedFiles.front()->getName();
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(mainFile, ec)) {
+            return;
+        }
+
+        std::string error;
+        if (!ASTSerializer::write(ASTSerializer::cachePathFor(mainFile), programNode, sourceHash(), error)) {
+            err << "Warning: cannot save AST cache: " << error << std::endl;
+        }
+    }
+
+    uint64_t Compiler::incrementalConfigHash() const {
+        uint64_t hash = hashContent("umbra-incremental");
+        hash = hashCombine(hash, static_cast<uint64_t>(options.optLevel));
+        hash = hashCombine(hash, options.boundsCheck);
+        hash = hashContent(options.targetTriple, hash);
+        hash = hashContent(options.targetCPU, hash);
+        // Las firmas de los módulos importados no tienen tokens en el programa: cuentan por sus fuentes
+        for (const ModuleInterface& module : importedModules) {
+            for (const ModuleInterface::Source& source : module.sources) {
+                hash = hashContent(source.path, hash);
+                hash = hashCombine(hash, source.hash);
+            }
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Fragmento de una función: ella más los prototipos de las funciones que llama.
+     * @details Los nodos se mueven temporalmente a un ProgramNode propio y se devuelven después;
+     *          las llamadas se marcan como importadas para que codegen solo las declare.
+     */
+    bool Compiler::generateFragment(ProgramNode& programNode, size_t function, const std::vector<size_t>& callees,
+                                    const std::string& objectFile){
+        std::vector<size_t> members = {function};
+        members.insert(members.end(), callees.begin(), callees.end());
+
+        std::vector<bool> wasImported;
+        std::vector<std::unique_ptr<FunctionDefinition>> functions;
+        for (size_t member : members) {
+            wasImported.push_back(programNode.functions[member]->isImported);
+            if (member != function) {
+                programNode.functions[member]->isImported = true;
+            }
+            functions.push_back(std::move(programNode.functions[member]));
+        }
+
+        ProgramNode fragment(std::move(functions));
+        std::string moduleName = fragment.functions.front()->name->name;
+        bool generated = generateCode(fragment, moduleName, objectFile);
+
+        for (size_t i = 0; i < members.size(); ++i) {
+            fragment.functions[i]->isImported = wasImported[i];
+            programNode.functions[members[i]] = std::move(fragment.functions[i]);
+        }
+        return generated;
+    }
+
+    /**
+     * @brief --incremental: solo las funciones editadas pasan por análisis, codegen y optimización.
+     * @details Lex y parse recorren todo el programa (son baratos y dan las claves de FunctionCache).
+     *          Una función con objeto vigente queda como prototipo, igual que las de un módulo
+     *          importado: el análisis semántico solo registra su firma. Se pierde la optimización
+     *          entre funciones (inlining, efectos de las llamadas), como entre módulos.
+     */
+    bool Compiler::compileIncremental(){
+        auto tokens = lex(sourceMap);
+        if (errorManagerRef_.hasErrors() || tokens.empty() || tokens.back().type != TokenType::TOK_EOF) {
             return false;
         }
+        auto root = parse(tokens);
+        if (errorManagerRef_.hasErrors() || !root) {
+            return false;
+        }
+        declareImportedFunctions(*root);
+
+        FunctionCache cache(FunctionCache::directoryFor(splicedFiles.front()->getName()));
+        std::string error;
+        if (!cache.prepare(error)) {
+            err << "Error: " << error << std::endl;
+            return false;
+        }
+        std::vector<FunctionCache::FunctionKey> keys =
+            FunctionCache::computeKeys(*root, tokens, sourceMap, incrementalConfigHash(), options.boundsCheck);
+
+        // Definidas en el programa (no prototipos de módulos), las que tienen objeto se reutilizan
+        std::vector<size_t> defined;
+        std::vector<size_t> changed;
+        for (size_t i = 0; i < root->functions.size(); ++i) {
+            FunctionDefinition& function = *root->functions[i];
+            if (function.isImported) continue;
+            defined.push_back(i);
+            if (keys[i].cacheable && cache.contains(function.name->name, keys[i].key)) {
+                function.isImported = true;
+                // ConstantFolder necesita el cuerpo de una constfunc para evaluar las llamadas a ella
+                if (!function.isConstFunc) {
+                    function.body.clear();
+                }
+            } else {
+                changed.push_back(i);
+            }
+        }
+
+        if (!semanticAnalyze(root.get()) || !foldConstants(root.get())) {
+            return false;
+        }
+
+        for (size_t i : changed) {
+            const std::string& name = root->functions[i]->name->name;
+            if (!generateFragment(*root, i, keys[i].callees, cache.objectPathFor(name, keys[i].key).string())) {
+                return false;
+            }
+        }
+
+        std::vector<std::filesystem::path> objects;
+        std::vector<std::string> objectFiles;
+        for (size_t i : defined) {
+            objects.push_back(cache.objectPathFor(root->functions[i]->name->name, keys[i].key));
+            objectFiles.push_back(objects.back().string());
+        }
+        cache.prune(objects);
+
+        if (!linkExecutable(objectFiles, options.outputExecName)) {
+            return false;
+        }
+        out << "Rebuilt " << changed.size() << " of " << defined.size() << " functions" << std::endl;
+        out << "Compilation successful!" << std::endl;
+        return true;
+    }
+
+    void Compiler::initializeTargets(){
+        hostTarget();
+    }
+
+    bool Compiler::compile(){
+        if (!preprocess()){
+
+            return false;
+        }
+
+        if (options.incremental) {
+            std::error_code ec;
+            if (!options.emitModule && options.profileGenerateFile.empty() && options.profileUseFile.empty() &&
+                std::filesystem::is_regular_file(splicedFiles.front()->getName(), ec)) {
+                return compileIncremental();
+            }
+            err << "Warning: --incremental needs a source file and no --emit-module or profile options; "
+                         "compiling the whole program." << std::endl;
+        }
+
+        // --show-tokenizer necesita pasar por el lexer aunque el AST esté en caché
+        std::unique_ptr<ProgramNode> root;
+        if (options.astCache && !options.printTokens) {
+            root = loadCachedAST();
+        }
+        if (!root) {
+            root = analyze();
+            if (!root) {
+                return false;
+            }
+            if (options.astCache) {
+                storeCachedAST(*root);
+            }
+        }
+
+        if (!options.emitASTFile.empty()) {
+            std::string error;
+            if (!ASTSerializer::write(options.emitASTFile, *root, sourceHash(), error)) {
+                err << "Error: " << error << std::endl;
+                return false;
+            }
+        }
 
         if (options.printAST){
-            std::cout << "Printing AST " << std::endl;
+            out << "Printing AST " << std::endl;
             printAST(*root);
         }
 
@@ -199,9 +877,15 @@ namespace umbra {
             return false;
         }
 
-        generateExecutable(options.outputIRFile, options.outputExecName);
+        if (options.emitModule) {
+            if (!writeModuleInterface(*root)) {
+                return false;
+            }
+        } else if (!generateExecutable(options.outputIRFile, options.outputExecName)) {
+            return false;
+        }
 
-        std::cout << "Compilation successful!" << std::endl;
+        out << "Compilation successful!" << std::endl;
         return true;
 
 
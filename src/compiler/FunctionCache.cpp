@@ -0,0 +1,174 @@
+#include "umbra/compiler/FunctionCache.h"
+#include "umbra/io/ContentHash.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <set>
+#include <system_error>
+#include <unordered_map>
+
+namespace umbra {
+
+namespace {
+
+bool isFunctionModifier(TokenType type) {
+    return type == TokenType::TOK_FUNC || type == TokenType::TOK_CONSTFUNC ||
+           type == TokenType::TOK_INLINE || type == TokenType::TOK_NOINLINE;
+}
+
+// Tokens de una función: desde su primer modificador hasta la '}' que cierra el cuerpo
+struct TokenRange {
+    size_t begin = 0;
+    size_t bodyBegin = 0; // '{'
+    size_t end = 0;       // Una posición después de la '}'
+};
+
+bool findRange(const std::vector<Lexer::Token>& tokens, const FunctionDefinition& function, TokenRange& range) {
+    uint32_t offset = function.name->location.offset;
+    auto nameToken = std::lower_bound(tokens.begin(), tokens.end(), offset,
+        [](const Lexer::Token& token, uint32_t value) { return token.location.offset < value; });
+    if (nameToken == tokens.end() || nameToken->location.offset != offset || nameToken->lexeme != function.name->name) {
+        return false;
+    }
+
+    size_t name = nameToken - tokens.begin();
+    range.begin = name;
+    for (size_t i = name; i > 0; --i) {
+        TokenType type = tokens[i - 1].type;
+        if (isFunctionModifier(type)) range.begin = i - 1;
+        else if (type != TokenType::TOK_NEWLINE) break;
+    }
+
+    size_t i = name;
+    while (i < tokens.size() && tokens[i].type != TokenType::TOK_LEFT_BRACE) ++i;
+    range.bodyBegin = i;
+    int depth = 0;
+    for (; i < tokens.size(); ++i) {
+        if (tokens[i].type == TokenType::TOK_LEFT_BRACE) ++depth;
+        else if (tokens[i].type == TokenType::TOK_RIGHT_BRACE && --depth == 0) {
+            range.end = i + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+std::filesystem::path FunctionCache::directoryFor(const std::filesystem::path& sourcePath) {
+    return std::filesystem::path(sourcePath).replace_extension(".ufc");
+}
+
+std::vector<FunctionCache::FunctionKey> FunctionCache::computeKeys(const ProgramNode& program,
+                                                                   const std::vector<Lexer::Token>& tokens,
+                                                                   const SourceMap& sourceMap, uint64_t configHash,
+                                                                   bool withPositions) {
+    const auto& functions = program.functions;
+    std::vector<FunctionKey> keys(functions.size());
+    std::vector<uint64_t> headerHash(functions.size());
+    std::vector<uint64_t> bodyHash(functions.size());
+
+    std::unordered_map<std::string, size_t> byName;
+    std::vector<bool> duplicated(functions.size(), false);
+    for (size_t i = 0; i < functions.size(); ++i) {
+        auto [it, inserted] = byName.emplace(functions[i]->name->name, i);
+        if (!inserted) duplicated[i] = duplicated[it->second] = true;
+    }
+
+    auto hashTokens = [&](size_t begin, size_t end, uint64_t hash) {
+        for (size_t i = begin; i < end; ++i) {
+            hash = hashCombine(hash, static_cast<uint64_t>(tokens[i].type));
+            hash = hashContent(tokens[i].lexeme, hash);
+            if (withPositions) {
+                PresumedLocation where = sourceMap.resolve(tokens[i].location);
+                if (where.isValid()) hash = hashContent(where.buffer->getName(), hash);
+                hash = hashCombine(hash, (static_cast<uint64_t>(where.line) << 32) | static_cast<uint32_t>(where.column));
+            }
+        }
+        return hash;
+    };
+
+    for (size_t i = 0; i < functions.size(); ++i) {
+        const FunctionDefinition& function = *functions[i];
+        // Prototipos de módulos: su firma entra en configHash con los hashes de sus fuentes
+        headerHash[i] = bodyHash[i] = hashContent(function.name->name);
+
+        TokenRange range;
+        if (function.isImported || !findRange(tokens, function, range)) continue;
+
+        headerHash[i] = hashTokens(range.begin, range.bodyBegin, hashContent("header"));
+        bodyHash[i] = hashTokens(range.begin, range.end, hashContent("body"));
+        keys[i].cacheable = !duplicated[i];
+
+        for (size_t t = range.begin; t < range.end; ++t) {
+            if (tokens[t].type != TokenType::TOK_IDENTIFIER) continue;
+            auto callee = byName.find(tokens[t].lexeme);
+            if (callee != byName.end() && callee->second != i) keys[i].callees.push_back(callee->second);
+        }
+        // Por nombre: la clave no depende del orden de las funciones en el archivo
+        std::sort(keys[i].callees.begin(), keys[i].callees.end(), [&](size_t a, size_t b) {
+            return functions[a]->name->name < functions[b]->name->name;
+        });
+        keys[i].callees.erase(std::unique(keys[i].callees.begin(), keys[i].callees.end()), keys[i].callees.end());
+    }
+
+    // Lo que aporta una función llamada: su firma y, si es constfunc, todo lo que su evaluación usa
+    enum class State { Pending, Visiting, Done };
+    std::vector<State> state(functions.size(), State::Pending);
+    std::vector<uint64_t> closure(functions.size());
+    std::function<uint64_t(size_t)> contribution = [&](size_t callee) -> uint64_t {
+        uint64_t hash = headerHash[callee];
+        if (!functions[callee]->isConstFunc) return hash;
+        if (state[callee] == State::Visiting) return hashCombine(hash, bodyHash[callee]); // Recursión
+        if (state[callee] == State::Pending) {
+            state[callee] = State::Visiting;
+            uint64_t body = bodyHash[callee];
+            for (size_t next : keys[callee].callees) body = hashCombine(body, contribution(next));
+            closure[callee] = body;
+            state[callee] = State::Done;
+        }
+        return hashCombine(hash, closure[callee]);
+    };
+
+    for (size_t i = 0; i < functions.size(); ++i) {
+        if (!keys[i].cacheable) continue;
+        uint64_t key = hashCombine(configHash, bodyHash[i]);
+        for (size_t callee : keys[i].callees) key = hashCombine(key, contribution(callee));
+        keys[i].key = key;
+    }
+    return keys;
+}
+
+std::filesystem::path FunctionCache::objectPathFor(const std::string& name, uint64_t key) const {
+    char hex[17];
+    std::snprintf(hex, sizeof hex, "%016llx", static_cast<unsigned long long>(key));
+    return directory / (name + "-" + hex + ".o");
+}
+
+bool FunctionCache::contains(const std::string& name, uint64_t key) const {
+    std::error_code ec;
+    return std::filesystem::is_regular_file(objectPathFor(name, key), ec);
+}
+
+bool FunctionCache::prepare(std::string& error) const {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        error = "cannot create " + directory.string() + ": " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+void FunctionCache::prune(const std::vector<std::filesystem::path>& keep) const {
+    std::set<std::filesystem::path> kept(keep.begin(), keep.end());
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.path().extension() == ".o" && !kept.count(entry.path())) {
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+}
+
+} // namespace umbra
@@ -7,8 +7,13 @@ namespace umbra {
 std::string CompilerError::toString() const {
     std::ostringstream oss;
     oss << "\033[31m" // Iniciar color rojo
-        << getErrorTypeString() << " error at line " << line << ", column " << column << ": "
-        << "\033[0m" // Restablecer color
+        << getErrorTypeString() << " error at ";
+    if (!file.empty()) {
+        oss << file << ":" << line << ":" << column << ": ";
+    } else {
+        oss << "line " << line << ", column " << column << ": ";
+    }
+    oss << "\033[0m" // Restablecer color
         << message;
     return oss.str();
 }
@@ -36,6 +41,9 @@ std::string LexicalError::toString() const {
 SemanticError::SemanticError(const std::string &message, int line, int column, Action action)
     : CompilerError(ErrorType::SEMANTIC, message, line, column), action(action) {}
 
+SemanticError::SemanticError(const std::string &message, SourceLocation location, Action action)
+    : CompilerError(ErrorType::SEMANTIC, message, location), action(action) {}
+
 std::string SemanticError::toString() const {
     std::ostringstream oss;
     oss << CompilerError::toString() << " (" << (action == Action::ERROR ? "error" : "warning") << ")";
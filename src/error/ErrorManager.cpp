@@ -1,9 +1,25 @@
 #include "umbra/error/ErrorManager.h"
+#include "umbra/io/SourceMap.h"
 #include <algorithm>
+#include <filesystem>
 #include <sstream>
 
 namespace umbra {
 
+namespace {
+
+/// Ruta relativa al directorio actual cuando el archivo está por debajo de él.
+std::string displayName(const std::string &path) {
+    std::error_code ec;
+    std::filesystem::path cwd = std::filesystem::current_path(ec);
+    if (ec) return path;
+    std::filesystem::path relative = std::filesystem::path(path).lexically_proximate(cwd);
+    std::string shown = relative.string();
+    return shown.rfind("..", 0) == 0 ? path : shown;
+}
+
+} // namespace
+
 void ErrorManager::addError(std::unique_ptr<CompilerError> error) {
     if (errors.size() < MAX_ERRORS) {
         errors.push_back(std::move(error));
@@ -17,6 +33,7 @@ void ErrorManager::addError(std::unique_ptr<CompilerError> error) {
 bool ErrorManager::hasErrors() const { return !errors.empty(); }
 
 std::string ErrorManager::getErrorReport() const {
+    resolveLocations();
     std::ostringstream report;
     for (const auto &error : errors) {
         report << error->toString() << "\n";
@@ -36,8 +53,13 @@ const std::vector<std::unique_ptr<CompilerError>> &ErrorManager::getErrors() con
 }
 
 void ErrorManager::sortErrors() {
+    resolveLocations();
     std::sort(errors.begin(), errors.end(),
               [](const std::unique_ptr<CompilerError> &a, const std::unique_ptr<CompilerError> &b) {
+                  // Con ubicación, el orden del programa (también entre archivos distintos)
+                  if (a->getLocation().isValid() && b->getLocation().isValid()) {
+                      return a->getLocation().offset < b->getLocation().offset;
+                  }
                   if (a->getLine() != b->getLine()) {
                       return a->getLine() < b->getLine();
                   }
@@ -45,4 +67,24 @@ void ErrorManager::sortErrors() {
               });
 }
 
+void ErrorManager::detachSourceMap() {
+    resolveLocations();
+    sourceMap = nullptr;
+}
+
+/**
+ * La tabla de líneas de cada archivo solo se construye aquí, cuando hay errores que
+ * mostrar. Los errores ya resueltos (con archivo) no se vuelven a calcular.
+ */
+void ErrorManager::resolveLocations() const {
+    if (!sourceMap) return;
+    for (const auto &error : errors) {
+        if (!error->getLocation().isValid() || !error->getFile().empty()) continue;
+        PresumedLocation presumed = sourceMap->resolve(error->getLocation());
+        if (presumed.isValid()) {
+            error->resolve(displayName(presumed.buffer->getName()), presumed.line, presumed.column);
+        }
+    }
+}
+
 } // namespace umbra
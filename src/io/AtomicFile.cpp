@@ -0,0 +1,40 @@
+#include "umbra/io/AtomicFile.h"
+
+#include <atomic>
+#include <fstream>
+#include <system_error>
+#include <unistd.h>
+
+namespace umbra {
+
+    std::filesystem::path temporaryPathFor(const std::filesystem::path& path) {
+        static std::atomic<unsigned long> counter{0};
+        std::filesystem::path temporary = path;
+        temporary += ".tmp" + std::to_string(::getpid()) + "-" + std::to_string(counter++);
+        return temporary;
+    }
+
+    bool writeFileAtomically(const std::filesystem::path& path, std::string_view data, std::string& error) {
+        std::filesystem::path temporary = temporaryPathFor(path);
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file) {
+                file.close();
+                std::error_code ec;
+                std::filesystem::remove(temporary, ec);
+                error = "cannot write " + temporary.string();
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(temporary, path, ec);
+        if (ec) {
+            std::filesystem::remove(temporary, ec);
+            error = "cannot write " + path.string();
+            return false;
+        }
+        return true;
+    }
+
+} // namespace umbra
@@ -0,0 +1,71 @@
+#include "umbra/io/BinaryStream.h"
+
+namespace umbra {
+
+    void BinaryWriter::writeVarint(uint64_t value) {
+        while (value >= 0x80) {
+            writeU8(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        writeU8(static_cast<uint8_t>(value));
+    }
+
+    void BinaryWriter::writeU64(uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            writeU8(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void BinaryWriter::writeString(std::string_view value) {
+        writeVarint(value.size());
+        writeBytes(value);
+    }
+
+    uint8_t BinaryReader::readU8() {
+        if (failed || pos >= data.size()) {
+            failed = true;
+            return 0;
+        }
+        return static_cast<uint8_t>(data[pos++]);
+    }
+
+    uint64_t BinaryReader::readVarint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = readU8();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return failed ? 0 : value;
+        }
+        failed = true; // más de 10 bytes: no es un varint válido
+        return 0;
+    }
+
+    uint64_t BinaryReader::readU64() {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(readU8()) << (8 * i);
+        }
+        return failed ? 0 : value;
+    }
+
+    std::string BinaryReader::readString() {
+        uint64_t size = readVarint();
+        if (failed || size > data.size() - pos) {
+            failed = true;
+            return {};
+        }
+        std::string value(data.substr(pos, size));
+        pos += size;
+        return value;
+    }
+
+    bool BinaryReader::expectBytes(std::string_view expected) {
+        if (failed || data.substr(pos, expected.size()) != expected) {
+            failed = true;
+            return false;
+        }
+        pos += expected.size();
+        return true;
+    }
+
+} // namespace umbra
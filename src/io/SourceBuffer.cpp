@@ -0,0 +1,157 @@
+#include "umbra/io/SourceBuffer.h"
+#include "umbra/io/ContentHash.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace umbra {
+
+    namespace {
+
+        /// Cierra el descriptor al salir del ámbito.
+        struct FileDescriptor {
+            int fd;
+            explicit FileDescriptor(int fd) : fd(fd) {}
+            ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+        };
+
+        /// Lee hasta EOF; sirve para pipes, FIFOs y /dev/stdin, donde st_size no es fiable.
+        bool readStream(int fd, std::string& out, size_t sizeHint) {
+            out.clear();
+            out.reserve(sizeHint > 0 ? sizeHint : 64 * 1024);
+            char chunk[64 * 1024];
+            for (;;) {
+                ssize_t n = ::read(fd, chunk, sizeof(chunk));
+                if (n == 0) return true;
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                out.append(chunk, static_cast<size_t>(n));
+            }
+        }
+
+    } // namespace
+
+    SourceBuffer::~SourceBuffer() {
+        if (mapped) {
+            ::munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    std::unique_ptr<SourceBuffer> SourceBuffer::open(const std::filesystem::path& file, std::string& error, bool map) {
+        FileDescriptor fd(::open(file.c_str(), O_RDONLY | O_CLOEXEC));
+        if (fd.fd < 0) {
+            error = errno == ENOENT ? "El archivo " + file.string() + " no existe"
+                                    : "No se pudo abrir el archivo " + file.string() + ": " + std::strerror(errno);
+            return nullptr;
+        }
+
+        struct stat st;
+        if (::fstat(fd.fd, &st) != 0) {
+            error = "No se pudo consultar el archivo " + file.string() + ": " + std::strerror(errno);
+            return nullptr;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            error = "El archivo " + file.string() + " no es regular";
+            return nullptr;
+        }
+
+        std::unique_ptr<SourceBuffer> buffer(new SourceBuffer());
+        buffer->name = file.string();
+
+        // mmap de un archivo vacío falla con EINVAL: se trata como buffer propio vacío
+        if (map && S_ISREG(st.st_mode) && st.st_size > 0) {
+            size_t length = static_cast<size_t>(st.st_size);
+            void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd.fd, 0);
+            if (address != MAP_FAILED) {
+                ::madvise(address, length, MADV_SEQUENTIAL);
+                buffer->data = static_cast<const char*>(address);
+                buffer->size = length;
+                buffer->mapped = true;
+                buffer->detectBOM();
+                return buffer;
+            }
+            // Sistemas de archivos sin soporte de mmap: se lee como un stream
+        }
+
+        std::string content;
+        size_t hint = S_ISREG(st.st_mode) ? static_cast<size_t>(st.st_size) : 0;
+        if (!readStream(fd.fd, content, hint)) {
+            error = "Hubo un error al leer " + file.string() + ": " + std::strerror(errno);
+            return nullptr;
+        }
+        buffer->adopt(std::move(content));
+        return buffer;
+    }
+
+    std::unique_ptr<SourceBuffer> SourceBuffer::fromString(std::string name, std::string content) {
+        std::unique_ptr<SourceBuffer> buffer(new SourceBuffer());
+        buffer->name = std::move(name);
+        buffer->adopt(std::move(content));
+        return buffer;
+    }
+
+    void SourceBuffer::adopt(std::string content) {
+        owned = std::move(content);
+        data = owned.data();
+        size = owned.size();
+        mapped = false;
+        detectBOM();
+    }
+
+    void SourceBuffer::detectBOM() {
+        bomSize = (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) ? 3 : 0;
+    }
+
+    const std::vector<uint32_t>& SourceBuffer::getLineStarts() const {
+        std::call_once(lineStartsOnce, [this] {
+            std::string_view source = text();
+            lineStarts.push_back(0);
+            const char* begin = source.data();
+            const char* end = begin + source.size();
+            for (const char* p = begin; p < end;) {
+                const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+                if (!newline) break;
+                p = static_cast<const char*>(newline) + 1;
+                lineStarts.push_back(static_cast<uint32_t>(p - begin));
+            }
+        });
+        return lineStarts;
+    }
+
+    uint64_t SourceBuffer::getContentHash() const {
+        std::call_once(contentHashOnce, [this] { contentHash = hashContent(text()); });
+        return contentHash;
+    }
+
+    std::pair<int, int> SourceBuffer::getLineColumn(size_t offset) const {
+        const std::vector<uint32_t>& starts = getLineStarts();
+        offset = std::min(offset, text().size());
+        auto next = std::upper_bound(starts.begin(), starts.end(), static_cast<uint32_t>(offset));
+        size_t index = static_cast<size_t>(next - starts.begin()) - 1;
+        return {static_cast<int>(index + 1), static_cast<int>(offset - starts[index] + 1)};
+    }
+
+    std::string_view SourceBuffer::getLineText(int line) const {
+        const std::vector<uint32_t>& starts = getLineStarts();
+        if (line < 1 || static_cast<size_t>(line) > starts.size()) return {};
+
+        std::string_view source = text();
+        size_t begin = starts[static_cast<size_t>(line) - 1];
+        size_t end = static_cast<size_t>(line) < starts.size() ? starts[static_cast<size_t>(line)] - 1 : source.size();
+        if (end > begin && source[end - 1] == '\r') --end;
+        return source.substr(begin, end - begin);
+    }
+
+    size_t SourceBuffer::getLineCount() const {
+        return getLineStarts().size();
+    }
+
+} // namespace umbra
@@ -0,0 +1,158 @@
+#include "umbra/io/SourceCache.h"
+
+#include <sys/stat.h>
+
+namespace umbra {
+
+    namespace {
+
+        std::filesystem::path lexicalAbsolute(const std::filesystem::path& path) {
+            std::error_code ec;
+            std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+            return (ec ? path : absolute).lexically_normal();
+        }
+
+    } // namespace
+
+    SourceCache& SourceCache::global() {
+        static SourceCache cache;
+        return cache;
+    }
+
+    bool SourceCache::lookup(const std::filesystem::path& path, FileKey& key, Entry& entry) {
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+            return false;
+        }
+        key = {static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino)};
+        int64_t mtimeNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+        int64_t size = static_cast<int64_t>(st.st_size);
+        auto fresh = [&](const Entry& cached) { return cached.mtimeNs == mtimeNs && cached.size == size; };
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = files.find(key);
+            if (found != files.end() && fresh(found->second)) {
+                recency.splice(recency.begin(), recency, found->second.recent);
+                entry = found->second;
+                return true;
+            }
+        }
+
+        // Primera vez (o archivo modificado): se canonicaliza fuera del lock
+        std::error_code ec;
+        std::filesystem::path canonical = std::filesystem::canonical(path, ec);
+        entry = Entry();
+        entry.mtimeNs = mtimeNs;
+        entry.size = size;
+        entry.canonicalPath = ec ? lexicalAbsolute(path) : canonical;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = files.find(key);
+        if (found != files.end()) {
+            if (fresh(found->second)) {
+                entry = found->second; // Otro hilo lo registró mientras tanto
+                return true;
+            }
+            erase(found);
+        }
+        // La ruta resolvía a otro inodo: nadie volverá a llegar a esa entrada por ella
+        auto previous = byPath.find(entry.canonicalPath);
+        if (previous != byPath.end()) {
+            erase(files.find(previous->second));
+        }
+
+        recency.push_front(key);
+        entry.recent = recency.begin();
+        entry.cost = sizeof(Entry) + entry.canonicalPath.native().size();
+        files.emplace(key, entry);
+        byPath[entry.canonicalPath] = key;
+        bytes += entry.cost;
+        trim();
+        return true;
+    }
+
+    void SourceCache::erase(std::map<FileKey, Entry>::iterator found) {
+        if (found == files.end()) return;
+        auto path = byPath.find(found->second.canonicalPath);
+        if (path != byPath.end() && path->second == found->first) {
+            byPath.erase(path);
+        }
+        recency.erase(found->second.recent);
+        bytes -= found->second.cost;
+        files.erase(found);
+    }
+
+    void SourceCache::trim() {
+        while (bytes > capacity && !recency.empty()) {
+            erase(files.find(recency.back()));
+        }
+    }
+
+    std::filesystem::path SourceCache::canonicalPath(const std::filesystem::path& path) {
+        FileKey key;
+        Entry entry;
+        if (lookup(path, key, entry)) {
+            return entry.canonicalPath;
+        }
+
+        // Pipes, dispositivos y directorios no se guardan; /dev/stdin no se puede canonicalizar
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec)) {
+            return {};
+        }
+        return lexicalAbsolute(path);
+    }
+
+    std::shared_ptr<const SourceBuffer> SourceCache::load(const std::filesystem::path& path, std::string& error) {
+        FileKey key;
+        Entry entry;
+        if (!lookup(path, key, entry)) {
+            // El contenido de un pipe no se puede volver a leer: no se guarda
+            std::unique_ptr<SourceBuffer> buffer = SourceBuffer::open(path, error);
+            return buffer ? std::shared_ptr<const SourceBuffer>(std::move(buffer)) : nullptr;
+        }
+        if (entry.buffer) {
+            return entry.buffer;
+        }
+
+        std::unique_ptr<SourceBuffer> opened = SourceBuffer::open(entry.canonicalPath, error, mapFiles);
+        if (!opened) {
+            return nullptr;
+        }
+        std::shared_ptr<const SourceBuffer> buffer(std::move(opened));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = files.find(key);
+        if (found != files.end() && found->second.mtimeNs == entry.mtimeNs && found->second.size == entry.size) {
+            if (found->second.buffer) {
+                return found->second.buffer; // Otro hilo lo leyó mientras tanto
+            }
+            found->second.buffer = buffer;
+            found->second.cost += buffer->text().size();
+            bytes += buffer->text().size();
+            trim();
+        }
+        return buffer;
+    }
+
+    void SourceCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        files.clear();
+        byPath.clear();
+        recency.clear();
+        bytes = 0;
+    }
+
+    void SourceCache::setCapacity(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex);
+        capacity = bytes;
+        trim();
+    }
+
+    size_t SourceCache::getSize() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return bytes;
+    }
+
+} // namespace umbra
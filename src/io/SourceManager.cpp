@@ -0,0 +1,42 @@
+#include "umbra/io/SourceManager.h"
+#include "umbra/io/SourceCache.h"
+
+namespace umbra {
+
+    const SourceBuffer* SourceManager::load(const std::filesystem::path& file, std::string* errMsg) {
+        std::string key = file.string();
+        auto found = byPath.find(key);
+        if (found != byPath.end()) {
+            return buffers[found->second].get();
+        }
+
+        std::string error;
+        std::shared_ptr<const SourceBuffer> buffer = SourceCache::global().load(file, error);
+        if (!buffer) {
+            if (errMsg) *errMsg = error;
+            return nullptr;
+        }
+
+        FileID id = static_cast<FileID>(buffers.size());
+        buffers.push_back(std::move(buffer));
+        byPath.emplace(std::move(key), id);
+        return buffers.back().get();
+    }
+
+    const SourceBuffer* SourceManager::addBuffer(std::string name, std::string content) {
+        buffers.push_back(SourceBuffer::fromString(std::move(name), std::move(content)));
+        return buffers.back().get();
+    }
+
+    SourceManager::FileID SourceManager::getFileID(const SourceBuffer* buffer) const {
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            if (buffers[i].get() == buffer) return static_cast<FileID>(i);
+        }
+        return static_cast<FileID>(-1);
+    }
+
+    const SourceBuffer* SourceManager::getBuffer(FileID id) const {
+        return id < buffers.size() ? buffers[id].get() : nullptr;
+    }
+
+} // namespace umbra
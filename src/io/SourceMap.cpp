@@ -0,0 +1,47 @@
+#include "umbra/io/SourceMap.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace umbra {
+
+    void SourceMap::append(const SourceBuffer& buffer, size_t begin, size_t end) {
+        if (end <= begin) return;
+
+        // Las posiciones son de 32 bits: el programa completo no puede pasar de 4 GiB
+        if (end - begin > std::numeric_limits<uint32_t>::max() - size) {
+            throw std::runtime_error("El programa preprocesado excede 4 GiB: " + buffer.getName());
+        }
+
+        // Tramos contiguos del mismo archivo se funden en uno
+        if (!segments.empty() && segments.back().buffer == &buffer && segments.back().end == begin) {
+            segments.back().end = static_cast<uint32_t>(end);
+        } else {
+            segments.push_back({&buffer, static_cast<uint32_t>(begin), static_cast<uint32_t>(end), size});
+        }
+        size += static_cast<uint32_t>(end - begin);
+    }
+
+    PresumedLocation SourceMap::resolve(SourceLocation location) const {
+        if (!location.isValid() || segments.empty() || location.offset > size) return {};
+
+        // Último tramo cuyo offset es <= location; el fin del programa cae en el último tramo
+        auto next = std::upper_bound(segments.begin(), segments.end(), location.offset,
+                                     [](uint32_t offset, const Segment& segment) { return offset < segment.offset; });
+        const Segment& segment = *(next - 1);
+        auto [line, column] = segment.buffer->getLineColumn(segment.begin + (location.offset - segment.offset));
+        return {segment.buffer, line, column};
+    }
+
+    std::string SourceMap::flatten() const {
+        std::string out;
+        out.reserve(size);
+        for (const Segment& segment : segments) {
+            std::string_view text = segment.text();
+            out.append(text.data(), text.size());
+        }
+        return out;
+    }
+
+} // namespace umbra
@@ -81,9 +81,10 @@ constexpr char getEscapeChar(char c) {
  * @param source Código fuente a tokenizar
  */
 Lexer::Lexer(const std::string &source)
-    : source(source), 
+    : internalBuffer(SourceBuffer::fromString("<input>", source)),
       internalErrorManager(std::make_unique<ErrorManager>()),
       errorManager(internalErrorManager.get()) {
+    sourceMap.append(*internalBuffer, 0, internalBuffer->text().size());
     setupDispatch();
 }
 
@@ -93,7 +94,30 @@ Lexer::Lexer(const std::string &source)
  * @param externalErrorManager Referencia al gestor externo
  */
 Lexer::Lexer(const std::string &source, ErrorManager &externalErrorManager)
-    : source(source), 
+    : internalBuffer(SourceBuffer::fromString("<input>", source)),
+      errorManager(&externalErrorManager) {
+    sourceMap.append(*internalBuffer, 0, internalBuffer->text().size());
+    setupDispatch();
+}
+
+/**
+ * @brief Constructor sobre un buffer existente
+ * @param buffer Buffer fuente (mmap o preprocesado), compartido sin copia
+ * @param externalErrorManager Referencia al gestor externo
+ */
+Lexer::Lexer(const SourceBuffer &buffer, ErrorManager &externalErrorManager)
+    : errorManager(&externalErrorManager) {
+    sourceMap.append(buffer, 0, buffer.text().size());
+    setupDispatch();
+}
+
+/**
+ * @brief Constructor sobre los tramos del preprocesador
+ * @param sourceMap Tramos en orden de inclusión (se copia la lista, no el texto)
+ * @param externalErrorManager Referencia al gestor externo
+ */
+Lexer::Lexer(const SourceMap &sourceMap, ErrorManager &externalErrorManager)
+    : sourceMap(sourceMap),
       errorManager(&externalErrorManager) {
     setupDispatch();
 }
@@ -240,6 +264,23 @@ void Lexer::handleDefault(char c) {
     }
 }
 
+/**
+ * @brief Posiciona el escáner al inicio de un tramo
+ * @param segment Tramo del mapa de fuentes
+ * @details Los tramos empiezan siempre al inicio de una línea. Si no es la
+ * primera del archivo, su número sale de la tabla de líneas del buffer, que
+ * solo se construye para archivos que contienen directivas 'use'.
+ */
+void Lexer::enterSegment(const SourceMap::Segment& segment) {
+    buffer = segment.buffer;
+    source = segment.text();
+    segmentOffset = segment.offset;
+    current = 0;
+    start = 0;
+    column = 1;
+    line = segment.begin == 0 ? 1 : buffer->getLineColumn(segment.begin).first;
+}
+
 //==============================================================================
 // Bucle Principal de Tokenización
 //==============================================================================
@@ -254,42 +295,49 @@ void Lexer::handleDefault(char c) {
  */
 std::vector<Lexer::Token> Lexer::tokenize() {
     tokens.clear();
-    tokens.reserve(source.length() >> 2); // Heurística: ~4 chars por token
-    
-    current = 0;
-    line = 1;
-    column = 1;
-    start = 0;
-
-    while (!isAtEnd()) {
-        start = current;
-        char c = advance();
+    tokens.reserve(sourceMap.getSize() >> 2); // Heurística: ~4 chars por token
+
+    const std::vector<SourceMap::Segment>& segments = sourceMap.getSegments();
+    for (size_t index = 0; index < segments.size(); ++index) {
+        enterSegment(segments[index]);
+
+        while (!isAtEnd()) {
+            start = current;
+            char c = advance();
+
+            // Espacios en blanco (optimizado para caso común)
+            switch (c) {
+                case ' ':
+                case '\r':
+                case '\t':
+                    continue;
+                case '\n':
+                    ++line;
+                    column = 1;
+                    if (tokens.empty() || tokens.back().type != TokenType::TOK_NEWLINE) {
+                        addToken(TokenType::TOK_NEWLINE);
+                    }
+                    continue;
+                default:
+                    break;
+            }
 
-        // Espacios en blanco (optimizado para caso común)
-        switch (c) {
-            case ' ':
-            case '\r':
-            case '\t':
-                continue;
-            case '\n':
-                ++line;
-                column = 1;
-                if (tokens.empty() || tokens.back().type != TokenType::TOK_NEWLINE) {
-                    addToken(TokenType::TOK_NEWLINE);
-                }
-                continue;
-            default:
-                break;
+            // Tabla de despacho para operadores/delimitadores
+            if (auto handler = dispatchTable[static_cast<unsigned char>(c)]) {
+                (this->*handler)();
+            } else {
+                handleDefault(c);
+            }
         }
 
-        // Tabla de despacho para operadores/delimitadores
-        if (auto handler = dispatchTable[static_cast<unsigned char>(c)]) {
-            (this->*handler)();
-        } else {
-            handleDefault(c);
+        // Un archivo incluido sin salto final no debe pegar su última línea a la siguiente
+        if (index + 1 < segments.size() && !tokens.empty() && tokens.back().type != TokenType::TOK_NEWLINE) {
+            start = current;
+            addToken(TokenType::TOK_NEWLINE, "\n", 1);
         }
     }
 
+    start = current;
     addToken(TokenType::TOK_EOF);
     return tokens;
 }
@@ -343,7 +391,7 @@ bool Lexer::match(char expected) {
  * @param type Tipo de token a emitir
  */
 void Lexer::addToken(TokenType type) {
-    addToken(type, &source[start], current - start);
+    addToken(type, source.data() + start, current - start);
 }
 
 /**
@@ -353,7 +401,8 @@ void Lexer::addToken(TokenType type) {
  * @param length Longitud del lexema
  */
 void Lexer::addToken(TokenType type, const char* lexeme, size_t length) {
-    tokens.emplace_back(type, lexeme, length, line, column - length);
+    // Los tokens empiezan siempre en start (los literales pasan su valor ya procesado como lexema)
+    tokens.emplace_back(type, lexeme, length, SourceLocation(segmentOffset + static_cast<uint32_t>(start)));
 }
 
 //==============================================================================
@@ -511,7 +560,7 @@ void Lexer::identifier() {
 //==============================================================================
 
 /// @brief Obtiene el código fuente
-const std::string& Lexer::getSource() const { return source; }
+std::string_view Lexer::getSource() const { return source; }
 
 /// @brief Verifica si es signo de operación
 bool Lexer::isSing(char c) const {
@@ -549,7 +598,7 @@ void Lexer::reset() {
 Lexer::Token Lexer::peekToken() {
     if (tokenIndex < tokens.size()) return tokens[tokenIndex];
     if (!tokens.empty() && tokens.back().type == TokenType::TOK_EOF) return tokens.back();
-    return Token(TokenType::TOK_EOF, "", 0, line, column);
+    return Token(TokenType::TOK_EOF, "", 0, SourceLocation(sourceMap.getSize()));
 }
 
 /**
@@ -563,7 +612,7 @@ Lexer::Token Lexer::getNextToken() {
         }
         return tokens[tokenIndex];
     }
-    return Token(TokenType::TOK_EOF, "", 0, line, column);
+    return Token(TokenType::TOK_EOF, "", 0, SourceLocation(sourceMap.getSize()));
 }
 
 /**
@@ -572,21 +621,8 @@ Lexer::Token Lexer::getNextToken() {
  * @return Contenido de la línea
  */
 std::string Lexer::getLineContent(int lineNumber) const {
-    size_t pos = 0;
-    int currentLine = 1;
-    
-    // Buscar inicio de la línea
-    while (pos < source.length() && currentLine < lineNumber) {
-        if (source[pos++] == '\n') ++currentLine;
-    }
-    
-    if (currentLine != lineNumber) return "";
-    
-    // Buscar fin de la línea
-    size_t lineStart = pos;
-    while (pos < source.length() && source[pos] != '\n') ++pos;
-    
-    return std::string(source, lineStart, pos - lineStart);
+    // La tabla de líneas del buffer se calcula solo cuando hay un error que mostrar
+    return buffer ? std::string(buffer->getLineText(lineNumber)) : std::string();
 }
 
 //==============================================================================
@@ -609,8 +645,10 @@ void Lexer::reportLexicalError(const std::string& msg, int offset) {
 
     std::string fullMessage = "\n" + lineContent + "\n" + underline + "\n" + msg;
 
-    errorManager->addError(std::make_unique<CompilerError>(
-        ErrorType::LEXICAL, fullMessage, line, errorColumn));
+    auto error = std::make_unique<CompilerError>(ErrorType::LEXICAL, fullMessage, line, errorColumn);
+    // La ubicación aporta el archivo cuando el ErrorManager tiene el SourceMap de la compilación
+    error->setLocation(SourceLocation(segmentOffset + static_cast<uint32_t>(start + offset)));
+    errorManager->addError(std::move(error));
 }
 
 } // namespace umbra
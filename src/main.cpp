@@ -14,26 +14,62 @@
 #include <llvm/IR/Value.h>
 #include <boost/program_options.hpp>
 #include <optional>
+#include <fstream>
 #include <iostream>
 #include <chrono>
+#include <filesystem>
 #include "umbra/compiler/Compiler.h"
+#include "umbra/io/SourceCache.h"
+#include "umbra/server/CompileServer.h"
+#include "umbra/server/DaemonProtocol.h"
 
 namespace po = boost::program_options;
 
-int main(int argc, char *argv[]) {
+static int runDaemon(const po::variables_map& vm);
+
+/**
+ * @brief Una invocación de umbra: la del propio proceso o una petición de umbra-client a --daemon.
+ * @param workingDirectory Vacío en una invocación normal; en una petición, el directorio del
+ *                         cliente, contra el que se resuelven las rutas relativas.
+ * @param out, err std::cout y std::cerr, o los streams de la petición: varias compilaciones del
+ *                 daemon escriben a la vez y no pueden compartir el estado de un mismo ostream.
+ */
+static int runCommandLine(const std::vector<std::string>& arguments, const std::string& workingDirectory,
+                          std::ostream& out, std::ostream& err) {
+    auto resolve = [&](const std::string& path) {
+        if (workingDirectory.empty() || path.empty()) return path;
+        return (std::filesystem::path(workingDirectory) / path).string();
+    };
 
     po::options_description desc("Allowed options");
     desc.add_options()
         ("help,h", "Show this menu")
         ("input-file", po::value<std::string>(), "Input source file") // Opción para el archivo de entrada
-        ("set-target-machine", "Set the target machine code")
+        ("set-target-machine", po::value<std::string>(), "Target triple (default: host, e.g. x86_64-pc-linux-gnu); other triples stop at the object file")
+        ("march", po::value<std::string>(), "Target CPU; 'native' (default) uses the host CPU and its features")
+        ("mcpu", po::value<std::string>(), "Same as --march")
+        ("profile-generate", po::value<std::string>()->implicit_value(""),
+            "Instrument the program for PGO; runs write default_%m.profraw (into the given directory, if any)")
+        ("profile-use", po::value<std::string>(), "Optimize with a profile merged by llvm-profdata merge (needs -O1 or higher)")
+        ("profile-runtime", po::value<std::string>(), "Path to libclang_rt.profile used with --profile-generate")
         ("show-tokenizer", "Print all tokens")
         ("show-ast", "Print the AST")
         ("show-ir", "Print the LLVM IR")
         ("show-asm", "Print the assembly code")
         ("dump-ir", "Dump the LLVM IR to a file")
         ("dump-asm", "Dump the assembly code to a file")
-        ("compile-to-executable", "Compile to an executable");
+        ("compile-to-executable", "Compile to an executable")
+        ("runtime-lib", po::value<std::string>(), "Path to libumbra_rt.a used when linking")
+        ("bounds-check", "Trap on out-of-range array accesses (reports line and column)")
+        ("emit-module", "Compile a library for `use`: writes lib.o and its interface lib.umi next to lib.umbra")
+        ("no-modules", "Include `use` files as text even when a precompiled .umi interface exists")
+        ("ast-cache", "Reuse the checked AST saved in main.uast when no source changed (skips lexing, parsing and checking)")
+        ("emit-ast", po::value<std::string>(), "Write the checked AST in binary form (.uast) to the given file")
+        ("incremental", "Keep one object per function in main.ufc/ and only recompile the functions that changed")
+        ("daemon", "Serve compiles from umbra-client on a Unix socket, keeping caches and LLVM initialized")
+        ("socket", po::value<std::string>(), "Socket for --daemon (default: $UMBRA_SOCKET, or umbra.sock in $XDG_RUNTIME_DIR)")
+        ("daemon-jobs", po::value<int>(), "Compiles served at once by --daemon (default: number of CPUs)")
+        ("opt-level,O", po::value<int>(), "Optimization level 0-3 (e.g. -O2)");
 
 
     po::positional_options_description p;
@@ -41,21 +77,29 @@ int main(int argc, char *argv[]) {
     p.add("input-file", 1);
 
     po::variables_map vm;
-    po::store(po::command_line_parser(argc, argv).options(desc).positional(p).run(), vm);
+    po::store(po::command_line_parser(arguments).options(desc).positional(p).run(), vm);
     po::notify(vm);
 
     if(vm.count("help")) {
-        std::cout << desc << "\n";
+        out << desc << "\n";
         return 0;
     }
 
+    if(vm.count("daemon")){
+        if(!workingDirectory.empty()){
+            err << "Error: --daemon cannot be requested through umbra-client." << std::endl;
+            return 1;
+        }
+        return runDaemon(vm);
+    }
+
     umbra::UmbraCompilerOptions options;
 
     if (vm.count("input-file")) {
-        options.inputFilePath = vm["input-file"].as<std::string>();
+        options.inputFilePath = resolve(vm["input-file"].as<std::string>());
     } else {
-        std::cerr << "Error: No input file specified." << std::endl;
-        std::cout << desc << std::endl;
+        err << "Error: No input file specified." << std::endl;
+        out << desc << std::endl;
         return 1;
     }
 
@@ -67,12 +111,126 @@ int main(int argc, char *argv[]) {
         options.printAST = true;
     }
 
+    if(vm.count("runtime-lib")){
+        options.runtimeLibraryPath = resolve(vm["runtime-lib"].as<std::string>());
+    }
+
+    if(vm.count("bounds-check")){
+        options.boundsCheck = true;
+    }
+
+    if(vm.count("emit-module")){
+        options.emitModule = true;
+    }
+
+    if(vm.count("no-modules")){
+        options.useModules = false;
+    }
+
+    if(vm.count("ast-cache")){
+        options.astCache = true;
+    }
+
+    if(vm.count("emit-ast")){
+        options.emitASTFile = resolve(vm["emit-ast"].as<std::string>());
+    }
+
+    if(vm.count("incremental")){
+        options.incremental = true;
+    }
+
+    if(vm.count("set-target-machine")){
+        options.targetTriple = vm["set-target-machine"].as<std::string>();
+    }
+
+    if(vm.count("march")){
+        options.targetCPU = vm["march"].as<std::string>();
+    }
+
+    if(vm.count("mcpu")){
+        options.targetCPU = vm["mcpu"].as<std::string>();
+    }
+
+    if(vm.count("opt-level")){
+        options.optLevel = vm["opt-level"].as<int>();
+        if(options.optLevel < 0 || options.optLevel > 3){
+            err << "Error: --opt-level must be between 0 and 3." << std::endl;
+            return 1;
+        }
+    }
+
+    if(vm.count("profile-generate") && vm.count("profile-use")){
+        err << "Error: --profile-generate and --profile-use cannot be used together." << std::endl;
+        return 1;
+    }
+
+    if(vm.count("profile-generate")){
+        // Sin directorio, el perfil se escribe en el directorio desde el que se ejecuta el programa
+        std::string directory = resolve(vm["profile-generate"].as<std::string>());
+        options.profileGenerateFile = directory.empty() ? "default_%m.profraw"
+                                                        : (std::filesystem::path(directory) / "default_%m.profraw").string();
+    }
+
+    if(vm.count("profile-use")){
+        options.profileUseFile = resolve(vm["profile-use"].as<std::string>());
+        if(!std::ifstream(options.profileUseFile)){
+            err << "Error: cannot open profile '" << options.profileUseFile << "'." << std::endl;
+            return 1;
+        }
+        if(options.optLevel == 0){
+            err << "Error: --profile-use requires -O1 or higher." << std::endl;
+            return 1;
+        }
+    }
+
+    if(vm.count("profile-runtime")){
+        options.profileRuntimePath = resolve(vm["profile-runtime"].as<std::string>());
+    }
+
+    if(!workingDirectory.empty()){
+        options.outputIRFile = resolve(options.outputIRFile);
+        options.outputExecName = resolve(options.outputExecName);
+        // /dev/stdin o un pipe serían los del daemon, no los del cliente
+        std::error_code ec;
+        if(std::filesystem::exists(options.inputFilePath, ec) && !std::filesystem::is_regular_file(options.inputFilePath, ec)){
+            err << "Error: the daemon only compiles regular files; run umbra directly for '"
+                      << options.inputFilePath << "'." << std::endl;
+            return 1;
+        }
+    }
+
     umbra::ErrorManager errorManager;
-    umbra::Compiler compiler(options, errorManager);
-    compiler.compile();
+    umbra::Compiler compiler(options, errorManager, out, err);
+    bool compiled = compiler.compile();
     if(errorManager.hasErrors()){
-        std::cout << errorManager.getErrorReport();
+        out << errorManager.getErrorReport();
+    }
+
+    return compiled && !errorManager.hasErrors() ? 0 : 1;
+}
+
+static int runDaemon(const po::variables_map& vm) {
+    std::string socketPath = vm.count("socket") ? vm["socket"].as<std::string>() : umbra::DaemonProtocol::defaultSocketPath();
+    int jobs = vm.count("daemon-jobs") ? vm["daemon-jobs"].as<int>() : 0;
+    if(jobs < 0){
+        std::cerr << "Error: --daemon-jobs must be positive." << std::endl;
+        return 1;
     }
 
+    // Lo que cada compilación pagaría al arrancar se hace una vez aquí
+    umbra::Compiler::initializeTargets();
+    // Un fuente truncado mientras está proyectado tiraría el daemon con SIGBUS
+    umbra::SourceCache::global().setMapFiles(false);
+
+    umbra::CompileServer server(socketPath, static_cast<unsigned>(jobs), runCommandLine);
+    std::string error;
+    if(!server.run(error)){
+        std::cerr << "Error: " << error << "." << std::endl;
+        return 1;
+    }
     return 0;
 }
+
+int main(int argc, char *argv[]) {
+    return runCommandLine(std::vector<std::string>(argv + 1, argv + argc), "", std::cout, std::cerr);
+}
@@ -0,0 +1,170 @@
+#include "umbra/module/ModuleInterface.h"
+#include "umbra/io/AtomicFile.h"
+#include "umbra/io/BinaryStream.h"
+#include "umbra/io/SourceCache.h"
+
+#include <system_error>
+
+namespace umbra {
+
+namespace {
+
+constexpr std::string_view kMagic = "UMBI";
+
+constexpr unsigned kSemanticTypeCount = 0
+    #define X(T) + 1
+    #include "umbra/utils/builtin_types.def"
+    #undef X
+    ;
+
+// Límite de cordura para listas leídas del archivo: evita reservar memoria por un tamaño corrupto
+constexpr uint64_t kMaxEntries = 1u << 20;
+
+void writeType(BinaryWriter& out, SemanticType type) {
+    out.writeU8(static_cast<uint8_t>(type));
+}
+
+SemanticType readType(BinaryReader& in) {
+    uint8_t value = in.readU8();
+    if (value >= kSemanticTypeCount) {
+        in.fail();
+        return SemanticType::Error;
+    }
+    return static_cast<SemanticType>(value);
+}
+
+uint64_t readCount(BinaryReader& in) {
+    uint64_t count = in.readVarint();
+    if (count > kMaxEntries) {
+        in.fail();
+        return 0;
+    }
+    return count;
+}
+
+void writeSignature(BinaryWriter& out, const FunctionSignature& signature) {
+    writeType(out, signature.returnType);
+    out.writeU8((signature.isVarArg ? 1 : 0) | (signature.isConstFunc ? 2 : 0));
+    out.writeVarint(signature.argTypes.size());
+    for (size_t i = 0; i < signature.argTypes.size(); ++i) {
+        writeType(out, signature.argTypes[i]);
+        out.writeVarint(i < signature.argArrayDims.size() ? signature.argArrayDims[i] : 0);
+        out.writeU8(i < signature.argByReference.size() && signature.argByReference[i] ? 1 : 0);
+        writeType(out, i < signature.argPointeeTypes.size() ? signature.argPointeeTypes[i] : SemanticType::None);
+    }
+}
+
+FunctionSignature readSignature(BinaryReader& in) {
+    FunctionSignature signature;
+    signature.returnType = readType(in);
+    uint8_t flags = in.readU8();
+    signature.isVarArg = flags & 1;
+    signature.isConstFunc = flags & 2;
+    uint64_t argCount = readCount(in);
+    for (uint64_t i = 0; i < argCount && in.ok(); ++i) {
+        signature.argTypes.push_back(readType(in));
+        signature.argArrayDims.push_back(static_cast<int>(in.readVarint()));
+        signature.argByReference.push_back(in.readU8() != 0);
+        signature.argPointeeTypes.push_back(readType(in));
+    }
+    return signature;
+}
+
+} // namespace
+
+std::filesystem::path ModuleInterface::interfacePathFor(const std::filesystem::path& sourcePath) {
+    return std::filesystem::path(sourcePath).replace_extension(".umi");
+}
+
+std::filesystem::path ModuleInterface::objectPathFor(const std::filesystem::path& sourcePath) {
+    return std::filesystem::path(sourcePath).replace_extension(".o");
+}
+
+bool ModuleInterface::write(const std::filesystem::path& path, std::string& error) const {
+    BinaryWriter out;
+    out.writeBytes(kMagic);
+    out.writeVarint(FormatVersion);
+    out.writeString(targetTriple);
+    out.writeString(objectFile);
+
+    out.writeVarint(sources.size());
+    for (const Source& source : sources) {
+        out.writeString(source.path);
+        out.writeU64(source.hash);
+    }
+
+    out.writeVarint(imports.size());
+    for (const std::string& import : imports) {
+        out.writeString(import);
+    }
+
+    out.writeVarint(functions.size());
+    for (const Function& function : functions) {
+        out.writeString(function.name);
+        writeSignature(out, function.signature);
+    }
+
+    // Se escribe aparte y se renombra: otro compilador nunca ve una interfaz a medias
+    return writeFileAtomically(path, out.buffer(), error);
+}
+
+std::optional<ModuleInterface> ModuleInterface::read(const std::filesystem::path& path, std::string& error) {
+    // Por SourceCache: en un proceso que compila muchas veces (--daemon) una interfaz ya leída
+    // cuesta un stat
+    std::string openError;
+    std::shared_ptr<const SourceBuffer> file = SourceCache::global().load(path, openError);
+    if (!file) {
+        error = "cannot open " + path.string();
+        return std::nullopt;
+    }
+
+    BinaryReader in(file->text());
+    ModuleInterface module;
+    if (!in.expectBytes(kMagic) || in.readVarint() != FormatVersion) {
+        error = path.string() + " is not a module interface of this compiler version";
+        return std::nullopt;
+    }
+    module.targetTriple = in.readString();
+    module.objectFile = in.readString();
+
+    uint64_t sourceCount = readCount(in);
+    for (uint64_t i = 0; i < sourceCount && in.ok(); ++i) {
+        Source source;
+        source.path = in.readString();
+        source.hash = in.readU64();
+        module.sources.push_back(std::move(source));
+    }
+
+    uint64_t importCount = readCount(in);
+    for (uint64_t i = 0; i < importCount && in.ok(); ++i) {
+        module.imports.push_back(in.readString());
+    }
+
+    uint64_t functionCount = readCount(in);
+    for (uint64_t i = 0; i < functionCount && in.ok(); ++i) {
+        Function function;
+        function.name = in.readString();
+        function.signature = readSignature(in);
+        module.functions.push_back(std::move(function));
+    }
+
+    if (!in.ok() || !in.atEnd() || module.sources.empty()) {
+        error = path.string() + " is truncated or corrupt";
+        return std::nullopt;
+    }
+    return module;
+}
+
+bool ModuleInterface::isUpToDate() const {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(objectFile, ec)) return false;
+
+    for (const Source& source : sources) {
+        std::string error;
+        std::shared_ptr<const SourceBuffer> buffer = SourceCache::global().load(source.path, error);
+        if (!buffer || buffer->getContentHash() != source.hash) return false;
+    }
+    return true;
+}
+
+} // namespace umbra
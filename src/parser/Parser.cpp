@@ -20,6 +20,8 @@
 #include "umbra/error/ErrorTypes.h"
 #include <iostream>
 #include <algorithm>
+#include <charconv>
+#include <climits>
 #include <string_view>
 #include <array>
 
@@ -41,18 +43,35 @@ namespace {
     switch (t) {
         case TokenType::TOK_INT:
         case TokenType::TOK_FLOAT:
+        case TokenType::TOK_LONG:
+        case TokenType::TOK_DOUBLE:
         case TokenType::TOK_STRING:
         case TokenType::TOK_BOOL:
         case TokenType::TOK_VOID:
         case TokenType::TOK_CHAR:
         case TokenType::TOK_PTR:
         case TokenType::TOK_REF:
+        case TokenType::TOK_VEC4:
+        case TokenType::TOK_VEC8:
             return true;
         default:
             return false;
     }
 }
 
+/**
+ * @brief Mapea `vec4`/`vec8` + tipo de elemento al BuiltinType vectorial
+ * @return BuiltinType::Error si la combinación no existe
+ */
+[[nodiscard]] constexpr BuiltinType vectorBuiltinType(TokenType lanes, TokenType elem) noexcept {
+    const bool four = lanes == TokenType::TOK_VEC4;
+    switch (elem) {
+        case TokenType::TOK_INT:    return four ? BuiltinType::Vec4Int : BuiltinType::Vec8Int;
+        case TokenType::TOK_FLOAT:  return four ? BuiltinType::Vec4Float : BuiltinType::Vec8Float;
+        default:                    return BuiltinType::Error;
+    }
+}
+
 /**
  * @brief Verifica si es operador de comparación (optimizado)
  */
@@ -115,6 +134,8 @@ namespace {
     switch (t) {
         case TokenType::TOK_INT:    return BuiltinType::Int;
         case TokenType::TOK_FLOAT:  return BuiltinType::Float;
+        case TokenType::TOK_LONG:   return BuiltinType::Long;
+        case TokenType::TOK_DOUBLE: return BuiltinType::Double;
         case TokenType::TOK_STRING: return BuiltinType::String;
         case TokenType::TOK_BOOL:   return BuiltinType::Bool;
         case TokenType::TOK_VOID:   return BuiltinType::Void;
@@ -125,6 +146,22 @@ namespace {
     }
 }
 
+/**
+ * @brief Construye el literal numérico de un lexema
+ * @details Con '.' o exponente es Float; un entero que no cabe en 32 bits es Long.
+ *          Devuelve nullptr si el entero no cabe en un long.
+ */
+[[nodiscard]] inline std::unique_ptr<NumericLiteral> makeNumericLiteral(const std::string& lexeme) {
+    if (lexeme.find_first_of(".eE") != std::string::npos) {
+        return std::make_unique<NumericLiteral>(std::stod(lexeme), BuiltinType::Float);
+    }
+    // Los enteros no pasan por double: 9007199254740993 se conserva exacto
+    int64_t value = 0;
+    auto [end, ec] = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+    if (ec != std::errc() || end != lexeme.data() + lexeme.size()) return nullptr;
+    return std::make_unique<NumericLiteral>(value, value > INT32_MAX ? BuiltinType::Long : BuiltinType::Int);
+}
+
 /**
  * @brief Tabla de lookup para operadores → string_view
  * @details Usa string_view para evitar allocaciones de memoria
@@ -159,7 +196,17 @@ struct OperatorTable {
 /**
  * @brief Token EOF por defecto (evita construcciones repetidas)
  */
-inline const Lexer::Token kEofToken{TokenType::TOK_EOF, "", 0, 0, 0};
+inline const Lexer::Token kEofToken{TokenType::TOK_EOF, "", 0, SourceLocation()};
+
+/**
+ * @brief Fija la ubicación de un nodo recién construido
+ * @details Los diagnósticos semánticos la resuelven a archivo:línea:columna.
+ */
+template <typename Node>
+std::unique_ptr<Node> located(std::unique_ptr<Node> node, SourceLocation location) {
+    node->location = location;
+    return node;
+}
 
 } // namespace anónimo
 
@@ -231,10 +278,15 @@ void Parser::skipNewLines() noexcept {
     while (check(TokenType::TOK_NEWLINE)) [[unlikely]] advance();
 }
 
+bool Parser::checkContextual(const char* word) const noexcept {
+    const Lexer::Token& tk = peek();
+    return tk.type == TokenType::TOK_IDENTIFIER && tk.lexeme == word;
+}
+
 Lexer::Token Parser::consume(TokenType t, const char* msg) {
     if (check(t)) [[likely]] return advance();
-    error(msg, peek().line, peek().column);
-    return Lexer::Token{TokenType::TOK_INVALID, "", 0, peek().line, peek().column};
+    error(msg, peek().location);
+    return Lexer::Token{TokenType::TOK_INVALID, "", 0, peek().location};
 }
 
 //==============================================================================
@@ -273,14 +325,22 @@ void Parser::synchronize() noexcept {
         
         switch (peek().type) {
             case TokenType::TOK_FUNC:
+            case TokenType::TOK_CONSTFUNC:
+            case TokenType::TOK_INLINE:
+            case TokenType::TOK_NOINLINE:
             case TokenType::TOK_IF:
             case TokenType::TOK_REPEAT:
             case TokenType::TOK_RETURN:
             case TokenType::TOK_INT:
             case TokenType::TOK_FLOAT:
+            case TokenType::TOK_LONG:
+            case TokenType::TOK_DOUBLE:
             case TokenType::TOK_BOOL:
             case TokenType::TOK_STRING:
             case TokenType::TOK_VOID:
+            case TokenType::TOK_VEC4:
+            case TokenType::TOK_VEC8:
+            case TokenType::TOK_CONST:
                 return;
             default:
                 break;
@@ -289,12 +349,12 @@ void Parser::synchronize() noexcept {
     }
 }
 
-void Parser::error(const char* msg, int ln, int col) {
+void Parser::error(const char* msg, SourceLocation location) {
     if (errorManager) {
         errorManager->addError(std::make_unique<CompilerError>(
-            ErrorType::SYNTACTIC, std::string(msg), ln, col));
+            ErrorType::SYNTACTIC, std::string(msg), location));
     } else {
-        std::cerr << "[Parser Error] Línea " << ln << ", Col " << col 
+        std::cerr << "[Parser Error] Posición " << location.offset
                   << ": " << msg << std::endl;
     }
 }
@@ -310,12 +370,13 @@ std::unique_ptr<ProgramNode> Parser::parseProgram() {
     skipNewLines();
     
     while (!isAtEnd()) [[likely]] {
-        if (check(TokenType::TOK_FUNC)) [[likely]] {
+        if (check(TokenType::TOK_FUNC) || check(TokenType::TOK_CONSTFUNC) ||
+            check(TokenType::TOK_INLINE) || check(TokenType::TOK_NOINLINE)) [[likely]] {
             if (auto fn = parseFunctionDefinition()) {
                 functions.push_back(std::move(fn));
             }
         } else [[unlikely]] {
-            error("Se esperaba definición de función", peek().line, peek().column);
+            error("Se esperaba definición de función", peek().location);
             synchronize();
         }
         skipNewLines();
@@ -329,7 +390,18 @@ std::unique_ptr<ProgramNode> Parser::parseProgram() {
 //==============================================================================
 
 std::unique_ptr<FunctionDefinition> Parser::parseFunctionDefinition() {
-    consume(TokenType::TOK_FUNC, "Se esperaba 'func'");
+    InlineHint inlineHint = InlineHint::Default;
+    if (match(TokenType::TOK_INLINE)) {
+        inlineHint = InlineHint::Always;
+    } else if (match(TokenType::TOK_NOINLINE)) {
+        inlineHint = InlineHint::Never;
+    }
+    skipNewLines();
+
+    bool isConstFunc = match(TokenType::TOK_CONSTFUNC);
+    if (!isConstFunc) {
+        consume(TokenType::TOK_FUNC, "Se esperaba 'func'");
+    }
     skipNewLines();
     
     Lexer::Token nameToken = consume(TokenType::TOK_IDENTIFIER, "Se esperaba nombre de función");
@@ -345,16 +417,17 @@ std::unique_ptr<FunctionDefinition> Parser::parseFunctionDefinition() {
         do {
             skipNewLines();
             if (!isTypeToken(peek())) {
-                error("Se esperaba tipo de parámetro", peek().line, peek().column);
+                error("Se esperaba tipo de parámetro", peek().location);
                 break;
             }
             
-            auto paramType = parseType();
+            // Los arrays se reciben como slices: `int []v`, `float [][]m`
+            auto paramType = parseType(true);
             Lexer::Token paramName = consume(TokenType::TOK_IDENTIFIER, "Se esperaba nombre de parámetro");
             
             params.emplace_back(
                 std::move(paramType),
-                std::make_unique<Identifier>(paramName.lexeme)
+                located(std::make_unique<Identifier>(paramName.lexeme), paramName.location)
             );
             
             skipNewLines();
@@ -380,19 +453,22 @@ std::unique_ptr<FunctionDefinition> Parser::parseFunctionDefinition() {
     
     auto paramList = std::make_unique<ParameterList>(std::move(params));
     
-    return std::make_unique<FunctionDefinition>(
-        std::make_unique<Identifier>(nameToken.lexeme),
+    auto function = located(std::make_unique<FunctionDefinition>(
+        located(std::make_unique<Identifier>(nameToken.lexeme), nameToken.location),
         std::move(paramList),
         std::move(returnType),
         std::move(body)
-    );
+    ), nameToken.location);
+    function->isConstFunc = isConstFunc;
+    function->inlineHint = inlineHint;
+    return function;
 }
 
 //==============================================================================
 // Parsing de Tipos
 //==============================================================================
 
-std::unique_ptr<Type> Parser::parseType() {
+std::unique_ptr<Type> Parser::parseType(bool allowUnsized) {
     bool isPointer = false;
     bool isReference = false;
     
@@ -407,12 +483,22 @@ std::unique_ptr<Type> Parser::parseType() {
     }
     
     if (!isTypeToken(peek())) {
-        error("Se esperaba especificador de tipo", peek().line, peek().column);
+        error("Se esperaba especificador de tipo", peek().location);
         return std::make_unique<Type>(BuiltinType::Void);
     }
     
     Lexer::Token typeToken = advance();
     BuiltinType baseType = tokenToBuiltinType(typeToken.type);
+
+    // Tipos SIMD: vec4 float, vec8 int, ...
+    if (typeToken.type == TokenType::TOK_VEC4 || typeToken.type == TokenType::TOK_VEC8) {
+        baseType = vectorBuiltinType(typeToken.type, peek().type);
+        if (baseType == BuiltinType::Error) {
+            error("Se esperaba 'int' o 'float' como tipo de elemento del vector", peek().location);
+            return std::make_unique<Type>(BuiltinType::Void);
+        }
+        advance();
+    }
     
     // Dimensiones de array con expresiones
     std::vector<std::unique_ptr<Expression>> arraySizes;
@@ -422,13 +508,19 @@ std::unique_ptr<Type> Parser::parseType() {
         advance();
         skipNewLines();
         
-        if (check(TokenType::TOK_NUMBER)) {
-            int size = std::stoi(advance().lexeme);
-            arraySizes.push_back(std::make_unique<NumericLiteral>(
-                static_cast<double>(size), BuiltinType::Int));
-            ++arrayDimensions;
+        // El tamaño puede ser cualquier expresión constante (int [3*4]m, int [N]v con
+        // const N); ConstantFolder la reduce a un literal antes de codegen
+        if (check(TokenType::TOK_RIGHT_BRACKET)) {
+            // Dimensión sin tamaño (solo en parámetros): la longitud llega con el slice
+            if (allowUnsized) {
+                arraySizes.push_back(nullptr);
+                ++arrayDimensions;
+            } else {
+                error("Se esperaba tamaño de array", peek().location);
+            }
         } else {
-            error("Se esperaba tamaño de array", peek().line, peek().column);
+            arraySizes.push_back(parseExpression());
+            ++arrayDimensions;
         }
         
         skipNewLines();
@@ -459,7 +551,9 @@ std::vector<std::unique_ptr<Statement>> Parser::parseStatementList() {
     skipNewLines();
     
     while (!isAtEnd() && !check(TokenType::TOK_RIGHT_BRACE)) [[likely]] {
+        SourceLocation location = peek().location;
         if (auto stmt = parseStatement()) [[likely]] {
+            if (!stmt->location.isValid()) stmt->location = location;
             stmts.push_back(std::move(stmt));
         }
         skipNewLines();
@@ -481,6 +575,24 @@ std::unique_ptr<Statement> Parser::parseStatement() {
         case TokenType::TOK_IF:
             return parseIfStatement();
             
+        case TokenType::TOK_CONST: {
+            advance();
+            auto decl = parseVariableDeclaration();
+            decl->isConst = true;
+            return decl;
+        }
+
+        case TokenType::TOK_ACCESS: {
+            // access p = v: escritura a través de un puntero
+            auto target = parseExpression();
+            if (match(TokenType::TOK_ASSIGN)) {
+                skipNewLines();
+                auto value = parseExpression();
+                return std::make_unique<AssignmentStatement>(std::move(target), std::move(value));
+            }
+            return std::make_unique<ExpressionStatement>(std::move(target));
+        }
+
         case TokenType::TOK_REPEAT: {
             // Distinguir entre repeat (n) times y repeat if
             if (lookAhead(1).type == TokenType::TOK_IF) [[unlikely]] {
@@ -501,8 +613,13 @@ std::unique_ptr<Statement> Parser::parseStatement() {
             if (isBasicType(next) || next == TokenType::TOK_IDENTIFIER) {
                 return parseVariableDeclaration();
             }
+        } else if (t == TokenType::TOK_VEC4 || t == TokenType::TOK_VEC8) {
+            return parseVariableDeclaration();
         } else if (next == TokenType::TOK_IDENTIFIER) {
             return parseVariableDeclaration();
+        } else if (next == TokenType::TOK_LEFT_BRACKET && t != TokenType::TOK_IDENTIFIER) {
+            // Declaración de array: int [N]nombre
+            return parseVariableDeclaration();
         }
     }
     
@@ -517,6 +634,7 @@ std::unique_ptr<Statement> Parser::parseStatement() {
 }
 
 std::unique_ptr<VariableDeclaration> Parser::parseVariableDeclaration() {
+    SourceLocation location = peek().location;
     auto type = parseType();
     Lexer::Token nameToken = consume(TokenType::TOK_IDENTIFIER, "Se esperaba nombre de variable");
     
@@ -526,27 +644,27 @@ std::unique_ptr<VariableDeclaration> Parser::parseVariableDeclaration() {
         initializer = parseExpression();
     }
     
-    return std::make_unique<VariableDeclaration>(
+    return located(std::make_unique<VariableDeclaration>(
         std::move(type),
-        std::make_unique<Identifier>(nameToken.lexeme),
+        located(std::make_unique<Identifier>(nameToken.lexeme), nameToken.location),
         std::move(initializer)
-    );
+    ), location);
 }
 
 std::unique_ptr<AssignmentStatement> Parser::parseAssignmentStatement() {
     Lexer::Token nameToken = consume(TokenType::TOK_IDENTIFIER, "Se esperaba identificador");
     
     // Construir expresión target (puede ser acceso a array)
-    std::unique_ptr<Expression> target = std::make_unique<Identifier>(nameToken.lexeme);
+    std::unique_ptr<Expression> target = located(std::make_unique<Identifier>(nameToken.lexeme), nameToken.location);
     
     while (check(TokenType::TOK_LEFT_BRACKET)) {
-        advance();
+        Lexer::Token bracket = advance();
         skipNewLines();
         auto index = parseExpression();
         skipNewLines();
         consume(TokenType::TOK_RIGHT_BRACKET, "Se esperaba ']'");
         
-        target = std::make_unique<ArrayAccessExpression>(std::move(target), std::move(index));
+        target = located(std::make_unique<ArrayAccessExpression>(std::move(target), std::move(index)), bracket.location);
     }
     
     consume(TokenType::TOK_ASSIGN, "Se esperaba '='");
@@ -554,7 +672,7 @@ std::unique_ptr<AssignmentStatement> Parser::parseAssignmentStatement() {
     
     auto value = parseExpression();
     
-    return std::make_unique<AssignmentStatement>(std::move(target), std::move(value));
+    return located(std::make_unique<AssignmentStatement>(std::move(target), std::move(value)), nameToken.location);
 }
 
 std::unique_ptr<ReturnExpression> Parser::parseReturnExpression() {
@@ -619,28 +737,70 @@ std::unique_ptr<RepeatTimesStatement> Parser::parseRepeatTimesStatement() {
     consume(TokenType::TOK_REPEAT, "Se esperaba 'repeat'");
     skipNewLines();
     
-    
-    consume(TokenType::TOK_LEFT_PAREN, "Se esperaba '('");
-    skipNewLines();
-    
+    // Los paréntesis son opcionales: repeat 5 times / repeat (n) times.
+    // Una expresión entre paréntesis ya la resuelve parsePrimary.
     auto count = parseExpression();
     skipNewLines();
     
-    consume(TokenType::TOK_RIGHT_PAREN, "Se esperaba ')'");
-    skipNewLines();
-    
     consume(TokenType::TOK_TIMES, "Se esperaba 'times'");
     skipNewLines();
+
+    // 'in parallel' es contextual: 'in' y 'parallel' siguen siendo identificadores válidos
+    auto loop = std::make_unique<RepeatTimesStatement>(std::move(count), std::vector<std::unique_ptr<Statement>>{});
+    if (checkContextual("in") && lookAhead(1).type == TokenType::TOK_IDENTIFIER &&
+        lookAhead(1).lexeme == "parallel") {
+        advance();
+        advance();
+        loop->parallel = true;
+        parseParallelClauses(*loop);
+        skipNewLines();
+    }
     
     consume(TokenType::TOK_LEFT_BRACE, "Se esperaba '{'");
     skipNewLines();
     
-    auto body = parseStatementList();
+    loop->body = parseStatementList();
     skipNewLines();
     
     consume(TokenType::TOK_RIGHT_BRACE, "Se esperaba '}'");
     
-    return std::make_unique<RepeatTimesStatement>(std::move(count), std::move(body));
+    return loop;
+}
+
+/**
+ * @brief Cláusulas de un repeat paralelo: [as i] [reduce(op: v, ...)]
+ * @details op es '+', 'min' o 'max'.
+ */
+void Parser::parseParallelClauses(RepeatTimesStatement& loop) {
+    if (checkContextual("as")) {
+        advance();
+        Lexer::Token name = consume(TokenType::TOK_IDENTIFIER, "Se esperaba nombre del índice tras 'as'");
+        loop.indexVar = located(std::make_unique<Identifier>(name.lexeme), name.location);
+    }
+
+    if (!checkContextual("reduce")) return;
+    advance();
+    consume(TokenType::TOK_LEFT_PAREN, "Se esperaba '(' tras 'reduce'");
+    do {
+        skipNewLines();
+        Lexer::Token opToken = peek();
+        std::string op;
+        if (opToken.type == TokenType::TOK_ADD) {
+            op = "+";
+        } else if (opToken.type == TokenType::TOK_IDENTIFIER &&
+                   (opToken.lexeme == "min" || opToken.lexeme == "max")) {
+            op = opToken.lexeme;
+        } else {
+            error("Operador de reducción no soportado (se esperaba '+', 'min' o 'max')", opToken.location);
+            return;
+        }
+        advance();
+        consume(TokenType::TOK_COLON, "Se esperaba ':' en la reducción");
+        Lexer::Token target = consume(TokenType::TOK_IDENTIFIER, "Se esperaba variable de reducción");
+        loop.reductions.push_back(Reduction{op, located(std::make_unique<Identifier>(target.lexeme), target.location)});
+        skipNewLines();
+    } while (match(TokenType::TOK_COMMA));
+    consume(TokenType::TOK_RIGHT_PAREN, "Se esperaba ')'");
 }
 
 std::unique_ptr<RepeatIfStatement> Parser::parseRepeatIfStatement() {
@@ -679,12 +839,12 @@ std::unique_ptr<Expression> Parser::parseLogicalOr() {
     auto left = parseLogicalAnd();
     
     while (check(TokenType::TOK_OR)) [[unlikely]] {
-        advance();
+        SourceLocation location = advance().location;
         skipNewLines();
         auto right = parseLogicalAnd();
-        left = std::make_unique<BinaryExpression>(
+        left = located(std::make_unique<BinaryExpression>(
             std::string(OperatorTable::get(TokenType::TOK_OR)),
-            std::move(left), std::move(right));
+            std::move(left), std::move(right)), location);
     }
     
     return left;
@@ -694,12 +854,12 @@ std::unique_ptr<Expression> Parser::parseLogicalAnd() {
     auto left = parseEquality();
     
     while (check(TokenType::TOK_AND)) [[unlikely]] {
-        advance();
+        SourceLocation location = advance().location;
         skipNewLines();
         auto right = parseEquality();
-        left = std::make_unique<BinaryExpression>(
+        left = located(std::make_unique<BinaryExpression>(
             std::string(OperatorTable::get(TokenType::TOK_AND)),
-            std::move(left), std::move(right));
+            std::move(left), std::move(right)), location);
     }
     
     return left;
@@ -710,10 +870,11 @@ std::unique_ptr<Expression> Parser::parseEquality() {
     
     TokenType t = peek().type;
     while (t == TokenType::TOK_EQUAL || t == TokenType::TOK_DIFFERENT) [[unlikely]] {
-        std::string op(OperatorTable::get(advance().type));
+        const Lexer::Token opToken = advance();
+        std::string op(OperatorTable::get(opToken.type));
         skipNewLines();
         auto right = parseRelational();
-        left = std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right));
+        left = located(std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right)), opToken.location);
         t = peek().type;
     }
     
@@ -727,10 +888,11 @@ std::unique_ptr<Expression> Parser::parseRelational() {
     while (isComparisonOp(peek().type) && 
            peek().type != TokenType::TOK_EQUAL && 
            peek().type != TokenType::TOK_DIFFERENT) [[unlikely]] {
-        std::string op(OperatorTable::get(advance().type));
+        const Lexer::Token opToken = advance();
+        std::string op(OperatorTable::get(opToken.type));
         skipNewLines();
         auto right = parseAdditive();
-        left = std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right));
+        left = located(std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right)), opToken.location);
     }
     
     return left;
@@ -741,10 +903,11 @@ std::unique_ptr<Expression> Parser::parseAdditive() {
     
     // Optimizado: usa función helper inline
     while (isAdditiveOp(peek().type)) [[likely]] {
-        std::string op(OperatorTable::get(advance().type));
+        const Lexer::Token opToken = advance();
+        std::string op(OperatorTable::get(opToken.type));
         skipNewLines();
         auto right = parseMultiplicative();
-        left = std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right));
+        left = located(std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right)), opToken.location);
     }
     
     return left;
@@ -755,10 +918,11 @@ std::unique_ptr<Expression> Parser::parseMultiplicative() {
     
     // Optimizado: usa función helper inline
     while (isMultiplicativeOp(peek().type)) [[unlikely]] {
-        std::string op(OperatorTable::get(advance().type));
+        const Lexer::Token opToken = advance();
+        std::string op(OperatorTable::get(opToken.type));
         skipNewLines();
         auto right = parseUnary();
-        left = std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right));
+        left = located(std::make_unique<BinaryExpression>(std::move(op), std::move(left), std::move(right)), opToken.location);
     }
     
     return left;
@@ -769,26 +933,27 @@ std::unique_ptr<Expression> Parser::parseUnary() {
     
     // Operadores unarios prefijo (optimizado con helper)
     if (isUnaryPrefixOp(t)) [[unlikely]] {
-        std::string op(OperatorTable::get(advance().type));
+        const Lexer::Token opToken = advance();
+        std::string op(OperatorTable::get(opToken.type));
         skipNewLines();
         auto operand = parseUnary();
-        return std::make_unique<UnaryExpression>(std::move(op), std::move(operand));
+        return located(std::make_unique<UnaryExpression>(std::move(op), std::move(operand)), opToken.location);
     }
     
     // Incremento prefijo
     if (t == TokenType::TOK_INCREMENT) [[unlikely]] {
-        advance();
+        SourceLocation location = advance().location;
         skipNewLines();
         auto operand = parseUnary();
-        return std::make_unique<IncrementExpression>(std::move(operand), true);
+        return located(std::make_unique<IncrementExpression>(std::move(operand), true), location);
     }
     
     // Decremento prefijo
     if (t == TokenType::TOK_DECREMENT) [[unlikely]] {
-        advance();
+        SourceLocation location = advance().location;
         skipNewLines();
         auto operand = parseUnary();
-        return std::make_unique<DecrementExpression>(std::move(operand), true);
+        return located(std::make_unique<DecrementExpression>(std::move(operand), true), location);
     }
     
     return parsePostfix();
@@ -804,12 +969,12 @@ std::unique_ptr<Expression> Parser::parsePostfix() {
         switch (t) {
             case TokenType::TOK_LEFT_BRACKET: {
                 // Acceso a array
-                advance();
+                Lexer::Token bracket = advance();
                 skipNewLines();
                 auto index = parseExpression();
                 skipNewLines();
                 consume(TokenType::TOK_RIGHT_BRACKET, "Se esperaba ']'");
-                expr = std::make_unique<ArrayAccessExpression>(std::move(expr), std::move(index));
+                expr = located(std::make_unique<ArrayAccessExpression>(std::move(expr), std::move(index)), bracket.location);
                 continue;
             }
             
@@ -818,6 +983,7 @@ std::unique_ptr<Expression> Parser::parsePostfix() {
                 auto* id = dynamic_cast<Identifier*>(expr.get());
                 if (id) [[likely]] {
                     std::string funcName = id->name;
+                    SourceLocation location = id->location;
                     advance();
                     skipNewLines();
                     
@@ -834,23 +1000,21 @@ std::unique_ptr<Expression> Parser::parsePostfix() {
                     
                     consume(TokenType::TOK_RIGHT_PAREN, "Se esperaba ')'");
                     
-                    expr = std::make_unique<FunctionCall>(
-                        std::make_unique<Identifier>(std::move(funcName)),
+                    expr = located(std::make_unique<FunctionCall>(
+                        located(std::make_unique<Identifier>(std::move(funcName)), location),
                         std::move(args)
-                    );
+                    ), location);
                     continue;
                 }
                 break;
             }
             
             case TokenType::TOK_INCREMENT:
-                advance();
-                expr = std::make_unique<IncrementExpression>(std::move(expr), false);
+                expr = located(std::make_unique<IncrementExpression>(std::move(expr), false), advance().location);
                 continue;
                 
             case TokenType::TOK_DECREMENT:
-                advance();
-                expr = std::make_unique<DecrementExpression>(std::move(expr), false);
+                expr = located(std::make_unique<DecrementExpression>(std::move(expr), false), advance().location);
                 continue;
                 
             default:
@@ -864,44 +1028,45 @@ std::unique_ptr<Expression> Parser::parsePostfix() {
 
 std::unique_ptr<Expression> Parser::parsePrimary() {
     const TokenType t = peek().type;
+    const SourceLocation location = peek().location;
     
     // Optimizado: switch para dispatch directo O(1)
     switch (t) {
         // Literales numéricos (más frecuente)
         case TokenType::TOK_NUMBER: {
-            const std::string& lexeme = peek().lexeme;
-            double val = std::stod(lexeme);
+            auto literal = makeNumericLiteral(peek().lexeme);
+            if (!literal) {
+                error("Literal entero fuera del rango de long", location);
+                literal = std::make_unique<NumericLiteral>(int64_t{0}, BuiltinType::Long);
+            }
             advance();
-            // Detectar si es float por presencia de '.'
-            BuiltinType type = (lexeme.find('.') != std::string::npos) 
-                              ? BuiltinType::Float : BuiltinType::Int;
-            return std::make_unique<NumericLiteral>(val, type);
+            return located(std::move(literal), location);
         }
         
         // String literal
         case TokenType::TOK_STRING_LITERAL:
-            return std::make_unique<StringLiteral>(advance().lexeme);
+            return located(std::make_unique<StringLiteral>(advance().lexeme), location);
         
         // Boolean true
         case TokenType::TOK_TRUE:
             advance();
-            return std::make_unique<BooleanLiteral>(true);
+            return located(std::make_unique<BooleanLiteral>(true), location);
         
         // Boolean false
         case TokenType::TOK_FALSE:
             advance();
-            return std::make_unique<BooleanLiteral>(false);
+            return located(std::make_unique<BooleanLiteral>(false), location);
         
         // Char literal
         case TokenType::TOK_CHAR_LITERAL: {
             std::string val = advance().lexeme;
             char c = val.empty() ? '\0' : val[0];
-            return std::make_unique<CharLiteral>(c);
+            return located(std::make_unique<CharLiteral>(c), location);
         }
         
         // Identifier (muy frecuente)
         case TokenType::TOK_IDENTIFIER:
-            return std::make_unique<Identifier>(advance().lexeme);
+            return located(std::make_unique<Identifier>(advance().lexeme), location);
         
         // Expresión parentizada
         case TokenType::TOK_LEFT_PAREN: {
@@ -918,9 +1083,9 @@ std::unique_ptr<Expression> Parser::parsePrimary() {
     }
     
     // Error recovery
-    error("Se esperaba expresión", peek().line, peek().column);
+    error("Se esperaba expresión", location);
     advance();
-    return std::make_unique<NumericLiteral>(0.0, BuiltinType::Int);
+    return located(std::make_unique<NumericLiteral>(int64_t{0}, BuiltinType::Int), location);
 }
 
 //==============================================================================
@@ -946,30 +1111,31 @@ std::unique_ptr<Expression> Parser::parseFunctionCall() {
     
     consume(TokenType::TOK_RIGHT_PAREN, "Se esperaba ')'");
     
-    return std::make_unique<FunctionCall>(
-        std::make_unique<Identifier>(nameToken.lexeme),
+    return located(std::make_unique<FunctionCall>(
+        located(std::make_unique<Identifier>(nameToken.lexeme), nameToken.location),
         std::move(args)
-    );
+    ), nameToken.location);
 }
 
 std::unique_ptr<Identifier> Parser::parseIdentifier() {
     Lexer::Token tk = consume(TokenType::TOK_IDENTIFIER, "Se esperaba identificador");
-    return std::make_unique<Identifier>(tk.lexeme);
+    return located(std::make_unique<Identifier>(tk.lexeme), tk.location);
 }
 
 std::unique_ptr<Literal> Parser::parseLiteral() {
     if (check(TokenType::TOK_NUMBER)) [[likely]] {
-        const std::string& lexeme = peek().lexeme;
-        double val = std::stod(lexeme);
+        const SourceLocation location = peek().location;
+        auto literal = makeNumericLiteral(peek().lexeme);
+        if (!literal) {
+            error("Literal entero fuera del rango de long", location);
+            literal = std::make_unique<NumericLiteral>(int64_t{0}, BuiltinType::Long);
+        }
         advance();
-        // Detectar tipo por presencia de punto decimal
-        BuiltinType type = (lexeme.find('.') != std::string::npos) 
-                          ? BuiltinType::Float : BuiltinType::Int;
-        return std::make_unique<NumericLiteral>(val, type);
+        return located(std::move(literal), location);
     }
     
-    error("Se esperaba literal numérico", peek().line, peek().column);
-    return std::make_unique<NumericLiteral>(0.0, BuiltinType::Int);
+    error("Se esperaba literal numérico", peek().location);
+    return located(std::make_unique<NumericLiteral>(int64_t{0}, BuiltinType::Int), peek().location);
 }
 
 } // namespace umbra
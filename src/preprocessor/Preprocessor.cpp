@@ -1,13 +1,33 @@
 #include "umbra/preprocessor/Preprocessor.h"
-#include <fstream>
-#include <sstream>
+#include "umbra/io/SourceCache.h"
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
+#include <thread>
 #include <iostream> // Para depuración
-#include "umbra/io/UmbraIO.h"
 
 namespace umbra {
 
-Preprocessor::Preprocessor(const std::string& mainFilePath) {
+namespace {
+
+bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+} // namespace
+
+Preprocessor::Preprocessor(const std::string& mainFilePath)
+    : internalSources(std::make_unique<SourceManager>()),
+      sources(*internalSources),
+      warnings(std::cerr) {
+    run(mainFilePath);
+}
+
+Preprocessor::Preprocessor(const std::string& mainFilePath, SourceManager& sources, bool useModules,
+                           std::ostream& warnings)
+    : sources(sources), useModules(useModules), warnings(warnings) {
+    run(mainFilePath);
+}
+
+void Preprocessor::run(const std::string& mainFilePath) {
     std::filesystem::path main_file_path_obj(mainFilePath);
     std::filesystem::path canonical_main_path;
 
@@ -15,48 +35,95 @@ Preprocessor::Preprocessor(const std::string& mainFilePath) {
         throw std::runtime_error("La ruta del archivo principal no puede estar vacía.");
     }
 
-    try {
-
-        if (main_file_path_obj.is_absolute()) {
-            canonical_main_path = std::filesystem::weakly_canonical(main_file_path_obj);
-        } else {
-            canonical_main_path = std::filesystem::weakly_canonical(std::filesystem::current_path() / main_file_path_obj);
-        }
-    } catch (const std::filesystem::filesystem_error& e) {
-        throw std::runtime_error("Error al procesar la ruta del archivo principal '" + mainFilePath + "': " + e.what());
+    // Para /dev/stdin (un pipe) SourceCache devuelve la ruta absoluta sin resolver el enlace
+    canonical_main_path = SourceCache::global().canonicalPath(main_file_path_obj);
+    if (canonical_main_path.empty()) {
+        canonical_main_path = std::filesystem::absolute(main_file_path_obj).lexically_normal();
     }
 
-    if (!std::filesystem::is_regular_file(canonical_main_path)) {
+    std::error_code ec;
+    if (!std::filesystem::exists(canonical_main_path, ec) || std::filesystem::is_directory(canonical_main_path, ec)) {
         throw std::runtime_error("El archivo principal no existe o no es un archivo regular: " + canonical_main_path.string());
     }
 
-    this->processedContent = processFile(canonical_main_path, 0);
+    includedFilesCanonicalPaths.insert(canonical_main_path.string());
+    processFile(loadFile(canonical_main_path), canonical_main_path, 0);
 }
 
-std::string Preprocessor::getProcessedContent() const {
-    return processedContent;
+void Preprocessor::includeFile(const std::filesystem::path& canonicalPath, int level) {
+    if (!includedFilesCanonicalPaths.insert(canonicalPath.string()).second) {
+        return;
+    }
+    if (importModule(canonicalPath, level)) {
+        return;
+    }
+    processFile(loadFile(canonicalPath), canonicalPath, level);
 }
 
-std::optional<std::string> Preprocessor::parseUseDirective(const std::string& line) {
-    std::stringstream ss(line);
-    std::string keyword;
-    ss >> keyword; // Lee la primera palabra
+bool Preprocessor::importModule(const std::filesystem::path& canonicalPath, int level) {
+    if (!useModules) return false;
 
-    if (keyword == "use") {
-        std::string filePathWithQuotes;
-        size_t start_pos = line.find_first_not_of(" \t", keyword.length());
-        if (start_pos == std::string::npos) return std::nullopt;
+    std::filesystem::path interfacePath = ModuleInterface::interfacePathFor(canonicalPath);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(interfacePath, ec)) return false;
 
-        filePathWithQuotes = line.substr(start_pos);
+    std::string error;
+    std::optional<ModuleInterface> module = ModuleInterface::read(interfacePath, error);
+    if (!module) {
+        warnings << "Warning: ignoring module interface: " << error << std::endl;
+        return false;
+    }
+    if (module->sources.front().path != canonicalPath.string() || !module->isUpToDate()) {
+        return false;
+    }
 
-        if (filePathWithQuotes.length() >= 2 && filePathWithQuotes.front() == '"' && filePathWithQuotes.back() == '"') {
-            return filePathWithQuotes.substr(1, filePathWithQuotes.length() - 2);
-        } else if (!filePathWithQuotes.empty() && filePathWithQuotes.find(' ') == std::string::npos) {
-            return filePathWithQuotes;
+    // Si algún archivo del módulo ya entró como texto, sus funciones estarían definidas dos veces
+    for (const ModuleInterface::Source& source : module->sources) {
+        if (source.path != canonicalPath.string() && includedFilesCanonicalPaths.count(source.path)) {
+            return false;
         }
-        std::cerr << "Warning: Malformed 'use' directive or unquoted path with spaces: " << line << std::endl;
-        return std::nullopt;
     }
+    for (const ModuleInterface::Source& source : module->sources) {
+        includedFilesCanonicalPaths.insert(source.path);
+    }
+
+    std::vector<std::string> imports = module->imports;
+    modules.push_back(std::move(*module));
+    for (const std::string& import : imports) {
+        includeFile(import, level + 1);
+    }
+    return true;
+}
+
+std::string Preprocessor::getProcessedContent() const {
+    return sourceMap.flatten();
+}
+
+const SourceBuffer& Preprocessor::loadFile(const std::filesystem::path& canonicalPath) {
+    std::string error;
+    const SourceBuffer* buffer = sources.load(canonicalPath, &error);
+    if (!buffer) {
+        throw std::runtime_error("No se pudo abrir o leer el archivo para inclusión: " + canonicalPath.string() + " (" + error + ")");
+    }
+    return *buffer;
+}
+
+std::optional<std::string> Preprocessor::parseUseDirective(std::string_view line) {
+    // El llamador ya comprobó que la línea empieza (tras espacios) por "use" y un blanco
+    size_t keyword_pos = line.find("use");
+    size_t start_pos = line.find_first_not_of(" \t", keyword_pos + 3);
+    if (start_pos == std::string_view::npos) return std::nullopt;
+
+    std::string_view filePathWithQuotes = line.substr(start_pos);
+    size_t last = filePathWithQuotes.find_last_not_of(" \t\r");
+    filePathWithQuotes = filePathWithQuotes.substr(0, last + 1);
+
+    if (filePathWithQuotes.length() >= 2 && filePathWithQuotes.front() == '"' && filePathWithQuotes.back() == '"') {
+        return std::string(filePathWithQuotes.substr(1, filePathWithQuotes.length() - 2));
+    } else if (!filePathWithQuotes.empty() && filePathWithQuotes.find(' ') == std::string_view::npos) {
+        return std::string(filePathWithQuotes);
+    }
+    warnings << "Warning: Malformed 'use' directive or unquoted path with spaces: " << line << std::endl;
     return std::nullopt;
 }
 
@@ -76,51 +143,90 @@ std::filesystem::path Preprocessor::resolveIncludePath(
         resolved_path = current_file_directory / include_directive_path_obj;
     }
 
-    try {
+    // SourceCache: una llamada a stat si el archivo ya se vio en este proceso
+    std::filesystem::path canonical = SourceCache::global().canonicalPath(resolved_path);
+    return canonical.empty() ? resolved_path.lexically_normal() : canonical;
+}
+
+std::vector<Preprocessor::UseDirective> Preprocessor::scanUseDirectives(const SourceBuffer& currentFile) {
+    std::vector<UseDirective> directives;
+    std::string_view text = currentFile.text();
+
+    // Se buscan apariciones de "use" en vez de recorrer línea a línea: las líneas sin directiva
+    // no se tocan y quedan dentro de un único tramo
+    size_t pos = 0;
+    while ((pos = text.find("use", pos)) != std::string_view::npos) {
+        size_t lineStart = pos;
+        while (lineStart > 0 && isBlank(text[lineStart - 1])) --lineStart;
+        if ((lineStart > 0 && text[lineStart - 1] != '\n') || pos + 3 >= text.size() || !isBlank(text[pos + 3])) {
+            pos += 3;
+            continue;
+        }
 
-        return std::filesystem::weakly_canonical(resolved_path);
-    } catch (const std::filesystem::filesystem_error& e) {
+        size_t lineEnd = text.find('\n', pos);
+        if (lineEnd == std::string_view::npos) lineEnd = text.size();
 
-        std::cerr << "Advertencia al canonicalizar la ruta '" << resolved_path.string() << "': " << e.what() << ". Usando ruta normalizada léxicamente." << std::endl;
-        return resolved_path.lexically_normal();
+        if (auto includePath = parseUseDirective(text.substr(lineStart, lineEnd - lineStart))) {
+            directives.push_back({lineStart, lineEnd, std::move(*includePath), {}});
+        }
+        pos = lineEnd;
     }
+    return directives;
 }
 
-std::string Preprocessor::processFile(const std::filesystem::path& currentFileCanonicalPath, int level) {
-    if (level > MAX_INCLUDE_DEPTH) {
-        throw std::runtime_error("Profundidad máxima de inclusión excedida, posible inclusión cíclica involucrando: " + currentFileCanonicalPath.string());
+void Preprocessor::prefetch(std::vector<UseDirective>& directives, const std::filesystem::path& currentFileCanonicalPath,
+                            bool parallel) {
+    auto resolve = [&](UseDirective& directive) {
+        directive.target = resolveIncludePath(currentFileCanonicalPath, directive.path);
+        if (includedFilesCanonicalPaths.count(directive.target.string())) return;
+        // Solo calienta SourceCache; si falla, includeFile informa el error en su turno
+        std::string error;
+        SourceCache::global().load(directive.target, error);
+    };
+
+    unsigned workers = parallel ? std::min<size_t>(directives.size(), std::max(1u, std::thread::hardware_concurrency())) : 1;
+    if (workers <= 1) {
+        for (UseDirective& directive : directives) resolve(directive);
+        return;
     }
 
-    const std::string canonicalPathStr = currentFileCanonicalPath.string();
-
-    if (includedFilesCanonicalPaths.count(canonicalPathStr)) {
-        return ""; // Ya incluido
+    // includedFilesCanonicalPaths solo se lee mientras trabajan los hilos
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < workers; ++i) {
+        threads.emplace_back([&] {
+            for (size_t index; (index = next.fetch_add(1)) < directives.size();) {
+                resolve(directives[index]);
+            }
+        });
     }
-    includedFilesCanonicalPaths.insert(canonicalPathStr);
+    for (std::thread& thread : threads) thread.join();
+}
 
-    // Sustituye ifstream por UmbraIO::readAll
-    std::string fileContent;
-    if (!UmbraIO::readAll(currentFileCanonicalPath, fileContent, nullptr)) {
-        throw std::runtime_error("No se pudo abrir o leer el archivo para inclusión: " + canonicalPathStr);
+void Preprocessor::processFile(const SourceBuffer& currentFile, const std::filesystem::path& currentFileCanonicalPath,
+                               int level) {
+    if (level > MAX_INCLUDE_DEPTH) {
+        throw std::runtime_error("Profundidad máxima de inclusión excedida, posible inclusión cíclica involucrando: " + currentFileCanonicalPath.string());
     }
 
-    std::stringstream content_buffer;
-    std::string line;
-
-    // Procesa por líneas desde el buffer leído
-    std::istringstream iss(fileContent);
-    while (std::getline(iss, line)) {
-        if (auto included_file_directive_path = parseUseDirective(line)) {
-            std::filesystem::path next_file_to_include_canonical_path =
-                resolveIncludePath(currentFileCanonicalPath, *included_file_directive_path);
-
-            content_buffer << processFile(next_file_to_include_canonical_path, level + 1);
-        } else {
-            content_buffer << line << '\n';
-        }
+    splicedFiles.push_back(&currentFile);
+
+    // Los archivos de todas las directivas se resuelven y leen antes de expandirlas en orden; así
+    // un archivo con muchos 'use' no espera cada lectura por separado. Solo el archivo principal
+    // lanza hilos; si no, cada archivo incluido con dos o más 'use' crearía su propio grupo
+    std::vector<UseDirective> directives = scanUseDirectives(currentFile);
+    prefetch(directives, currentFileCanonicalPath, level == 0);
+
+    size_t copied = 0; // Inicio del tramo pendiente de agregar al mapa
+    std::string_view text = currentFile.text();
+    for (const UseDirective& directive : directives) {
+        // La línea de la directiva no forma parte de ningún tramo
+        sourceMap.append(currentFile, copied, directive.lineStart);
+        copied = std::min(directive.lineEnd + 1, text.size());
+        includeFile(directive.target, level + 1);
     }
 
-    return content_buffer.str();
+    sourceMap.append(currentFile, copied, text.size());
 }
 
 } // namespace umbra
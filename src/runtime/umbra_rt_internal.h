@@ -0,0 +1,13 @@
+#ifndef UMBRA_RT_INTERNAL_H
+#define UMBRA_RT_INTERNAL_H
+
+/**
+ * @file umbra_rt_internal.h
+ * @brief Estado compartido entre los módulos del runtime (no forma parte de la interfaz C).
+ */
+
+/// Distinto de 0 mientras un repeat paralelo está repartiendo trabajo entre hilos.
+/// La salida con buffer solo toma su lock en ese caso.
+extern volatile int umbra_rt_parallel_active;
+
+#endif // UMBRA_RT_INTERNAL_H
@@ -0,0 +1,198 @@
+/**
+ * @file umbra_rt_parallel.c
+ * @brief Planificador de `repeat N times in parallel`: pool de hilos con robo de trabajo.
+ * @details
+ * Cada hilo del pool (el hilo que llama incluido) recibe una porción contigua del rango
+ * [0, n). El dueño consume su porción por el frente en bloques de `grain` iteraciones;
+ * cuando se queda sin trabajo roba la mitad final de la porción de otro hilo. Un repeat
+ * paralelo anidado dentro de un cuerpo paralelo se ejecuta secuencialmente.
+ *
+ * El número de hilos se toma de UMBRA_NUM_THREADS o, si no está definida, del número de
+ * CPUs en línea.
+ */
+
+#include "umbra/runtime/umbra_rt.h"
+#include "umbra_rt_internal.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/// Porción de iteraciones de un hilo. Alineada a línea de caché para evitar falso compartir.
+typedef struct {
+    pthread_mutex_t lock;
+    int64_t begin;
+    int64_t end;
+} __attribute__((aligned(64))) worker_range;
+
+typedef struct {
+    int threads;               ///< Hilos totales (incluye al que llama)
+    pthread_t* handles;
+    worker_range* ranges;
+
+    pthread_mutex_t lock;
+    pthread_cond_t start_cv;
+    pthread_cond_t done_cv;
+    uint64_t generation;       ///< Se incrementa con cada trabajo nuevo
+    int running;               ///< Hilos del pool que aún no terminaron el trabajo actual
+
+    umbra_rt_parallel_body body;
+    void* ctx;
+    int64_t grain;
+} thread_pool;
+
+static thread_pool pool;
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t submit_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread int inside_parallel = 0;
+
+volatile int umbra_rt_parallel_active = 0;
+
+/// Toma hasta `grain` iteraciones del frente de la porción propia.
+static int take_own(worker_range* own, int64_t grain, int64_t* begin, int64_t* end) {
+    pthread_mutex_lock(&own->lock);
+    int found = own->begin < own->end;
+    if (found) {
+        *begin = own->begin;
+        *end = own->end - own->begin > grain ? own->begin + grain : own->end;
+        own->begin = *end;
+    }
+    pthread_mutex_unlock(&own->lock);
+    return found;
+}
+
+/// Roba la mitad final de la porción de otro hilo y la pasa a la propia.
+static int steal(int self, int64_t grain) {
+    for (int k = 1; k < pool.threads; ++k) {
+        worker_range* victim = &pool.ranges[(self + k) % pool.threads];
+        pthread_mutex_lock(&victim->lock);
+        int64_t remaining = victim->end - victim->begin;
+        if (remaining > grain) {
+            int64_t mid = victim->begin + remaining / 2;
+            int64_t stolenEnd = victim->end;
+            victim->end = mid;
+            pthread_mutex_unlock(&victim->lock);
+
+            worker_range* own = &pool.ranges[self];
+            pthread_mutex_lock(&own->lock);
+            own->begin = mid;
+            own->end = stolenEnd;
+            pthread_mutex_unlock(&own->lock);
+            return 1;
+        }
+        pthread_mutex_unlock(&victim->lock);
+    }
+    return 0;
+}
+
+static void run_worker(int self) {
+    worker_range* own = &pool.ranges[self];
+    int64_t begin, end;
+    inside_parallel = 1;
+    for (;;) {
+        while (take_own(own, pool.grain, &begin, &end)) {
+            pool.body(pool.ctx, begin, end);
+        }
+        if (!steal(self, pool.grain)) break;
+    }
+    inside_parallel = 0;
+}
+
+static void* worker_main(void* arg) {
+    int self = (int)(intptr_t)arg;
+    uint64_t seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&pool.lock);
+        while (pool.generation == seen) pthread_cond_wait(&pool.start_cv, &pool.lock);
+        seen = pool.generation;
+        pthread_mutex_unlock(&pool.lock);
+
+        run_worker(self);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.running == 0) pthread_cond_signal(&pool.done_cv);
+        pthread_mutex_unlock(&pool.lock);
+    }
+    return NULL;
+}
+
+static int configured_threads(void) {
+    const char* env = getenv("UMBRA_NUM_THREADS");
+    if (env) {
+        int n = atoi(env);
+        if (n > 0) return n;
+    }
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+static void pool_init(void) {
+    pool.threads = configured_threads();
+    pool.ranges = (worker_range*)calloc((size_t)pool.threads, sizeof(worker_range));
+    pool.handles = (pthread_t*)calloc((size_t)pool.threads, sizeof(pthread_t));
+    if (!pool.ranges || !pool.handles) {
+        pool.threads = 1;
+        return;
+    }
+    for (int i = 0; i < pool.threads; ++i) pthread_mutex_init(&pool.ranges[i].lock, NULL);
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.start_cv, NULL);
+    pthread_cond_init(&pool.done_cv, NULL);
+
+    // Hilo 0 es siempre el que llama; el resto queda dormido esperando trabajo
+    for (int i = 1; i < pool.threads; ++i) {
+        if (pthread_create(&pool.handles[i], NULL, worker_main, (void*)(intptr_t)i) != 0) {
+            pool.threads = i;
+            break;
+        }
+        pthread_detach(pool.handles[i]);
+    }
+}
+
+void umbra_rt_parallel_for(int64_t n, umbra_rt_parallel_body body, void* ctx) {
+    if (n <= 0) return;
+
+    pthread_once(&pool_once, pool_init);
+    if (inside_parallel || pool.threads == 1 || n == 1) {
+        body(ctx, 0, n);
+        return;
+    }
+
+    // Un único trabajo a la vez: dos hilos de usuario no comparten el pool simultáneamente
+    pthread_mutex_lock(&submit_lock);
+
+    int threads = pool.threads;
+    // Bloques pequeños para equilibrar, pero no tanto como para que domine el reparto
+    int64_t grain = n / ((int64_t)threads * 16);
+    pool.grain = grain > 0 ? grain : 1;
+    pool.body = body;
+    pool.ctx = ctx;
+
+    int64_t share = n / threads;
+    int64_t extra = n % threads;
+    int64_t next = 0;
+    for (int i = 0; i < threads; ++i) {
+        int64_t size = share + (i < extra ? 1 : 0);
+        pool.ranges[i].begin = next;
+        pool.ranges[i].end = next + size;
+        next += size;
+    }
+
+    umbra_rt_parallel_active = 1;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.running = threads - 1;
+    ++pool.generation;
+    pthread_cond_broadcast(&pool.start_cv);
+    pthread_mutex_unlock(&pool.lock);
+
+    run_worker(0);
+
+    pthread_mutex_lock(&pool.lock);
+    while (pool.running > 0) pthread_cond_wait(&pool.done_cv, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+
+    umbra_rt_parallel_active = 0;
+
+    pthread_mutex_unlock(&submit_lock);
+}
@@ -0,0 +1,243 @@
+/**
+ * @file umbra_rt_print.c
+ * @brief Salida con buffer del runtime de Umbra.
+ * @details
+ * Sustituye a printf en el código generado: cada primitiva formatea su valor directamente
+ * en un buffer de 64 KiB y solo se llama a write(2) cuando el buffer se llena, al salir
+ * del programa o, si stdout es una terminal, al final de cada línea.
+ */
+
+#include "umbra/runtime/umbra_rt.h"
+#include "umbra_rt_internal.h"
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define UMBRA_RT_OUT_CAPACITY (64 * 1024)
+// "%f" más largo de un double: signo, 309 dígitos enteros, punto, 6 decimales y el nulo
+#define UMBRA_RT_F64_MAX_CHARS 330
+
+static char out_buffer[UMBRA_RT_OUT_CAPACITY];
+static size_t out_length = 0;
+static int out_initialized = 0;
+static int out_is_tty = 0;
+static pthread_mutex_t out_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/// Serializa el acceso al buffer solo mientras hay un repeat paralelo en curso.
+static inline int out_lock_begin(void) {
+    int locked = umbra_rt_parallel_active;
+    if (locked) pthread_mutex_lock(&out_lock);
+    return locked;
+}
+
+static inline void out_lock_end(int locked) {
+    if (locked) pthread_mutex_unlock(&out_lock);
+}
+
+static void write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+/// Vacía el buffer sin tomar el lock (lo llaman funciones que ya lo tienen).
+static void out_flush(void) {
+    if (out_length == 0) return;
+    write_all(STDOUT_FILENO, out_buffer, out_length);
+    out_length = 0;
+}
+
+void umbra_rt_flush(void) {
+    int locked = out_lock_begin();
+    out_flush();
+    out_lock_end(locked);
+}
+
+/// Inicialización perezosa: registra el vaciado al salir y detecta si stdout es una terminal.
+static void out_init(void) {
+    out_initialized = 1;
+    out_is_tty = isatty(STDOUT_FILENO);
+    atexit(umbra_rt_flush);
+}
+
+/// Garantiza al menos `needed` bytes libres (needed <= capacidad).
+static inline char* out_reserve(size_t needed) {
+    if (!out_initialized) out_init();
+    if (UMBRA_RT_OUT_CAPACITY - out_length < needed) out_flush();
+    return out_buffer + out_length;
+}
+
+static void umbra_print_str_unlocked(const char* s) {
+    if (!s) return;
+    size_t length = strlen(s);
+    if (length >= UMBRA_RT_OUT_CAPACITY) {
+        // Cadenas enormes: se escriben directamente sin pasar por el buffer
+        if (!out_initialized) out_init();
+        out_flush();
+        write_all(STDOUT_FILENO, s, length);
+        return;
+    }
+    memcpy(out_reserve(length), s, length);
+    out_length += length;
+}
+
+static void umbra_print_char_unlocked(char c) {
+    *out_reserve(1) = c;
+    out_length += 1;
+}
+
+static void umbra_print_newline_unlocked(void) {
+    *out_reserve(1) = '\n';
+    out_length += 1;
+    if (out_is_tty) out_flush();
+}
+
+/// Escribe los dígitos de value en dst y devuelve cuántos se escribieron.
+static inline size_t format_u64(char* dst, uint64_t value) {
+    char digits[20];
+    size_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    for (size_t i = 0; i < n; ++i) dst[i] = digits[n - 1 - i];
+    return n;
+}
+
+static void umbra_print_i64_unlocked(int64_t value) {
+    char* dst = out_reserve(20);
+    size_t n = 0;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0) {
+        dst[n++] = '-';
+        // 0 - x en aritmética sin signo: válido también para INT64_MIN
+        magnitude = 0 - magnitude;
+    }
+    n += format_u64(dst + n, magnitude);
+    out_length += n;
+}
+
+/**
+ * Escribe |v| con seis decimales redondeando el valor binario exacto al par más cercano,
+ * igual que printf("%f"). v = mantissa / 2^shift; mantissa * 10^6 cabe en 73 bits.
+ */
+static size_t format_fixed6(char* dst, double v) {
+#ifdef __SIZEOF_INT128__
+    int exponent;
+    double fraction = frexp(v, &exponent);
+    uint64_t mantissa = (uint64_t)ldexp(fraction, 53);
+    int shift = 53 - exponent;
+
+    uint64_t scaled;
+    if (shift <= 0) {
+        scaled = (mantissa << -shift) * 1000000u;
+    } else if (shift > 100) {
+        scaled = 0; // < 2^-47: por debajo de media millonésima
+    } else {
+        unsigned __int128 micros = (unsigned __int128)mantissa * 1000000u;
+        unsigned __int128 quotient = micros >> shift;
+        unsigned __int128 remainder = micros - (quotient << shift);
+        unsigned __int128 half = (unsigned __int128)1 << (shift - 1);
+        if (remainder > half || (remainder == half && (quotient & 1u))) ++quotient;
+        scaled = (uint64_t)quotient;
+    }
+
+    size_t n = format_u64(dst, scaled / 1000000);
+    dst[n++] = '.';
+    uint64_t micro = scaled % 1000000;
+    for (int i = 5; i >= 0; --i) {
+        dst[n + (size_t)i] = (char)('0' + micro % 10);
+        micro /= 10;
+    }
+    return n + 6;
+#else
+    int length = snprintf(dst, 32, "%f", v);
+    return length > 0 ? (size_t)length : 0;
+#endif
+}
+
+static void umbra_print_f64_unlocked(double v) {
+    // Fuera del rango del camino rápido (o NaN/inf) se usa el formateador de libc
+    if (!isfinite(v) || fabs(v) >= 1e12) {
+        // Se escribe directamente en el buffer: basta para "%f" de -DBL_MAX
+        char* dst = out_reserve(UMBRA_RT_F64_MAX_CHARS);
+        int length = snprintf(dst, UMBRA_RT_F64_MAX_CHARS, "%f", v);
+        if (length > 0) out_length += (size_t)length;
+        return;
+    }
+
+    char* dst = out_reserve(32);
+    size_t n = 0;
+    if (signbit(v)) {
+        dst[n++] = '-';
+        v = -v;
+    }
+    n += format_fixed6(dst + n, v);
+    out_length += n;
+}
+
+void umbra_rt_report_bounds(int64_t index, uint64_t size, int32_t line, int32_t column) {
+    umbra_rt_flush();
+    char message[256];
+    int length = snprintf(message, sizeof message,
+                          "Error en tiempo de ejecución: índice %lld fuera de rango para un array de tamaño %llu "
+                          "(línea %d, columna %d)\n",
+                          (long long)index, (unsigned long long)size, (int)line, (int)column);
+    if (length > 0) {
+        if ((size_t)length >= sizeof message) length = (int)sizeof message - 1;
+        write_all(STDERR_FILENO, message, (size_t)length);
+    }
+}
+
+void umbra_print_str(const char* s) {
+    int locked = out_lock_begin();
+    umbra_print_str_unlocked(s);
+    out_lock_end(locked);
+}
+
+void umbra_print_char(char c) {
+    int locked = out_lock_begin();
+    umbra_print_char_unlocked(c);
+    out_lock_end(locked);
+}
+
+void umbra_print_newline(void) {
+    int locked = out_lock_begin();
+    umbra_print_newline_unlocked();
+    out_lock_end(locked);
+}
+
+void umbra_print_i32(int32_t value) {
+    int locked = out_lock_begin();
+    umbra_print_i64_unlocked(value);
+    out_lock_end(locked);
+}
+
+void umbra_print_i64(int64_t value) {
+    int locked = out_lock_begin();
+    umbra_print_i64_unlocked(value);
+    out_lock_end(locked);
+}
+
+void umbra_print_f32(float value) {
+    int locked = out_lock_begin();
+    umbra_print_f64_unlocked((double)value);
+    out_lock_end(locked);
+}
+
+void umbra_print_f64(double value) {
+    int locked = out_lock_begin();
+    umbra_print_f64_unlocked(value);
+    out_lock_end(locked);
+}
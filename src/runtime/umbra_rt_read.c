@@ -0,0 +1,292 @@
+/**
+ * @file umbra_rt_read.c
+ * @brief Entrada con buffer del runtime de Umbra (read_int, read_float, read_line).
+ * @details
+ * stdin se lee con read(2) en bloques de 64 KiB, sin scanf. Los enteros se analizan a mano;
+ * los reales se copian a un buffer y los convierte strtod, que redondea correctamente (el
+ * programa no cambia de locale, así que el separador decimal es siempre '.'). Las líneas
+ * leídas se copian a un arena propio que vive hasta el final del programa (las cadenas de
+ * Umbra no se liberan). Un token que no es un número se descarta y la lectura devuelve 0, así
+ * un bucle de lectura siempre avanza.
+ */
+
+#include "umbra/runtime/umbra_rt.h"
+#include "umbra_rt_internal.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define UMBRA_RT_IN_CAPACITY (64 * 1024)
+#define UMBRA_RT_ARENA_CHUNK (1024 * 1024)
+
+static char in_buffer[UMBRA_RT_IN_CAPACITY];
+static size_t in_pos = 0;
+static size_t in_length = 0;
+static int in_eof = 0;
+static pthread_mutex_t in_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/// Igual que la salida: el buffer de entrada solo se protege durante un repeat paralelo.
+static inline int in_lock_begin(void) {
+    int locked = umbra_rt_parallel_active;
+    if (locked) pthread_mutex_lock(&in_lock);
+    return locked;
+}
+
+static inline void in_lock_end(int locked) {
+    if (locked) pthread_mutex_unlock(&in_lock);
+}
+
+/// Rellena el buffer de entrada. Devuelve 0 si se alcanzó el final de stdin.
+static int in_refill(void) {
+    if (in_eof) return 0;
+    // Lo escrito hasta ahora (p. ej. un prompt) debe verse antes de bloquear en read
+    umbra_rt_flush();
+    for (;;) {
+        ssize_t n = read(STDIN_FILENO, in_buffer, UMBRA_RT_IN_CAPACITY);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            in_eof = 1;
+            in_pos = in_length = 0;
+            return 0;
+        }
+        in_pos = 0;
+        in_length = (size_t)n;
+        return 1;
+    }
+}
+
+/// Siguiente byte sin consumirlo, o -1 al final de la entrada.
+static inline int in_peek(void) {
+    if (in_pos == in_length && !in_refill()) return -1;
+    return (unsigned char)in_buffer[in_pos];
+}
+
+static inline int is_space(int c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline int is_digit(int c) {
+    return c >= '0' && c <= '9';
+}
+
+static void skip_spaces(void) {
+    int c;
+    while ((c = in_peek()) != -1 && is_space(c)) ++in_pos;
+}
+
+/// Descarta el resto del token actual (hasta el siguiente espacio).
+static void skip_token(void) {
+    int c;
+    while ((c = in_peek()) != -1 && !is_space(c)) ++in_pos;
+}
+
+/// Consume un signo opcional; devuelve 1 si era '-'.
+static int read_sign(void) {
+    int c = in_peek();
+    if (c == '-' || c == '+') {
+        ++in_pos;
+        return c == '-';
+    }
+    return 0;
+}
+
+/// Lee un entero con signo saturado a [-limit - 1, limit].
+static int64_t read_integer(uint64_t limit) {
+    skip_spaces();
+    int negative = read_sign();
+    uint64_t value = 0;
+    int digits = 0;
+    int c;
+    while ((c = in_peek()) != -1 && is_digit(c)) {
+        // Se satura en lugar de desbordar con entradas demasiado largas
+        uint64_t digit = (uint64_t)(c - '0');
+        value = value > (UINT64_MAX - digit) / 10 ? UINT64_MAX : value * 10 + digit;
+        ++in_pos;
+        digits = 1;
+    }
+    if (!digits) {
+        // "abc" o un '-' suelto: sin descartarlo, la siguiente lectura volvería a tropezar aquí
+        skip_token();
+        return 0;
+    }
+    if (negative) {
+        return value > limit ? -(int64_t)limit - 1 : -(int64_t)value;
+    }
+    return value > limit ? (int64_t)limit : (int64_t)value;
+}
+
+int32_t umbra_read_i32(void) {
+    int locked = in_lock_begin();
+    int32_t value = (int32_t)read_integer((uint64_t)INT32_MAX);
+    in_lock_end(locked);
+    return value;
+}
+
+int64_t umbra_read_i64(void) {
+    int locked = in_lock_begin();
+    int64_t value = read_integer((uint64_t)INT64_MAX);
+    in_lock_end(locked);
+    return value;
+}
+
+static char number_local[64];
+static char* number_text = number_local;
+static size_t number_capacity = sizeof number_local;
+static size_t number_length = 0;
+
+/// Añade c al real que se está leyendo; false si no hay memoria para alargarlo.
+static int number_push(char c) {
+    if (number_length + 1 == number_capacity) {
+        size_t capacity = number_capacity * 2;
+        char* grown = (char*)malloc(capacity);
+        if (!grown) return 0;
+        memcpy(grown, number_text, number_length);
+        if (number_text != number_local) free(number_text);
+        number_text = grown;
+        number_capacity = capacity;
+    }
+    number_text[number_length++] = c;
+    return 1;
+}
+
+/// Consume dígitos y los añade al real que se está leyendo; devuelve cuántos añadió.
+static size_t number_push_digits(void) {
+    size_t count = 0;
+    int c;
+    while ((c = in_peek()) != -1 && is_digit(c) && number_push((char)c)) {
+        ++in_pos;
+        ++count;
+    }
+    return count;
+}
+
+static double read_f64_unlocked(void) {
+    skip_spaces();
+    number_length = 0;
+
+    // Se copia el token ([+-]dígitos[.dígitos][(e|E)[+-]dígitos]) tal cual: acumular la
+    // mantisa y escalar por 10^e redondearía dos veces (0.3 -> 0.30000000000000004)
+    int c = in_peek();
+    if (c == '-' || c == '+') {
+        number_push((char)c);
+        ++in_pos;
+    }
+    size_t digits = number_push_digits();
+    if (in_peek() == '.') {
+        number_push('.');
+        ++in_pos;
+        digits += number_push_digits();
+    }
+    if (digits == 0) {
+        skip_token();
+        return 0.0;
+    }
+    c = in_peek();
+    if (c == 'e' || c == 'E') {
+        number_push((char)c);
+        ++in_pos;
+        c = in_peek();
+        if (c == '-' || c == '+') {
+            number_push((char)c);
+            ++in_pos;
+        }
+        number_push_digits();
+    }
+    number_text[number_length] = '\0';
+
+    // strtod se queda con el prefijo válido ("1e" -> 1)
+    return strtod(number_text, NULL);
+}
+
+double umbra_read_f64(void) {
+    int locked = in_lock_begin();
+    double value = read_f64_unlocked();
+    in_lock_end(locked);
+    return value;
+}
+
+float umbra_read_f32(void) {
+    return (float)umbra_read_f64();
+}
+
+//==============================================================================
+// read_line
+//==============================================================================
+
+static char* arena_cursor = NULL;
+static size_t arena_left = 0;
+
+/// Reserva size bytes en el arena de cadenas.
+static char* arena_alloc(size_t size) {
+    if (size > arena_left) {
+        size_t chunk = size > UMBRA_RT_ARENA_CHUNK ? size : UMBRA_RT_ARENA_CHUNK;
+        char* block = (char*)malloc(chunk);
+        if (!block) return NULL;
+        arena_cursor = block;
+        arena_left = chunk;
+    }
+    char* result = arena_cursor;
+    arena_cursor += size;
+    arena_left -= size;
+    return result;
+}
+
+static const char* read_line_unlocked(void) {
+    // Línea acumulada fuera del arena mientras cruza bloques de entrada
+    char* pending = NULL;
+    size_t pendingLength = 0;
+
+    for (;;) {
+        if (in_peek() == -1) break;
+
+        const char* start = in_buffer + in_pos;
+        size_t available = in_length - in_pos;
+        const char* newline = (const char*)memchr(start, '\n', available);
+        size_t chunk = newline ? (size_t)(newline - start) : available;
+
+        if (!pending && newline) {
+            // Caso común: la línea completa está en el buffer
+            size_t length = chunk;
+            if (length > 0 && start[length - 1] == '\r') --length;
+            char* line = arena_alloc(length + 1);
+            if (!line) return "";
+            memcpy(line, start, length);
+            line[length] = '\0';
+            in_pos += chunk + 1;
+            return line;
+        }
+
+        char* grown = (char*)realloc(pending, pendingLength + chunk + 1);
+        if (!grown) break;
+        pending = grown;
+        memcpy(pending + pendingLength, start, chunk);
+        pendingLength += chunk;
+        in_pos += chunk;
+
+        if (newline) {
+            ++in_pos;
+            break;
+        }
+    }
+
+    if (pendingLength > 0 && pending[pendingLength - 1] == '\r') --pendingLength;
+    char* line = arena_alloc(pendingLength + 1);
+    if (!line) {
+        free(pending);
+        return "";
+    }
+    if (pendingLength) memcpy(line, pending, pendingLength);
+    line[pendingLength] = '\0';
+    free(pending);
+    return line;
+}
+
+const char* umbra_read_line(void) {
+    int locked = in_lock_begin();
+    const char* line = read_line_unlocked();
+    in_lock_end(locked);
+    return line;
+}
@@ -0,0 +1,477 @@
+#include "umbra/semantic/ConstEvaluator.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace umbra {
+
+namespace {
+
+    bool isIntegerBuiltin(BuiltinType t){
+        return t == BuiltinType::Int || t == BuiltinType::Long;
+    }
+
+    bool isFloatingBuiltin(BuiltinType t){
+        return t == BuiltinType::Float || t == BuiltinType::Double;
+    }
+
+    ConstValue floatingValue(BuiltinType type, double value){
+        return ConstValue{type, 0, value};
+    }
+
+    bool isScalarBuiltin(BuiltinType t){
+        return isIntegerBuiltin(t) || isFloatingBuiltin(t) || t == BuiltinType::Bool;
+    }
+
+    /// Tipo común de dos operandos numéricos; None si no hay promoción implícita.
+    BuiltinType commonType(BuiltinType a, BuiltinType b){
+        if(a == b) return a;
+        if(isIntegerBuiltin(a) && isIntegerBuiltin(b)) return BuiltinType::Long;
+        if(isFloatingBuiltin(a) && isFloatingBuiltin(b)) return BuiltinType::Double;
+        return BuiltinType::None;
+    }
+
+    bool isComparison(const std::string& op){
+        return op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=";
+    }
+
+    template<typename T>
+    bool compare(const std::string& op, T a, T b){
+        if(op == "==") return a == b;
+        if(op == "!=") return a != b;
+        if(op == "<") return a < b;
+        if(op == ">") return a > b;
+        if(op == "<=") return a <= b;
+        return a >= b;
+    }
+
+    /// Aritmética entera con la semántica del código generado (complemento a dos, sdiv/srem).
+    template<typename Signed, typename Unsigned>
+    std::optional<Signed> integerArith(const std::string& op, Signed a, Signed b){
+        if(op == "+") return static_cast<Signed>(static_cast<Unsigned>(a) + static_cast<Unsigned>(b));
+        if(op == "-") return static_cast<Signed>(static_cast<Unsigned>(a) - static_cast<Unsigned>(b));
+        if(op == "*") return static_cast<Signed>(static_cast<Unsigned>(a) * static_cast<Unsigned>(b));
+        if(op == "/" || op == "%"){
+            // División por cero y MIN / -1 son comportamiento indefinido: se dejan sin plegar
+            if(b == 0) return std::nullopt;
+            if(a == std::numeric_limits<Signed>::min() && b == -1) return std::nullopt;
+            return op == "/" ? a / b : a % b;
+        }
+        return std::nullopt;
+    }
+
+    template<typename T>
+    std::optional<T> floatingArith(const std::string& op, T a, T b){
+        if(op == "+") return a + b;
+        if(op == "-") return a - b;
+        if(op == "*") return a * b;
+        if(op == "/") return a / b;
+        if(op == "%") return static_cast<T>(std::fmod(a, b));
+        return std::nullopt;
+    }
+
+}
+
+std::optional<ConstValue> evalConstBinary(const std::string& op, ConstValue lhs, ConstValue rhs){
+    if(op == "and" || op == "or"){
+        if(lhs.type != BuiltinType::Bool || rhs.type != BuiltinType::Bool) return std::nullopt;
+        bool a = lhs.integer != 0, b = rhs.integer != 0;
+        return ConstValue{BuiltinType::Bool, op == "and" ? (a && b) : (a || b)};
+    }
+
+    BuiltinType type = commonType(lhs.type, rhs.type);
+    if(type == BuiltinType::None) return std::nullopt;
+
+    if(isComparison(op)){
+        bool value;
+        switch(type){
+            case BuiltinType::Int:
+            case BuiltinType::Long:
+                value = compare(op, lhs.integer, rhs.integer);
+                break;
+            case BuiltinType::Float:
+                value = compare(op, static_cast<float>(lhs.floating), static_cast<float>(rhs.floating));
+                break;
+            case BuiltinType::Double:
+                value = compare(op, lhs.floating, rhs.floating);
+                break;
+            case BuiltinType::Bool:
+                if(op != "==" && op != "!=") return std::nullopt;
+                value = compare(op, lhs.integer != 0, rhs.integer != 0);
+                break;
+            default:
+                return std::nullopt;
+        }
+        return ConstValue{BuiltinType::Bool, value};
+    }
+
+    switch(type){
+        case BuiltinType::Int: {
+            auto value = integerArith<int32_t, uint32_t>(op, static_cast<int32_t>(lhs.integer), static_cast<int32_t>(rhs.integer));
+            if(!value) return std::nullopt;
+            return ConstValue{type, *value};
+        }
+        case BuiltinType::Long: {
+            auto value = integerArith<int64_t, uint64_t>(op, lhs.integer, rhs.integer);
+            if(!value) return std::nullopt;
+            return ConstValue{type, *value};
+        }
+        case BuiltinType::Float: {
+            auto value = floatingArith<float>(op, static_cast<float>(lhs.floating), static_cast<float>(rhs.floating));
+            if(!value) return std::nullopt;
+            return floatingValue(type, *value);
+        }
+        case BuiltinType::Double: {
+            auto value = floatingArith<double>(op, lhs.floating, rhs.floating);
+            if(!value) return std::nullopt;
+            return floatingValue(type, *value);
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<ConstValue> evalConstUnary(const std::string& op, ConstValue operand){
+    if(op == "not"){
+        if(operand.type != BuiltinType::Bool && !isIntegerBuiltin(operand.type)) return std::nullopt;
+        return ConstValue{BuiltinType::Bool, operand.integer == 0};
+    }
+    if(op != "-") return std::nullopt;
+
+    switch(operand.type){
+        case BuiltinType::Int:
+            return ConstValue{operand.type, static_cast<int32_t>(0u - static_cast<uint32_t>(static_cast<int32_t>(operand.integer)))};
+        case BuiltinType::Long:
+            return ConstValue{operand.type, static_cast<int64_t>(0u - static_cast<uint64_t>(operand.integer))};
+        case BuiltinType::Float:
+            return floatingValue(operand.type, -static_cast<float>(operand.floating));
+        case BuiltinType::Double:
+            return floatingValue(operand.type, -operand.floating);
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<ConstValue> convertConstValue(ConstValue value, BuiltinType to){
+    if(value.type == to) return value;
+    if(to == BuiltinType::Long && value.type == BuiltinType::Int) return ConstValue{to, value.integer};
+    if(to == BuiltinType::Double && value.type == BuiltinType::Float) return floatingValue(to, value.floating);
+    if(isFloatingBuiltin(to) && isIntegerBuiltin(value.type)){
+        return floatingValue(to, to == BuiltinType::Float ? static_cast<double>(static_cast<float>(value.integer))
+                                                          : static_cast<double>(value.integer));
+    }
+    return std::nullopt;
+}
+
+std::optional<ConstValue> literalConstValue(Expression* expr){
+    if(!expr) return std::nullopt;
+    if(expr->kind == NodeKind::NUMERIC_LITERAL){
+        auto* literal = static_cast<NumericLiteral*>(expr);
+        if(literal->isFloating()) return floatingValue(literal->builtinType, literal->floatValue);
+        return ConstValue{literal->builtinType, literal->intValue};
+    }
+    if(expr->kind == NodeKind::BOOLEAN_LITERAL){
+        return ConstValue{BuiltinType::Bool, static_cast<BooleanLiteral*>(expr)->value};
+    }
+    return std::nullopt;
+}
+
+//==============================================================================
+// Intérprete
+//==============================================================================
+
+std::optional<ConstValue> ConstEvaluator::call(FunctionDefinition* function, const std::vector<ConstValue>& args){
+    frames.clear();
+    steps = 0;
+    liveElements = 0;
+    limitHit.clear();
+    returning = false;
+    return invoke(function, args);
+}
+
+std::optional<ConstValue> ConstEvaluator::invoke(FunctionDefinition* function, const std::vector<ConstValue>& args){
+    if(frames.size() >= MAX_CALL_DEPTH){
+        limitHit = "call depth limit (" + std::to_string(MAX_CALL_DEPTH) + ") exceeded";
+        return std::nullopt;
+    }
+
+    auto& params = function->parameters->parameters;
+    if(params.size() != args.size()) return std::nullopt;
+
+    Frame frame;
+    for(std::size_t i = 0; i < params.size(); ++i){
+        auto value = convertConstValue(args[i], params[i].first->builtinType);
+        if(!value) return std::nullopt;
+        frame.scalars[params[i].second->name] = *value;
+    }
+    frames.push_back(std::move(frame));
+
+    bool ok = execBody(function->body);
+    bool didReturn = returning;
+    returning = false;
+
+    for(auto& [name, array] : frames.back().arrays){
+        liveElements -= array.elements.size();
+    }
+    frames.pop_back();
+
+    if(!ok) return std::nullopt;
+    // Caer al final del cuerpo devuelve 0, igual que el retorno por defecto de codegen
+    ConstValue returned = didReturn ? result : ConstValue{BuiltinType::Int, 0};
+    return convertConstValue(returned, function->returnType->builtinType);
+}
+
+bool ConstEvaluator::execBody(std::vector<std::unique_ptr<Statement>>& body){
+    for(auto& stmt : body){
+        if(!step() || !visit(stmt.get())) return false;
+        if(returning) return true;
+    }
+    return true;
+}
+
+bool ConstEvaluator::step(){
+    if(++steps > MAX_STEPS){
+        limitHit = "step limit (" + std::to_string(MAX_STEPS) + ") exceeded";
+        return false;
+    }
+    return true;
+}
+
+bool ConstEvaluator::evalExpression(Expression* expr, ConstValue& out){
+    if(!expr || !step() || !visit(expr)) return false;
+    out = result;
+    return true;
+}
+
+ConstValue* ConstEvaluator::resolveSlot(Expression* target){
+    if(target->kind == NodeKind::IDENTIFIER){
+        auto& scalars = frames.back().scalars;
+        auto it = scalars.find(static_cast<Identifier*>(target)->name);
+        return it == scalars.end() ? nullptr : &it->second;
+    }
+    if(target->kind != NodeKind::ARRAY_ACCESS_EXPRESSION) return nullptr;
+
+    // a[i][j]: se recorre la cadena de accesos hasta el identificador del array
+    std::vector<Expression*> indices;
+    Expression* base = target;
+    while(base->kind == NodeKind::ARRAY_ACCESS_EXPRESSION){
+        auto* access = static_cast<ArrayAccessExpression*>(base);
+        indices.insert(indices.begin(), access->index.get());
+        base = access->array.get();
+    }
+    if(base->kind != NodeKind::IDENTIFIER) return nullptr;
+
+    std::vector<int64_t> position;
+    for(Expression* index : indices){
+        ConstValue value;
+        if(!evalExpression(index, value) || !isIntegerBuiltin(value.type)) return nullptr;
+        position.push_back(value.integer);
+    }
+
+    auto& arrays = frames.back().arrays;
+    auto it = arrays.find(static_cast<Identifier*>(base)->name);
+    if(it == arrays.end() || position.size() != it->second.dims.size()) return nullptr;
+
+    std::size_t flat = 0;
+    for(std::size_t d = 0; d < position.size(); ++d){
+        // Un acceso fuera de rango se deja para tiempo de ejecución (y --bounds-check)
+        if(position[d] < 0 || static_cast<std::size_t>(position[d]) >= it->second.dims[d]) return nullptr;
+        flat = flat * it->second.dims[d] + static_cast<std::size_t>(position[d]);
+    }
+    return &it->second.elements[flat];
+}
+
+bool ConstEvaluator::visitVariableDeclaration(VariableDeclaration* node){
+    Type* type = node->type.get();
+    if(type->isPointer || type->isReference || !isScalarBuiltin(type->builtinType)) return false;
+
+    Frame& frame = frames.back();
+    const std::string& name = node->name->name;
+
+    if(type->arrayDimensions > 0){
+        Array array{type->builtinType, {}, {}};
+        std::size_t total = 1;
+        for(auto& size : type->arraySizes){
+            auto value = literalConstValue(size.get());
+            if(!value || !isIntegerBuiltin(value->type) || value->integer <= 0) return false;
+            array.dims.push_back(static_cast<std::size_t>(value->integer));
+            total *= array.dims.back();
+            if(total > MAX_ARRAY_ELEMENTS) break;
+        }
+        if(liveElements + total > MAX_ARRAY_ELEMENTS){
+            limitHit = "memory limit (" + std::to_string(MAX_ARRAY_ELEMENTS) + " array elements) exceeded";
+            return false;
+        }
+        auto previous = frame.arrays.find(name);
+        if(previous != frame.arrays.end()) liveElements -= previous->second.elements.size();
+        array.elements.assign(total, ConstValue{type->builtinType, 0});
+        liveElements += total;
+        frames.back().arrays[name] = std::move(array);
+        return true;
+    }
+
+    ConstValue value{type->builtinType, 0};
+    if(node->initializer){
+        ConstValue init;
+        if(!evalExpression(node->initializer.get(), init)) return false;
+        auto converted = convertConstValue(init, type->builtinType);
+        if(!converted) return false;
+        value = *converted;
+    }
+    frames.back().scalars[name] = value;
+    return true;
+}
+
+bool ConstEvaluator::visitAssignmentStatement(AssignmentStatement* node){
+    // El valor primero: evaluarlo puede llamar a otra función y mover los marcos
+    ConstValue value;
+    if(!evalExpression(node->value.get(), value)) return false;
+
+    ConstValue* slot = resolveSlot(node->target.get());
+    if(!slot) return false;
+    auto converted = convertConstValue(value, slot->type);
+    if(!converted) return false;
+    *slot = *converted;
+    return true;
+}
+
+bool ConstEvaluator::visitIfStatement(IfStatement* node){
+    for(auto& branch : node->branches){
+        ConstValue condition;
+        if(!evalExpression(branch.condition.get(), condition)) return false;
+        if(condition.integer != 0) return execBody(branch.body);
+    }
+    return execBody(node->elseBranch);
+}
+
+bool ConstEvaluator::visitRepeatTimesStatement(RepeatTimesStatement* node){
+    ConstValue times;
+    if(!evalExpression(node->times.get(), times) || !isIntegerBuiltin(times.type)) return false;
+
+    // Un repeat paralelo se ejecuta en orden: las reducciones dan el mismo resultado
+    int64_t trips = times.integer;
+    for(int64_t i = 0; i < trips; ++i){
+        if(node->indexVar){
+            frames.back().scalars[node->indexVar->name] = ConstValue{times.type, i};
+        }
+        if(!step() || !execBody(node->body)) return false;
+        if(returning) return true;
+    }
+    return true;
+}
+
+bool ConstEvaluator::visitRepeatIfStatement(RepeatIfStatement* node){
+    for(;;){
+        ConstValue condition;
+        if(!evalExpression(node->condition.get(), condition)) return false;
+        if(condition.integer == 0) return true;
+        if(!execBody(node->body)) return false;
+        if(returning) return true;
+    }
+}
+
+bool ConstEvaluator::visitExpressionStatement(ExpressionStatement* node){
+    ConstValue ignored;
+    return evalExpression(node->exp.get(), ignored);
+}
+
+bool ConstEvaluator::visitReturnExpression(ReturnExpression* node){
+    if(node->returnValue){
+        ConstValue value;
+        if(!evalExpression(node->returnValue.get(), value)) return false;
+        result = value;
+    } else {
+        result = ConstValue{BuiltinType::Int, 0};
+    }
+    returning = true;
+    return true;
+}
+
+bool ConstEvaluator::visitIdentifier(Identifier* node){
+    auto& scalars = frames.back().scalars;
+    auto it = scalars.find(node->name);
+    if(it == scalars.end()) return false;
+    result = it->second;
+    return true;
+}
+
+bool ConstEvaluator::visitNumericLiteral(NumericLiteral* node){
+    result = *literalConstValue(node);
+    return true;
+}
+
+bool ConstEvaluator::visitBooleanLiteral(BooleanLiteral* node){
+    result = ConstValue{BuiltinType::Bool, node->value};
+    return true;
+}
+
+bool ConstEvaluator::visitBinaryExpression(BinaryExpression* node){
+    ConstValue lhs, rhs;
+    if(!evalExpression(node->left.get(), lhs) || !evalExpression(node->right.get(), rhs)) return false;
+    auto value = evalConstBinary(node->op, lhs, rhs);
+    if(!value) return false;
+    result = *value;
+    return true;
+}
+
+bool ConstEvaluator::visitUnaryExpression(UnaryExpression* node){
+    ConstValue operand;
+    if(!evalExpression(node->operand.get(), operand)) return false;
+    auto value = evalConstUnary(node->op, operand);
+    if(!value) return false;
+    result = *value;
+    return true;
+}
+
+bool ConstEvaluator::visitPrimaryExpression(PrimaryExpression* node){
+    if(node->exprType != PrimaryExpression::PARENTHESIZED) return false;
+    return evalExpression(node->parenthesized.get(), result);
+}
+
+bool ConstEvaluator::visitArrayAccessExpression(ArrayAccessExpression* node){
+    ConstValue* slot = resolveSlot(node);
+    if(!slot) return false;
+    result = *slot;
+    return true;
+}
+
+bool ConstEvaluator::applyStep(Expression* operand, bool isPrefix, const char* op){
+    ConstValue* slot = resolveSlot(operand);
+    if(!slot) return false;
+    ConstValue before = *slot;
+    auto after = evalConstBinary(op, before, convertConstValue(ConstValue{BuiltinType::Int, 1}, before.type)
+                                                 .value_or(ConstValue{BuiltinType::None, 0}));
+    if(!after) return false;
+    *slot = *after;
+    result = isPrefix ? *after : before;
+    return true;
+}
+
+bool ConstEvaluator::visitIncrementExpression(IncrementExpression* node){
+    return applyStep(node->operand.get(), node->isPrefix, "+");
+}
+
+bool ConstEvaluator::visitDecrementExpression(DecrementExpression* node){
+    return applyStep(node->operand.get(), node->isPrefix, "-");
+}
+
+bool ConstEvaluator::visitFunctionCall(FunctionCall* node){
+    auto it = functions.find(node->functionName->name);
+    if(it == functions.end()) return false;
+
+    std::vector<ConstValue> args;
+    args.reserve(node->arguments.size());
+    for(auto& arg : node->arguments){
+        ConstValue value;
+        if(!evalExpression(arg.get(), value)) return false;
+        args.push_back(value);
+    }
+
+    auto value = invoke(it->second, args);
+    if(!value) return false;
+    result = *value;
+    return true;
+}
+
+}
@@ -0,0 +1,239 @@
+#include "umbra/semantic/ConstantFolder.h"
+#include "umbra/error/CompilerError.h"
+
+#include <iostream>
+
+namespace umbra {
+
+void ConstantFolder::fold(ProgramNode* program){
+    if(!program) return;
+    constFunctions.clear();
+    for(auto& function : program->functions){
+        if(function->isConstFunc) constFunctions[function->name->name] = function.get();
+    }
+    for(auto& function : program->functions){
+        // Los parámetros nunca son constantes: cada función empieza con el entorno vacío
+        constants.clear();
+        foldStatements(function->body);
+    }
+    constants.clear();
+}
+
+void ConstantFolder::foldStatements(std::vector<std::unique_ptr<Statement>>& body){
+    for(auto& stmt : body){
+        foldStatement(stmt.get());
+    }
+}
+
+/**
+ * @brief Pliega un bloque anidado y descarta las constantes que declaró.
+ * @details El bloque puede no ejecutarse, así que lo declarado dentro no se propaga fuera;
+ *          restaurar el entorno también recupera constantes ocultadas en el scope del repeat paralelo.
+ */
+void ConstantFolder::foldBlock(std::vector<std::unique_ptr<Statement>>& body){
+    auto saved = constants;
+    foldStatements(body);
+    constants = std::move(saved);
+}
+
+void ConstantFolder::foldStatement(Statement* stmt){
+    if(!stmt) return;
+
+    switch(stmt->kind){
+        case NodeKind::VARIABLE_DECLARATION:
+            foldVariableDeclaration(static_cast<VariableDeclaration*>(stmt));
+            break;
+        case NodeKind::ASSIGNMENT_STATEMENT: {
+            auto* node = static_cast<AssignmentStatement*>(stmt);
+            foldLValue(node->target);
+            foldExpression(node->value);
+            break;
+        }
+        case NodeKind::EXPRESSION_STATEMENT:
+            foldExpression(static_cast<ExpressionStatement*>(stmt)->exp);
+            break;
+        case NodeKind::RETURN_EXPRESSION:
+            foldExpression(static_cast<ReturnExpression*>(stmt)->returnValue);
+            break;
+        case NodeKind::IF_STATEMENT: {
+            auto* node = static_cast<IfStatement*>(stmt);
+            for(auto& branch : node->branches){
+                foldExpression(branch.condition);
+                foldBlock(branch.body);
+            }
+            foldBlock(node->elseBranch);
+            break;
+        }
+        case NodeKind::REPEAT_TIMES_STATEMENT: {
+            auto* node = static_cast<RepeatTimesStatement*>(stmt);
+            foldExpression(node->times);
+            auto saved = constants;
+            if(node->indexVar) constants.erase(node->indexVar->name);
+            foldStatements(node->body);
+            constants = std::move(saved);
+            break;
+        }
+        case NodeKind::REPEAT_IF_STATEMENT: {
+            auto* node = static_cast<RepeatIfStatement*>(stmt);
+            foldExpression(node->condition);
+            foldBlock(node->body);
+            break;
+        }
+        case NodeKind::MEMORY_MANAGEMENT:
+            foldExpression(static_cast<MemoryManagement*>(stmt)->size);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Pliega tamaños de array e inicializador, y registra la variable si es `const`.
+ * @details Un tamaño de array que no se reduce a un literal entero positivo es un error:
+ *          codegen reserva los arrays locales con tamaño fijo.
+ */
+void ConstantFolder::foldVariableDeclaration(VariableDeclaration* node){
+    const std::string& name = node->name->name;
+    Type* type = node->type.get();
+
+    for(auto& size : type->arraySizes){
+        foldExpression(size);
+        if(type->isPointer || type->isReference) continue;
+
+        auto value = literalConstValue(size.get());
+        if(!value || (value->type != BuiltinType::Int && value->type != BuiltinType::Long) || value->integer <= 0){
+            std::string msg = "Array size of '" + name + "' must be a positive constant integer expression";
+            errorManager.addError(std::make_unique<SemanticError>(msg, size->location.isValid() ? size->location : node->location, SemanticError::Action::ERROR));
+        }
+    }
+
+    foldExpression(node->initializer);
+
+    constants.erase(name);
+    if(!node->isConst || !node->initializer || type->arrayDimensions > 0) return;
+    if(type->isPointer || type->isReference) return;
+
+    if(auto value = literalConstValue(node->initializer.get())){
+        if(auto converted = convertConstValue(*value, type->builtinType)){
+            constants[name] = *converted;
+        }
+    }
+}
+
+void ConstantFolder::foldExpression(std::unique_ptr<Expression>& expr){
+    if(!expr) return;
+
+    std::optional<ConstValue> result;
+
+    switch(expr->kind){
+        case NodeKind::IDENTIFIER: {
+            auto it = constants.find(static_cast<Identifier*>(expr.get())->name);
+            if(it != constants.end()) result = it->second;
+            break;
+        }
+        case NodeKind::PRIMARY_EXPRESSION: {
+            auto* node = static_cast<PrimaryExpression*>(expr.get());
+            if(node->exprType == PrimaryExpression::PARENTHESIZED){
+                foldExpression(node->parenthesized);
+                result = literalConstValue(node->parenthesized.get());
+            }
+            break;
+        }
+        case NodeKind::BINARY_EXPRESSION: {
+            auto* node = static_cast<BinaryExpression*>(expr.get());
+            foldExpression(node->left);
+            foldExpression(node->right);
+            auto lhs = literalConstValue(node->left.get());
+            auto rhs = literalConstValue(node->right.get());
+            if(lhs && rhs) result = evalConstBinary(node->op, *lhs, *rhs);
+            break;
+        }
+        case NodeKind::UNARY_EXPRESSION: {
+            auto* node = static_cast<UnaryExpression*>(expr.get());
+            if(node->op == "-" || node->op == "not"){
+                foldExpression(node->operand);
+                if(auto operand = literalConstValue(node->operand.get())){
+                    result = evalConstUnary(node->op, *operand);
+                }
+            } else if(node->op == "ref"){
+                foldLValue(node->operand);
+            } else {
+                foldExpression(node->operand);
+            }
+            break;
+        }
+        case NodeKind::INCREMENT_EXPRESSION:
+            foldLValue(static_cast<IncrementExpression*>(expr.get())->operand);
+            break;
+        case NodeKind::DECREMENT_EXPRESSION:
+            foldLValue(static_cast<DecrementExpression*>(expr.get())->operand);
+            break;
+        case NodeKind::ARRAY_ACCESS_EXPRESSION:
+            foldLValue(expr);
+            break;
+        case NodeKind::FUNCTION_CALL: {
+            auto* node = static_cast<FunctionCall*>(expr.get());
+            for(auto& arg : node->arguments){
+                foldExpression(arg);
+            }
+            result = foldConstFuncCall(node);
+            break;
+        }
+        default:
+            break;
+    }
+
+    if(result){
+        if(auto literal = makeLiteral(*result)){
+            expr = std::move(literal);
+        }
+    }
+}
+
+void ConstantFolder::foldLValue(std::unique_ptr<Expression>& expr){
+    if(!expr) return;
+    if(expr->kind == NodeKind::IDENTIFIER) return;
+    if(expr->kind == NodeKind::ARRAY_ACCESS_EXPRESSION){
+        auto* node = static_cast<ArrayAccessExpression*>(expr.get());
+        foldLValue(node->array);
+        foldExpression(node->index);
+        return;
+    }
+    foldExpression(expr);
+}
+
+std::optional<ConstValue> ConstantFolder::foldConstFuncCall(FunctionCall* call){
+    auto it = constFunctions.find(call->functionName->name);
+    if(it == constFunctions.end()) return std::nullopt;
+
+    std::vector<ConstValue> args;
+    for(auto& arg : call->arguments){
+        auto value = literalConstValue(arg.get());
+        if(!value) return std::nullopt;
+        args.push_back(*value);
+    }
+
+    ConstEvaluator evaluator(constFunctions);
+    auto value = evaluator.call(it->second, args);
+    if(!value && !evaluator.limitReason().empty()){
+        // No es un error: la llamada se compila y se evalúa en tiempo de ejecución
+        warnings << "Advertencia: la constfunc '" << call->functionName->name << "' no se evaluó en compilación ("
+                  << evaluator.limitReason() << ")" << std::endl;
+    }
+    return value;
+}
+
+std::unique_ptr<Expression> ConstantFolder::makeLiteral(ConstValue c){
+    if(c.type == BuiltinType::Bool){
+        return std::make_unique<BooleanLiteral>(c.integer != 0);
+    }
+    if(c.type == BuiltinType::Int || c.type == BuiltinType::Long){
+        return std::make_unique<NumericLiteral>(c.integer, c.type);
+    }
+    if(c.type == BuiltinType::Float || c.type == BuiltinType::Double){
+        return std::make_unique<NumericLiteral>(c.floating, c.type);
+    }
+    return nullptr;
+}
+
+}
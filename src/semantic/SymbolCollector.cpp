@@ -20,9 +20,57 @@
 #include "umbra/semantic/SymbolTable.h"
 #include <algorithm>
 #include <iostream>
+#include <set>
+#include <stdexcept>
 
 namespace umbra {
 
+namespace {
+
+    /// Tipo semántico de un parámetro: `ref T` se usa como T; los arrays, por su tipo de elemento.
+    SemanticType parameterSemaType(Type* type) {
+        if(type->isReference && type->baseType) {
+            return builtinTypeToSemaType(type->baseType->builtinType);
+        }
+        return builtinTypeToSemaType(type->builtinType);
+    }
+
+    /// Tipo apuntado por un parámetro o variable `ptr T` (None si no es un puntero).
+    SemanticType declaredPointeeType(Type* type) {
+        if(type->isPointer && type->baseType) {
+            return builtinTypeToSemaType(type->baseType->builtinType);
+        }
+        return SemanticType::None;
+    }
+
+    /**
+     * @brief Variable raíz de un argumento lvalue: `x` -> x, `a[i][j]` -> a.
+     * @param indices Recibe cuántos índices se aplican sobre la raíz.
+     * @return nullptr si el argumento no es una variable ni un acceso a array.
+     */
+    Identifier* argumentRoot(Expression* expr, size_t& indices) {
+        indices = 0;
+        while(expr) {
+            if(auto* primary = dynamic_cast<PrimaryExpression*>(expr)) {
+                if(primary->exprType == PrimaryExpression::IDENTIFIER) {
+                    expr = primary->identifier.get();
+                } else if(primary->exprType == PrimaryExpression::ARRAY_ACCESS) {
+                    expr = primary->arrayAccess.get();
+                } else {
+                    return nullptr;
+                }
+            } else if(auto* access = dynamic_cast<ArrayAccessExpression*>(expr)) {
+                ++indices;
+                expr = access->array.get();
+            } else {
+                return dynamic_cast<Identifier*>(expr);
+            }
+        }
+        return nullptr;
+    }
+
+} // namespace
+
 /// @brief Orquesta la recolección de símbolos a nivel de programa.
 /// @details Registra builtins, visita cada función y valida el entry point.
 /// @param node Nodo raíz del programa (no nulo).
@@ -31,7 +79,9 @@ void SymbolCollector::visitProgramNode(ProgramNode* node) {
     for(auto &F : node->functions){
         visit(F.get());
     }
-    validateEntryPoint();
+    if (requireEntryPoint) {
+        validateEntryPoint();
+    }
 }
 
 /**
@@ -41,6 +91,7 @@ void SymbolCollector::visitProgramNode(ProgramNode* node) {
  * 2) Inserta el símbolo de la función en el scope global.
  * 3) Entra al scope de la función, inserta parámetros como variables y visita el cuerpo.
  * 4) Sale del scope de la función.
+ * En una `constfunc` además se valida la firma y, durante el cuerpo, que solo llame a otras constfunc.
  * @param node Definición de función a registrar/visitar.
  */
 void SymbolCollector::visitFunctionDefinition(FunctionDefinition* node) {
@@ -54,52 +105,91 @@ void SymbolCollector::visitFunctionDefinition(FunctionDefinition* node) {
 
     if (node->parameters) {
         for(auto& param : node->parameters->parameters) {
-            SemanticType paramType = builtinTypeToSemaType(param.first->builtinType);
-            signature.argTypes.push_back(paramType);
+            Type* type = param.first.get();
+            signature.argTypes.push_back(parameterSemaType(type));
+            signature.argArrayDims.push_back(type->arrayDimensions);
+            signature.argByReference.push_back(type->isReference);
+            signature.argPointeeTypes.push_back(declaredPointeeType(type));
+
+            if(type->isReference && type->baseType && type->baseType->arrayDimensions > 0) {
+                std::string msg = "Reference parameter '" + param.second->name + "' of function '" + node->name->name +
+                                  "' cannot be an array: arrays are always passed as slices";
+                errorManager.addError(std::make_unique<SemanticError>(msg, param.second->location, SemanticError::Action::ERROR));
+            }
         }
     }
 
+    signature.isConstFunc = node->isConstFunc;
     node->Signature = signature;
 
+    if (node->isConstFunc) {
+        validateConstFuncSignature(node);
+    }
+
     Symbol functionSymbol{
         .type = returnType,
         .kind = SymbolKind::FUCNTION,
         .signature = signature,
-        .line = 0,  // TODO: obtener línea real
-        .col = 0    // TODO: obtener columna real
+        .location = node->name->location
     };
 
-    symTable.insert(node->name->name, functionSymbol);
+    declare(node->name->name, functionSymbol);
 
     theContext.enterScope();
 
     if (node->parameters) {
         for(auto& param : node->parameters->parameters) {
-            SemanticType paramType = builtinTypeToSemaType(param.first->builtinType);
-
             Symbol paramSymbol{
-                .type = paramType,
+                .type = parameterSemaType(param.first.get()),
                 .kind = SymbolKind::VARIABLE,
                 .signature = {},
-                .line = 0,
-                .col = 0
+                .location = param.second->location,
+                .arrayDimensions = param.first->arrayDimensions,
+                .pointeeType = declaredPointeeType(param.first.get())
             };
-            symTable.insert(param.second->name, paramSymbol);
+            declare(param.second->name, paramSymbol);
         }
     }
 
+    currentConstFunc = node->isConstFunc ? node->name->name : std::string();
+
     for(auto& S: node->body){
         visit(S.get());
     }
 
+    currentConstFunc.clear();
     theContext.exitScope();
 }
 
+void SymbolCollector::validateConstFuncSignature(FunctionDefinition* node) {
+    auto isEvaluable = [](Type* type) {
+        if (type->isPointer || type->isReference || type->arrayDimensions > 0) return false;
+        SemanticType t = builtinTypeToSemaType(type->builtinType);
+        return isIntegerType(t) || isFloatingType(t) || t == SemanticType::Bool;
+    };
+
+    if (!isEvaluable(node->returnType.get())) {
+        std::string msg = "constfunc '" + node->name->name + "' must return Int, Long, Float, Double or Bool";
+        errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+    }
+    if (node->parameters) {
+        for (auto& param : node->parameters->parameters) {
+            if (!isEvaluable(param.first.get())) {
+                std::string msg = "Parameter '" + param.second->name + "' of constfunc '" + node->name->name +
+                                  "' must be a scalar passed by value";
+                errorManager.addError(std::make_unique<SemanticError>(msg, param.second->location, SemanticError::Action::ERROR));
+            }
+        }
+    }
+}
+
 /**
  * @brief Inserta variables locales y valida su inicializador (si existe).
  * @details
  * - Si el inicializador es una llamada, primero valida la firma y el tipo de retorno.
  * - Consulta a TypeCk para inferir el tipo de la expresión; si falla, reporta error.
+ * - Los tamaños de array deben ser expresiones enteras (ConstantFolder exige que sean constantes).
+ * - Una variable const necesita inicializador.
  * - Inserta el símbolo de la variable en el scope actual.
  * @param node Declaración de variable a procesar.
  */
@@ -109,25 +199,66 @@ void SymbolCollector::visitVariableDeclaration(VariableDeclaration* node){
         .type=builtinTypeToSemaType(node->type->builtinType),
         .kind=SymbolKind::VARIABLE,
         .signature={},
-        .line=0,
-        .col=0
+        .location=node->name->location,
+        .isConst=node->isConst,
+        .arrayDimensions=node->type->arrayDimensions,
+        .pointeeType=declaredPointeeType(node->type.get())
     };
 
+    for(auto& size : node->type->arraySizes){
+        validateCallsInExpression(size.get());
+        SemanticType sizeType = typeCk.visit(size.get());
+        if(sizeType != SemanticType::Error && !isIntegerType(sizeType)){
+            std::string msg = "Array size of '" + node->name->name + "' must be of type Int, got " +
+                              semanticTypeToString(sizeType);
+            errorManager.addError(std::make_unique<SemanticError>(msg, size->location, SemanticError::Action::ERROR));
+        }
+    }
+
+    if(node->isConst && !node->initializer){
+        std::string msg = "Constant '" + node->name->name + "' must be initialized";
+        errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+    }
+
     if(node->initializer != nullptr){
         validateCallsInExpression(node->initializer.get());
 
         // TypeCk ahora reporta errores específicos a través de errorManager,
         // por lo que no necesitamos agregar un mensaje genérico aquí.
-        (void)typeCk.visit(node->initializer.get());
+        SemanticType initType = typeCk.visit(node->initializer.get());
         // Si el resultado es Error, TypeCk ya reportó el problema específico
+        if(initType == SemanticType::Ptr){
+            validatePointerTarget("Pointer '" + node->name->name + "'", varSymb.pointeeType, node->initializer.get());
+        }
     }
-    symTable.insert(node->name->name, varSymb);
+    declare(node->name->name, varSymb);
 }
 
 void SymbolCollector::visitAssignmentStatement(AssignmentStatement* node){
+    // access p = v: escribe en la variable apuntada, del tipo apuntado por p
+    if(auto* deref = dynamic_cast<UnaryExpression*>(node->target.get()); deref && deref->op == "access"){
+        validateCallsInExpression(node->value.get());
+        SemanticType targetType = typeCk.visit(deref);
+        SemanticType valueType = typeCk.visit(node->value.get());
+        if(targetType != SemanticType::Error && valueType != SemanticType::Error &&
+           !isImplicitlyConvertible(valueType, targetType)){
+            std::string msg = "Type mismatch in assignment: target has type '" + semanticTypeToString(targetType) +
+                              "' but assigned value has type '" + semanticTypeToString(valueType) + "'";
+            errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+        }
+        return;
+    }
+
     Identifier* baseIdentifier = nullptr;
     if(auto id = dynamic_cast<Identifier*>(node->target.get())){
         baseIdentifier = id;
+    } else if(auto access = dynamic_cast<ArrayAccessExpression*>(node->target.get())){
+        // El parser construye a[i][j] como accesos anidados sin PrimaryExpression
+        Expression* current = access->array.get();
+        while(auto inner = dynamic_cast<ArrayAccessExpression*>(current)){
+            current = inner->array.get();
+        }
+        baseIdentifier = dynamic_cast<Identifier*>(current);
     } else if(auto primaryExpr = dynamic_cast<PrimaryExpression*>(node->target.get())){
         if(primaryExpr->exprType == PrimaryExpression::ARRAY_ACCESS && primaryExpr->arrayAccess){
             Expression* current = primaryExpr->arrayAccess->array.get();
@@ -152,7 +283,7 @@ void SymbolCollector::visitAssignmentStatement(AssignmentStatement* node){
             std::make_unique<CompilerError>(
                 ErrorType::SEMANTIC,
                 "Invalid assignment target",
-                0, 0
+                node->location
             )
         );
         return;
@@ -165,12 +296,16 @@ void SymbolCollector::visitAssignmentStatement(AssignmentStatement* node){
             std::make_unique<CompilerError>(
                 ErrorType::SEMANTIC,
                 msg,
-                Sym.line,
-                Sym.col
+                baseIdentifier->location
             )
         );
         return;
     }
+    if(Sym.isConst){
+        std::string msg = "Cannot assign to constant '" + baseIdentifier->name + "'";
+        errorManager.addError(std::make_unique<SemanticError>(msg, baseIdentifier->location, SemanticError::Action::ERROR));
+        return;
+    }
     validateCallsInExpression(node->value.get());
 
     SemanticType semaT = typeCk.visit(node->value.get());
@@ -180,8 +315,16 @@ void SymbolCollector::visitAssignmentStatement(AssignmentStatement* node){
     }
 
     SemanticType targetType = Sym.type;
+    if(semaT == SemanticType::Ptr && Sym.pointeeType != SemanticType::None){
+        validatePointerTarget("Pointer '" + baseIdentifier->name + "'", Sym.pointeeType, node->value.get());
+    }
     
-    if(auto primaryExpr = dynamic_cast<PrimaryExpression*>(node->target.get())){
+    if(node->target->getKind() == NodeKind::ARRAY_ACCESS_EXPRESSION){
+        targetType = typeCk.visit(node->target.get());
+        if(targetType == SemanticType::Error){
+            return;
+        }
+    } else if(auto primaryExpr = dynamic_cast<PrimaryExpression*>(node->target.get())){
         if(primaryExpr->exprType == PrimaryExpression::ARRAY_ACCESS){
             targetType = typeCk.visit(node->target.get());
             if(targetType == SemanticType::Error){
@@ -190,7 +333,7 @@ void SymbolCollector::visitAssignmentStatement(AssignmentStatement* node){
         }
     }
 
-    if(semaT != targetType){
+    if(!isImplicitlyConvertible(semaT, targetType)){
         std::string msg = "Type mismatch in assignment: target has type '" + 
                           semanticTypeToString(targetType) +
                           "' but assigned value has type '" + semanticTypeToString(semaT) + "'";
@@ -198,8 +341,7 @@ void SymbolCollector::visitAssignmentStatement(AssignmentStatement* node){
             std::make_unique<CompilerError>(
                 ErrorType::SEMANTIC,
                 msg,
-                Sym.line,
-                Sym.col
+                node->location
             )
         );
     }
@@ -229,6 +371,9 @@ void SymbolCollector::visitExpressionStatement(ExpressionStatement* node) {
     PrimaryExpression* pExpr = dynamic_cast<PrimaryExpression*>(node->exp.get());
     if(pExpr != nullptr){
         visitPrimaryExpression(pExpr);
+    } else {
+        // El parser genera las llamadas sin envolver en PrimaryExpression
+        validateCallsInExpression(node->exp.get());
     }
 }
 
@@ -259,12 +404,245 @@ void SymbolCollector::visitRepeatTimesStatement(RepeatTimesStatement* node) {
         validateCallsInExpression(node->times.get());
     }
 
+    if(node->parallel) {
+        visitParallelRepeat(node);
+        return;
+    }
+
     // Visitar el cuerpo del bucle
     for(auto& stmt : node->body) {
         visit(stmt.get());
     }
 }
 
+namespace {
+    bool isVectorBuiltin(const std::string& name) {
+        return name == "splat4" || name == "splat8" || name == "lane" || name == "with_lane" ||
+               name == "hsum" || name == "hmin" || name == "hmax" || name == "select";
+    }
+
+    bool containsReturn(const std::vector<std::unique_ptr<Statement>>& stmts) {
+        for(auto& stmt : stmts) {
+            switch(stmt->getKind()) {
+                case NodeKind::RETURN_EXPRESSION:
+                    return true;
+                case NodeKind::IF_STATEMENT: {
+                    auto* ifStmt = static_cast<IfStatement*>(stmt.get());
+                    for(auto& branch : ifStmt->branches) {
+                        if(containsReturn(branch.body)) return true;
+                    }
+                    if(containsReturn(ifStmt->elseBranch)) return true;
+                    break;
+                }
+                case NodeKind::REPEAT_TIMES_STATEMENT:
+                    if(containsReturn(static_cast<RepeatTimesStatement*>(stmt.get())->body)) return true;
+                    break;
+                case NodeKind::REPEAT_IF_STATEMENT:
+                    if(containsReturn(static_cast<RepeatIfStatement*>(stmt.get())->body)) return true;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return false;
+    }
+
+    Identifier* asIdentifier(Expression* expr) {
+        if(auto* primary = dynamic_cast<PrimaryExpression*>(expr); primary && primary->exprType == PrimaryExpression::IDENTIFIER) {
+            return primary->identifier.get();
+        }
+        return dynamic_cast<Identifier*>(expr);
+    }
+
+    void collectOuterWrites(Expression* expr, const std::set<std::string>& locals, std::vector<Identifier*>& writes) {
+        if(!expr) return;
+        auto note = [&](Expression* target) {
+            if(Identifier* id = asIdentifier(target); id && !locals.count(id->name)) writes.push_back(id);
+        };
+        auto walk = [&](Expression* child) { collectOuterWrites(child, locals, writes); };
+        switch(expr->getKind()) {
+            case NodeKind::INCREMENT_EXPRESSION:
+                note(static_cast<IncrementExpression*>(expr)->operand.get());
+                walk(static_cast<IncrementExpression*>(expr)->operand.get());
+                break;
+            case NodeKind::DECREMENT_EXPRESSION:
+                note(static_cast<DecrementExpression*>(expr)->operand.get());
+                walk(static_cast<DecrementExpression*>(expr)->operand.get());
+                break;
+            case NodeKind::BINARY_EXPRESSION:
+                walk(static_cast<BinaryExpression*>(expr)->left.get());
+                walk(static_cast<BinaryExpression*>(expr)->right.get());
+                break;
+            case NodeKind::UNARY_EXPRESSION:
+                walk(static_cast<UnaryExpression*>(expr)->operand.get());
+                break;
+            case NodeKind::FUNCTION_CALL:
+                for(auto& arg : static_cast<FunctionCall*>(expr)->arguments) walk(arg.get());
+                break;
+            case NodeKind::ARRAY_ACCESS_EXPRESSION:
+                walk(static_cast<ArrayAccessExpression*>(expr)->array.get());
+                walk(static_cast<ArrayAccessExpression*>(expr)->index.get());
+                break;
+            case NodeKind::TERNARY_EXPRESSION: {
+                auto* ternary = static_cast<TernaryExpression*>(expr);
+                walk(ternary->condition.get());
+                walk(ternary->trueExpr.get());
+                walk(ternary->falseExpr.get());
+                break;
+            }
+            case NodeKind::CAST_EXPRESSION:
+                walk(static_cast<CastExpression*>(expr)->expression.get());
+                break;
+            case NodeKind::PRIMARY_EXPRESSION:
+            case NodeKind::PARENTHESIZED: {
+                auto* primary = static_cast<PrimaryExpression*>(expr);
+                walk(primary->parenthesized.get());
+                walk(primary->functionCall.get());
+                walk(primary->arrayAccess.get());
+                walk(primary->castExpression.get());
+                walk(primary->ternaryExpression.get());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    /**
+     * @brief Variables escalares que un bloque modifica sin haberlas declarado dentro.
+     * @details Asignaciones directas, ++/-- y reducciones de un repeat paralelo anidado. Cada
+     *          bloque anidado recibe una copia de locals: sus declaraciones no salen de él.
+     */
+    void collectOuterWrites(const std::vector<std::unique_ptr<Statement>>& block, std::set<std::string> locals,
+                            std::vector<Identifier*>& writes) {
+        for(auto& stmt : block) {
+            switch(stmt->getKind()) {
+                case NodeKind::VARIABLE_DECLARATION: {
+                    auto* decl = static_cast<VariableDeclaration*>(stmt.get());
+                    collectOuterWrites(decl->initializer.get(), locals, writes);
+                    locals.insert(decl->name->name);
+                    break;
+                }
+                case NodeKind::ASSIGNMENT_STATEMENT: {
+                    auto* assign = static_cast<AssignmentStatement*>(stmt.get());
+                    if(Identifier* id = asIdentifier(assign->target.get()); id && !locals.count(id->name)) {
+                        writes.push_back(id);
+                    }
+                    collectOuterWrites(assign->target.get(), locals, writes);
+                    collectOuterWrites(assign->value.get(), locals, writes);
+                    break;
+                }
+                case NodeKind::EXPRESSION_STATEMENT:
+                    collectOuterWrites(static_cast<ExpressionStatement*>(stmt.get())->exp.get(), locals, writes);
+                    break;
+                case NodeKind::RETURN_EXPRESSION:
+                    collectOuterWrites(static_cast<ReturnExpression*>(stmt.get())->returnValue.get(), locals, writes);
+                    break;
+                case NodeKind::IF_STATEMENT: {
+                    auto* ifStmt = static_cast<IfStatement*>(stmt.get());
+                    for(auto& branch : ifStmt->branches) {
+                        collectOuterWrites(branch.condition.get(), locals, writes);
+                        collectOuterWrites(branch.body, locals, writes);
+                    }
+                    collectOuterWrites(ifStmt->elseBranch, locals, writes);
+                    break;
+                }
+                case NodeKind::REPEAT_TIMES_STATEMENT: {
+                    auto* loop = static_cast<RepeatTimesStatement*>(stmt.get());
+                    collectOuterWrites(loop->times.get(), locals, writes);
+                    std::set<std::string> inner = locals;
+                    for(auto& reduction : loop->reductions) {
+                        if(!locals.count(reduction.target->name)) writes.push_back(reduction.target.get());
+                        // Dentro del repeat anidado la reducción es suya: ya se informó arriba
+                        inner.insert(reduction.target->name);
+                    }
+                    if(loop->indexVar) inner.insert(loop->indexVar->name);
+                    collectOuterWrites(loop->body, std::move(inner), writes);
+                    break;
+                }
+                case NodeKind::REPEAT_IF_STATEMENT: {
+                    auto* loop = static_cast<RepeatIfStatement*>(stmt.get());
+                    collectOuterWrites(loop->condition.get(), locals, writes);
+                    collectOuterWrites(loop->body, locals, writes);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Valida un `repeat N times in parallel [as i] [reduce(op: v, ...)]`.
+ * @details
+ * - El cuerpo abre un scope propio donde el índice (si existe) es una variable Int.
+ * - Las variables de reducción deben existir y ser numéricas (min/max solo Int o Long).
+ *   Cada hilo parte del neutro de op y al final se combina su valor con op, así que el cuerpo
+ *   debe plegar cada iteración en la variable: `t = t + x` con +, `if (x > m) { m = x }` con max.
+ * - Las demás variables escalares externas son de solo lectura: cada hilo trabaja sobre una
+ *   copia privada y lo que escribiera en ella se perdería.
+ * - El índice es Long si el número de iteraciones es Long; Int en otro caso.
+ * - No se permite 'return' dentro del cuerpo: cada iteración corre en un hilo cualquiera.
+ */
+void SymbolCollector::visitParallelRepeat(RepeatTimesStatement* node) {
+    for(auto& reduction : node->reductions) {
+        auto sym = theContext.symbolTable.lookup(reduction.target->name);
+        if(sym.type == SemanticType::Error || sym.kind != SymbolKind::VARIABLE) {
+            std::string msg = "Undefined reduction variable '" + reduction.target->name + "'";
+            errorManager.addError(std::make_unique<SemanticError>(msg, reduction.target->location, SemanticError::Action::ERROR));
+            continue;
+        }
+        bool validType = isIntegerType(sym.type) ||
+                         (isFloatingType(sym.type) && reduction.op == "+");
+        if(!validType) {
+            std::string msg = "Reduction '" + reduction.op + "' not supported for variable '" +
+                              reduction.target->name + "' of type '" + semanticTypeToString(sym.type) + "'";
+            errorManager.addError(std::make_unique<SemanticError>(msg, reduction.target->location, SemanticError::Action::ERROR));
+        }
+    }
+
+    if(containsReturn(node->body)) {
+        errorManager.addError(std::make_unique<SemanticError>(
+            "'return' is not allowed inside 'repeat ... in parallel'", node->location, SemanticError::Action::ERROR));
+    }
+
+    std::set<std::string> locals;
+    if(node->indexVar) locals.insert(node->indexVar->name);
+    std::vector<Identifier*> writes;
+    collectOuterWrites(node->body, locals, writes);
+    for(Identifier* target : writes) {
+        bool reduced = std::any_of(node->reductions.begin(), node->reductions.end(),
+                                   [&](const Reduction& r) { return r.target->name == target->name; });
+        auto sym = theContext.symbolTable.lookup(target->name);
+        if(reduced || sym.type == SemanticType::Error || sym.kind != SymbolKind::VARIABLE || sym.arrayDimensions > 0) {
+            continue;
+        }
+        std::string msg = "Cannot modify '" + target->name + "' inside 'repeat ... in parallel': each thread works on a "
+                          "private copy; combine the iterations with reduce(op: " + target->name + ")";
+        errorManager.addError(std::make_unique<SemanticError>(msg, target->location, SemanticError::Action::ERROR));
+    }
+
+    SemanticType indexType = typeCk.visit(node->times.get()) == SemanticType::Long
+                           ? SemanticType::Long : SemanticType::Int;
+
+    theContext.enterScope();
+    if(node->indexVar) {
+        Symbol indexSymbol{
+            .type = indexType,
+            .kind = SymbolKind::VARIABLE,
+            .signature = {},
+            .location = node->indexVar->location
+        };
+        declare(node->indexVar->name, indexSymbol);
+    }
+
+    for(auto& stmt : node->body) {
+        visit(stmt.get());
+    }
+    theContext.exitScope();
+}
+
 void SymbolCollector::visitRepeatIfStatement(RepeatIfStatement* node) {
     if(!node) return;
 
@@ -283,8 +661,8 @@ void SymbolCollector::visitRepeatIfStatement(RepeatIfStatement* node) {
  * @brief Valida semánticamente una llamada a función.
  * @details
  * - Busca el símbolo de la función (si no existe: error).
- * - Caso especial "print": la firma está marcada como variádica en registerBuiltins()
- *   (pendiente de parsear placeholders aquí; por ahora no se forza conteo para el extra).
+ * - Caso especial "print": la firma está marcada como variádica en registerBuiltins(); el
+ *   formato debe ser un literal de cadena con tantos `{}` como argumentos le siguen.
  * - Para funciones no variádicas: compara número y tipos de argumentos 1:1.
  * - Propaga en el nodo: tipos de args (argTypes) y tipo de retorno (semaT).
  * @param node Nodo de llamada.
@@ -292,14 +670,36 @@ void SymbolCollector::visitRepeatIfStatement(RepeatIfStatement* node) {
  */
 bool SymbolCollector::validateFunctionCall(FunctionCall* node) {
     if(!node) {
-        errorManager.addError(std::make_unique<SemanticError>("Null function call node", 0, 0, SemanticError::Action::ERROR));
+        errorManager.addError(std::make_unique<SemanticError>("Null function call node", SourceLocation(), SemanticError::Action::ERROR));
         return false;
     }
 
+    // Una llamada inválida queda como Error: TypeCk no vuelve a reportarla como no resuelta
+    node->semaT = SemanticType::Error;
+
+    if(!currentConstFunc.empty()) {
+        // Una constfunc es pura: solo puede llamar a otras constfunc (ni print, ni read_*, ni builtins SIMD)
+        auto callee = symTable.lookup(node->functionName->name);
+        if(callee.kind == SymbolKind::FUCNTION && callee.type != SemanticType::Error && !callee.signature.isConstFunc) {
+            std::string msg = "constfunc '" + currentConstFunc + "' cannot call non-constfunc '" + node->functionName->name + "'";
+            errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+            return false;
+        }
+    }
+
+    if(isVectorBuiltin(node->functionName->name)) {
+        if(!currentConstFunc.empty()) {
+            std::string msg = "constfunc '" + currentConstFunc + "' cannot call SIMD builtin '" + node->functionName->name + "'";
+            errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+            return false;
+        }
+        return validateVectorBuiltin(node);
+    }
+
     auto symbolFCall = symTable.lookup(node->functionName->name);
     if(symbolFCall.type == SemanticType::Error){
         std::string msg = "Undefined function '" + node->functionName->name + "'";
-        errorManager.addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+        errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
         return false;
     }
 
@@ -310,46 +710,255 @@ bool SymbolCollector::validateFunctionCall(FunctionCall* node) {
         if(argTypes.size() < expectedTypes.size()) {
             std::string msg = "Wrong number of arguments for function '" + node->functionName->name + "'. Expected at least: " +
                               std::to_string(expectedTypes.size()) + ", Got: " + std::to_string(argTypes.size());
-            errorManager.addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+            errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+            return false;
+        }
+        if(node->functionName->name == "print" && !validatePrintFormat(node)) {
             return false;
         }
     } else {
         if(argTypes.size() != expectedTypes.size()) {
             std::string msg = "Wrong number of arguments for function '" + node->functionName->name + "'. Expected: " +
                               std::to_string(expectedTypes.size()) + ", Got: " + std::to_string(argTypes.size());
-            errorManager.addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+            errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
             return false;
         }
     }
 
     for(size_t i = 0; i < expectedTypes.size(); ++i) {
-        if(argTypes[i] != expectedTypes[i]) {
+        // El argumento ya reportó su propio error
+        if(argTypes[i] == SemanticType::Error) return false;
+        if(!isImplicitlyConvertible(argTypes[i], expectedTypes[i])) {
             std::string msg = "Type mismatch in argument " + std::to_string(i + 1) + " of function '" + node->functionName->name +
                               "': expected type '" + semanticTypeToString(expectedTypes[i]) +
                               "' but got type '" + semanticTypeToString(argTypes[i]) + "'";
-            errorManager.addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+            errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
             return false;
         }
     }
 
+    if(!validateArgumentPassing(node, symbolFCall.signature, argTypes)) {
+        return false;
+    }
+
     node->argTypes = std::move(argTypes);
     node->semaT = symbolFCall.signature.returnType;
     return true;
 }
 
+/**
+ * @brief El formato de print se resuelve en compilación: debe ser un literal y cada `{}` consume
+ *        un argumento, en orden. Un marcador sin argumento o un argumento sin marcador es un error.
+ */
+bool SymbolCollector::validatePrintFormat(FunctionCall* node) {
+    Expression* format = node->arguments[0].get();
+    if(auto* primary = dynamic_cast<PrimaryExpression*>(format); primary && primary->exprType == PrimaryExpression::LITERAL) {
+        format = primary->literal.get();
+    }
+    auto* literal = dynamic_cast<StringLiteral*>(format);
+    if(!literal) {
+        errorManager.addError(std::make_unique<SemanticError>("The format of 'print' must be a string literal",
+                                                              node->location, SemanticError::Action::ERROR));
+        return false;
+    }
+
+    size_t placeholders = 0;
+    for(size_t pos = literal->value.find("{}"); pos != std::string::npos; pos = literal->value.find("{}", pos + 2)) {
+        ++placeholders;
+    }
+    size_t values = node->arguments.size() - 1;
+    if(placeholders != values) {
+        std::string msg = "The format of 'print' has " + std::to_string(placeholders) + " placeholder(s) '{}' but " +
+                          std::to_string(values) + " value(s) were given";
+        errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Un puntero `ptr T` solo puede apuntar a valores de tipo T.
+ * @details Codegen carga y almacena a través del puntero con el tipo declarado (y su
+ *          metadata TBAA), así que apuntar a otro tipo leería o escribiría con otro ancho.
+ */
+void SymbolCollector::validatePointerTarget(const std::string& what, SemanticType pointee, Expression* value) {
+    SemanticType target = typeCk.pointeeType(value);
+    if(pointee != SemanticType::None && target != SemanticType::None && target != pointee){
+        std::string msg = what + " of type 'ptr " + semanticTypeToString(pointee) +
+                          "' cannot point to a value of type '" + semanticTypeToString(target) + "'";
+        errorManager.addError(std::make_unique<SemanticError>(msg, value->location, SemanticError::Action::ERROR));
+    }
+}
+
+void SymbolCollector::declare(const std::string& name, const Symbol& symbol) {
+    try {
+        symTable.insert(name, symbol);
+    } catch (const std::runtime_error&) {
+        std::string msg = "Redefinition of symbol '" + name + "' in the same scope";
+        errorManager.addError(std::make_unique<SemanticError>(msg, symbol.location, SemanticError::Action::ERROR));
+    }
+}
+
+/**
+ * @brief Reglas de paso de arrays (slices) y parámetros `ref T`.
+ * @details
+ * - Un parámetro array recibe un array completo con las mismas dimensiones y el mismo tipo
+ *   de elemento (se pasa su dirección y longitudes, sin copia ni conversión).
+ * - Un parámetro `ref T` recibe una variable o un elemento de array de tipo T exacto y no const.
+ * - Un array no puede pasarse donde se espera un escalar.
+ * - Una misma variable no puede llegar dos veces por referencia a la misma llamada: codegen
+ *   marca esos punteros como noalias.
+ */
+bool SymbolCollector::validateArgumentPassing(FunctionCall* node, const FunctionSignature& signature,
+                                              const std::vector<SemanticType>& argTypes) {
+    const std::string& fname = node->functionName->name;
+    std::vector<std::string> byReference;   // raíces pasadas a parámetros ref o array (noalias)
+    std::vector<std::string> pointerArgs;   // raíces de `ref x` pasadas a parámetros ptr
+    bool valid = true;
+    auto fail = [&](const std::string& msg) {
+        errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+        valid = false;
+    };
+
+    for(size_t i = 0; i < node->arguments.size(); ++i) {
+        size_t indices = 0;
+        Identifier* root = argumentRoot(node->arguments[i].get(), indices);
+        Symbol sym = root ? symTable.lookup(root->name) : Symbol{};
+        int dims = i < signature.argArrayDims.size() ? signature.argArrayDims[i] : 0;
+        bool byRef = i < signature.argByReference.size() && signature.argByReference[i];
+        std::string position = "Argument " + std::to_string(i + 1) + " of function '" + fname + "'";
+
+        if(dims > 0) {
+            if(!root || indices != 0 || sym.arrayDimensions != dims || argTypes[i] != signature.argTypes[i]) {
+                fail(position + " must be an array of " + std::to_string(dims) + " dimension(s) of type '" +
+                     semanticTypeToString(signature.argTypes[i]) + "'");
+                continue;
+            }
+            byReference.push_back(root->name);
+        } else if(byRef) {
+            if(!root || sym.arrayDimensions != static_cast<int>(indices) || argTypes[i] != signature.argTypes[i]) {
+                fail(position + " is passed by reference and must be a variable or array element of type '" +
+                     semanticTypeToString(signature.argTypes[i]) + "'");
+                continue;
+            }
+            if(sym.isConst) {
+                fail("Cannot pass constant '" + root->name + "' by reference to function '" + fname + "'");
+                continue;
+            }
+            byReference.push_back(root->name);
+        } else if(root && sym.arrayDimensions > static_cast<int>(indices)) {
+            fail("Array '" + root->name + "' cannot be passed as argument " + std::to_string(i + 1) +
+                 " of function '" + fname + "': the parameter is not an array");
+        } else if(i < signature.argPointeeTypes.size() && signature.argPointeeTypes[i] != SemanticType::None) {
+            validatePointerTarget(position,
+                                  signature.argPointeeTypes[i], node->arguments[i].get());
+        }
+        if(auto* unary = dynamic_cast<UnaryExpression*>(node->arguments[i].get()); unary && unary->op == "ref") {
+            // `ref x` hacia un parámetro ptr también es un alias de x dentro de la llamada
+            if(Identifier* target = argumentRoot(unary->operand.get(), indices)) {
+                pointerArgs.push_back(target->name);
+            }
+        }
+    }
+
+    std::sort(byReference.begin(), byReference.end());
+    auto duplicate = std::adjacent_find(byReference.begin(), byReference.end());
+    for(auto it = pointerArgs.begin(); duplicate == byReference.end() && it != pointerArgs.end(); ++it) {
+        duplicate = std::lower_bound(byReference.begin(), byReference.end(), *it);
+        if(duplicate != byReference.end() && *duplicate != *it) duplicate = byReference.end();
+    }
+    if(duplicate != byReference.end()) {
+        fail("Variable '" + *duplicate + "' is passed more than once by reference to function '" + fname + "'");
+    }
+    return valid;
+}
+
+/**
+ * @brief Valida un builtin SIMD y deduce su tipo de retorno de los argumentos.
+ * @details
+ * - splat4(x) / splat8(x): x Int o Float -> vector con x en todos los lanes.
+ * - lane(v, i): lane i de v (Int) -> tipo de elemento. Un índice literal fuera de rango es error.
+ * - with_lane(v, i, x): copia de v con el lane i reemplazado por x.
+ * - hsum(v) / hmin(v) / hmax(v): reducción horizontal -> tipo de elemento.
+ * - select(mask, a, b): por lane, a si mask != 0, b en otro caso; mask es el vector Int de a.
+ */
+bool SymbolCollector::validateVectorBuiltin(FunctionCall* node) {
+    const std::string& name = node->functionName->name;
+    std::vector<SemanticType> argTypes = extractArgumentTypes(node->arguments);
+
+    auto fail = [&](const std::string& msg) {
+        errorManager.addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+        return false;
+    };
+
+    size_t expectedArgs = 1;
+    if(name == "lane") expectedArgs = 2;
+    else if(name == "with_lane" || name == "select") expectedArgs = 3;
+    if(argTypes.size() != expectedArgs) {
+        return fail("Wrong number of arguments for function '" + name + "'. Expected: " +
+                    std::to_string(expectedArgs) + ", Got: " + std::to_string(argTypes.size()));
+    }
+    for(SemanticType t : argTypes) {
+        if(t == SemanticType::Error) return false;
+    }
+
+    SemanticType result = SemanticType::Error;
+    if(name == "splat4" || name == "splat8") {
+        result = makeVectorType(argTypes[0], name == "splat4" ? 4 : 8);
+        if(result == SemanticType::Error) {
+            return fail("'" + name + "' expects an Int or Float argument, got '" + semanticTypeToString(argTypes[0]) + "'");
+        }
+    } else {
+        SemanticType vecType = name == "select" ? argTypes[1] : argTypes[0];
+        if(!isVectorType(vecType)) {
+            return fail("'" + name + "' expects a vector argument, got '" + semanticTypeToString(vecType) + "'");
+        }
+        SemanticType elemType = vectorElementType(vecType);
+
+        if(name == "lane" || name == "with_lane") {
+            if(argTypes[1] != SemanticType::Int) {
+                return fail("Lane index of '" + name + "' must be of type Int, got " + semanticTypeToString(argTypes[1]));
+            }
+            if(auto* literal = dynamic_cast<NumericLiteral*>(node->arguments[1].get())) {
+                if(literal->intValue < 0 || literal->intValue >= vectorLaneCount(vecType)) {
+                    return fail("Lane index " + std::to_string(literal->intValue) +
+                                " out of range for '" + semanticTypeToString(vecType) + "'");
+                }
+            }
+            if(name == "with_lane" && argTypes[2] != elemType) {
+                return fail("Type mismatch in argument 3 of function 'with_lane': expected type '" +
+                            semanticTypeToString(elemType) + "' but got type '" + semanticTypeToString(argTypes[2]) + "'");
+            }
+            result = name == "lane" ? elemType : vecType;
+        } else if(name == "select") {
+            if(argTypes[2] != vecType || argTypes[0] != vectorMaskType(vecType)) {
+                return fail("'select' expects (" + semanticTypeToString(vectorMaskType(vecType)) + ", " +
+                            semanticTypeToString(vecType) + ", " + semanticTypeToString(vecType) + ")");
+            }
+            result = vecType;
+        } else {
+            result = elemType;
+        }
+    }
+
+    node->argTypes = std::move(argTypes);
+    node->semaT = result;
+    return true;
+}
+
 /**
  * @brief Convierte cada argumento a su SemanticType usando el TypeCk.
  * @param arguments Vector de expresiones de argumentos.
  * @return Vector de tipos inferidos en el mismo orden.
  */
 void SymbolCollector::validateCallsInExpression(Expression* expr) {
-    static int recursionDepth = 0;
+    thread_local int recursionDepth = 0;
     if(!expr) return;
 
     // Protección contra recursión infinita
     if(++recursionDepth > 1000) {
         std::string msg = "Internal error: infinite recursion in validateCallsInExpression";
-        errorManager.addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+        errorManager.addError(std::make_unique<SemanticError>(msg, expr->location, SemanticError::Action::ERROR));
         --recursionDepth;
         return;
     }
@@ -357,10 +966,13 @@ void SymbolCollector::validateCallsInExpression(Expression* expr) {
     if(expr->getKind() == NodeKind::PRIMARY_EXPRESSION) {
         auto* primaryExpr = dynamic_cast<PrimaryExpression*>(expr);
         if(primaryExpr && primaryExpr->exprType == PrimaryExpression::Type::EXPRESSION_CALL && primaryExpr->functionCall) {
+            // validateFunctionCall ya recorre los argumentos (extractArgumentTypes)
             validateFunctionCall(primaryExpr->functionCall.get());
-            for(auto& arg : primaryExpr->functionCall->arguments) {
-                validateCallsInExpression(arg.get());
-            }
+        }
+    } else if(expr->getKind() == NodeKind::FUNCTION_CALL) {
+        auto* callExpr = dynamic_cast<FunctionCall*>(expr);
+        if(callExpr) {
+            validateFunctionCall(callExpr);
         }
     } else if(expr->getKind() == NodeKind::BINARY_EXPRESSION) {
         auto* binExpr = dynamic_cast<BinaryExpression*>(expr);
@@ -417,16 +1029,34 @@ void SymbolCollector::printCollectedSymbols() const {
  * @brief Registra símbolos builtin en el scope global.
  * @details
  * - print(String, ...) -> Void (variádica): la firma marca vararg=true y exige primer arg String.
+ * - read_int() -> Int, read_long() -> Long, read_float() -> Float, read_double() -> Double,
+ *   read_line() -> String: lectura de stdin (libumbra_rt).
  */
 void SymbolCollector::registerBuiltins() {
     Symbol printSym{
         .type = SemanticType::Void,
         .kind = SymbolKind::FUCNTION,
         .signature = FunctionSignature{true, SemanticType::Void, {SemanticType::String}},
-        .line = 0,
-        .col = 0
+        .location = SourceLocation()
     };
     symTable.insert("print", printSym);
+
+    const std::pair<const char*, SemanticType> readBuiltins[] = {
+        {"read_int", SemanticType::Int},
+        {"read_long", SemanticType::Long},
+        {"read_float", SemanticType::Float},
+        {"read_double", SemanticType::Double},
+        {"read_line", SemanticType::String},
+    };
+    for(const auto& [name, returnType] : readBuiltins) {
+        Symbol readSym{
+            .type = returnType,
+            .kind = SymbolKind::FUCNTION,
+            .signature = FunctionSignature{false, returnType, {}},
+            .location = SourceLocation()
+        };
+        symTable.insert(name, readSym);
+    }
 }
 
 /**
@@ -437,11 +1067,11 @@ void SymbolCollector::validateEntryPoint() {
     auto sym = symTable.lookup("start");
     if (sym.kind != SymbolKind::FUCNTION || sym.signature.argTypes.size() != 0) {
         errorManager.addError(std::make_unique<SemanticError>(
-            "Entry point 'start' must be a function with no parameters", 0, 0, SemanticError::Action::ERROR));
+            "Entry point 'start' must be a function with no parameters", sym.location, SemanticError::Action::ERROR));
     }
     if (!(sym.signature.returnType == SemanticType::Void || sym.signature.returnType == SemanticType::Int)) {
         errorManager.addError(std::make_unique<SemanticError>(
-            "Entry point 'start' must return void or int", 0, 0, SemanticError::Action::ERROR));
+            "Entry point 'start' must return void or int", sym.location, SemanticError::Action::ERROR));
     }
 }
 
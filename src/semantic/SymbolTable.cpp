@@ -46,6 +46,6 @@ namespace umbra {
                 return found->second;
             }
         }
-        return Symbol{SemanticType::Error, SymbolKind::VARIABLE, {}, 0, 0};
+        return Symbol{SemanticType::Error, SymbolKind::VARIABLE, {}, SourceLocation()};
     }
 }
@@ -20,13 +20,22 @@ namespace umbra{
             return SemanticType::Error;
         }
 
+        if (isVectorType(lType) || isVectorType(rType)) {
+            return vectorBinaryType(node, lType, rType);
+        }
+
         if (lType != rType) {
+            // int con long -> long, float con double -> double
+            SemanticType promoted = promoteNumeric(lType, rType);
+            if (promoted != SemanticType::Error) {
+                return promoted;
+            }
             if(errorManager) {
                 std::string msg = "Type mismatch in binary expression: left side is '" +
                                   semanticTypeToString(lType) +
                                   "', right side is '" +
                                   semanticTypeToString(rType) + "'";
-                errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
             }
             return SemanticType::Error;
         }
@@ -34,19 +43,66 @@ namespace umbra{
         return lType;
     }
 
+    /**
+     * Operadores sobre vec4/vec8:
+     * - + - * / operan lane a lane; % solo con vectores de Int.
+     * - Un operando escalar del tipo de elemento se expande (splat) a todos los lanes.
+     * - Las comparaciones devuelven un vector de Int con los mismos lanes (1 o 0 por lane).
+     * - and/or no están definidos sobre vectores.
+     */
+    SemanticType TypeCk::vectorBinaryType(BinaryExpression* node, SemanticType lType, SemanticType rType){
+        SemanticType vecType = isVectorType(lType) ? lType : rType;
+        SemanticType other = isVectorType(lType) ? rType : lType;
+        const std::string& op = node->op;
+
+        auto fail = [&](const std::string& msg) {
+            if(errorManager) {
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+            }
+            return SemanticType::Error;
+        };
+
+        if (other != vecType && other != vectorElementType(vecType)) {
+            return fail("Type mismatch in vector expression: '" + semanticTypeToString(lType) +
+                        "' " + op + " '" + semanticTypeToString(rType) + "'");
+        }
+
+        if (op == "+" || op == "-" || op == "*" || op == "/") {
+            return vecType;
+        }
+        if (op == "%") {
+            if (vectorElementType(vecType) != SemanticType::Int) {
+                return fail("Operator '%' requires an int vector, got '" + semanticTypeToString(vecType) + "'");
+            }
+            return vecType;
+        }
+        if (op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=") {
+            return vectorMaskType(vecType);
+        }
+        return fail("Operator '" + op + "' is not defined for '" + semanticTypeToString(vecType) + "'");
+    }
+
     SemanticType TypeCk::visitStringLiteral(StringLiteral* /*node */) {
         return SemanticType::String;
     }
 
+    SemanticType TypeCk::visitBooleanLiteral(BooleanLiteral* /*node */) {
+        return SemanticType::Bool;
+    }
+
+    SemanticType TypeCk::visitCharLiteral(CharLiteral* /*node */) {
+        return SemanticType::Char;
+    }
+
     SemanticType TypeCk::visitPrimaryExpression(PrimaryExpression* node){
-        static int recursionDepth = 0;
+        thread_local int recursionDepth = 0;
         if(!node) return SemanticType::Error;
 
         // Protección contra recursión infinita
         if(++recursionDepth > 1000) {
             if(errorManager) {
                 std::string msg = "Internal error: infinite recursion detected in type checking";
-                errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
             }
             --recursionDepth;
             return SemanticType::Error;
@@ -93,7 +149,7 @@ namespace umbra{
         // Si no tiene tipo establecido, es un error
         if(errorManager) {
             std::string msg = "Function call type not resolved (internal error)";
-            errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+            errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
         }
         return SemanticType::Error;
     }
@@ -107,7 +163,7 @@ namespace umbra{
 
         if(errorManager) {
             std::string msg = "Undefined variable '" + node->name + "' (variable may be out of scope or not declared)";
-            errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+            errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
         }
 
         node->semaT = SemanticType::Error;
@@ -122,10 +178,10 @@ namespace umbra{
         }
         
         SemanticType indexType = visit(node->index.get());
-        if(indexType != SemanticType::Int){
+        if(!isIntegerType(indexType)){
             if(errorManager){
-                std::string msg = "Array index must be of type Int, got " + semanticTypeToString(indexType);
-                errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+                std::string msg = "Array index must be of type Int or Long, got " + semanticTypeToString(indexType);
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
             }
             return SemanticType::Error;
         }
@@ -140,10 +196,10 @@ namespace umbra{
             return SemanticType::Error;
         }
         
-        if(operandType != SemanticType::Int && operandType != SemanticType::Float){
+        if(!isIntegerType(operandType) && !isFloatingType(operandType)){
             if(errorManager){
-                std::string msg = "Increment operator requires numeric type (Int or Float), got " + semanticTypeToString(operandType);
-                errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+                std::string msg = "Increment operator requires numeric type (Int, Long, Float or Double), got " + semanticTypeToString(operandType);
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
             }
             return SemanticType::Error;
         }
@@ -158,10 +214,10 @@ namespace umbra{
             return SemanticType::Error;
         }
         
-        if(operandType != SemanticType::Int && operandType != SemanticType::Float){
+        if(!isIntegerType(operandType) && !isFloatingType(operandType)){
             if(errorManager){
-                std::string msg = "Decrement operator requires numeric type (Int or Float), got " + semanticTypeToString(operandType);
-                errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+                std::string msg = "Decrement operator requires numeric type (Int, Long, Float or Double), got " + semanticTypeToString(operandType);
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
             }
             return SemanticType::Error;
         }
@@ -192,13 +248,19 @@ namespace umbra{
             if(operandType != SemanticType::Ptr){
                 if(errorManager){
                     std::string msg = "'access' operator requires pointer type, got " + semanticTypeToString(operandType);
-                    errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+                    errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
                 }
                 return SemanticType::Error;
             }
-            // For now, return Int as we don't track the pointed-to type semantically yet
-            // TODO: Track pointed-to type for proper type checking
-            return SemanticType::Int;
+            SemanticType pointee = pointeeType(node->operand.get());
+            if(pointee == SemanticType::None){
+                if(errorManager){
+                    std::string msg = "Cannot determine the type pointed to by the operand of 'access'";
+                    errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+                }
+                return SemanticType::Error;
+            }
+            return pointee;
         }
 
         // Handle 'ptr' operator (in expressions) - similar to 'ref'
@@ -206,12 +268,53 @@ namespace umbra{
             return SemanticType::Ptr;
         }
 
+        // Negación aritmética: enteros, reales y vectores
+        if(node->op == "-"){
+            if(isIntegerType(operandType) || isFloatingType(operandType) || isVectorType(operandType)){
+                return operandType;
+            }
+            if(errorManager){
+                std::string msg = "Unary '-' requires a numeric operand, got " + semanticTypeToString(operandType);
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+            }
+            return SemanticType::Error;
+        }
+
+        // Negación lógica: mismo criterio que las condiciones (Bool o entero distinto de 0)
+        if(node->op == "not"){
+            if(operandType == SemanticType::Bool || isIntegerType(operandType)){
+                return SemanticType::Bool;
+            }
+            if(errorManager){
+                std::string msg = "'not' requires a Bool or integer operand, got " + semanticTypeToString(operandType);
+                errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
+            }
+            return SemanticType::Error;
+        }
+
         // Unknown unary operator
         if(errorManager){
             std::string msg = "Unknown unary operator '" + node->op + "'";
-            errorManager->addError(std::make_unique<SemanticError>(msg, 0, 0, SemanticError::Action::ERROR));
+            errorManager->addError(std::make_unique<SemanticError>(msg, node->location, SemanticError::Action::ERROR));
         }
         return SemanticType::Error;
     }
 
+    SemanticType TypeCk::pointeeType(Expression* expr){
+        while(auto* primary = dynamic_cast<PrimaryExpression*>(expr)){
+            if(primary->exprType == PrimaryExpression::IDENTIFIER) expr = primary->identifier.get();
+            else if(primary->exprType == PrimaryExpression::PARENTHESIZED) expr = primary->parenthesized.get();
+            else break;
+        }
+        if(auto* id = dynamic_cast<Identifier*>(expr)){
+            return ctxt.symbolTable.lookup(id->name).pointeeType;
+        }
+        // ref x apunta al tipo de x
+        if(auto* unary = dynamic_cast<UnaryExpression*>(expr); unary && unary->op == "ref"){
+            SemanticType target = visit(unary->operand.get());
+            return target == SemanticType::Error ? SemanticType::None : target;
+        }
+        return SemanticType::None;
+    }
+
 }
@@ -0,0 +1,247 @@
+#include "umbra/server/CompileServer.h"
+#include "umbra/server/DaemonProtocol.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace umbra {
+
+    namespace {
+
+        /// Salida de una petición: se envía al cliente en frames de un tipo al vaciarse.
+        class FrameBuffer : public std::streambuf {
+        public:
+            FrameBuffer(int fd, DaemonProtocol::Frame type) : fd(fd), type(type) {
+                setp(buffer, buffer + sizeof buffer);
+            }
+            ~FrameBuffer() override { send(); }
+
+        protected:
+            int_type overflow(int_type ch) override {
+                send();
+                if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                    *pptr() = traits_type::to_char_type(ch);
+                    pbump(1);
+                }
+                return traits_type::not_eof(ch);
+            }
+            int sync() override {
+                send();
+                return 0;
+            }
+
+        private:
+            int fd;
+            DaemonProtocol::Frame type;
+            bool connected = true;
+            char buffer[4096];
+
+            void send() {
+                if (pptr() == pbase()) return;
+                // Si el cliente se fue, la compilación sigue y su salida se descarta
+                connected = connected && DaemonProtocol::writeFrame(fd, type, std::string_view(pbase(), pptr() - pbase()));
+                setp(buffer, buffer + sizeof buffer);
+            }
+        };
+
+        int stopPipe[2] = {-1, -1};
+
+        void onStopSignal(int) {
+            char byte = 0;
+            ssize_t written = ::write(stopPipe[1], &byte, 1);
+            (void)written;
+        }
+
+    } // namespace
+
+    CompileServer::CompileServer(std::string socketPath, unsigned threads, Handler handler)
+        : socketPath(std::move(socketPath)),
+          threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          handler(std::move(handler)) {}
+
+    int CompileServer::listen(std::string& error) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            error = "socket path too long: " + socketPath;
+            return -1;
+        }
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        std::string ignored;
+        int existing = DaemonProtocol::connect(socketPath, ignored);
+        if (existing >= 0) {
+            ::close(existing);
+            error = "another umbra daemon is listening on " + socketPath;
+            return -1;
+        }
+        // Socket de un daemon que terminó sin borrarlo; cualquier otro archivo se respeta
+        struct stat st;
+        if (::lstat(socketPath.c_str(), &st) == 0) {
+            if (!S_ISSOCK(st.st_mode)) {
+                error = socketPath + " exists and is not a socket";
+                return -1;
+            }
+            ::unlink(socketPath.c_str());
+        }
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            error = std::strerror(errno);
+            return -1;
+        }
+        // Solo el usuario puede conectarse; aún no hay otros hilos que dependan de la umask
+        mode_t previousMask = ::umask(0077);
+        int bound = ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        ::umask(previousMask);
+        if (bound != 0 || ::listen(fd, SOMAXCONN) != 0) {
+            error = "cannot listen on " + socketPath + ": " + std::strerror(errno);
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    bool CompileServer::run(std::string& error) {
+        int listener = listen(error);
+        if (listener < 0) {
+            return false;
+        }
+        if (::pipe2(stopPipe, O_CLOEXEC) != 0) {
+            error = std::strerror(errno);
+            ::close(listener);
+            ::unlink(socketPath.c_str());
+            return false;
+        }
+
+        struct sigaction action{};
+        action.sa_handler = onStopSignal;
+        sigemptyset(&action.sa_mask);
+        struct sigaction previousInt, previousTerm;
+        ::sigaction(SIGINT, &action, &previousInt);
+        ::sigaction(SIGTERM, &action, &previousTerm);
+
+        {
+            std::vector<std::thread> workers;
+            for (unsigned i = 0; i < threads; ++i) {
+                workers.emplace_back(&CompileServer::work, this);
+            }
+            std::cout << "umbra daemon listening on " << socketPath << " (" << threads << " threads)" << std::endl;
+
+            pollfd fds[2] = {{listener, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+            for (;;) {
+                if (::poll(fds, 2, -1) < 0) {
+                    if (errno == EINTR) continue;
+                    break;
+                }
+                if (fds[1].revents) break;
+                if (!(fds[0].revents & POLLIN)) continue;
+
+                int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                if (client < 0) continue;
+                ucred credentials{};
+                socklen_t length = sizeof(credentials);
+                if (::getsockopt(client, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0 ||
+                    credentials.uid != ::geteuid()) {
+                    ::close(client);
+                    continue;
+                }
+                // Un cliente detenido no debe ocupar un hilo para siempre
+                timeval timeout{30, 0};
+                ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    pending.push_back(client);
+                }
+                available.notify_one();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            available.notify_all();
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        ::close(listener);
+        ::unlink(socketPath.c_str());
+        ::sigaction(SIGINT, &previousInt, nullptr);
+        ::sigaction(SIGTERM, &previousTerm, nullptr);
+        ::close(stopPipe[0]);
+        ::close(stopPipe[1]);
+        stopPipe[0] = stopPipe[1] = -1;
+        std::cout << "umbra daemon stopped" << std::endl;
+        return true;
+    }
+
+    void CompileServer::work() {
+        for (;;) {
+            int fd;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                available.wait(lock, [this] { return stopping || !pending.empty(); });
+                // Al parar se atienden primero las conexiones ya aceptadas
+                if (pending.empty()) return;
+                fd = pending.front();
+                pending.pop_front();
+            }
+            serve(fd);
+        }
+    }
+
+    void CompileServer::serve(int fd) {
+        DaemonProtocol::Frame type;
+        std::string data;
+        if (!DaemonProtocol::readFrame(fd, type, data, DaemonProtocol::MaxRequestSize) ||
+            type != DaemonProtocol::Frame::Request) {
+            ::close(fd);
+            return;
+        }
+
+        int status = 1;
+        {
+            FrameBuffer outBuffer(fd, DaemonProtocol::Frame::Stdout);
+            FrameBuffer errBuffer(fd, DaemonProtocol::Frame::Stderr);
+            std::ostream out(&outBuffer);
+            std::ostream err(&errBuffer);
+
+            DaemonProtocol::Request request;
+            std::string error;
+            if (!DaemonProtocol::decodeRequest(data, request, error)) {
+                err << "Error: " << error << "." << std::endl;
+            } else {
+                try {
+                    status = handler(request.arguments, request.workingDirectory, out, err);
+                } catch (const std::exception& exception) {
+                    err << "Error: " << exception.what() << std::endl;
+                }
+            }
+            out.flush();
+        }
+
+        char code = static_cast<char>(status);
+        DaemonProtocol::writeFrame(fd, DaemonProtocol::Frame::Exit, std::string_view(&code, 1));
+        ::close(fd);
+    }
+
+} // namespace umbra
@@ -0,0 +1,128 @@
+#include "umbra/server/DaemonProtocol.h"
+#include "umbra/io/BinaryStream.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace umbra {
+
+    namespace {
+
+        bool sendAll(int fd, const char* data, size_t length) {
+            while (length > 0) {
+                // MSG_NOSIGNAL: un cliente que se fue no debe matar al daemon con SIGPIPE
+                ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL);
+                if (sent < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                data += sent;
+                length -= static_cast<size_t>(sent);
+            }
+            return true;
+        }
+
+        bool receiveAll(int fd, char* data, size_t length) {
+            while (length > 0) {
+                ssize_t received = ::recv(fd, data, length, 0);
+                if (received < 0 && errno == EINTR) continue;
+                if (received <= 0) return false;
+                data += received;
+                length -= static_cast<size_t>(received);
+            }
+            return true;
+        }
+
+    } // namespace
+
+    std::string DaemonProtocol::defaultSocketPath() {
+        if (const char* socket = std::getenv("UMBRA_SOCKET"); socket && *socket) {
+            return socket;
+        }
+        if (const char* runtimeDirectory = std::getenv("XDG_RUNTIME_DIR"); runtimeDirectory && *runtimeDirectory) {
+            return std::string(runtimeDirectory) + "/umbra.sock";
+        }
+        return "/tmp/umbra-" + std::to_string(::getuid()) + ".sock";
+    }
+
+    int DaemonProtocol::connect(const std::string& socketPath, std::string& error) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            error = "socket path too long: " + socketPath;
+            return -1;
+        }
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            error = std::strerror(errno);
+            return -1;
+        }
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            error = "cannot connect to " + socketPath + ": " + std::strerror(errno);
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    bool DaemonProtocol::writeFrame(int fd, Frame type, std::string_view data) {
+        uint32_t length = static_cast<uint32_t>(data.size());
+        char header[5] = {static_cast<char>(type),
+                          static_cast<char>(length), static_cast<char>(length >> 8),
+                          static_cast<char>(length >> 16), static_cast<char>(length >> 24)};
+        return sendAll(fd, header, sizeof header) && sendAll(fd, data.data(), data.size());
+    }
+
+    bool DaemonProtocol::readFrame(int fd, Frame& type, std::string& data, uint32_t maxSize) {
+        unsigned char header[5];
+        if (!receiveAll(fd, reinterpret_cast<char*>(header), sizeof header)) {
+            return false;
+        }
+        uint32_t length = header[1] | (header[2] << 8) | (header[3] << 16) | (static_cast<uint32_t>(header[4]) << 24);
+        if (length > maxSize) {
+            return false;
+        }
+        type = static_cast<Frame>(header[0]);
+        data.resize(length);
+        return receiveAll(fd, data.data(), length);
+    }
+
+    std::string DaemonProtocol::encodeRequest(const Request& request) {
+        BinaryWriter out;
+        out.writeVarint(Version);
+        out.writeString(request.workingDirectory);
+        out.writeVarint(request.arguments.size());
+        for (const std::string& argument : request.arguments) {
+            out.writeString(argument);
+        }
+        return out.buffer();
+    }
+
+    bool DaemonProtocol::decodeRequest(std::string_view data, Request& request, std::string& error) {
+        BinaryReader in(data);
+        uint64_t version = in.readVarint();
+        if (in.ok() && version != Version) {
+            error = "umbra-client speaks protocol " + std::to_string(version) + ", this daemon speaks " +
+                    std::to_string(Version) + "; restart the daemon";
+            return false;
+        }
+        request.workingDirectory = in.readString();
+        uint64_t count = in.readVarint();
+        for (uint64_t i = 0; i < count && in.ok(); ++i) {
+            request.arguments.push_back(in.readString());
+        }
+        if (!in.ok() || !in.atEnd()) {
+            error = "malformed request";
+            return false;
+        }
+        return true;
+    }
+
+} // namespace umbra
@@ -0,0 +1,195 @@
+#include "umbra/ast/ASTSerializer.h"
+#include "umbra/ast/PrintASTVisitor.h"
+#include "umbra/error/ErrorManager.h"
+#include "umbra/lexer/Lexer.h"
+#include "umbra/parser/Parser.h"
+#include "umbra/semantic/ConstantFolder.h"
+#include "umbra/semantic/SemanticAnalyzer.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Programa con lo que el análisis deja en el AST: tipos resueltos, slices, ref, constfunc y
+// un repeat paralelo con reducciones
+const char* kProgram = R"(constfunc square(int n) -> int {
+    return n * n
+}
+
+func scale(double []v, double factor) -> void {
+    int i = 0
+    repeat 4 times {
+        v[i] = v[i] * factor
+        i = i + 1
+    }
+}
+
+func bump(ref long counter, int by) -> void {
+    counter = counter + by
+}
+
+func start() -> void {
+    const int SIZE = square(3)
+    double [SIZE]values
+    long total = 0
+    int top = 0
+    repeat SIZE times in parallel as i reduce(+: total, max: top) {
+        total = total + i
+        if (i > top) {
+            top = i
+        }
+    }
+    scale(values, 2.5)
+    bump(total, 3)
+    float f = 1.5e2
+    print("total={} top={} f={}", total, top, f)
+}
+)";
+
+// Lexer, parser, análisis semántico y plegado de constantes, como Compiler
+std::unique_ptr<ProgramNode> checkedProgram(const std::string& source, ErrorManager& errors) {
+    Lexer lexer(source, errors);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+    Parser parser(tokens, errors);
+    std::unique_ptr<ProgramNode> program = parser.parseProgram();
+    if (!program || errors.hasErrors()) return nullptr;
+    SemanticAnalyzer analyzer(errors, program.get());
+    analyzer.execAnalysisPipeline();
+    std::ostringstream warnings;
+    ConstantFolder folder(errors, warnings);
+    folder.fold(program.get());
+    return errors.hasErrors() ? nullptr : std::move(program);
+}
+
+std::string printed(ProgramNode& program) {
+    std::ostringstream out;
+    Printer printer(out);
+    printer.visitProgramNode(program);
+    return out.str();
+}
+
+FunctionDefinition* findFunction(ProgramNode& program, const std::string& name) {
+    for (auto& function : program.functions) {
+        if (function->name->name == name) return function.get();
+    }
+    return nullptr;
+}
+
+template <typename T>
+T* findStatement(FunctionDefinition& function) {
+    for (auto& stmt : function.body) {
+        if (auto* found = dynamic_cast<T*>(stmt.get())) return found;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// Serializar y leer de vuelta conserva la estructura y lo que dejaron las fases de análisis
+TEST(ASTSerializerTest, RoundTripCheckedProgram) {
+    ErrorManager errors;
+    std::unique_ptr<ProgramNode> original = checkedProgram(kProgram, errors);
+    ASSERT_TRUE(original) << errors.getErrorReport();
+
+    std::string data = ASTSerializer::serialize(*original, 42);
+    std::string error;
+    std::unique_ptr<ProgramNode> restored = ASTSerializer::deserialize(data, error, 42);
+    ASSERT_TRUE(restored) << error;
+
+    EXPECT_EQ(printed(*restored), printed(*original));
+    EXPECT_EQ(ASTSerializer::serialize(*restored, 42), data); // Nada se pierde en el camino
+
+    FunctionDefinition* square = findFunction(*restored, "square");
+    ASSERT_TRUE(square);
+    EXPECT_TRUE(square->isConstFunc);
+    EXPECT_TRUE(square->Signature.isConstFunc);
+    EXPECT_EQ(square->Signature.returnType, SemanticType::Int);
+
+    FunctionDefinition* scale = findFunction(*restored, "scale");
+    ASSERT_TRUE(scale);
+    EXPECT_EQ(scale->Signature.argArrayDims, (std::vector<int>{1, 0}));
+    EXPECT_EQ(scale->Signature.argTypes, (std::vector<SemanticType>{SemanticType::Double, SemanticType::Double}));
+
+    FunctionDefinition* bump = findFunction(*restored, "bump");
+    ASSERT_TRUE(bump);
+    EXPECT_EQ(bump->Signature.argByReference, (std::vector<bool>{true, false}));
+    EXPECT_TRUE(bump->parameters->parameters[0].first->isReference);
+
+    FunctionDefinition* start = findFunction(*restored, "start");
+    ASSERT_TRUE(start);
+    auto* parallel = findStatement<RepeatTimesStatement>(*start);
+    ASSERT_TRUE(parallel);
+    EXPECT_TRUE(parallel->parallel);
+    ASSERT_TRUE(parallel->indexVar);
+    EXPECT_EQ(parallel->indexVar->name, "i");
+    ASSERT_EQ(parallel->reductions.size(), 2u);
+    EXPECT_EQ(parallel->reductions[0].op, "+");
+    EXPECT_EQ(parallel->reductions[0].target->name, "total");
+    EXPECT_EQ(parallel->reductions[1].op, "max");
+    EXPECT_EQ(parallel->reductions[1].target->name, "top");
+
+    // Tipos que el análisis resolvió en llamadas e identificadores
+    std::vector<FunctionCall*> calls;
+    for (auto& stmt : start->body) {
+        auto* expression = dynamic_cast<ExpressionStatement*>(stmt.get());
+        if (auto* call = expression ? dynamic_cast<FunctionCall*>(expression->exp.get()) : nullptr) {
+            calls.push_back(call);
+        }
+    }
+    ASSERT_EQ(calls.size(), 3u);
+    EXPECT_EQ(calls[1]->functionName->name, "bump");
+    EXPECT_EQ(calls[1]->semaT, SemanticType::Void);
+    EXPECT_EQ(calls[1]->argTypes, (std::vector<SemanticType>{SemanticType::Long, SemanticType::Int}));
+    FunctionCall* print = calls[2];
+    ASSERT_EQ(print->arguments.size(), 4u);
+    EXPECT_EQ(print->arguments[1]->semaT, SemanticType::Long);
+    EXPECT_EQ(print->arguments[3]->semaT, SemanticType::Float);
+}
+
+// Cualquier prefijo del archivo se rechaza con un motivo, sin leer fuera de los datos
+TEST(ASTSerializerTest, RejectsTruncatedData) {
+    ErrorManager errors;
+    std::unique_ptr<ProgramNode> program = checkedProgram(kProgram, errors);
+    ASSERT_TRUE(program) << errors.getErrorReport();
+    std::string data = ASTSerializer::serialize(*program, 7);
+
+    for (size_t length = 0; length < data.size(); ++length) {
+        std::string error;
+        EXPECT_FALSE(ASTSerializer::deserialize(std::string_view(data).substr(0, length), error))
+            << "prefix of " << length << " bytes";
+        EXPECT_FALSE(error.empty());
+    }
+}
+
+// Otra versión del formato u otro hash de las fuentes: no se decodifica
+TEST(ASTSerializerTest, RejectsOtherVersionOrSourceHash) {
+    ErrorManager errors;
+    std::unique_ptr<ProgramNode> program = checkedProgram(kProgram, errors);
+    ASSERT_TRUE(program) << errors.getErrorReport();
+    std::string data = ASTSerializer::serialize(*program, 7);
+
+    // La versión es el varint que sigue a la firma "UMBA"
+    std::string otherVersion = data;
+    ASSERT_EQ(static_cast<unsigned char>(otherVersion[4]), ASTSerializer::FormatVersion);
+    otherVersion[4] = static_cast<char>(ASTSerializer::FormatVersion + 1);
+    std::string error;
+    EXPECT_FALSE(ASTSerializer::deserialize(otherVersion, error));
+    EXPECT_FALSE(error.empty());
+
+    error.clear();
+    EXPECT_FALSE(ASTSerializer::deserialize(data, error, 8));
+    EXPECT_FALSE(error.empty());
+
+    error.clear();
+    EXPECT_TRUE(ASTSerializer::deserialize(data, error, 7)) << error;
+}
+
+} // namespace umbra
+
+} // namespace umbra
@@ -0,0 +1,106 @@
+#include "umbra/codegen/context/CodegenContext.h"
+#include "umbra/codegen/visitors/CodegenVisitor.h"
+#include "umbra/error/ErrorManager.h"
+#include "umbra/lexer/Lexer.h"
+#include "umbra/parser/Parser.h"
+#include "umbra/semantic/ConstantFolder.h"
+#include "umbra/semantic/SemanticAnalyzer.h"
+#include <gtest/gtest.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/raw_ostream.h>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Fases del compilador hasta el módulo LLVM, sin optimizarlo
+std::unique_ptr<CodegenContext> generate(const std::string& source, ErrorManager& errors) {
+    Lexer lexer(source, errors);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+    Parser parser(tokens, errors);
+    std::unique_ptr<ProgramNode> program = parser.parseProgram();
+    if (!program || errors.hasErrors()) return nullptr;
+    SemanticAnalyzer analyzer(errors, program.get());
+    analyzer.execAnalysisPipeline();
+    std::ostringstream warnings;
+    ConstantFolder folder(errors, warnings);
+    folder.fold(program.get());
+    if (errors.hasErrors()) return nullptr;
+
+    auto context = std::make_unique<CodegenContext>("codegen_test");
+    code_gen::CodegenVisitor visitor(*context);
+    visitor.visit(program.get());
+    return context;
+}
+
+// Mensajes del verificador de LLVM; vacío si el módulo es válido
+std::string verify(CodegenContext& context) {
+    std::string message;
+    llvm::raw_string_ostream out(message);
+    if (!llvm::verifyModule(context.llvmModule, &out)) return "";
+    out.flush();
+    return message.empty() ? "invalid module" : message;
+}
+
+// IR textual del módulo
+std::string printModule(CodegenContext& context) {
+    std::string text;
+    llvm::raw_string_ostream out(text);
+    context.llvmModule.print(out, nullptr);
+    out.flush();
+    return text;
+}
+
+} // namespace
+
+// Literales de distinto largo comparten la firma i8* de umbra_print_str (punteros tipados de LLVM 14)
+TEST(CodegenTest, StringLiteralsOfDifferentLengthsVerify) {
+    ErrorManager errors;
+    std::unique_ptr<CodegenContext> context = generate(R"(func start() -> void {
+    int x = 3
+    print("hi")
+    print("a longer literal: {}", x)
+    string s = "from a variable"
+    print("{} {}", s, "inline")
+}
+)", errors);
+    ASSERT_TRUE(context) << errors.getErrorReport();
+    EXPECT_EQ(verify(*context), "");
+}
+
+// Los literales enteros no pasan por double: 2^53 + 1 y el máximo de long llegan exactos al IR
+TEST(CodegenTest, LongLiteralsAreExact) {
+    ErrorManager errors;
+    std::unique_ptr<CodegenContext> context = generate(R"(func start() -> void {
+    long odd = 9007199254740993
+    long top = 9223372036854775807
+    print("{} {}", odd, top)
+}
+)", errors);
+    ASSERT_TRUE(context) << errors.getErrorReport();
+    std::string ir = printModule(*context);
+    EXPECT_NE(ir.find("i64 9007199254740993"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("i64 9223372036854775807"), std::string::npos) << ir;
+}
+
+TEST(CodegenTest, OverflowingIntegerLiteralIsDiagnosed) {
+    ErrorManager errors;
+    std::unique_ptr<CodegenContext> context = generate(R"(func start() -> void {
+    long big = 9223372036854775808
+    print("{}", big)
+}
+)", errors);
+    EXPECT_FALSE(context);
+    ASSERT_EQ(errors.getErrorCount(), 1u);
+    EXPECT_NE(errors.getErrorReport().find("fuera del rango de long"), std::string::npos) << errors.getErrorReport();
+}
+
+} // namespace umbra
+
+} // namespace umbra
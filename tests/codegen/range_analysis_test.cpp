@@ -0,0 +1,69 @@
+#include "umbra/codegen/analysis/RangeAnalysis.h"
+#include "umbra/error/ErrorManager.h"
+#include "umbra/lexer/Lexer.h"
+#include "umbra/parser/Parser.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Programa parseado con el índice de cada asignación `a[...] = v` de start, en orden
+struct Accesses {
+    ErrorManager errors;
+    std::unique_ptr<ProgramNode> program;
+    FunctionDefinition* start = nullptr;
+    std::vector<ArrayAccessExpression*> targets;
+
+    explicit Accesses(const std::string& source) {
+        Lexer lexer(source, errors);
+        std::vector<Lexer::Token> tokens = lexer.tokenize();
+        Parser parser(tokens, errors);
+        program = parser.parseProgram();
+        if (!program) return;
+        for (auto& function : program->functions) {
+            if (function->name->name == "start") start = function.get();
+        }
+        if (!start) return;
+        for (auto& stmt : start->body) {
+            auto* assignment = dynamic_cast<AssignmentStatement*>(stmt.get());
+            if (!assignment) continue;
+            if (auto* access = dynamic_cast<ArrayAccessExpression*>(assignment->target.get())) {
+                targets.push_back(access);
+            }
+        }
+    }
+};
+
+} // namespace
+
+// Un producto que desborda int64_t deja el índice sin rango, en lugar de envolver a un valor válido
+TEST(RangeAnalysisTest, OverflowingProductIsUntracked) {
+    Accesses accesses(R"(func start() -> void {
+    int [10]a
+    a[3] = 1
+    a[1073741824 * 512 * 1073741824] = 2
+}
+)");
+    ASSERT_FALSE(accesses.errors.hasErrors()) << accesses.errors.getErrorReport();
+    ASSERT_TRUE(accesses.start);
+    ASSERT_EQ(accesses.targets.size(), 2u);
+
+    code_gen::IndexRangeAnalysis analysis;
+    analysis.analyzeFunction(accesses.start);
+
+    auto literal = analysis.staticRange(accesses.targets[0]);
+    ASSERT_TRUE(literal);
+    EXPECT_EQ(literal->lo, 3);
+    EXPECT_EQ(literal->hi, 3);
+    EXPECT_FALSE(analysis.staticRange(accesses.targets[1]));
+}
+
+} // namespace umbra
+
+} // namespace umbra
@@ -0,0 +1,110 @@
+#include "umbra/compiler/FunctionCache.h"
+#include "umbra/error/ErrorManager.h"
+#include "umbra/io/SourceBuffer.h"
+#include "umbra/io/SourceMap.h"
+#include "umbra/lexer/Lexer.h"
+#include "umbra/parser/Parser.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Claves de --incremental por nombre de función
+std::map<std::string, uint64_t> keysOf(const std::string& source) {
+    std::unique_ptr<SourceBuffer> buffer = SourceBuffer::fromString("main.umbra", source);
+    SourceMap sourceMap;
+    sourceMap.append(*buffer, 0, buffer->text().size());
+
+    ErrorManager errors;
+    Lexer lexer(sourceMap, errors);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+    Parser parser(tokens, errors);
+    std::unique_ptr<ProgramNode> program = parser.parseProgram();
+    EXPECT_TRUE(program && !errors.hasErrors()) << errors.getErrorReport();
+
+    std::map<std::string, uint64_t> keys;
+    if (!program) return keys;
+    std::vector<FunctionCache::FunctionKey> computed =
+        FunctionCache::computeKeys(*program, tokens, sourceMap, 1, false);
+    for (size_t i = 0; i < computed.size(); ++i) {
+        EXPECT_TRUE(computed[i].cacheable) << program->functions[i]->name->name;
+        keys[program->functions[i]->name->name] = computed[i].key;
+    }
+    return keys;
+}
+
+const char* kHelper = R"(func helper(int x) -> int {
+    return x + 1
+}
+)";
+
+const char* kEditedHelper = R"(func helper(int x) -> int {
+    return x + 2
+}
+)";
+
+const char* kCaller = R"(func caller() -> int {
+    return helper(41)
+}
+)";
+
+const char* kStart = R"(func start() -> void {
+    print("{}", caller())
+}
+)";
+
+} // namespace
+
+// El objeto de quien llama solo depende de la firma de la función llamada
+TEST(FunctionCacheTest, EditingCalleeBodyKeepsCallerKey) {
+    auto before = keysOf(std::string(kHelper) + kCaller + kStart);
+    auto after = keysOf(std::string(kEditedHelper) + kCaller + kStart);
+
+    EXPECT_NE(before["helper"], after["helper"]);
+    EXPECT_EQ(before["caller"], after["caller"]);
+    EXPECT_EQ(before["start"], after["start"]);
+}
+
+// Cambiar la firma sí invalida a quien llama
+TEST(FunctionCacheTest, EditingCalleeSignatureChangesCallerKey) {
+    auto before = keysOf(std::string(kHelper) + kCaller + kStart);
+    auto after = keysOf(std::string("func helper(long x) -> int {\n    return 1\n}\n") + kCaller + kStart);
+
+    EXPECT_NE(before["caller"], after["caller"]);
+    EXPECT_EQ(before["start"], after["start"]);
+}
+
+// ConstantFolder evalúa las constfunc en quien llama: su cuerpo forma parte de la clave,
+// también el de las constfunc que usa a su vez
+TEST(FunctionCacheTest, EditingConstfuncChangesCallerKey) {
+    const char* twice = "constfunc twice(int x) -> int {\n    return x * 2\n}\n";
+    const char* editedTwice = "constfunc twice(int x) -> int {\n    return x * 3\n}\n";
+    std::string helper = "constfunc helper(int x) -> int {\n    return twice(x) + 1\n}\n";
+
+    auto before = keysOf(twice + helper + kCaller + kStart);
+    auto after = keysOf(editedTwice + helper + kCaller + kStart);
+
+    EXPECT_NE(before["twice"], after["twice"]);
+    EXPECT_NE(before["helper"], after["helper"]);
+    EXPECT_NE(before["caller"], after["caller"]);
+    EXPECT_EQ(before["start"], after["start"]); // caller no es constfunc
+}
+
+// Las claves no dependen del orden de las funciones en el archivo
+TEST(FunctionCacheTest, ReorderingFunctionsKeepsKeys) {
+    auto before = keysOf(std::string(kHelper) + kCaller + kStart);
+    auto after = keysOf(std::string(kStart) + kCaller + kHelper);
+
+    EXPECT_EQ(before, after);
+}
+
+} // namespace umbra
+
+} // namespace umbra
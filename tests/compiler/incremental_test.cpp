@@ -0,0 +1,112 @@
+#include "umbra/compiler/Compiler.h"
+#include "umbra/error/ErrorManager.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Directorio temporal propio de cada prueba, borrado al terminar
+class TempDirectory {
+public:
+    TempDirectory() {
+        path = std::filesystem::temp_directory_path() /
+               ("umbra_incremental_" + std::to_string(::getpid()) + "_" + std::to_string(counter++));
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    std::filesystem::path path;
+
+private:
+    static inline int counter = 0;
+};
+
+std::string program(const std::string& factor) {
+    return "func twice(int x) -> int {\n    return x * " + factor + "\n}\n\n"
+           "func offset(int x) -> int {\n    return x + 100\n}\n\n"
+           "func start() -> void {\n    print(\"value={} name={}\", offset(twice(21)), \"incremental\")\n}\n";
+}
+
+// `umbra --incremental main.umbra` dentro de dir; deja lo que escribió la compilación en log
+bool compileIncremental(const std::filesystem::path& dir, std::string& log) {
+    UmbraCompilerOptions options;
+    options.inputFilePath = (dir / "main.umbra").string();
+    options.outputIRFile = (dir / "umbra_ir.ll").string();
+    options.outputExecName = (dir / "umbra_output").string();
+    options.incremental = true;
+
+    ErrorManager errors;
+    std::ostringstream out, err;
+    bool compiled = Compiler(options, errors, out, err).compile();
+    log = out.str() + err.str() + (errors.hasErrors() ? errors.getErrorReport() : "");
+    return compiled && !errors.hasErrors();
+}
+
+std::string run(const std::filesystem::path& executable) {
+    std::string output;
+    if (std::FILE* pipe = ::popen(executable.c_str(), "r")) {
+        std::array<char, 256> chunk;
+        size_t n;
+        while ((n = std::fread(chunk.data(), 1, chunk.size(), pipe)) > 0) output.append(chunk.data(), n);
+        ::pclose(pipe);
+    }
+    return output;
+}
+
+// Objetos de main.ufc/ con su fecha de modificación
+std::map<std::string, std::filesystem::file_time_type> objects(const std::filesystem::path& dir) {
+    std::map<std::string, std::filesystem::file_time_type> found;
+    for (const auto& entry : std::filesystem::directory_iterator(dir / "main.ufc")) {
+        found[entry.path().filename().string()] = entry.last_write_time();
+    }
+    return found;
+}
+
+} // namespace
+
+// Compila, enlaza y ejecuta un programa con print; al editar una función solo se regenera su objeto
+TEST(IncrementalTest, RebuildsOnlyTheEditedFunction) {
+    TempDirectory dir;
+    std::ofstream(dir.path / "main.umbra") << program("2");
+
+    std::string log;
+    ASSERT_TRUE(compileIncremental(dir.path, log)) << log;
+    EXPECT_NE(log.find("Rebuilt 3 of 3 functions"), std::string::npos) << log;
+    EXPECT_EQ(run(dir.path / "umbra_output"), "value=142 name=incremental\n");
+    auto before = objects(dir.path);
+    ASSERT_EQ(before.size(), 3u);
+
+    std::ofstream(dir.path / "main.umbra") << program("3");
+    ASSERT_TRUE(compileIncremental(dir.path, log)) << log;
+    EXPECT_NE(log.find("Rebuilt 1 of 3 functions"), std::string::npos) << log;
+    EXPECT_EQ(run(dir.path / "umbra_output"), "value=163 name=incremental\n");
+
+    auto after = objects(dir.path);
+    ASSERT_EQ(after.size(), 3u);
+    for (const auto& [name, time] : after) {
+        if (name.rfind("twice-", 0) == 0) {
+            EXPECT_EQ(before.count(name), 0u) << name; // Clave nueva
+        } else {
+            ASSERT_EQ(before.count(name), 1u) << name;
+            EXPECT_EQ(before[name], time) << name << " was rewritten";
+        }
+    }
+}
+
+} // namespace umbra
+
+} // namespace umbra
@@ -0,0 +1,119 @@
+#include "umbra/io/SourceCache.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Directorio temporal propio de cada prueba, borrado al terminar
+class TempDirectory {
+public:
+    TempDirectory() {
+        path = std::filesystem::temp_directory_path() /
+               ("umbra_source_cache_" + std::to_string(::getpid()) + "_" + std::to_string(counter++));
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    std::filesystem::path write(const std::string& name, const std::string& content) const {
+        std::filesystem::path file = path / name;
+        std::ofstream(file, std::ios::binary) << content;
+        return file;
+    }
+
+    std::filesystem::path path;
+
+private:
+    static inline int counter = 0;
+};
+
+} // namespace
+
+// Un archivo sin cambios se sirve con el mismo buffer
+TEST(SourceCacheTest, ReusesUnchangedFile) {
+    TempDirectory dir;
+    std::filesystem::path file = dir.write("a.umbra", "int x = 1");
+    SourceCache cache;
+    std::string error;
+
+    auto first = cache.load(file, error);
+    auto second = cache.load(file, error);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->text(), "int x = 1");
+}
+
+// Guardar escribiendo otro archivo y renombrándolo cambia el inodo: la entrada vieja se olvida
+TEST(SourceCacheTest, ForgetsReplacedInode) {
+    TempDirectory dir;
+    std::filesystem::path file = dir.write("a.umbra", "int x = 1");
+    SourceCache cache;
+    std::string error;
+
+    auto before = cache.load(file, error);
+    ASSERT_TRUE(before);
+    size_t oneFile = cache.getSize();
+
+    std::filesystem::path replacement = dir.write("a.umbra.tmp", "int x = 2");
+    std::filesystem::rename(replacement, file);
+    auto after = cache.load(file, error);
+    ASSERT_TRUE(after);
+    EXPECT_EQ(after->text(), "int x = 2");
+    EXPECT_EQ(before->text(), "int x = 1"); // Quien tenía el buffer lo conserva
+    EXPECT_EQ(cache.getSize(), oneFile);
+}
+
+// Al superar la capacidad se olvida primero el archivo usado hace más tiempo
+TEST(SourceCacheTest, EvictsLeastRecentlyUsed) {
+    TempDirectory dir;
+    std::filesystem::path a = dir.write("a.umbra", std::string(1000, 'a'));
+    std::filesystem::path b = dir.write("b.umbra", std::string(1000, 'b'));
+    std::filesystem::path c = dir.write("c.umbra", std::string(1000, 'c'));
+    SourceCache cache;
+    std::string error;
+
+    auto bufferA = cache.load(a, error);
+    size_t oneFile = cache.getSize();
+    cache.setCapacity(2 * oneFile + 100);
+    auto bufferB = cache.load(b, error);
+    EXPECT_EQ(cache.load(a, error), bufferA); // a pasa a ser el más reciente
+    cache.load(c, error);                     // sale b
+
+    EXPECT_LE(cache.getSize(), 2 * oneFile + 100);
+    EXPECT_EQ(cache.load(a, error), bufferA);
+    EXPECT_NE(cache.load(b, error), bufferB);
+
+    cache.setCapacity(0);
+    EXPECT_EQ(cache.getSize(), 0u);
+}
+
+// Sin mmap el contenido vive en memoria del buffer: truncar el archivo no lo afecta
+TEST(SourceCacheTest, ReadsIntoOwnedMemoryWhenNotMapping) {
+    TempDirectory dir;
+    std::filesystem::path file = dir.write("a.umbra", std::string(8192, 'x'));
+    SourceCache cache;
+    cache.setMapFiles(false);
+    std::string error;
+
+    auto buffer = cache.load(file, error);
+    ASSERT_TRUE(buffer);
+    EXPECT_FALSE(buffer->isMapped());
+
+    std::filesystem::resize_file(file, 0);
+    EXPECT_EQ(buffer->text().size(), 8192u);
+    EXPECT_EQ(buffer->text().back(), 'x');
+}
+
+} // namespace umbra
+
+} // namespace umbra
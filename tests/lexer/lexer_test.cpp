@@ -187,6 +187,86 @@ TEST(LexerTest, TokenizeExpressionsWithoutSpaces) {
     EXPECT_EQ(tokens[10].type, TokenType::TOK_EOF);          // EOF
 }
 
+// Prueba de tipos vectoriales SIMD
+TEST(LexerTest, TokenizeVectorTypes) {
+    std::string source = "vec4 float v = splat4(1.0) vec8 int vec4x";
+    Lexer lexer(source);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 12); // 11 tokens + EOF
+
+    EXPECT_EQ(tokens[0].type, TokenType::TOK_VEC4);          // 'vec4'
+    EXPECT_EQ(tokens[1].type, TokenType::TOK_FLOAT);         // 'float'
+    EXPECT_EQ(tokens[2].type, TokenType::TOK_IDENTIFIER);    // 'v'
+    EXPECT_EQ(tokens[4].type, TokenType::TOK_IDENTIFIER);    // 'splat4' (builtin, no palabra clave)
+    EXPECT_EQ(tokens[8].type, TokenType::TOK_VEC8);          // 'vec8'
+    EXPECT_EQ(tokens[9].type, TokenType::TOK_INT);           // 'int'
+    EXPECT_EQ(tokens[10].type, TokenType::TOK_IDENTIFIER);   // 'vec4x'
+    EXPECT_EQ(tokens[11].type, TokenType::TOK_EOF);          // EOF
+}
+
+TEST(LexerTest, TokenizeConstKeywords) {
+    std::string source = "constfunc const constant";
+    Lexer lexer(source);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 4); // 3 tokens + EOF
+
+    EXPECT_EQ(tokens[0].type, TokenType::TOK_CONSTFUNC);     // 'constfunc'
+    EXPECT_EQ(tokens[1].type, TokenType::TOK_CONST);         // 'const'
+    EXPECT_EQ(tokens[2].type, TokenType::TOK_IDENTIFIER);    // 'constant'
+    EXPECT_EQ(tokens[3].type, TokenType::TOK_EOF);           // EOF
+}
+
+TEST(LexerTest, TokenizeLongDoubleKeywords) {
+    std::string source = "long double longer doubles";
+    Lexer lexer(source);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 5); // 4 tokens + EOF
+
+    EXPECT_EQ(tokens[0].type, TokenType::TOK_LONG);          // 'long'
+    EXPECT_EQ(tokens[1].type, TokenType::TOK_DOUBLE);        // 'double'
+    EXPECT_EQ(tokens[2].type, TokenType::TOK_IDENTIFIER);    // 'longer'
+    EXPECT_EQ(tokens[3].type, TokenType::TOK_IDENTIFIER);    // 'doubles'
+    EXPECT_EQ(tokens[4].type, TokenType::TOK_EOF);           // EOF
+}
+
+TEST(LexerTest, TokenizeExponentLiterals) {
+    // El parser tipa como Float todo literal cuyo lexema tiene '.', 'e' o 'E'
+    std::string source = "double d = 1e5 + 2.5E-3 * 4e+2";
+    Lexer lexer(source);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 9); // 8 tokens + EOF
+
+    EXPECT_EQ(tokens[0].type, TokenType::TOK_DOUBLE);        // 'double'
+    EXPECT_EQ(tokens[3].type, TokenType::TOK_NUMBER);        // '1e5'
+    EXPECT_EQ(tokens[3].lexeme, "1e5");
+    EXPECT_EQ(tokens[4].type, TokenType::TOK_ADD);           // '+'
+    EXPECT_EQ(tokens[5].type, TokenType::TOK_NUMBER);        // '2.5E-3'
+    EXPECT_EQ(tokens[5].lexeme, "2.5E-3");
+    EXPECT_EQ(tokens[6].type, TokenType::TOK_MULT);          // '*'
+    EXPECT_EQ(tokens[7].type, TokenType::TOK_NUMBER);        // '4e+2'
+    EXPECT_EQ(tokens[7].lexeme, "4e+2");
+    EXPECT_EQ(tokens[8].type, TokenType::TOK_EOF);           // EOF
+}
+
+TEST(LexerTest, TokenizeInlineKeywords) {
+    std::string source = "inline func f() -> int noinline inlined";
+    Lexer lexer(source);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+
+    ASSERT_EQ(tokens.size(), 10); // 9 tokens + EOF
+
+    EXPECT_EQ(tokens[0].type, TokenType::TOK_INLINE);        // 'inline'
+    EXPECT_EQ(tokens[1].type, TokenType::TOK_FUNC);          // 'func'
+    EXPECT_EQ(tokens[2].type, TokenType::TOK_IDENTIFIER);    // 'f'
+    EXPECT_EQ(tokens[7].type, TokenType::TOK_NOINLINE);      // 'noinline'
+    EXPECT_EQ(tokens[8].type, TokenType::TOK_IDENTIFIER);    // 'inlined'
+    EXPECT_EQ(tokens[9].type, TokenType::TOK_EOF);           // EOF
+}
+
 } // namespace umbra
 
 } // namespace umbra
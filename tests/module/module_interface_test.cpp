@@ -0,0 +1,136 @@
+#include "umbra/io/ContentHash.h"
+#include "umbra/module/ModuleInterface.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Directorio temporal propio de cada prueba, borrado al terminar
+class TempDirectory {
+public:
+    TempDirectory() {
+        path = std::filesystem::temp_directory_path() /
+               ("umbra_module_" + std::to_string(::getpid()) + "_" + std::to_string(counter++));
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    std::filesystem::path write(const std::string& name, const std::string& content) const {
+        std::filesystem::path file = path / name;
+        std::ofstream(file, std::ios::binary) << content;
+        return file;
+    }
+
+    std::filesystem::path path;
+
+private:
+    static inline int counter = 0;
+};
+
+const char* kLibrary = "func add(int a, int b) -> int {\n    return a + b\n}\n";
+
+// Interfaz de lib.umbra con su objeto y una función de cada clase de parámetro
+ModuleInterface makeInterface(const TempDirectory& dir) {
+    ModuleInterface module;
+    module.targetTriple = "x86_64-pc-linux-gnu";
+    module.objectFile = dir.write("lib.o", "objeto").string();
+    module.sources.push_back({dir.write("lib.umbra", kLibrary).string(), hashContent(kLibrary)});
+    module.imports.push_back((dir.path / "base.umbra").string());
+
+    ModuleInterface::Function add;
+    add.name = "add";
+    add.signature.returnType = SemanticType::Int;
+    add.signature.argTypes = {SemanticType::Int, SemanticType::Int};
+    add.signature.argArrayDims = {0, 0};
+    add.signature.argByReference = {false, false};
+    add.signature.argPointeeTypes = {SemanticType::None, SemanticType::None};
+    module.functions.push_back(add);
+
+    ModuleInterface::Function fill;
+    fill.name = "fill";
+    fill.signature.returnType = SemanticType::Void;
+    fill.signature.isConstFunc = true;
+    fill.signature.argTypes = {SemanticType::Double, SemanticType::Long, SemanticType::Ptr};
+    fill.signature.argArrayDims = {2, 0, 0};
+    fill.signature.argByReference = {false, true, false};
+    fill.signature.argPointeeTypes = {SemanticType::None, SemanticType::None, SemanticType::Float};
+    module.functions.push_back(fill);
+    return module;
+}
+
+} // namespace
+
+// Lo que se escribe en el .umi se lee igual
+TEST(ModuleInterfaceTest, WriteReadRoundTrip) {
+    TempDirectory dir;
+    ModuleInterface module = makeInterface(dir);
+    std::filesystem::path path = ModuleInterface::interfacePathFor(dir.path / "lib.umbra");
+    EXPECT_EQ(path.filename(), "lib.umi");
+
+    std::string error;
+    ASSERT_TRUE(module.write(path, error)) << error;
+    std::optional<ModuleInterface> read = ModuleInterface::read(path, error);
+    ASSERT_TRUE(read) << error;
+
+    EXPECT_EQ(read->targetTriple, module.targetTriple);
+    EXPECT_EQ(read->objectFile, module.objectFile);
+    ASSERT_EQ(read->sources.size(), 1u);
+    EXPECT_EQ(read->sources[0].path, module.sources[0].path);
+    EXPECT_EQ(read->sources[0].hash, module.sources[0].hash);
+    EXPECT_EQ(read->imports, module.imports);
+    ASSERT_EQ(read->functions.size(), 2u);
+    for (size_t i = 0; i < module.functions.size(); ++i) {
+        const FunctionSignature& expected = module.functions[i].signature;
+        const FunctionSignature& actual = read->functions[i].signature;
+        EXPECT_EQ(read->functions[i].name, module.functions[i].name);
+        EXPECT_EQ(actual.returnType, expected.returnType);
+        EXPECT_EQ(actual.isVarArg, expected.isVarArg);
+        EXPECT_EQ(actual.isConstFunc, expected.isConstFunc);
+        EXPECT_EQ(actual.argTypes, expected.argTypes);
+        EXPECT_EQ(actual.argArrayDims, expected.argArrayDims);
+        EXPECT_EQ(actual.argByReference, expected.argByReference);
+        EXPECT_EQ(actual.argPointeeTypes, expected.argPointeeTypes);
+    }
+}
+
+// Una interfaz truncada se rechaza en lugar de devolver firmas a medias
+TEST(ModuleInterfaceTest, RejectsTruncatedInterface) {
+    TempDirectory dir;
+    std::filesystem::path path = dir.path / "lib.umi";
+    std::string error;
+    ASSERT_TRUE(makeInterface(dir).write(path, error)) << error;
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    EXPECT_FALSE(ModuleInterface::read(path, error));
+    EXPECT_FALSE(error.empty());
+}
+
+// Si cambia un fuente del módulo o falta su objeto, la interfaz deja de servir
+TEST(ModuleInterfaceTest, IsUpToDateDetectsStaleSource) {
+    TempDirectory dir;
+    ModuleInterface module = makeInterface(dir);
+    EXPECT_TRUE(module.isUpToDate());
+
+    dir.write("lib.umbra", "func add(int a, int b) -> int {\n    return a - b\n}\n// editado\n");
+    EXPECT_FALSE(module.isUpToDate());
+
+    dir.write("lib.umbra", kLibrary);
+    EXPECT_TRUE(module.isUpToDate());
+
+    std::filesystem::remove(module.objectFile);
+    EXPECT_FALSE(module.isUpToDate());
+}
+
+} // namespace umbra
+
+} // namespace umbra
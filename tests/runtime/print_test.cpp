@@ -0,0 +1,61 @@
+#include "umbra/runtime/umbra_rt.h"
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <unistd.h>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Lo que print escribe en stdout (fd 1) mientras corre body
+std::string captureStdout(const std::function<void()>& body) {
+    std::FILE* file = std::tmpfile();
+    int saved = ::dup(STDOUT_FILENO);
+    ::dup2(::fileno(file), STDOUT_FILENO);
+    body();
+    umbra_rt_flush();
+    ::dup2(saved, STDOUT_FILENO);
+    ::close(saved);
+
+    std::string text;
+    std::rewind(file);
+    char chunk[512];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof chunk, file)) > 0) text.append(chunk, n);
+    std::fclose(file);
+    return text;
+}
+
+std::string printfFixed(double value) {
+    char text[400];
+    std::snprintf(text, sizeof text, "%f", value);
+    return text;
+}
+
+} // namespace
+
+// Doubles en el camino rápido: mismo texto que printf("%f")
+TEST(RuntimePrintTest, DoublesMatchPrintf) {
+    for (double value : {0.0, -0.0, 1.5, -2.25, 0.1, 1234567.0000005, 999999999999.9999}) {
+        EXPECT_EQ(captureStdout([&] { umbra_print_f64(value); }), printfFixed(value)) << value;
+    }
+}
+
+// Los valores enormes no se truncan: 1e300 lleva sus 301 dígitos y ".000000"
+TEST(RuntimePrintTest, HugeDoublesAreNotTruncated) {
+    for (double value : {1e300, -DBL_MAX, DBL_MAX, 1e12}) {
+        std::string printed = captureStdout([&] { umbra_print_f64(value); });
+        EXPECT_EQ(printed, printfFixed(value));
+        EXPECT_EQ(printed.substr(printed.size() - 7), ".000000");
+    }
+    EXPECT_EQ(captureStdout([] { umbra_print_f64(-DBL_MAX); }).size(), 1 + 309 + 7u);
+}
+
+} // namespace umbra
+
+} // namespace umbra
@@ -0,0 +1,50 @@
+#include "umbra/runtime/umbra_rt.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Redirige stdin (fd 0) a un archivo temporal con text; el runtime lo lee hasta el final
+void feedStdin(const std::string& text) {
+    std::FILE* file = std::tmpfile();
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::rewind(file);
+    ::dup2(::fileno(file), STDIN_FILENO);
+    std::fclose(file);
+}
+
+} // namespace
+
+// El buffer de entrada es global: toda la entrada del proceso se consume en esta prueba.
+// Un token que no es un número se descarta y da 0, así un bucle de lectura no se queda girando
+TEST(RuntimeReadTest, NonNumericTokensAreSkipped) {
+    feedStdin("12 abc 7 - -x 9000000000 3.5 zz .e 2.0 -4\nrest of line\n");
+
+    EXPECT_EQ(umbra_read_i32(), 12);
+    EXPECT_EQ(umbra_read_i32(), 0);
+    EXPECT_EQ(umbra_read_i32(), 7);
+    EXPECT_EQ(umbra_read_i32(), 0);
+    EXPECT_EQ(umbra_read_i64(), 0);
+    EXPECT_EQ(umbra_read_i64(), 9000000000LL);
+    EXPECT_EQ(umbra_read_f64(), 3.5);
+    EXPECT_EQ(umbra_read_f64(), 0.0);
+    EXPECT_EQ(umbra_read_f32(), 0.0f);
+    EXPECT_EQ(umbra_read_f64(), 2.0);
+    EXPECT_EQ(umbra_read_i32(), -4);
+    EXPECT_STREQ(umbra_read_line(), "");
+    EXPECT_STREQ(umbra_read_line(), "rest of line");
+
+    // Al final de la entrada todas las lecturas devuelven 0 sin bloquear
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(umbra_read_i32(), 0);
+    EXPECT_STREQ(umbra_read_line(), "");
+}
+
+} // namespace umbra
+
+} // namespace umbra
@@ -0,0 +1,80 @@
+#include "umbra/error/ErrorManager.h"
+#include "umbra/lexer/Lexer.h"
+#include "umbra/parser/Parser.h"
+#include "umbra/semantic/SemanticAnalyzer.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Ejecuta el pipeline semántico y devuelve los mensajes de error emitidos
+std::vector<std::string> analyze(const std::string& source) {
+    ErrorManager errors;
+    Lexer lexer(source, errors);
+    std::vector<Lexer::Token> tokens = lexer.tokenize();
+    Parser parser(tokens, errors);
+    std::unique_ptr<ProgramNode> program = parser.parseProgram();
+    if (program && !errors.hasErrors()) {
+        SemanticAnalyzer analyzer(errors, program.get());
+        analyzer.execAnalysisPipeline();
+    }
+    std::vector<std::string> messages;
+    for (const auto& error : errors.getErrors()) messages.push_back(error->toString());
+    return messages;
+}
+
+// Anida depth llamadas a inc alrededor de 0
+std::string nestedCalls(int depth) {
+    std::string call = "0";
+    for (int i = 0; i < depth; ++i) call = "inc(" + call + ")";
+    return call;
+}
+
+const char* kInc = R"(func inc(int n) -> int {
+    return n + 1
+}
+)";
+
+} // namespace
+
+TEST(CallValidationTest, ArgumentErrorIsReportedOnce) {
+    std::string source = std::string(kInc) +
+                         "func start() -> void {\n    int result = inc(inc(missing))\n"
+                         "    print(\"{}\", result)\n}\n";
+    std::vector<std::string> messages = analyze(source);
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_NE(messages[0].find("missing"), std::string::npos);
+}
+
+TEST(CallValidationTest, DuplicateReferenceIsReportedOnce) {
+    std::string source = R"(func both(int []a, int []b) -> int {
+    return a[0] + b[0]
+}
+func start() -> void {
+    int [3]values
+    int result = both(values, values)
+    print("{}", result)
+}
+)";
+    std::vector<std::string> messages = analyze(source);
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_NE(messages[0].find("more than once by reference"), std::string::npos);
+    for (const auto& message : messages) EXPECT_EQ(message.find("internal error"), std::string::npos);
+}
+
+// Cada nivel valida sus argumentos una sola vez: el coste es lineal en la profundidad
+TEST(CallValidationTest, DeeplyNestedCallsAreValidatedOnce) {
+    std::string source = std::string(kInc) + "func start() -> void {\n    int result = " + nestedCalls(40) +
+                         "\n    print(\"{}\", result)\n}\n";
+    EXPECT_TRUE(analyze(source).empty());
+}
+
+} // namespace umbra
+
+} // namespace umbra
@@ -0,0 +1,184 @@
+#include "umbra/error/ErrorManager.h"
+#include "umbra/lexer/Lexer.h"
+#include "umbra/parser/Parser.h"
+#include "umbra/semantic/ConstEvaluator.h"
+#include "umbra/semantic/ConstantFolder.h"
+#include "umbra/semantic/SemanticAnalyzer.h"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Programa analizado y plegado; los avisos de ConstantFolder quedan en warnings
+struct Folded {
+    ErrorManager errors;
+    std::unique_ptr<ProgramNode> program;
+    std::ostringstream warnings;
+
+    explicit Folded(const std::string& source) {
+        Lexer lexer(source, errors);
+        std::vector<Lexer::Token> tokens = lexer.tokenize();
+        Parser parser(tokens, errors);
+        program = parser.parseProgram();
+        if (!program || errors.hasErrors()) return;
+        SemanticAnalyzer analyzer(errors, program.get());
+        analyzer.execAnalysisPipeline();
+        if (errors.hasErrors()) return;
+        ConstantFolder folder(errors, warnings);
+        folder.fold(program.get());
+    }
+
+    /// Inicializador (ya plegado) de la variable name declarada en start
+    Expression* initializer(const std::string& name) {
+        if (!program) return nullptr;
+        for (auto& function : program->functions) {
+            if (function->name->name != "start") continue;
+            for (auto& stmt : function->body) {
+                auto* declaration = dynamic_cast<VariableDeclaration*>(stmt.get());
+                if (declaration && declaration->name->name == name) return declaration->initializer.get();
+            }
+        }
+        return nullptr;
+    }
+};
+
+// start con una declaración `int result = <call>` y las constfunc dadas
+std::string withCall(const std::string& functions, const std::string& call) {
+    return functions + "\nfunc start() -> void {\n    int result = " + call +
+           "\n    print(\"{}\", result)\n}\n";
+}
+
+const char* kDepth = R"(constfunc depth(int n) -> int {
+    if (n == 0) {
+        return 0
+    }
+    return depth(n - 1) + 1
+}
+)";
+
+const char* kDivide = R"(constfunc divide(int a, int b) -> int {
+    return a / b
+}
+)";
+
+// La llamada se reemplazó por un literal con ese valor
+void expectFolded(Folded& folded, int64_t value) {
+    ASSERT_FALSE(folded.errors.hasErrors()) << folded.errors.getErrorReport();
+    auto* literal = dynamic_cast<NumericLiteral*>(folded.initializer("result"));
+    ASSERT_TRUE(literal) << "the call was not folded; warnings: " << folded.warnings.str();
+    EXPECT_EQ(literal->intValue, value);
+}
+
+// La llamada quedó para tiempo de ejecución
+void expectRuntimeCall(Folded& folded) {
+    ASSERT_FALSE(folded.errors.hasErrors()) << folded.errors.getErrorReport();
+    EXPECT_TRUE(dynamic_cast<FunctionCall*>(folded.initializer("result")));
+}
+
+} // namespace
+
+TEST(ConstEvaluatorTest, FoldsConstfuncCall) {
+    Folded folded(withCall(R"(constfunc sum(int n) -> int {
+    int total = 0
+    int i = 1
+    repeat n times {
+        total = total + i
+        i = i + 1
+    }
+    return total
+}
+)", "sum(100)"));
+    expectFolded(folded, 5050);
+    EXPECT_TRUE(folded.warnings.str().empty());
+}
+
+// Int envuelve a 32 bits como el código generado
+TEST(ConstEvaluatorTest, IntArithmeticWraps) {
+    Folded folded(withCall(R"(constfunc next(int n) -> int {
+    return n + 1
+}
+)", "next(2147483647)"));
+    expectFolded(folded, -2147483648LL);
+
+    Folded product(withCall(R"(constfunc square(int n) -> int {
+    return n * n
+}
+)", "square(65536)"));
+    expectFolded(product, 0);
+}
+
+// Long se pliega en 64 bits exactos, también por encima de 2^53
+TEST(ConstEvaluatorTest, LongArithmeticIsExact) {
+    Folded folded(withCall(R"(constfunc next(long n) -> long {
+    return n + 1
+}
+)", "next(9007199254740993)"));
+    expectFolded(folded, 9007199254740994LL);
+
+    Folded wrapped(withCall(R"(constfunc next(long n) -> long {
+    return n + 1
+}
+)", "next(9223372036854775807)"));
+    expectFolded(wrapped, INT64_MIN);
+}
+
+TEST(ConstEvaluatorTest, StepLimitLeavesRuntimeCall) {
+    Folded folded(withCall(R"(constfunc spin(int n) -> int {
+    int total = 0
+    repeat n times {
+        total = total + 1
+    }
+    return total
+}
+)", "spin(2000000)"));
+    expectRuntimeCall(folded);
+    EXPECT_NE(folded.warnings.str().find("step limit"), std::string::npos) << folded.warnings.str();
+}
+
+TEST(ConstEvaluatorTest, MemoryLimitLeavesRuntimeCall) {
+    Folded folded(withCall(R"(constfunc big(int n) -> int {
+    int [2000000]cells
+    cells[0] = n
+    return cells[0]
+}
+)", "big(3)"));
+    expectRuntimeCall(folded);
+    EXPECT_NE(folded.warnings.str().find("memory limit"), std::string::npos) << folded.warnings.str();
+}
+
+// MAX_CALL_DEPTH marcos: depth(255) usa 256 y se pliega; depth(256) ya no
+TEST(ConstEvaluatorTest, CallDepthLimit) {
+    ASSERT_EQ(ConstEvaluator::MAX_CALL_DEPTH, 256u);
+
+    Folded deepest(withCall(kDepth, "depth(255)"));
+    expectFolded(deepest, 255);
+
+    Folded tooDeep(withCall(kDepth, "depth(256)"));
+    expectRuntimeCall(tooDeep);
+    EXPECT_NE(tooDeep.warnings.str().find("call depth limit (256)"), std::string::npos) << tooDeep.warnings.str();
+}
+
+// Dividir por cero o MIN / -1 se deja para tiempo de ejecución, sin aviso de límites
+TEST(ConstEvaluatorTest, TrappingDivisionsStayRuntimeCalls) {
+    Folded byZero(withCall(kDivide, "divide(1, 0)"));
+    expectRuntimeCall(byZero);
+    EXPECT_TRUE(byZero.warnings.str().empty());
+
+    Folded overflow(withCall(kDivide, "divide(-2147483647 - 1, -1)"));
+    expectRuntimeCall(overflow);
+
+    Folded valid(withCall(kDivide, "divide(-7, 2)"));
+    expectFolded(valid, -3);
+}
+
+} // namespace umbra
+
+} // namespace umbra
@@ -0,0 +1,117 @@
+#include "umbra/io/BinaryStream.h"
+#include "umbra/server/DaemonProtocol.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace umbra {
+
+namespace umbra {
+
+namespace {
+
+// Par de sockets conectados entre sí, cerrados al terminar
+struct SocketPair {
+    int fds[2] = {-1, -1};
+    SocketPair() { EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0); }
+    ~SocketPair() {
+        for (int fd : fds) {
+            if (fd >= 0) ::close(fd);
+        }
+    }
+};
+
+DaemonProtocol::Request sampleRequest() {
+    DaemonProtocol::Request request;
+    request.workingDirectory = "/home/user/proyecto";
+    request.arguments = {"main.umbra", "-O", "2", "", "--emit-llvm"};
+    return request;
+}
+
+} // namespace
+
+TEST(DaemonProtocolTest, RequestRoundTrip) {
+    DaemonProtocol::Request request = sampleRequest();
+    DaemonProtocol::Request decoded;
+    std::string error;
+
+    ASSERT_TRUE(DaemonProtocol::decodeRequest(DaemonProtocol::encodeRequest(request), decoded, error)) << error;
+    EXPECT_EQ(decoded.workingDirectory, request.workingDirectory);
+    EXPECT_EQ(decoded.arguments, request.arguments);
+}
+
+// Un cliente de otra versión recibe un motivo que dice qué hacer
+TEST(DaemonProtocolTest, RejectsOtherVersion) {
+    BinaryWriter out;
+    out.writeVarint(DaemonProtocol::Version + 1);
+    out.writeString("/tmp");
+    out.writeVarint(0);
+
+    DaemonProtocol::Request decoded;
+    std::string error;
+    EXPECT_FALSE(DaemonProtocol::decodeRequest(out.buffer(), decoded, error));
+    EXPECT_NE(error.find("restart the daemon"), std::string::npos);
+}
+
+TEST(DaemonProtocolTest, RejectsTrailingBytesAndTruncation) {
+    std::string data = DaemonProtocol::encodeRequest(sampleRequest());
+    DaemonProtocol::Request decoded;
+    std::string error;
+
+    EXPECT_FALSE(DaemonProtocol::decodeRequest(data + "x", decoded, error));
+    EXPECT_EQ(error, "malformed request");
+
+    for (size_t length = 0; length < data.size(); ++length) {
+        DaemonProtocol::Request partial;
+        error.clear();
+        EXPECT_FALSE(DaemonProtocol::decodeRequest(std::string_view(data).substr(0, length), partial, error))
+            << "prefix of " << length << " bytes";
+        EXPECT_FALSE(error.empty());
+    }
+}
+
+TEST(DaemonProtocolTest, FrameRoundTrip) {
+    SocketPair sockets;
+    std::string payload(10000, 'a');
+    ASSERT_TRUE(DaemonProtocol::writeFrame(sockets.fds[0], DaemonProtocol::Frame::Stdout, payload));
+    ASSERT_TRUE(DaemonProtocol::writeFrame(sockets.fds[0], DaemonProtocol::Frame::Exit, std::string(1, '\0')));
+
+    DaemonProtocol::Frame type;
+    std::string data;
+    ASSERT_TRUE(DaemonProtocol::readFrame(sockets.fds[1], type, data));
+    EXPECT_EQ(type, DaemonProtocol::Frame::Stdout);
+    EXPECT_EQ(data, payload);
+    ASSERT_TRUE(DaemonProtocol::readFrame(sockets.fds[1], type, data));
+    EXPECT_EQ(type, DaemonProtocol::Frame::Exit);
+    EXPECT_EQ(data, std::string(1, '\0'));
+}
+
+// El daemon no reserva memoria por una longitud mayor que la permitida
+TEST(DaemonProtocolTest, RejectsFrameOverMaxSize) {
+    SocketPair sockets;
+    ASSERT_TRUE(DaemonProtocol::writeFrame(sockets.fds[0], DaemonProtocol::Frame::Request, std::string(65, 'r')));
+
+    DaemonProtocol::Frame type;
+    std::string data;
+    EXPECT_FALSE(DaemonProtocol::readFrame(sockets.fds[1], type, data, 64));
+    EXPECT_TRUE(data.empty());
+}
+
+// Una conexión cerrada a mitad de un frame no se toma por un frame completo
+TEST(DaemonProtocolTest, RejectsFrameCutShort) {
+    SocketPair sockets;
+    const char header[5] = {static_cast<char>(DaemonProtocol::Frame::Stderr), 10, 0, 0, 0};
+    ASSERT_EQ(::write(sockets.fds[0], header, sizeof header), static_cast<ssize_t>(sizeof header));
+    ASSERT_EQ(::write(sockets.fds[0], "abc", 3), 3);
+    ::close(sockets.fds[0]);
+    sockets.fds[0] = -1;
+
+    DaemonProtocol::Frame type;
+    std::string data;
+    EXPECT_FALSE(DaemonProtocol::readFrame(sockets.fds[1], type, data));
+}
+
+} // namespace umbra
+
+} // namespace umbra